@@ -0,0 +1,448 @@
+/*
+	4x64-bit curve25519 field arithmetic for x86-64 with BMI2 and ADX
+
+	An element is 4 full 64-bit limbs, the same layout as the 4x64 words used
+	by the half-size reducers and EEA_q. Elements are kept in [0, 2^256) and
+	only reduced mod 2^255 - 19 by curve25519_contract; every add/sub folds its
+	carry back with 2^256 = 38 (mod p), so there is no headroom to manage and
+	the _after_basic and _reduce variants are the plain operations.
+
+	The 4x4 product uses mulx with two independent carry chains (adcx on CF
+	for the low halves, adox on OF for the high halves) and the 512-bit result
+	is folded the same way; squaring sums the cross products once and doubles
+	them. Build with -madx -mbmi2; without them the product and the square
+	fall back to uint128_t C (add/sub are plain adc/sbb assembly either way).
+*/
+
+typedef uint64_t bignum25519[4];
+
+static const uint64_t reduce_mask_63 = ((uint64_t)1 << 63) - 1;
+
+/* r = a + b + c, c = carry out */
+#define adc64(r, a, b, c) { uint128_t t_ = (uint128_t)(a) + (b) + (c); r = (uint64_t)t_; c = (uint64_t)(t_ >> 64); }
+
+/* out = in */
+DONNA_INLINE static void
+curve25519_copy(bignum25519 out, const bignum25519 in) {
+	out[0] = in[0];
+	out[1] = in[1];
+	out[2] = in[2];
+	out[3] = in[3];
+}
+
+/* out = a + b */
+DONNA_INLINE static void
+curve25519_add(bignum25519 out, const bignum25519 a, const bignum25519 b) {
+	uint64_t r0 = a[0], r1 = a[1], r2 = a[2], r3 = a[3], c;
+
+	/* 2^256 = 38, twice: the first fold can carry out again only when r1..r3 are all ones */
+	__asm__ (
+		"addq   %5, %0      \n\t"
+		"adcq   %6, %1      \n\t"
+		"adcq   %7, %2      \n\t"
+		"adcq   %8, %3      \n\t"
+		"sbbq   %4, %4      \n\t"
+		"andq   $38, %4     \n\t"
+		"addq   %4, %0      \n\t"
+		"adcq   $0, %1      \n\t"
+		"adcq   $0, %2      \n\t"
+		"adcq   $0, %3      \n\t"
+		"sbbq   %4, %4      \n\t"
+		"andq   $38, %4     \n\t"
+		"addq   %4, %0      \n\t"
+		: "+r" (r0), "+r" (r1), "+r" (r2), "+r" (r3), "=&r" (c)
+		: "rm" (b[0]), "rm" (b[1]), "rm" (b[2]), "rm" (b[3])
+		: "cc"
+	);
+	out[0] = r0;
+	out[1] = r1;
+	out[2] = r2;
+	out[3] = r3;
+}
+
+/* out = a + b, where a and/or b are the result of a basic op (add,sub) */
+DONNA_INLINE static void
+curve25519_add_after_basic(bignum25519 out, const bignum25519 a, const bignum25519 b) {
+	curve25519_add(out, a, b);
+}
+
+DONNA_INLINE static void
+curve25519_add_reduce(bignum25519 out, const bignum25519 a, const bignum25519 b) {
+	curve25519_add(out, a, b);
+}
+
+/* out = a - b */
+DONNA_INLINE static void
+curve25519_sub(bignum25519 out, const bignum25519 a, const bignum25519 b) {
+	uint64_t r0 = a[0], r1 = a[1], r2 = a[2], r3 = a[3], c;
+
+	/* a borrow added 2^256 = 38, take it back; a second borrow leaves r0 near 2^64 */
+	__asm__ (
+		"subq   %5, %0      \n\t"
+		"sbbq   %6, %1      \n\t"
+		"sbbq   %7, %2      \n\t"
+		"sbbq   %8, %3      \n\t"
+		"sbbq   %4, %4      \n\t"
+		"andq   $38, %4     \n\t"
+		"subq   %4, %0      \n\t"
+		"sbbq   $0, %1      \n\t"
+		"sbbq   $0, %2      \n\t"
+		"sbbq   $0, %3      \n\t"
+		"sbbq   %4, %4      \n\t"
+		"andq   $38, %4     \n\t"
+		"subq   %4, %0      \n\t"
+		: "+r" (r0), "+r" (r1), "+r" (r2), "+r" (r3), "=&r" (c)
+		: "rm" (b[0]), "rm" (b[1]), "rm" (b[2]), "rm" (b[3])
+		: "cc"
+	);
+	out[0] = r0;
+	out[1] = r1;
+	out[2] = r2;
+	out[3] = r3;
+}
+
+/* out = a - b, where a and/or b are the result of a basic op (add,sub) */
+DONNA_INLINE static void
+curve25519_sub_after_basic(bignum25519 out, const bignum25519 a, const bignum25519 b) {
+	curve25519_sub(out, a, b);
+}
+
+DONNA_INLINE static void
+curve25519_sub_reduce(bignum25519 out, const bignum25519 a, const bignum25519 b) {
+	curve25519_sub(out, a, b);
+}
+
+/* out = -a */
+DONNA_INLINE static void
+curve25519_neg(bignum25519 out, const bignum25519 a) {
+	static const bignum25519 zero = {0, 0, 0, 0};
+	curve25519_sub(out, zero, a);
+}
+
+/* out = a * b */
+DONNA_INLINE static void
+curve25519_mul(bignum25519 out, const bignum25519 a, const bignum25519 b) {
+#if defined(__BMI2__) && defined(__ADX__)
+	uint64_t t[3];
+
+	/*
+	 * Row i adds a[i] * b into the accumulator t[i..i+4]: adcx carries the low
+	 * halves into t[i+j], adox the high halves into t[i+j+1]. t[i] is final
+	 * after row i and goes to the scratch buffer, so five registers rotate
+	 * through the rows. Then t[0..3] + 38 * t[4..7] with the same two chains.
+	 */
+	__asm__ __volatile__ (
+		/* row 0: t0..t4 = r8, r9, r10, r11, r12 */
+		"movq   (%1), %%rdx           \n\t"
+		"mulxq  (%2), %%r8, %%r9      \n\t"
+		"mulxq  8(%2), %%r13, %%r10   \n\t"
+		"addq   %%r13, %%r9           \n\t"
+		"mulxq  16(%2), %%r13, %%r11  \n\t"
+		"adcq   %%r13, %%r10          \n\t"
+		"mulxq  24(%2), %%r13, %%r12  \n\t"
+		"adcq   %%r13, %%r11          \n\t"
+		"adcq   $0, %%r12             \n\t"
+		"movq   %%r8, (%3)            \n\t"
+
+		/* row 1: t1..t4 = r9, r10, r11, r12, t5 = r8 */
+		"movq   8(%1), %%rdx          \n\t"
+		"xorl   %%eax, %%eax          \n\t"
+		"mulxq  (%2), %%r13, %%r14    \n\t"
+		"adcxq  %%r13, %%r9           \n\t"
+		"adoxq  %%r14, %%r10          \n\t"
+		"mulxq  8(%2), %%r13, %%r14   \n\t"
+		"adcxq  %%r13, %%r10          \n\t"
+		"adoxq  %%r14, %%r11          \n\t"
+		"mulxq  16(%2), %%r13, %%r14  \n\t"
+		"adcxq  %%r13, %%r11          \n\t"
+		"adoxq  %%r14, %%r12          \n\t"
+		"mulxq  24(%2), %%r13, %%r8   \n\t"
+		"adcxq  %%r13, %%r12          \n\t"
+		"adoxq  %%rax, %%r8           \n\t"
+		"adcxq  %%rax, %%r8           \n\t"
+		"movq   %%r9, 8(%3)           \n\t"
+
+		/* row 2: t2..t5 = r10, r11, r12, r8, t6 = r9 */
+		"movq   16(%1), %%rdx         \n\t"
+		"xorl   %%eax, %%eax          \n\t"
+		"mulxq  (%2), %%r13, %%r14    \n\t"
+		"adcxq  %%r13, %%r10          \n\t"
+		"adoxq  %%r14, %%r11          \n\t"
+		"mulxq  8(%2), %%r13, %%r14   \n\t"
+		"adcxq  %%r13, %%r11          \n\t"
+		"adoxq  %%r14, %%r12          \n\t"
+		"mulxq  16(%2), %%r13, %%r14  \n\t"
+		"adcxq  %%r13, %%r12          \n\t"
+		"adoxq  %%r14, %%r8           \n\t"
+		"mulxq  24(%2), %%r13, %%r9   \n\t"
+		"adcxq  %%r13, %%r8           \n\t"
+		"adoxq  %%rax, %%r9           \n\t"
+		"adcxq  %%rax, %%r9           \n\t"
+		"movq   %%r10, 16(%3)         \n\t"
+
+		/* row 3: t3..t6 = r11, r12, r8, r9, t7 = r10 */
+		"movq   24(%1), %%rdx         \n\t"
+		"xorl   %%eax, %%eax          \n\t"
+		"mulxq  (%2), %%r13, %%r14    \n\t"
+		"adcxq  %%r13, %%r11          \n\t"
+		"adoxq  %%r14, %%r12          \n\t"
+		"mulxq  8(%2), %%r13, %%r14   \n\t"
+		"adcxq  %%r13, %%r12          \n\t"
+		"adoxq  %%r14, %%r8           \n\t"
+		"mulxq  16(%2), %%r13, %%r14  \n\t"
+		"adcxq  %%r13, %%r8           \n\t"
+		"adoxq  %%r14, %%r9           \n\t"
+		"mulxq  24(%2), %%r13, %%r10  \n\t"
+		"adcxq  %%r13, %%r9           \n\t"
+		"adoxq  %%rax, %%r10          \n\t"
+		"adcxq  %%rax, %%r10          \n\t"
+
+		/* t0..t2 in (%3), t3 = r11, t4..t7 = r12, r8, r9, r10: r = t0..t3 + 38 * t4..t7 in r13, r12, r14, r15 */
+		"movl   $38, %%edx            \n\t"
+		"xorl   %%eax, %%eax          \n\t"
+		"mulxq  %%r12, %%r13, %%r14   \n\t"
+		"adcxq  (%3), %%r13           \n\t"
+		"mulxq  %%r8, %%r12, %%r8     \n\t"
+		"adcxq  8(%3), %%r12          \n\t"
+		"adoxq  %%r14, %%r12          \n\t"
+		"mulxq  %%r9, %%r14, %%r9     \n\t"
+		"adcxq  16(%3), %%r14         \n\t"
+		"adoxq  %%r8, %%r14           \n\t"
+		"mulxq  %%r10, %%r15, %%r10   \n\t"
+		"adcxq  %%r11, %%r15          \n\t"
+		"adoxq  %%r9, %%r15           \n\t"
+		"adcxq  %%rax, %%r10          \n\t"
+		"adoxq  %%rax, %%r10          \n\t"
+
+		/* fold the top word (at most 39), then a last carry out of 2^256 */
+		"imulq  $38, %%r10, %%r10     \n\t"
+		"addq   %%r10, %%r13          \n\t"
+		"adcq   $0, %%r12             \n\t"
+		"adcq   $0, %%r14             \n\t"
+		"adcq   $0, %%r15             \n\t"
+		"sbbq   %%rax, %%rax          \n\t"
+		"andq   $38, %%rax            \n\t"
+		"addq   %%rax, %%r13          \n\t"
+		"movq   %%r13, (%0)           \n\t"
+		"movq   %%r12, 8(%0)          \n\t"
+		"movq   %%r14, 16(%0)         \n\t"
+		"movq   %%r15, 24(%0)         \n\t"
+		:
+		: "r" (out), "r" (a), "r" (b), "r" (t)
+		: "rax", "rdx", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15", "cc", "memory"
+	);
+#else
+	uint128_t m;
+	uint64_t t[8], r[4], c, h;
+	size_t i, j;
+
+	for (i = 0; i < 8; i++)
+		t[i] = 0;
+	for (i = 0; i < 4; i++) {
+		c = 0;
+		for (j = 0; j < 4; j++) {
+			m = (uint128_t)a[i] * b[j] + t[i + j] + c;
+			t[i + j] = (uint64_t)m;
+			c = (uint64_t)(m >> 64);
+		}
+		t[i + 4] = c;
+	}
+	c = 0;
+	for (i = 0; i < 4; i++) {
+		m = (uint128_t)t[i + 4] * 38 + t[i] + c;
+		r[i] = (uint64_t)m;
+		c = (uint64_t)(m >> 64);
+	}
+	c *= 38;
+	h = 0;
+	adc64(r[0], r[0], c, h);
+	adc64(r[1], r[1], 0, h);
+	adc64(r[2], r[2], 0, h);
+	adc64(r[3], r[3], 0, h);
+	out[0] = r[0] + h * 38;
+	out[1] = r[1];
+	out[2] = r[2];
+	out[3] = r[3];
+#endif
+}
+
+DONNA_NOINLINE static void
+curve25519_mul_noinline(bignum25519 out, const bignum25519 in2, const bignum25519 in) {
+	curve25519_mul(out, in2, in);
+}
+
+/* out = in^2 */
+DONNA_INLINE static void
+curve25519_square(bignum25519 out, const bignum25519 in) {
+#if defined(__BMI2__) && defined(__ADX__)
+	/*
+	 * The six cross products in[i] * in[j], i < j, are summed into t1..t6,
+	 * doubled into t1..t7, then the four squares in[i]^2 are added along the
+	 * diagonal: 10 mulx instead of 16. t0..t7 = r8..r15, reduced as in mul.
+	 */
+	__asm__ __volatile__ (
+		"movq   (%1), %%rdx           \n\t"
+		"mulxq  8(%1), %%r9, %%r10    \n\t"
+		"mulxq  16(%1), %%rax, %%r11  \n\t"
+		"addq   %%rax, %%r10          \n\t"
+		"mulxq  24(%1), %%rax, %%r12  \n\t"
+		"adcq   %%rax, %%r11          \n\t"
+		"adcq   $0, %%r12             \n\t"
+
+		"movq   8(%1), %%rdx          \n\t"
+		"xorl   %%r14d, %%r14d        \n\t"
+		"mulxq  16(%1), %%rax, %%rbx  \n\t"
+		"adcxq  %%rax, %%r11          \n\t"
+		"adoxq  %%rbx, %%r12          \n\t"
+		"mulxq  24(%1), %%rax, %%r13  \n\t"
+		"adcxq  %%rax, %%r12          \n\t"
+		"adoxq  %%r14, %%r13          \n\t"
+		"adcxq  %%r14, %%r13          \n\t"
+
+		"movq   16(%1), %%rdx         \n\t"
+		"mulxq  24(%1), %%rax, %%r14  \n\t"
+		"addq   %%rax, %%r13          \n\t"
+		"adcq   $0, %%r14             \n\t"
+
+		/* t1..t7 = 2 * (t1..t6) */
+		"xorl   %%r15d, %%r15d        \n\t"
+		"addq   %%r9, %%r9            \n\t"
+		"adcq   %%r10, %%r10          \n\t"
+		"adcq   %%r11, %%r11          \n\t"
+		"adcq   %%r12, %%r12          \n\t"
+		"adcq   %%r13, %%r13          \n\t"
+		"adcq   %%r14, %%r14          \n\t"
+		"adcq   $0, %%r15             \n\t"
+
+		/* + in[i]^2 at t(2i) */
+		"movq   (%1), %%rdx           \n\t"
+		"mulxq  %%rdx, %%r8, %%rax    \n\t"
+		"addq   %%rax, %%r9           \n\t"
+		"movq   8(%1), %%rdx          \n\t"
+		"mulxq  %%rdx, %%rax, %%rbx   \n\t"
+		"adcq   %%rax, %%r10          \n\t"
+		"adcq   %%rbx, %%r11          \n\t"
+		"movq   16(%1), %%rdx         \n\t"
+		"mulxq  %%rdx, %%rax, %%rbx   \n\t"
+		"adcq   %%rax, %%r12          \n\t"
+		"adcq   %%rbx, %%r13          \n\t"
+		"movq   24(%1), %%rdx         \n\t"
+		"mulxq  %%rdx, %%rax, %%rbx   \n\t"
+		"adcq   %%rax, %%r14          \n\t"
+		"adcq   %%rbx, %%r15          \n\t"
+
+		/* r = t0..t3 + 38 * t4..t7 in r8..r11 */
+		"movl   $38, %%edx            \n\t"
+		"xorl   %%ebx, %%ebx          \n\t"
+		"mulxq  %%r12, %%rax, %%r12   \n\t"
+		"adcxq  %%rax, %%r8           \n\t"
+		"adoxq  %%r12, %%r9           \n\t"
+		"mulxq  %%r13, %%rax, %%r13   \n\t"
+		"adcxq  %%rax, %%r9           \n\t"
+		"adoxq  %%r13, %%r10          \n\t"
+		"mulxq  %%r14, %%rax, %%r14   \n\t"
+		"adcxq  %%rax, %%r10          \n\t"
+		"adoxq  %%r14, %%r11          \n\t"
+		"mulxq  %%r15, %%rax, %%r15   \n\t"
+		"adcxq  %%rax, %%r11          \n\t"
+		"adoxq  %%rbx, %%r15          \n\t"
+		"adcxq  %%rbx, %%r15          \n\t"
+
+		"imulq  $38, %%r15, %%r15     \n\t"
+		"addq   %%r15, %%r8           \n\t"
+		"adcq   $0, %%r9              \n\t"
+		"adcq   $0, %%r10             \n\t"
+		"adcq   $0, %%r11             \n\t"
+		"sbbq   %%rax, %%rax          \n\t"
+		"andq   $38, %%rax            \n\t"
+		"addq   %%rax, %%r8           \n\t"
+		"movq   %%r8, (%0)            \n\t"
+		"movq   %%r9, 8(%0)           \n\t"
+		"movq   %%r10, 16(%0)         \n\t"
+		"movq   %%r11, 24(%0)         \n\t"
+		:
+		: "r" (out), "r" (in)
+		: "rax", "rbx", "rdx", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15", "cc", "memory"
+	);
+#else
+	curve25519_mul(out, in, in);
+#endif
+}
+
+/* out = in^(2 * count) */
+DONNA_NOINLINE static void
+curve25519_square_times(bignum25519 out, const bignum25519 in, uint64_t count) {
+	curve25519_square(out, in);
+	while (--count)
+		curve25519_square(out, out);
+}
+
+/* Take a little-endian, 32-byte number and expand it into the 4x64 form */
+DONNA_INLINE static void
+curve25519_expand(bignum25519 out, const unsigned char *in) {
+	out[0] = U8TO64_LE(in +  0);
+	out[1] = U8TO64_LE(in +  8);
+	out[2] = U8TO64_LE(in + 16);
+	out[3] = U8TO64_LE(in + 24) & reduce_mask_63;
+}
+
+/* out = in mod 2^255 - 19, fully reduced */
+DONNA_INLINE static void
+curve25519_freeze(bignum25519 out, const bignum25519 in) {
+	uint64_t t0, t1, t2, t3, u0, u1, u2, u3, c, mask;
+
+	/* fold bit 255 twice: t < 2^255 */
+	t0 = in[0]; t1 = in[1]; t2 = in[2]; t3 = in[3];
+	c = (t3 >> 63) * 19; t3 &= reduce_mask_63;
+	u0 = 0; adc64(t0, t0, c, u0); adc64(t1, t1, 0, u0); adc64(t2, t2, 0, u0); adc64(t3, t3, 0, u0);
+	c = (t3 >> 63) * 19; t3 &= reduce_mask_63;
+	t0 += c;
+
+	/* t >= p iff t + 19 >= 2^255, in which case the result is t + 19 - 2^255 */
+	c = 19;
+	adc64(u0, t0, 0, c); adc64(u1, t1, 0, c); adc64(u2, t2, 0, c); adc64(u3, t3, 0, c);
+	mask = (uint64_t)0 - (u3 >> 63);
+	u3 &= reduce_mask_63;
+	out[0] = t0 ^ (mask & (t0 ^ u0));
+	out[1] = t1 ^ (mask & (t1 ^ u1));
+	out[2] = t2 ^ (mask & (t2 ^ u2));
+	out[3] = t3 ^ (mask & (t3 ^ u3));
+}
+
+/* Take an element in 4x64 form, reduce it and contract it into a
+ * little-endian, 32-byte array
+ */
+DONNA_INLINE static void
+curve25519_contract(unsigned char *out, const bignum25519 input) {
+	bignum25519 t;
+
+	curve25519_freeze(t, input);
+	U64TO8_LE(out +  0, t[0]);
+	U64TO8_LE(out +  8, t[1]);
+	U64TO8_LE(out + 16, t[2]);
+	U64TO8_LE(out + 24, t[3]);
+}
+
+/* out = (flag) ? in : out */
+DONNA_INLINE static void
+curve25519_move_conditional_bytes(uint8_t out[96], const uint8_t in[96], uint64_t flag) {
+	const uint64_t nb = flag - 1, b = ~nb;
+	const uint64_t *inq = (const uint64_t *)in;
+	uint64_t *outq = (uint64_t *)out;
+	size_t i;
+
+	for (i = 0; i < 12; i++)
+		outq[i] = (outq[i] & nb) | (inq[i] & b);
+}
+
+/* if (iswap) swap(a, b) */
+DONNA_INLINE static void
+curve25519_swap_conditional(bignum25519 a, bignum25519 b, uint64_t iswap) {
+	const uint64_t swap = (uint64_t)(-(int64_t)iswap);
+	uint64_t x0,x1,x2,x3;
+
+	x0 = swap & (a[0] ^ b[0]); a[0] ^= x0; b[0] ^= x0;
+	x1 = swap & (a[1] ^ b[1]); a[1] ^= x1; b[1] ^= x1;
+	x2 = swap & (a[2] ^ b[2]); a[2] ^= x2; b[2] ^= x2;
+	x3 = swap & (a[3] ^ b[3]); a[3] ^= x3; b[3] ^= x3;
+}
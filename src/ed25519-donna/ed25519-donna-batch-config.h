@@ -0,0 +1,7 @@
+/*
+	Batch verification profile, generated by `make calibrate`
+*/
+
+#define ED25519_BATCH_CHUNK_SIZE 128
+#define ED25519_BATCH_MIN_SIZE 4
+#define ED25519_BATCH_HALF_SIZE ED25519_BATCH_HEEA
@@ -0,0 +1,160 @@
+/*
+	Blinding randomness of the batch verifiers
+
+	Every batch chunk draws a random U, and the joint verifier 16 bytes per
+	signature after the first. ed25519_batch_rng_use selects where they come
+	from:
+
+	- ED25519_BATCH_RNG_DRBG (default): a per-thread ChaCha20 generator, keyed
+	  once per thread (and again after fork) from ed25519_randombytes_unsafe.
+	  Every refill of 4 blocks overwrites the key with the first 32 bytes of
+	  its output, and served bytes are wiped, so earlier outputs can not be
+	  recovered from the state;
+	- ED25519_BATCH_RNG_SYSTEM: ed25519_randombytes_unsafe for every chunk;
+	- ED25519_BATCH_RNG_TRANSCRIPT: SHA-512 of a domain tag, the number of
+	  signatures and, for each of them, R, S, A and H(R,A,M). U only depends
+	  on the batch, which makes benchmarks and replays reproducible; any
+	  change to a signature changes U, so the check stays sound when SHA-512
+	  is modelled as a random oracle.
+*/
+
+#include <unistd.h>
+
+#if defined(COMPILER_MSVC)
+	#define ED25519_THREAD_LOCAL __declspec(thread)
+#else
+	#define ED25519_THREAD_LOCAL __thread
+#endif
+
+typedef struct ed25519_batch_drbg_t {
+	uint32_t key[8];
+	unsigned char buffer[256];
+	size_t left;
+	pid_t pid; /* 0 until seeded */
+} ed25519_batch_drbg;
+
+static ed25519_batch_rng ed25519_batch_rng_mode = ED25519_BATCH_RNG_DRBG;
+static ED25519_THREAD_LOCAL ed25519_batch_drbg ed25519_batch_drbg_state;
+
+#define chacha20_quarter(a, b, c, d) \
+	a += b; d = ROTL32(d ^ a, 16); \
+	c += d; b = ROTL32(b ^ c, 12); \
+	a += b; d = ROTL32(d ^ a, 8); \
+	c += d; b = ROTL32(b ^ c, 7);
+
+/* one ChaCha20 block (RFC 8439) with a zero nonce */
+static void
+chacha20_block(unsigned char out[64], const uint32_t key[8], uint32_t counter) {
+	uint32_t x[16], j[16];
+	size_t i;
+
+	j[0] = 0x61707865;
+	j[1] = 0x3320646e;
+	j[2] = 0x79622d32;
+	j[3] = 0x6b206574;
+	for (i = 0; i < 8; i++)
+		j[4 + i] = key[i];
+	j[12] = counter;
+	j[13] = j[14] = j[15] = 0;
+
+	memcpy(x, j, sizeof(x));
+	for (i = 0; i < 10; i++) {
+		chacha20_quarter(x[0], x[4], x[ 8], x[12])
+		chacha20_quarter(x[1], x[5], x[ 9], x[13])
+		chacha20_quarter(x[2], x[6], x[10], x[14])
+		chacha20_quarter(x[3], x[7], x[11], x[15])
+		chacha20_quarter(x[0], x[5], x[10], x[15])
+		chacha20_quarter(x[1], x[6], x[11], x[12])
+		chacha20_quarter(x[2], x[7], x[ 8], x[13])
+		chacha20_quarter(x[3], x[4], x[ 9], x[14])
+	}
+	for (i = 0; i < 16; i++)
+		U32TO8_LE(out + 4 * i, x[i] + j[i]);
+}
+
+static void
+ed25519_batch_drbg_refill(ed25519_batch_drbg *st) {
+	size_t i;
+
+	for (i = 0; i < sizeof(st->buffer) / 64; i++)
+		chacha20_block(st->buffer + 64 * i, st->key, (uint32_t)i);
+	for (i = 0; i < 8; i++)
+		st->key[i] = U8TO32_LE(st->buffer + 4 * i);
+	memset(st->buffer, 0, 32);
+	st->left = sizeof(st->buffer) - 32;
+}
+
+static void
+ed25519_batch_drbg_random(ed25519_batch_drbg *st, unsigned char *out, size_t len) {
+	unsigned char seed[32], *p;
+	pid_t pid = getpid();
+	size_t i, use;
+
+	if (st->pid != pid) {
+		ED25519_FN(ed25519_randombytes_unsafe) (seed, sizeof(seed));
+		for (i = 0; i < 8; i++)
+			st->key[i] = U8TO32_LE(seed + 4 * i);
+		memset(seed, 0, sizeof(seed));
+		st->left = 0;
+		st->pid = pid;
+	}
+
+	while (len) {
+		if (!st->left)
+			ed25519_batch_drbg_refill(st);
+		use = (len > st->left) ? st->left : len;
+		p = st->buffer + sizeof(st->buffer) - st->left;
+		memcpy(out, p, use);
+		memset(p, 0, use);
+		st->left -= use;
+		out += use;
+		len -= use;
+	}
+}
+
+/* starts the transcript of a chunk; returns 0, and leaves ctx untouched, unless it is needed */
+static int
+ed25519_batch_transcript_init(ed25519_hash_context *ctx, const char *tag, size_t num) {
+	unsigned char count[8];
+
+	if (ed25519_batch_rng_mode != ED25519_BATCH_RNG_TRANSCRIPT)
+		return 0;
+	U64TO8_LE(count, (uint64_t)num);
+	ed25519_hash_init(ctx);
+	ed25519_hash_update(ctx, (const unsigned char *)tag, strlen(tag) + 1);
+	ed25519_hash_update(ctx, count, sizeof(count));
+	return 1;
+}
+
+static void
+ed25519_batch_transcript_add(ed25519_hash_context *ctx, const unsigned char *RS, const unsigned char *pk, const unsigned char hram[64]) {
+	ed25519_hash_update(ctx, RS, 64);
+	ed25519_hash_update(ctx, pk, 32);
+	ed25519_hash_update(ctx, hram, 64);
+}
+
+/* fills out with len <= 64 bytes of blinding randomness for one chunk, transcript is NULL unless it was started */
+static void
+ed25519_batch_randomness(unsigned char *out, size_t len, ed25519_hash_context *transcript) {
+	unsigned char hash[64];
+
+	if (transcript) {
+		ed25519_hash_final(transcript, hash);
+		memcpy(out, hash, len);
+	} else if (ed25519_batch_rng_mode == ED25519_BATCH_RNG_SYSTEM) {
+		ED25519_FN(ed25519_randombytes_unsafe) (out, len);
+	} else {
+		ed25519_batch_drbg_random(&ed25519_batch_drbg_state, out, len);
+	}
+}
+
+/* the per-thread generator behind ED25519_BATCH_RNG_DRBG */
+void
+ED25519_FN(ed25519_randombytes_drbg) (void *p, size_t len) {
+	ed25519_batch_drbg_random(&ed25519_batch_drbg_state, (unsigned char *)p, len);
+}
+
+void
+ED25519_FN(ed25519_batch_rng_use) (ed25519_batch_rng mode) {
+	ed25519_batch_rng_mode = mode;
+}
@@ -33,6 +33,8 @@
  * Modified version from ed25519-donna-batchverify.h
 */
 
+#include "ed25519-donna-batch-config.h"
+
 
 
 
@@ -40,13 +42,23 @@
 // #define heap_batch_size_new max_batch_size_new
 #define bignum256modm_128bitsScalar_most_significant_limb_index (128 / bignum256modm_bits_per_limb)
 
+/*
+ * View of the scratch arrays that the Bos-Coster heap works on. The arrays
+ * live in an ed25519_batch_workspace, so their size is not fixed at compile
+ * time and points and scalars can be switched between the two passes.
+ */
+typedef struct batch_heap_new_t {
+	ge25519 *points;
+	bignum256modm *scalars;
+	heap_index_t *heap;
+	size_t size;
+} batch_heap_new;
+
 static void
-heap_build_new(batch_heap *heap, size_t count) {
+heap_build_new(batch_heap_new *heap, size_t count) {
 	heap->heap[0] = 0;
 	heap->size = 0;
 	while (heap->size < count){
-		// heap_insert_next_new(heap);
-
 		size_t node = heap->size, parent;
 		heap_index_t *pheap = heap->heap;
 		bignum256modm *scalars = heap->scalars;
@@ -63,9 +75,46 @@ heap_build_new(batch_heap *heap, size_t count) {
 			parent = (node - 1) / 2;
 		}
 		heap->size++;
-		
 	}
+}
+
+/* heap_updated_root on a batch_heap_new */
+static void
+heap_updated_root_new(batch_heap_new *heap, size_t limbsize) {
+	size_t node, parent, childr, childl;
+	heap_index_t *pheap = heap->heap;
+	bignum256modm *scalars = heap->scalars;
+
+	/* sift root to the bottom */
+	parent = 0;
+	node = 1;
+	childl = 1;
+	childr = 2;
+	while ((childr < heap->size)) {
+		node = lt256_modm_batch(scalars[pheap[childl]], scalars[pheap[childr]], limbsize) ? childr : childl;
+		heap_swap(pheap, parent, node);
+		parent = node;
+		childl = (parent * 2) + 1;
+		childr = childl + 1;
+	}
+
+	/* sift root back up to its sorted spot */
+	parent = (node - 1) / 2;
+	while (node && lte256_modm_batch(scalars[pheap[parent]], scalars[pheap[node]], limbsize)) {
+		heap_swap(pheap, parent, node);
+		node = parent;
+		parent = (node - 1) / 2;
+	}
+}
 
+/* heap_get_top2 on a batch_heap_new */
+static void
+heap_get_top2_new(batch_heap_new *heap, heap_index_t *max1, heap_index_t *max2, size_t limbsize) {
+	heap_index_t h0 = heap->heap[0], h1 = heap->heap[1], h2 = heap->heap[2];
+	if (lt256_modm_batch(heap->scalars[h1], heap->scalars[h2], limbsize))
+		h1 = h2;
+	*max1 = h0;
+	*max2 = h1;
 }
 
 static void
@@ -115,7 +164,7 @@ ge25519_multi_scalarmult_vartime_final_new(ge25519 *r, ge25519 *point, bignum256
 
 /* count must be >= 3 */
 static void
-ge25519_multi_scalarmult_vartime_new(heap_index_t *max_index, batch_heap *heap, size_t count) {
+ge25519_multi_scalarmult_vartime_new(heap_index_t *max_index, batch_heap_new *heap, size_t count) {
 	heap_index_t max1, max2;
 
 	size_t limbsize =  bignum256modm_128bitsScalar_most_significant_limb_index;
@@ -124,7 +173,7 @@ ge25519_multi_scalarmult_vartime_new(heap_index_t *max_index, batch_heap *heap,
 	heap_build_new(heap, count);
 
 	for (;;) {
-	heap_get_top2(heap, &max1, &max2, limbsize);
+	heap_get_top2_new(heap, &max1, &max2, limbsize);
 
 	/* only one scalar remaining, we're done */
 	if (iszero256_modm_batch(heap->scalars[max2]))
@@ -143,7 +192,7 @@ ge25519_multi_scalarmult_vartime_new(heap_index_t *max_index, batch_heap *heap,
 
 	sub256_modm_batch(heap->scalars[max1], heap->scalars[max1], heap->scalars[max2], limbsize);
 	ge25519_add(&heap->points[max2], &heap->points[max2], &heap->points[max1]);
-	heap_updated_root(heap, limbsize);
+	heap_updated_root_new(heap, limbsize);
 	}
 
 	// ge25519_multi_scalarmult_vartime_new_final(r, &heap->points[max1], heap->scalars[max1]);
@@ -151,371 +200,1006 @@ ge25519_multi_scalarmult_vartime_new(heap_index_t *max_index, batch_heap *heap,
 }
 
 
-int
-ED25519_FN(ed25519_sign_open_batch_hEEA) (const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid) {
-	heap_index_t max_index;
-	batch_heap ALIGN(16) batch;
-	ge25519 ALIGN(16) sumR;
-	ge25519 ALIGN(16) sumBA;
-	ge25519 ALIGN(16) sumBAR;
-	ge25519 *tmp_point;
-	bignum25519 tmp_cordinate;
-	size_t i, batchsize, heap_size, limbsize = bignum256modm_limb_size - 1;
-	unsigned char hram[64], U_chr[32];
-	bignum256modm U, Uinv, h, v, rmuls, sumrs = {0}, Zero = {0}, t[max_batch_size], r_last, t_last, S2={0};
-	int r_isneg[max_batch_size], t_isneg[max_batch_size], r_last_isneg, t_last_isneg;
+#define joint_max_batch_size (joint_max_points / 2)
+
+/* single verification of signature i of a batch, from hrams[i] when the caller hashed the batch */
+static int
+batch_open_single_hEEA(const unsigned char **m, size_t *mlen, const unsigned char **hrams, const unsigned char **pk, const unsigned char **RS, size_t i) {
+	if (hrams)
+		return ED25519_FN(ed25519_verify_prehashed_hram) (hrams[i], pk[i], RS[i]);
+	return ED25519_FN(ed25519_sign_open_hEEA) (m[i], mlen[i], pk[i], RS[i]);
+}
+
+/*
+ * Joint verification of 2 or 3 signatures, where Bos-Coster does not pay off.
+ * The first equation is scaled by its hEEA pair (r, t); the others are scaled
+ * by a random short vector of their lattice {(r, r * h mod el)}, so an invalid
+ * signature can not be cancelled by another one. All the half-size streams
+ * share a single doubling chain:
+ * [sum(r_i * S_i)]B + sum([r_i](-R_i)) + sum([t_i](-A_i)) =? 0
+ *
+ * The random vectors are about 191 bits, so the chain is that long rather
+ * than 127. It can not be shorter for the same 2^-128 bound: the lattice
+ * has determinant el ~ 2^252, so it holds about 2^(2k - 250) vectors with
+ * both coordinates below 2^k, only 2^6 of them at k = 128 and 2^128 from
+ * k ~ 189. The batch chunks keep 127-bit weights by moving the randomness
+ * to [U] sum(A_i), which costs a second 127-bit chain (batch_check_A),
+ * about 254 doublings against 191. Even with the longer chain, the joint
+ * verifier on x86-64 (test_batchVerification) is 1.08 to 1.11 times faster
+ * per signature than ed25519_sign_open_hEEA for 2 signatures, and 1.18 times
+ * faster for 3.
+ */
+static int
+ed25519_sign_open_joint_hEEA(const unsigned char **m, size_t *mlen, const unsigned char **hrams, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid) {
+	ge25519 ALIGN(16) points[2 * joint_max_batch_size];
+	ge25519 ALIGN(16) sumBRA;
+	bignum256modm scalars[2 * joint_max_batch_size], h[joint_max_batch_size], rmuls, sumrs = {0}, S2 = {0};
+	ed25519_hash_context transcript;
+	size_t i, limbsize = bignum256modm_limb_size - 1;
+	unsigned char hram[64], rnd[16 * (joint_max_batch_size - 1)];
+	int r_isneg, t_isneg, use_transcript;
 	int ret = 0;
 
 	for (i = 0; i < num; i++)
 		valid[i] = 1;
 
-	while (num > 3) {
-		batchsize = (num > max_batch_size) ? max_batch_size : num;
+	use_transcript = ed25519_batch_transcript_init(&transcript, "ed25519 joint", num);
+	for (i = 0; i < num; i++) {
+		if (ed25519_S_rejected(RS[i] + 32))
+			goto fallback;
 
-		/* heap_size must be odd */
-		heap_size = batchsize + !(batchsize % 2);
+		/* compute h <-- H(R_i,A_i,m_i), unless the caller did */
+		if (hrams)
+			memcpy(hram, hrams[i], 64);
+		else
+			ed25519_hram(hram, RS[i], pk[i], m[i], mlen[i]);
+		if (use_transcript)
+			ed25519_batch_transcript_add(&transcript, RS[i], pk[i], hram);
+		expand256_modm(h[i], hram, 64);
+	}
 
-		/* pick a random U, s.t. 0 < U < el */
-		ed25519_randombytes_unsafe(U_chr, 32);
-		expand256_modm(U, U_chr, 32);
+	/* pick random weights for all signatures but the first one */
+	ed25519_batch_randomness(rnd, 16 * (num - 1), use_transcript ? &transcript : NULL);
 
-		/* Uinv * U = 1 mod el */
-		inv256_modm(Uinv, U);
+	for (i = 0; i < num; i++) {
+		/* compute r and t s.t. r*h = t mod el */
+		if (i == 0)
+			curve25519_half_size_scalar_vartime_hEEA(scalars[0], scalars[1], h[0], &r_isneg, &t_isneg);
+		else
+			curve25519_half_size_scalar_vartime_hEEA_randomized(scalars[2*i], scalars[2*i+1], h[i], rnd + 16 * (i - 1), &r_isneg, &t_isneg);
 
-		for (i = 0; i < batchsize; i++) {
+		/* extract S */
+		expand256_modm(rmuls, RS[i] + 32, 32);
+		mul256_modm(rmuls, rmuls, scalars[2*i]);
 
-			/* compute h <-- H(R_i,A_i,m_i) */
-			ed25519_hram(hram, RS[i], pk[i], m[i], mlen[i]);
-			expand256_modm(h, hram, 64);
-			
-			/* compute v <-- Uinv * h mod el */
-			mul256_modm(v, Uinv, h);
-			
-			/*compute r and t s.t. r*v = t mod el ==> r*h = U*t mod el */
-			// curve25519_half_size_scalar_vartime(batch.scalars[i], t[i], v, &r_isneg[i], &t_isneg[i]);
-			curve25519_half_size_scalar_vartime_hEEA(batch.scalars[i], t[i], v, &r_isneg[i], &t_isneg[i]);
-			
-			/* extract S */
-			expand256_modm(rmuls, RS[i] + 32, 32);
-			mul256_modm(rmuls, rmuls, batch.scalars[i]);
-
-			/* compute sum of r*S */
-			if (r_isneg[i])
-				sub256_modm_batch(rmuls, modm_m, rmuls, limbsize);
-			add256_modm(sumrs, sumrs, rmuls);
-		};
+		/* compute sum of r*S */
+		if (r_isneg)
+			sub256_modm_batch(rmuls, modm_m, rmuls, limbsize);
+		add256_modm(sumrs, sumrs, rmuls);
 
 		/* unpacking (-R_i) and adjust the sign based on the sign of r */
-		for (i = 0; i < batchsize; i++){
-			if (r_isneg[i]){
-				if (!ge25519_unpack_positive_vartime(&batch.points[i], RS[i]))
-					goto fallback;
-			}else{
-				if (!ge25519_unpack_negative_vartime(&batch.points[i], RS[i]))
-					goto fallback;
-			}
+		if (r_isneg){
+			if (!ge25519_unpack_positive_vartime(&points[2*i], RS[i]))
+				goto fallback;
+		}else{
+			if (!ge25519_unpack_negative_vartime(&points[2*i], RS[i]))
+				goto fallback;
 		}
-		/* if batchsize is even, add (point, scalar) = (neutral,{0}) to the heap */
-		if (heap_size != batchsize){
-			memcpy(batch.scalars[batchsize], Zero, sizeof(Zero));
-			tmp_point = &batch.points[batchsize];
-			memset(tmp_point, 0, sizeof(*tmp_point));
-			tmp_point->y[0] = 1;
-			tmp_point->z[0] = 1;
+
+		/* unpacking (-A_i) and adjust the sign based on the sign of t */
+		if (!ge25519_unpack_pk_vartime(&points[2*i+1], pk[i], !t_isneg))
+			goto fallback;
+	}
+
+	/* split S to S1 and S2, s.t. S = (S2<<126 | S1), bl(S1) = 126, bl(S2) = 127 */
+	bignum256modm_split126(S2, sumrs);
+
+	ge25519_joint_scalarmult_vartime(&sumBRA, points, scalars, 2 * num, sumrs, S2);
+
+	/* Check if the sum is 0 */
+	if (!ge25519_verify_neutral_vartime(&sumBRA)) {
+		ret |= 2;
+
+		fallback:
+		for (i = 0; i < num; i++) {
+			valid[i] = batch_open_single_hEEA(m, mlen, hrams, pk, RS, i) ? 0 : 1;
+			ret |= (valid[i] ^ 1);
 		}
+	}
 
-		/* comute sumR <-- sum([r_i](-R_i)) */
-		ge25519_multi_scalarmult_vartime_new(&max_index, &batch, heap_size);
-		ge25519_multi_scalarmult_vartime_final_new(&sumR, &batch.points[max_index], batch.scalars[max_index]);
+	return ret;
+}
 
-		/* unpacking (-A_i) and adjust the sign based on the sign of t */
-		for (i = 0; i < batchsize; i++){
-			if (t_isneg[i]){
-				if (!ge25519_unpack_positive_vartime(&batch.points[i], pk[i]))
+int
+ED25519_FN(ed25519_sign_open_joint2_hEEA) (const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, int *valid) {
+	return ed25519_sign_open_joint_hEEA(m, mlen, NULL, pk, RS, 2, valid);
+}
+
+int
+ED25519_FN(ed25519_sign_open_joint3_hEEA) (const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, int *valid) {
+	return ed25519_sign_open_joint_hEEA(m, mlen, NULL, pk, RS, 3, valid);
+}
+
+/*
+ * Scratch space of the batch verifiers, carved out of a single block so that
+ * a verification allocates nothing and the caller decides where it lives.
+ * Each array starts on a cache line. The heap works on r while summing the
+ * R_i and on t while summing the A_i, so the t_i are never copied.
+ */
+struct ed25519_batch_workspace_t {
+	size_t capacity;		/* signatures per Bos-Coster heap */
+	ge25519 *points;		/* capacity + 1, the extra slot pads the heap to an odd size */
+	bignum256modm *r;		/* capacity + 1 */
+	bignum256modm *t;		/* capacity + 1 */
+	heap_index_t *heap;		/* capacity + 1 */
+	const unsigned char **gm;	/* capacity each: the signatures that pass the pre-filter, */
+	const unsigned char **gpk;	/* with m or the caller's H(R,A,M) in gm */
+	const unsigned char **gRS;
+	size_t *gmlen;
+	size_t *gindex;			/* their position in the batch */
+	int *gvalid;
+	unsigned char *r_isneg;	/* capacity */
+	unsigned char *t_isneg;	/* capacity */
+	void *allocation;		/* set by ed25519_batch_workspace_create */
+};
+
+#define batch_workspace_line 64
+#define batch_workspace_round(x) (((x) + batch_workspace_line - 1) & ~(size_t)(batch_workspace_line - 1))
+#define batch_workspace_bytes(n) (batch_workspace_line - 1 + \
+	batch_workspace_round(sizeof(struct ed25519_batch_workspace_t)) + \
+	batch_workspace_round(((n) + 1) * sizeof(ge25519)) + \
+	2 * batch_workspace_round(((n) + 1) * sizeof(bignum256modm)) + \
+	batch_workspace_round(((n) + 1) * sizeof(heap_index_t)) + \
+	3 * batch_workspace_round((n) * sizeof(const unsigned char *)) + \
+	2 * batch_workspace_round((n) * sizeof(size_t)) + \
+	batch_workspace_round((n) * sizeof(int)) + \
+	2 * batch_workspace_round(n))
+
+/* a chunk smaller than 4 signatures goes to the joint or single verifiers */
+#define batch_workspace_min_capacity 4
+
+size_t
+ED25519_FN(ed25519_batch_workspace_size) (size_t capacity) {
+	if (capacity < batch_workspace_min_capacity || capacity > (SIZE_MAX / 4 - 4 * batch_workspace_line) / sizeof(ge25519))
+		return 0;
+	return batch_workspace_bytes(capacity);
+}
+
+ed25519_batch_workspace *
+ED25519_FN(ed25519_batch_workspace_init) (void *mem, size_t size, size_t capacity) {
+	struct ed25519_batch_workspace_t *ws;
+	size_t needed = ED25519_FN(ed25519_batch_workspace_size)(capacity);
+	unsigned char *p;
+
+	if (!mem || !needed || size < needed)
+		return NULL;
+
+	p = (unsigned char *)(((uintptr_t)mem + batch_workspace_line - 1) & ~(uintptr_t)(batch_workspace_line - 1));
+	ws = (struct ed25519_batch_workspace_t *)p;
+	p += batch_workspace_round(sizeof(*ws));
+	ws->capacity = capacity;
+	ws->points = (ge25519 *)p;
+	p += batch_workspace_round((capacity + 1) * sizeof(ge25519));
+	ws->r = (bignum256modm *)p;
+	p += batch_workspace_round((capacity + 1) * sizeof(bignum256modm));
+	ws->t = (bignum256modm *)p;
+	p += batch_workspace_round((capacity + 1) * sizeof(bignum256modm));
+	ws->heap = (heap_index_t *)p;
+	p += batch_workspace_round((capacity + 1) * sizeof(heap_index_t));
+	ws->gm = (const unsigned char **)p;
+	p += batch_workspace_round(capacity * sizeof(const unsigned char *));
+	ws->gpk = (const unsigned char **)p;
+	p += batch_workspace_round(capacity * sizeof(const unsigned char *));
+	ws->gRS = (const unsigned char **)p;
+	p += batch_workspace_round(capacity * sizeof(const unsigned char *));
+	ws->gmlen = (size_t *)p;
+	p += batch_workspace_round(capacity * sizeof(size_t));
+	ws->gindex = (size_t *)p;
+	p += batch_workspace_round(capacity * sizeof(size_t));
+	ws->gvalid = (int *)p;
+	p += batch_workspace_round(capacity * sizeof(int));
+	ws->r_isneg = p;
+	p += batch_workspace_round(capacity);
+	ws->t_isneg = p;
+	ws->allocation = NULL;
+	return ws;
+}
+
+ed25519_batch_workspace *
+ED25519_FN(ed25519_batch_workspace_create) (size_t capacity) {
+	struct ed25519_batch_workspace_t *ws;
+	size_t size = ED25519_FN(ed25519_batch_workspace_size)(capacity);
+	void *mem;
+
+	if (!size || !(mem = malloc(size)))
+		return NULL;
+	ws = ED25519_FN(ed25519_batch_workspace_init)(mem, size, capacity);
+	ws->allocation = mem;
+	return ws;
+}
+
+void
+ED25519_FN(ed25519_batch_workspace_free) (ed25519_batch_workspace *ws) {
+	if (ws)
+		free(ws->allocation);
+}
+
+size_t
+ED25519_FN(ed25519_batch_workspace_capacity) (const ed25519_batch_workspace *ws) {
+	return ws->capacity;
+}
+
+typedef void (*half_size_scalar_fn)(bignum256modm r, bignum256modm t, bignum256modm v, int *r_negative, int *t_negative);
+typedef int (*sign_open_fn)(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
+
+/* the Bos-Coster heap needs an odd number of at least 3 entries */
+#define batch_heap_size(n) (((n) < 3) ? 3 : (n) + !((n) % 2))
+
+/* fill the heap up to heap_size with (point, scalar) = (neutral, {0}) */
+static void
+batch_heap_pad_new(batch_heap_new *batch, size_t batchsize, size_t heap_size) {
+	ge25519 *tmp_point;
+
+	for (; batchsize < heap_size; batchsize++) {
+		memset(batch->scalars[batchsize], 0, sizeof(bignum256modm));
+		tmp_point = &batch->points[batchsize];
+		memset(tmp_point, 0, sizeof(*tmp_point));
+		tmp_point->y[0] = 1;
+		tmp_point->z[0] = 1;
+	}
+}
+
+/* p <-- -p */
+static void
+ge25519_neg_vartime(ge25519 *p) {
+	bignum25519 ALIGN(16) tmp_cordinate;
+
+	curve25519_copy(tmp_cordinate, p->x);
+	curve25519_neg(p->x, tmp_cordinate);
+	curve25519_copy(tmp_cordinate, p->t);
+	curve25519_neg(p->t, tmp_cordinate);
+}
+
+/*
+ * Takes h_i from ws->t[i], computes r_i and t_i s.t. r_i * Uinv * h_i = t_i
+ * mod el into ws->r[i] and ws->t[i], and adds r_i * S_i to sumrs unless RS
+ * is NULL (a half-aggregate carries only the sum).
+ */
+static void
+batch_half_size_scalars(ed25519_batch_workspace *ws, half_size_scalar_fn half_size, size_t i, const bignum256modm Uinv, const unsigned char *RS, bignum256modm sumrs) {
+	bignum256modm v, rmuls;
+	size_t limbsize = bignum256modm_limb_size - 1;
+	int r_isneg, t_isneg;
+
+	/* compute v <-- Uinv * h mod el */
+	mul256_modm(v, Uinv, ws->t[i]);
+
+	/*compute r and t s.t. r*v = t mod el ==> r*h = U*t mod el */
+	half_size(ws->r[i], ws->t[i], v, &r_isneg, &t_isneg);
+	ws->r_isneg[i] = (unsigned char)r_isneg;
+	ws->t_isneg[i] = (unsigned char)t_isneg;
+	if (!RS)
+		return;
+
+	/* extract S */
+	expand256_modm(rmuls, RS + 32, 32);
+	mul256_modm(rmuls, rmuls, ws->r[i]);
+
+	/* compute sum of r*S */
+	if (r_isneg)
+		sub256_modm_batch(rmuls, modm_m, rmuls, limbsize);
+	add256_modm(sumrs, sumrs, rmuls);
+}
+
+/* comute sumR <-- sum([r_i](-R_i)) over ws->points */
+static void
+batch_sum_R(ed25519_batch_workspace *ws, size_t batchsize, ge25519 *sumR) {
+	heap_index_t max_index;
+	batch_heap_new batch;
+	size_t heap_size = batch_heap_size(batchsize);
+
+	batch.points = ws->points;
+	batch.scalars = ws->r;
+	batch.heap = ws->heap;
+	batch_heap_pad_new(&batch, batchsize, heap_size);
+
+	ge25519_multi_scalarmult_vartime_new(&max_index, &batch, heap_size);
+	ge25519_multi_scalarmult_vartime_final_new(sumR, &batch.points[max_index], batch.scalars[max_index]);
+}
+
+/*
+ * Sums [t_i](-A_i) over points_A (which has room for batch_heap_size(batchsize) points)
+ * into [k]P and checks [sumrs]B + sumR + [U * k]P = 0; returns 1 if it holds
+ */
+static int
+batch_check_A(ed25519_batch_workspace *ws, ge25519 *points_A, size_t batchsize, half_size_scalar_fn half_size, bignum256modm U, bignum256modm sumrs, ge25519 *sumR) {
+	heap_index_t max_index;
+	batch_heap_new batch;
+	ge25519 ALIGN(16) sumBAR;
+	bignum256modm r_last, t_last, S2 = {0};
+	size_t heap_size = batch_heap_size(batchsize);
+	int r_last_isneg, t_last_isneg;
+
+	batch.points = points_A;
+	batch.scalars = ws->t;
+	batch.heap = ws->heap;
+	batch_heap_pad_new(&batch, batchsize, heap_size);
+
+	/* comput sumA = [k]P = sum([t_i](-A_i)) */
+	ge25519_multi_scalarmult_vartime_new(&max_index, &batch, heap_size);
+
+	/* compute U <-- Uk = U * k mod el */
+	mul256_modm(U, U, batch.scalars[max_index]);
+
+	/* compute r and t s.t. r * Uk = t mod el */
+	half_size(r_last, t_last, U, &r_last_isneg, &t_last_isneg);
+
+	/*
+	[sumrs]B + sumR + [U]sumA =? 0  ==> [r * sumrs]B + [r]sumR + [t]P =? 0
+	----------------------------------------------------------------------
+	r_last_isneg | t_last_isneg | [r * sumrs]B + [r]sumR + [t]P
+	----------------------------------------------------------------------
+	      0      |     0        | [|r| * sumrs]B + [|r|]sumR + [|t|]P
+	----------------------------------------------------------------------
+	      0      |     1        | [|r| * sumrs]B + [|r|]sumR - [|t|]P
+	----------------------------------------------------------------------
+	      1      |     0        | [-|r| * sumrs]B + [-|r|]sumR + [|t|]P ==> 
+		  		 |				| [|r| * sumrs] B + [|r|]sumR - [|t|]P
+	----------------------------------------------------------------------
+	      1      |     1        | [-|r| * sumrs]B + [-|r|]sumR + [-|t|]P ==> 
+		  		 |				| [|r| * sumrs] B + [|r|]sumR + [|t|]P
+	----------------------------------------------------------------------
+	*/
+	/* Adjust the sign of P based on the previous table*/
+	if (r_last_isneg != t_last_isneg)
+		ge25519_neg_vartime(&batch.points[max_index]);
+
+	/* sumrs <-- r_last * sumrs mod el */
+	mul256_modm(sumrs, sumrs, r_last);
+
+	/* split S to S1 and S2, s.t. S = (S2<<126 | S1), bl(S1) = 126, bl(S2) = 127 */
+	bignum256modm_split126(S2, sumrs);
+
+	/*
+	* [sumrs]B + sumR + [U]sumA =? 0 ==> 
+	* [sumrs]B + sumR + [Uk]P =? 0 ==>
+	* [r * sumrs]B + [r]sumR + [t]P =? 0 ==>
+	* [S1]B + [S2]([2^126]B) + [r]sumR + [t]P =? 0 
+	*/
+	ge25519_quadruple_scalarmult_vartime(&sumBAR, sumR, &batch.points[max_index], r_last, t_last, sumrs, S2);
+
+	/* Check if the sum is 0 */
+	return ge25519_verify_neutral_vartime(&sumBAR);
+}
+
+/*
+ * Verifies 4 <= batchsize <= ws->capacity signatures with one Bos-Coster sum
+ * over the R_i and one over the A_i. hrams, if not NULL, has H(R_i,A_i,m_i)
+ * and m is not read. On failure every signature of the chunk is checked
+ * again with single_open, or ed25519_verify_prehashed_hram.
+ */
+static int
+ed25519_sign_open_batch_chunk(ed25519_batch_workspace *ws, half_size_scalar_fn half_size, sign_open_fn single_open,
+	const unsigned char **m, size_t *mlen, const unsigned char **hrams, const unsigned char **pk, const unsigned char **RS, size_t batchsize, int *valid) {
+	ge25519 ALIGN(16) sumR;
+	size_t i;
+	unsigned char hram[64], U_chr[64];
+	bignum256modm U, Uinv, sumrs = {0};
+	ed25519_hash_context transcript;
+	int use_transcript;
+	int ret = 0;
+
+	/* compute h_i <-- H(R_i,A_i,m_i), kept in t until U is known */
+	use_transcript = ed25519_batch_transcript_init(&transcript, "ed25519 batch", batchsize);
+	for (i = 0; i < batchsize; i++) {
+		if (ed25519_S_rejected(RS[i] + 32))
+			goto fallback;
+		if (hrams)
+			memcpy(hram, hrams[i], 64);
+		else
+			ed25519_hram(hram, RS[i], pk[i], m[i], mlen[i]);
+		if (use_transcript)
+			ed25519_batch_transcript_add(&transcript, RS[i], pk[i], hram);
+		expand256_modm(ws->t[i], hram, 64);
+	}
+
+	/* pick a random U, s.t. 0 < U < el */
+	ed25519_batch_randomness(U_chr, 64, use_transcript ? &transcript : NULL);
+	expand256_modm(U, U_chr, 64);
+
+	/* Uinv * U = 1 mod el */
+	inv256_modm(Uinv, U);
+
+	for (i = 0; i < batchsize; i++)
+		batch_half_size_scalars(ws, half_size, i, Uinv, RS[i], sumrs);
+
+	/* unpacking (-R_i) and adjust the sign based on the sign of r */
+	for (i = 0; i < batchsize; i++){
+		if (ws->r_isneg[i]){
+			if (!ge25519_unpack_positive_vartime(&ws->points[i], RS[i]))
 				goto fallback;
-			}else{
-				if (!ge25519_unpack_negative_vartime(&batch.points[i], pk[i]))
+		}else{
+			if (!ge25519_unpack_negative_vartime(&ws->points[i], RS[i]))
 				goto fallback;
-			}
 		}
-		
-		/* Assign t to batch.scalars */
+	}
+	batch_sum_R(ws, batchsize, &sumR);
+
+	/* unpacking (-A_i) and adjust the sign based on the sign of t */
+	for (i = 0; i < batchsize; i++){
+		if (!ge25519_unpack_pk_vartime(&ws->points[i], pk[i], !ws->t_isneg[i]))
+			goto fallback;
+	}
+
+	if (!batch_check_A(ws, ws->points, batchsize, half_size, U, sumrs, &sumR)) {
+		ret |= 2;
+
+		fallback:
 		for (i = 0; i < batchsize; i++) {
-			for (size_t j = 0; j<bignum256modm_limb_size; j++)
-				batch.scalars[i][j] = t[i][j];
+			if (hrams)
+				valid[i] = ED25519_FN(ed25519_verify_prehashed_hram) (hrams[i], pk[i], RS[i]) ? 0 : 1;
+			else
+				valid[i] = single_open(m[i], mlen[i], pk[i], RS[i]) ? 0 : 1;
+			ret |= (valid[i] ^ 1);
 		}
+	}
 
-		/* if batchsize is even, add (point, scalar) = (neutral,{0}) to the heap */
-		if (heap_size != batchsize){
-			memcpy(batch.scalars[batchsize], Zero, sizeof(Zero));
-			tmp_point = &batch.points[batchsize];
-			memset(tmp_point, 0, sizeof(*tmp_point));
-			tmp_point->y[0] = 1;
-			tmp_point->z[0] = 1;
-		}
+	return ret;
+}
 
-		/* comput sumA = [k]P = sum([t_i](-A_i)) */
-		ge25519_multi_scalarmult_vartime_new(&max_index, &batch, heap_size);
-		
-		/* compute U <-- Uk = U * k mod el */
-		mul256_modm(U, U, batch.scalars[max_index]);
-
-		/* compute r and t s.t. r * Uk = t mod el */
-		// curve25519_half_size_scalar_vartime(r_last, t_last, U, &r_last_isneg, &t_last_isneg);
-		curve25519_half_size_scalar_vartime_hEEA(r_last, t_last, U, &r_last_isneg, &t_last_isneg);
-		
-		/*
-		[sumrs]B + sumR + [U]sumA =? 0  ==> [r * sumrs]B + [r]sumR + [t]P =? 0
-		----------------------------------------------------------------------
-		r_last_isneg | t_last_isneg | [r * sumrs]B + [r]sumR + [t]P
-		----------------------------------------------------------------------
-		      0      |     0        | [|r| * sumrs]B + [|r|]sumR + [|t|]P
-		----------------------------------------------------------------------
-		      0      |     1        | [|r| * sumrs]B + [|r|]sumR - [|t|]P
-		----------------------------------------------------------------------
-		      1      |     0        | [-|r| * sumrs]B + [-|r|]sumR + [|t|]P ==> 
-			  		 |				| [|r| * sumrs] B + [|r|]sumR - [|t|]P
-		----------------------------------------------------------------------
-		      1      |     1        | [-|r| * sumrs]B + [-|r|]sumR + [-|t|]P ==> 
-			  		 |				| [|r| * sumrs] B + [|r|]sumR + [|t|]P
-		----------------------------------------------------------------------
-		*/
-		/* Adjust the sign of P based on the previous table*/
-		if (r_last_isneg != t_last_isneg){
-			/* P <-- -P */
-			tmp_point = &batch.points[max_index];
-			curve25519_copy(tmp_cordinate, tmp_point->x);
-			curve25519_neg(tmp_point->x, tmp_cordinate);
-			curve25519_copy(tmp_cordinate, tmp_point->t);
-			curve25519_neg(tmp_point->t, tmp_cordinate);
-		}
+/*
+ * Chunking of the batch verifiers, from ed25519-donna-batch-config.h until
+ * ed25519_batch_config_use replaces it: a batch is split into chunks of
+ * chunk_size signatures (or the workspace capacity, if smaller) while at
+ * least min_batch_size remain, and the rest goes to the joint and single
+ * verifiers. The profile is process-wide; the only persistent one is the
+ * compiled header, for one thread per core. ed25519_batch_config_use is not
+ * synchronized with the verifiers: call it before the threads that verify
+ * start, or while none of them runs. Each batch call copies the profile once
+ * and splits the whole batch with that copy.
+ */
+static ed25519_batch_config ed25519_batch_profile = {ED25519_BATCH_CHUNK_SIZE, ED25519_BATCH_MIN_SIZE, ED25519_BATCH_HALF_SIZE};
 
-		/* sumrs <-- r_last * sumrs mod el */
-		mul256_modm(sumrs, sumrs, r_last);
-
-		/* split S to S1 and S2, s.t. S = (S2<<126 | S1), bl(S1) = 126, bl(S2) = 127 */
-		S2[0] = (sumrs[2] >> 14) | ((sumrs[3] & 0x3FFF) << 42);
-		S2[1] = (sumrs[3] >> 14) | ((sumrs[4] & 0x3FFF) << 42);
-		S2[2] = sumrs[4] >> 14;
-		sumrs[2] &= 0x3FFF;
-		sumrs[3] = 0;
-		sumrs[4] = 0;
-
-		/*
-		* [sumrs]B + sumR + [U]sumA =? 0 ==> 
-		* [sumrs]B + sumR + [Uk]P =? 0 ==>
-		* [r * sumrs]B + [r]sumR + [t]P =? 0 ==>
-		* [S1]B + [S2]([2^126]B) + [r]sumR + [t]P =? 0 
-		*/
-		ge25519_quadruple_scalarmult_vartime(&sumBAR, &sumR, &batch.points[max_index], r_last, t_last, sumrs, S2);
-
-		/* Check if the sum is 0 */
-		if (!ge25519_is_neutral_vartime(&sumBAR)) {
-			ret |= 2;
+/* a chunk above this needs a workspace of over 1 MB and no longer gains */
+#define batch_max_chunk_size 4096
 
-			fallback:
-			for (i = 0; i < batchsize; i++) {
-				valid[i] = ed25519_sign_open_hEEA (m[i], mlen[i], pk[i], RS[i]) ? 0 : 1;
-				ret |= (valid[i] ^ 1);
-			}
-		}
+static size_t
+batch_clamp(size_t x, size_t lo, size_t hi) {
+	return (x < lo) ? lo : (x > hi) ? hi : x;
+}
+
+/* chunk_size is clamped to [4, 4096] and min_batch_size to [4, chunk_size] */
+void
+ED25519_FN(ed25519_batch_config_use) (const ed25519_batch_config *config) {
+	static const ed25519_batch_config compiled = {ED25519_BATCH_CHUNK_SIZE, ED25519_BATCH_MIN_SIZE, ED25519_BATCH_HALF_SIZE};
+
+	if (!config)
+		config = &compiled;
+	ed25519_batch_profile.chunk_size = batch_clamp(config->chunk_size, batch_workspace_min_capacity, batch_max_chunk_size);
+	ed25519_batch_profile.min_batch_size = batch_clamp(config->min_batch_size, batch_workspace_min_capacity, ed25519_batch_profile.chunk_size);
+#if !defined(ED25519_NO_HGCD)
+	ed25519_batch_profile.half_size = (config->half_size == ED25519_BATCH_HGCD) ? ED25519_BATCH_HGCD : ED25519_BATCH_HEEA;
+#else
+	ed25519_batch_profile.half_size = ED25519_BATCH_HEEA;
+#endif
+}
 
-		m += batchsize;
-		mlen += batchsize;
-		pk += batchsize;
-		RS += batchsize;
-		num -= batchsize;
-		valid += batchsize;
+void
+ED25519_FN(ed25519_batch_config_get) (ed25519_batch_config *config) {
+	*config = ed25519_batch_profile;
+}
+
+/* signatures in the next chunk, out of left, with a workspace of the given capacity */
+static size_t
+batch_chunk_size(const ed25519_batch_config *profile, size_t left, size_t capacity) {
+	size_t chunk = (capacity < profile->chunk_size) ? capacity : profile->chunk_size;
+
+	return (left > chunk) ? chunk : left;
+}
+
+/* hEEA batch verification of either messages (hrams == NULL) or hashes computed by the caller (m == NULL) */
+static int
+ed25519_sign_open_batch_hEEA_impl(const ed25519_batch_config *profile, ed25519_batch_workspace *ws, const unsigned char **m, size_t *mlen, const unsigned char **hrams, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid) {
+	size_t i, batchsize, done = 0;
+	int ret = 0;
+
+	for (i = 0; i < num; i++)
+		valid[i] = 1;
+
+	while (num - done >= profile->min_batch_size) {
+		batchsize = batch_chunk_size(profile, num - done, ws->capacity);
+		ret |= ed25519_sign_open_batch_chunk(ws, curve25519_half_size_scalar_vartime_hEEA, ED25519_FN(ed25519_sign_open_hEEA),
+			m ? m + done : NULL, m ? mlen + done : NULL, hrams ? hrams + done : NULL, pk + done, RS + done, batchsize, valid + done);
+		done += batchsize;
 	}
 
-	for (i = 0; i < num; i++) {
-		valid[i] = ed25519_sign_open_hEEA (m[i], mlen[i], pk[i], RS[i]) ? 0 : 1;
-		ret |= (valid[i] ^ 1);
+	/* the rest is verified jointly, joint_max_batch_size at a time, never leaving a single one behind */
+	while (num - done > 1) {
+		batchsize = (num - done > joint_max_batch_size) ? joint_max_batch_size : num - done;
+		if (num - done - batchsize == 1)
+			batchsize--;
+		ret |= ed25519_sign_open_joint_hEEA(m ? m + done : NULL, m ? mlen + done : NULL, hrams ? hrams + done : NULL, pk + done, RS + done, batchsize, valid + done);
+		done += batchsize;
+	}
+	if (num - done == 1) {
+		valid[done] = batch_open_single_hEEA(m, mlen, hrams, pk, RS, done) ? 0 : 1;
+		ret |= (valid[done] ^ 1);
 	}
 
 	return ret;
 }
-int
-ED25519_FN(ed25519_sign_open_batch_hgcd) (const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid) {
-	heap_index_t max_index;
-	batch_heap ALIGN(16) batch;
-	ge25519 ALIGN(16) sumR;
-	ge25519 ALIGN(16) sumBA;
-	ge25519 ALIGN(16) sumBAR;
-	ge25519 *tmp_point;
-	bignum25519 tmp_cordinate;
-	size_t i, batchsize, heap_size, limbsize = bignum256modm_limb_size - 1;
-	unsigned char hram[64], U_chr[32];
-	bignum256modm U, Uinv, h, v, rmuls, sumrs = {0}, Zero = {0}, t[max_batch_size], r_last, t_last, S2={0};
-	int r_isneg[max_batch_size], t_isneg[max_batch_size], r_last_isneg, t_last_isneg;
+
+#if !defined(ED25519_NO_HGCD)
+/* hgcd batch verification, chunks and then single signatures */
+static int
+ed25519_sign_open_batch_hgcd_impl(const ed25519_batch_config *profile, ed25519_batch_workspace *ws, const unsigned char **m, size_t *mlen, const unsigned char **hrams, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid) {
+	size_t i, batchsize, done = 0;
 	int ret = 0;
 
 	for (i = 0; i < num; i++)
 		valid[i] = 1;
 
-	while (num > 3) {
-		batchsize = (num > max_batch_size) ? max_batch_size : num;
-
-		/* heap_size must be odd */
-		heap_size = batchsize + !(batchsize % 2);
-
-		/* pick a random U, s.t. 0 < U < el */
-		ed25519_randombytes_unsafe(U_chr, 32);
-		expand256_modm(U, U_chr, 32);
+	while (num - done >= profile->min_batch_size) {
+		batchsize = batch_chunk_size(profile, num - done, ws->capacity);
+		ret |= ed25519_sign_open_batch_chunk(ws, curve25519_half_size_scalar_vartime_hgcd, ED25519_FN(ed25519_sign_open_hgcd),
+			m ? m + done : NULL, m ? mlen + done : NULL, hrams ? hrams + done : NULL, pk + done, RS + done, batchsize, valid + done);
+		done += batchsize;
+	}
 
-		/* Uinv * U = 1 mod el */
-		inv256_modm(Uinv, U);
+	for (i = done; i < num; i++) {
+		if (hrams)
+			valid[i] = ED25519_FN(ed25519_verify_prehashed_hram) (hrams[i], pk[i], RS[i]) ? 0 : 1;
+		else
+			valid[i] = ED25519_FN(ed25519_sign_open_hgcd) (m[i], mlen[i], pk[i], RS[i]) ? 0 : 1;
+		ret |= (valid[i] ^ 1);
+	}
 
-		for (i = 0; i < batchsize; i++) {
+	return ret;
+}
+#endif
 
-			/* compute h <-- H(R_i,A_i,m_i) */
-			ed25519_hram(hram, RS[i], pk[i], m[i], mlen[i]);
-			expand256_modm(h, hram, 64);
-			
-			/* compute v <-- Uinv * h mod el */
-			mul256_modm(v, Uinv, h);
-			
-			/*compute r and t s.t. r*v = t mod el ==> r*h = U*t mod el */
-			// curve25519_half_size_scalar_vartime(batch.scalars[i], t[i], v, &r_isneg[i], &t_isneg[i]);
-			curve25519_half_size_scalar_vartime_hgcd(batch.scalars[i], t[i], v, &r_isneg[i], &t_isneg[i]);
-			
-			/* extract S */
-			expand256_modm(rmuls, RS[i] + 32, 32);
-			mul256_modm(rmuls, rmuls, batch.scalars[i]);
-
-			/* compute sum of r*S */
-			if (r_isneg[i])
-				sub256_modm_batch(rmuls, modm_m, rmuls, limbsize);
-			add256_modm(sumrs, sumrs, rmuls);
-		};
+typedef int (*batch_open_fn)(const ed25519_batch_config *profile, ed25519_batch_workspace *ws, const unsigned char **m, size_t *mlen, const unsigned char **hrams, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid);
 
-		/* unpacking (-R_i) and adjust the sign based on the sign of r */
-		for (i = 0; i < batchsize; i++){
-			if (r_isneg[i]){
-				if (!ge25519_unpack_positive_vartime(&batch.points[i], RS[i]))
-					goto fallback;
-			}else{
-				if (!ge25519_unpack_negative_vartime(&batch.points[i], RS[i]))
-					goto fallback;
+/*
+ * Runs the pre-filter over the whole batch, then open. When the filter
+ * rejects signatures, the others are gathered into the workspace, up to a
+ * whole number of the profile's chunks at a time, so that open splits them
+ * exactly as it would split them in one call.
+ */
+static int
+ed25519_batch_open_prefiltered(batch_open_fn open, const ed25519_batch_config *profile, ed25519_batch_workspace *ws, const unsigned char **m, size_t *mlen, const unsigned char **hrams, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid) {
+	size_t i = 0, j, n, chunk = batch_chunk_size(profile, ws->capacity, ws->capacity), group = ws->capacity - ws->capacity % chunk;
+	int ret = 1;
+
+	if (!ed25519_prefilter_rules || !ed25519_prefilter_batch(pk, RS, num, valid))
+		return open(profile, ws, m, mlen, hrams, pk, RS, num, valid);
+
+	while (i < num) {
+		for (n = 0; i < num && n < group; i++) {
+			if (!valid[i])
+				continue;
+			ws->gindex[n] = i;
+			ws->gpk[n] = pk[i];
+			ws->gRS[n] = RS[i];
+			if (m) {
+				ws->gm[n] = m[i];
+				ws->gmlen[n] = mlen[i];
+			} else {
+				ws->gm[n] = hrams[i];
 			}
+			n++;
 		}
-		/* if batchsize is even, add (point, scalar) = (neutral,{0}) to the heap */
-		if (heap_size != batchsize){
-			memcpy(batch.scalars[batchsize], Zero, sizeof(Zero));
-			tmp_point = &batch.points[batchsize];
-			memset(tmp_point, 0, sizeof(*tmp_point));
-			tmp_point->y[0] = 1;
-			tmp_point->z[0] = 1;
-		}
+		if (!n)
+			break;
+		ret |= open(profile, ws, m ? ws->gm : NULL, m ? ws->gmlen : NULL, hrams ? ws->gm : NULL, ws->gpk, ws->gRS, n, ws->gvalid);
+		for (j = 0; j < n; j++)
+			valid[ws->gindex[j]] = ws->gvalid[j];
+	}
 
-		/* comute sumR <-- sum([r_i](-R_i)) */
-		ge25519_multi_scalarmult_vartime_new(&max_index, &batch, heap_size);
-		ge25519_multi_scalarmult_vartime_final_new(&sumR, &batch.points[max_index], batch.scalars[max_index]);
+	return ret;
+}
 
-		/* unpacking (-A_i) and adjust the sign based on the sign of t */
-		for (i = 0; i < batchsize; i++){
-			if (t_isneg[i]){
-				if (!ge25519_unpack_positive_vartime(&batch.points[i], pk[i]))
-				goto fallback;
-			}else{
-				if (!ge25519_unpack_negative_vartime(&batch.points[i], pk[i]))
-				goto fallback;
-			}
+int
+ED25519_FN(ed25519_sign_open_batch_hEEA_ws) (ed25519_batch_workspace *ws, const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid) {
+	ed25519_batch_config profile = ed25519_batch_profile;
+
+	return ed25519_batch_open_prefiltered(ed25519_sign_open_batch_hEEA_impl, &profile, ws, m, mlen, NULL, pk, RS, num, valid);
+}
+
+/* ed25519_sign_open_batch_hEEA with hram[i] = H(R_i,A_i,m_i) computed by the caller */
+int
+ED25519_FN(ed25519_verify_prehashed_hram_batch_ws) (ed25519_batch_workspace *ws, const unsigned char **hram, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid) {
+	ed25519_batch_config profile = ed25519_batch_profile;
+
+	return ed25519_batch_open_prefiltered(ed25519_sign_open_batch_hEEA_impl, &profile, ws, NULL, NULL, hram, pk, RS, num, valid);
+}
+
+#if !defined(ED25519_NO_HGCD)
+int
+ED25519_FN(ed25519_sign_open_batch_hgcd_ws) (ed25519_batch_workspace *ws, const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid) {
+	ed25519_batch_config profile = ed25519_batch_profile;
+
+	return ed25519_batch_open_prefiltered(ed25519_sign_open_batch_hgcd_impl, &profile, ws, m, mlen, NULL, pk, RS, num, valid);
+}
+#endif
+
+/*
+ * The workspace of the entry points without one: one per thread, allocated
+ * on first use for max_batch_size signatures, or for the profile's chunks if
+ * larger, and kept for the next calls, so that they neither carve about
+ * 32 KB out of the stack nor call malloc each time. A thread frees it with
+ * ed25519_batch_thread_workspace_free before it exits.
+ */
+static ED25519_THREAD_LOCAL ed25519_batch_workspace *ed25519_batch_thread_ws;
+
+static ed25519_batch_workspace *
+batch_thread_workspace(size_t capacity) {
+	ed25519_batch_workspace *ws = ed25519_batch_thread_ws;
+
+	if (capacity < max_batch_size)
+		capacity = max_batch_size;
+	if (ws && ws->capacity >= capacity)
+		return ws;
+	ED25519_FN(ed25519_batch_workspace_free)(ws);
+	ed25519_batch_thread_ws = ED25519_FN(ed25519_batch_workspace_create)(capacity);
+	return ed25519_batch_thread_ws;
+}
+
+void
+ED25519_FN(ed25519_batch_thread_workspace_free) (void) {
+	ED25519_FN(ed25519_batch_workspace_free)(ed25519_batch_thread_ws);
+	ed25519_batch_thread_ws = NULL;
+}
+
+/* if the workspace cannot be allocated, the signatures are checked one by one */
+static int
+ed25519_batch_open_default(batch_open_fn open, const unsigned char **m, size_t *mlen, const unsigned char **hrams, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid) {
+	ed25519_batch_config profile = ed25519_batch_profile;
+	ed25519_batch_workspace *ws = batch_thread_workspace(batch_chunk_size(&profile, num, profile.chunk_size));
+	size_t i;
+	int ret = 0;
+
+	if (ws)
+		return ed25519_batch_open_prefiltered(open, &profile, ws, m, mlen, hrams, pk, RS, num, valid);
+	for (i = 0; i < num; i++) {
+		valid[i] = batch_open_single_hEEA(m, mlen, hrams, pk, RS, i) ? 0 : 1;
+		ret |= (valid[i] ^ 1);
+	}
+	return ret;
+}
+
+int
+ED25519_FN(ed25519_sign_open_batch_hEEA) (const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid) {
+	return ed25519_batch_open_default(ed25519_sign_open_batch_hEEA_impl, m, mlen, NULL, pk, RS, num, valid);
+}
+
+#if !defined(ED25519_NO_HGCD)
+int
+ED25519_FN(ed25519_sign_open_batch_hgcd) (const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid) {
+	return ed25519_batch_open_default(ed25519_sign_open_batch_hgcd_impl, m, mlen, NULL, pk, RS, num, valid);
+}
+#endif
+
+/* hEEA or hgcd, as the profile says */
+int
+ED25519_FN(ed25519_sign_open_batch_auto) (const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid) {
+#if !defined(ED25519_NO_HGCD)
+	return ed25519_batch_open_default((ed25519_batch_profile.half_size == ED25519_BATCH_HGCD) ? ed25519_sign_open_batch_hgcd_impl : ed25519_sign_open_batch_hEEA_impl,
+		m, mlen, NULL, pk, RS, num, valid);
+#else
+	return ed25519_batch_open_default(ed25519_sign_open_batch_hEEA_impl, m, mlen, NULL, pk, RS, num, valid);
+#endif
+}
+
+int
+ED25519_FN(ed25519_verify_prehashed_hram_batch) (const unsigned char **hram, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid) {
+	return ed25519_batch_open_default(ed25519_sign_open_batch_hEEA_impl, NULL, NULL, hram, pk, RS, num, valid);
+}
+
+#define batch_calibration_size 512
+#define batch_calibration_rounds 5
+#define batch_calibration_streak 3
+
+/* best of batch_calibration_rounds runs of open over num signatures, in ticks per signature */
+static uint64_t
+batch_calibration_time(uint64_t (*ticks)(void), batch_open_fn open, const ed25519_batch_config *profile, ed25519_batch_workspace *ws,
+	const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid) {
+	uint64_t t_begin, e, best = (uint64_t)-1;
+	size_t i;
+
+	for (i = 0; i < batch_calibration_rounds; i++) {
+		t_begin = ticks();
+		open(profile, ws, m, mlen, NULL, pk, RS, num, valid);
+		e = ticks() - t_begin;
+		if (e < best)
+			best = e;
+	}
+	return best / num;
+}
+
+/*
+ * Measures with the given cycle counter, on batch_calibration_size fresh
+ * signatures, the chunk size that verifies them fastest, the smallest batch
+ * from which a chunk verifies batch_calibration_streak sizes in a row faster
+ * than the joint and single verifiers, so that one noisy win does not set it,
+ * and whether hEEA or hgcd is faster with that chunking. It measures with a
+ * profile of its own and only writes config: the profile in use does not
+ * change until the caller passes config to ed25519_batch_config_use.
+ */
+void
+ED25519_FN(ed25519_batch_calibrate) (uint64_t (*ticks)(void), ed25519_batch_config *config) {
+	static const size_t chunk_sizes[] = {16, 32, 64, 128, 256, 512};
+	struct batch_calibration_data {
+		ed25519_public_key pk[batch_calibration_size];
+		ed25519_signature RS[batch_calibration_size];
+		unsigned char m[batch_calibration_size][32];
+		const unsigned char *pm[batch_calibration_size], *ppk[batch_calibration_size], *pRS[batch_calibration_size];
+		size_t mlen[batch_calibration_size];
+		int valid[batch_calibration_size];
+	} *data;
+	ed25519_batch_config profile = ed25519_batch_profile, best = ed25519_batch_profile;
+	ed25519_batch_workspace *ws = NULL;
+	ed25519_secret_key sk;
+	uint64_t t, t_best = (uint64_t)-1, t_small;
+	size_t i, n, wins;
+
+	data = (struct batch_calibration_data *)malloc(sizeof(*data));
+	if (data)
+		ws = ED25519_FN(ed25519_batch_workspace_create)(batch_calibration_size);
+	if (!ws) {
+		free(data);
+		*config = best;
+		return;
+	}
+
+	for (i = 0; i < batch_calibration_size; i++) {
+		ED25519_FN(ed25519_randombytes_unsafe) (sk, sizeof(sk));
+		ED25519_FN(ed25519_randombytes_unsafe) (data->m[i], sizeof(data->m[i]));
+		ED25519_FN(ed25519_publickey) (sk, data->pk[i]);
+		ED25519_FN(ed25519_sign) (data->m[i], sizeof(data->m[i]), sk, data->pk[i], data->RS[i]);
+		data->pm[i] = data->m[i];
+		data->mlen[i] = sizeof(data->m[i]);
+		data->ppk[i] = data->pk[i];
+		data->pRS[i] = data->RS[i];
+	}
+	memset(sk, 0, sizeof(sk));
+
+	/* chunk size */
+	profile.min_batch_size = batch_workspace_min_capacity;
+	for (i = 0; i < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); i++) {
+		profile.chunk_size = chunk_sizes[i];
+		t = batch_calibration_time(ticks, ed25519_sign_open_batch_hEEA_impl, &profile, ws, data->pm, data->mlen, data->ppk, data->pRS, batch_calibration_size, data->valid);
+		if (t < t_best) {
+			t_best = t;
+			best.chunk_size = chunk_sizes[i];
 		}
-		
-		/* Assign t to batch.scalars */
-		for (i = 0; i < batchsize; i++) {
-			for (size_t j = 0; j<bignum256modm_limb_size; j++)
-				batch.scalars[i][j] = t[i][j];
+	}
+	profile.chunk_size = best.chunk_size;
+
+	/* smallest batch from which a chunk beats the joint and single verifiers batch_calibration_streak times in a row */
+	best.min_batch_size = 4 * batch_workspace_min_capacity + 1;
+	for (n = batch_workspace_min_capacity, wins = 0; n < 4 * batch_workspace_min_capacity + batch_calibration_streak; n++) {
+		profile.min_batch_size = batch_workspace_min_capacity;
+		t = batch_calibration_time(ticks, ed25519_sign_open_batch_hEEA_impl, &profile, ws, data->pm, data->mlen, data->ppk, data->pRS, n, data->valid);
+		profile.min_batch_size = n + 1;
+		t_small = batch_calibration_time(ticks, ed25519_sign_open_batch_hEEA_impl, &profile, ws, data->pm, data->mlen, data->ppk, data->pRS, n, data->valid);
+		wins = (t <= t_small) ? wins + 1 : 0;
+		if (wins == batch_calibration_streak) {
+			best.min_batch_size = n + 1 - batch_calibration_streak;
+			break;
 		}
+	}
+	best.min_batch_size = batch_clamp(best.min_batch_size, batch_workspace_min_capacity, best.chunk_size);
+	profile.min_batch_size = best.min_batch_size;
+
+	/* half-size scalars */
+#if !defined(ED25519_NO_HGCD)
+	t = batch_calibration_time(ticks, ed25519_sign_open_batch_hgcd_impl, &profile, ws, data->pm, data->mlen, data->ppk, data->pRS, batch_calibration_size, data->valid);
+	t_best = batch_calibration_time(ticks, ed25519_sign_open_batch_hEEA_impl, &profile, ws, data->pm, data->mlen, data->ppk, data->pRS, batch_calibration_size, data->valid);
+	best.half_size = (t < t_best) ? ED25519_BATCH_HGCD : ED25519_BATCH_HEEA;
+#else
+	best.half_size = ED25519_BATCH_HEEA;
+#endif
+
+	ED25519_FN(ed25519_batch_workspace_free)(ws);
+	free(data);
+	*config = best;
+}
 
-		/* if batchsize is even, add (point, scalar) = (neutral,{0}) to the heap */
-		if (heap_size != batchsize){
-			memcpy(batch.scalars[batchsize], Zero, sizeof(Zero));
-			tmp_point = &batch.points[batchsize];
-			memset(tmp_point, 0, sizeof(*tmp_point));
-			tmp_point->y[0] = 1;
-			tmp_point->z[0] = 1;
-		}
+/*
+ * Incremental batch verification. ed25519_batch_ctx_add does the work of one
+ * signature as soon as it arrives: H(R,A,M), the half-size split of
+ * Uinv * h, r * S into sumrs and the decompression of R and A, so that
+ * ed25519_batch_ctx_finalize only runs the two Bos-Coster sums and the final
+ * check. In transcript mode U depends on the whole batch, so the split and
+ * r * S wait for finalize.
+ *
+ * Signatures that fail to decode are marked invalid by add and left out of
+ * the batch. The other buffers must stay valid until finalize, which reads
+ * them again if the batch check fails.
+ */
+struct ed25519_batch_ctx_t {
+	ed25519_batch_workspace *ws;	/* -R_i in ws->points, h_i and then t_i in ws->t */
+	ge25519 *points_A;		/* -A_i, capacity + 1 */
+	const unsigned char **m;	/* per slot, capacity */
+	size_t *mlen;
+	const unsigned char **pk;
+	const unsigned char **RS;
+	size_t *slot;			/* per signature, its slot or SIZE_MAX if add rejected it */
+	size_t capacity, count, slots;
+	int started, use_transcript;
+	bignum256modm U, Uinv, sumrs;
+	ed25519_hash_context transcript;
+	void *allocation;		/* set by ed25519_batch_ctx_create */
+};
+
+#define batch_workspace_align(p) ((unsigned char *)(((uintptr_t)(p) + batch_workspace_line - 1) & ~(uintptr_t)(batch_workspace_line - 1)))
+
+size_t
+ED25519_FN(ed25519_batch_ctx_size) (size_t capacity) {
+	size_t ws_size = ED25519_FN(ed25519_batch_workspace_size)(capacity);
+
+	if (!ws_size)
+		return 0;
+	return 2 * batch_workspace_line + batch_workspace_round(sizeof(struct ed25519_batch_ctx_t)) + ws_size +
+		batch_workspace_round((capacity + 1) * sizeof(ge25519)) +
+		3 * batch_workspace_round(capacity * sizeof(const unsigned char *)) +
+		2 * batch_workspace_round(capacity * sizeof(size_t));
+}
+
+ed25519_batch_ctx *
+ED25519_FN(ed25519_batch_ctx_init) (void *mem, size_t size, size_t capacity) {
+	struct ed25519_batch_ctx_t *ctx;
+	size_t needed = ED25519_FN(ed25519_batch_ctx_size)(capacity), ws_size;
+	unsigned char *p;
+
+	if (!mem || !needed || size < needed)
+		return NULL;
+
+	ws_size = ED25519_FN(ed25519_batch_workspace_size)(capacity);
+	p = batch_workspace_align(mem);
+	ctx = (struct ed25519_batch_ctx_t *)p;
+	p += batch_workspace_round(sizeof(*ctx));
+	ctx->ws = ED25519_FN(ed25519_batch_workspace_init)(p, ws_size, capacity);
+	p = batch_workspace_align(p + ws_size);
+	ctx->points_A = (ge25519 *)p;
+	p += batch_workspace_round((capacity + 1) * sizeof(ge25519));
+	ctx->m = (const unsigned char **)p;
+	p += batch_workspace_round(capacity * sizeof(const unsigned char *));
+	ctx->pk = (const unsigned char **)p;
+	p += batch_workspace_round(capacity * sizeof(const unsigned char *));
+	ctx->RS = (const unsigned char **)p;
+	p += batch_workspace_round(capacity * sizeof(const unsigned char *));
+	ctx->mlen = (size_t *)p;
+	p += batch_workspace_round(capacity * sizeof(size_t));
+	ctx->slot = (size_t *)p;
+	ctx->capacity = capacity;
+	ctx->count = 0;
+	ctx->slots = 0;
+	ctx->started = 0;
+	ctx->allocation = NULL;
+	return ctx;
+}
+
+ed25519_batch_ctx *
+ED25519_FN(ed25519_batch_ctx_create) (size_t capacity) {
+	struct ed25519_batch_ctx_t *ctx;
+	size_t size = ED25519_FN(ed25519_batch_ctx_size)(capacity);
+	void *mem;
+
+	if (!size || !(mem = malloc(size)))
+		return NULL;
+	ctx = ED25519_FN(ed25519_batch_ctx_init)(mem, size, capacity);
+	ctx->allocation = mem;
+	return ctx;
+}
 
-		/* comput sumA = [k]P = sum([t_i](-A_i)) */
-		ge25519_multi_scalarmult_vartime_new(&max_index, &batch, heap_size);
-		
-		/* compute U <-- Uk = U * k mod el */
-		mul256_modm(U, U, batch.scalars[max_index]);
-
-		/* compute r and t s.t. r * Uk = t mod el */
-		// curve25519_half_size_scalar_vartime(r_last, t_last, U, &r_last_isneg, &t_last_isneg);
-		curve25519_half_size_scalar_vartime_hgcd(r_last, t_last, U, &r_last_isneg, &t_last_isneg);
-		
-		/*
-		[sumrs]B + sumR + [U]sumA =? 0  ==> [r * sumrs]B + [r]sumR + [t]P =? 0
-		----------------------------------------------------------------------
-		r_last_isneg | t_last_isneg | [r * sumrs]B + [r]sumR + [t]P
-		----------------------------------------------------------------------
-		      0      |     0        | [|r| * sumrs]B + [|r|]sumR + [|t|]P
-		----------------------------------------------------------------------
-		      0      |     1        | [|r| * sumrs]B + [|r|]sumR - [|t|]P
-		----------------------------------------------------------------------
-		      1      |     0        | [-|r| * sumrs]B + [-|r|]sumR + [|t|]P ==> 
-			  		 |				| [|r| * sumrs] B + [|r|]sumR - [|t|]P
-		----------------------------------------------------------------------
-		      1      |     1        | [-|r| * sumrs]B + [-|r|]sumR + [-|t|]P ==> 
-			  		 |				| [|r| * sumrs] B + [|r|]sumR + [|t|]P
-		----------------------------------------------------------------------
-		*/
-		/* Adjust the sign of P based on the previous table*/
-		if (r_last_isneg != t_last_isneg){
-			/* P <-- -P */
-			tmp_point = &batch.points[max_index];
-			curve25519_copy(tmp_cordinate, tmp_point->x);
-			curve25519_neg(tmp_point->x, tmp_cordinate);
-			curve25519_copy(tmp_cordinate, tmp_point->t);
-			curve25519_neg(tmp_point->t, tmp_cordinate);
+void
+ED25519_FN(ed25519_batch_ctx_free) (ed25519_batch_ctx *ctx) {
+	if (ctx)
+		free(ctx->allocation);
+}
+
+size_t
+ED25519_FN(ed25519_batch_ctx_count) (const ed25519_batch_ctx *ctx) {
+	return ctx->count;
+}
+
+/* the half-size split of slot i, then the signs of -R_i and -A_i */
+static void
+batch_ctx_scalars(struct ed25519_batch_ctx_t *ctx, size_t i) {
+	batch_half_size_scalars(ctx->ws, curve25519_half_size_scalar_vartime_hEEA, i, ctx->Uinv, ctx->RS[i], ctx->sumrs);
+	if (ctx->ws->r_isneg[i])
+		ge25519_neg_vartime(&ctx->ws->points[i]);
+	if (ctx->ws->t_isneg[i])
+		ge25519_neg_vartime(&ctx->points_A[i]);
+}
+
+/* returns 0 if the signature was queued, 1 if it is malformed (and will be reported invalid), -1 if the context is full */
+int
+ED25519_FN(ed25519_batch_ctx_add) (ed25519_batch_ctx *ctx, const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS) {
+	size_t n = ctx->slots;
+	unsigned char hram[64], U_chr[64];
+
+	if (ctx->count == ctx->capacity)
+		return -1;
+
+	if (!ctx->started) {
+		ctx->use_transcript = ed25519_batch_transcript_init(&ctx->transcript, "ed25519 batch ctx", 0);
+		if (!ctx->use_transcript) {
+			/* pick a random U, s.t. 0 < U < el */
+			ed25519_batch_randomness(U_chr, 64, NULL);
+			expand256_modm(ctx->U, U_chr, 64);
+			inv256_modm(ctx->Uinv, ctx->U);
 		}
+		memset(ctx->sumrs, 0, sizeof(ctx->sumrs));
+		ctx->started = 1;
+	}
 
-		/* sumrs <-- r_last * sumrs mod el */
-		mul256_modm(sumrs, sumrs, r_last);
-
-		/* split S to S1 and S2, s.t. S = (S2<<126 | S1), bl(S1) = 126, bl(S2) = 127 */
-		S2[0] = (sumrs[2] >> 14) | ((sumrs[3] & 0x3FFF) << 42);
-		S2[1] = (sumrs[3] >> 14) | ((sumrs[4] & 0x3FFF) << 42);
-		S2[2] = sumrs[4] >> 14;
-		sumrs[2] &= 0x3FFF;
-		sumrs[3] = 0;
-		sumrs[4] = 0;
-
-		/*
-		* [sumrs]B + sumR + [U]sumA =? 0 ==> 
-		* [sumrs]B + sumR + [Uk]P =? 0 ==>
-		* [r * sumrs]B + [r]sumR + [t]P =? 0 ==>
-		* [S1]B + [S2]([2^126]B) + [r]sumR + [t]P =? 0 
-		*/
-		ge25519_quadruple_scalarmult_vartime(&sumBAR, &sumR, &batch.points[max_index], r_last, t_last, sumrs, S2);
-
-		/* Check if the sum is 0 */
-		if (!ge25519_is_neutral_vartime(&sumBAR)) {
-			ret |= 2;
+	/* unpacking (-R) and (-A), the signs are fixed once r and t are known */
+	if (ed25519_S_rejected(RS + 32) || ed25519_prefilter_reject(RS, RS + 32, pk) || !ge25519_unpack_negative_vartime(&ctx->ws->points[n], RS) || !ge25519_unpack_pk_vartime(&ctx->points_A[n], pk, 1)) {
+		ctx->slot[ctx->count++] = SIZE_MAX;
+		return 1;
+	}
 
-			fallback:
-			for (i = 0; i < batchsize; i++) {
-				valid[i] = ed25519_sign_open_hgcd (m[i], mlen[i], pk[i], RS[i]) ? 0 : 1;
-				ret |= (valid[i] ^ 1);
-			}
+	ctx->m[n] = m;
+	ctx->mlen[n] = mlen;
+	ctx->pk[n] = pk;
+	ctx->RS[n] = RS;
+
+	/* compute h <-- H(R,A,m) */
+	ed25519_hram(hram, RS, pk, m, mlen);
+	if (ctx->use_transcript)
+		ed25519_batch_transcript_add(&ctx->transcript, RS, pk, hram);
+	expand256_modm(ctx->ws->t[n], hram, 64);
+	if (!ctx->use_transcript)
+		batch_ctx_scalars(ctx, n);
+
+	ctx->slot[ctx->count++] = n;
+	ctx->slots++;
+	return 0;
+}
+
+/* verifies the signatures added since the last finalize, in order, and empties the context */
+int
+ED25519_FN(ed25519_batch_ctx_finalize) (ed25519_batch_ctx *ctx, int *valid) {
+	ge25519 ALIGN(16) sumR;
+	unsigned char U_chr[64];
+	size_t i, n = ctx->slots;
+	int ret = 0;
+
+	for (i = 0; i < n; i++)
+		valid[i] = 1;
+
+	if (n > 3) {
+		if (ctx->use_transcript) {
+			ed25519_batch_randomness(U_chr, 64, &ctx->transcript);
+			expand256_modm(ctx->U, U_chr, 64);
+			inv256_modm(ctx->Uinv, ctx->U);
+			for (i = 0; i < n; i++)
+				batch_ctx_scalars(ctx, i);
 		}
 
-		m += batchsize;
-		mlen += batchsize;
-		pk += batchsize;
-		RS += batchsize;
-		num -= batchsize;
-		valid += batchsize;
+		batch_sum_R(ctx->ws, n, &sumR);
+		if (!batch_check_A(ctx->ws, ctx->points_A, n, curve25519_half_size_scalar_vartime_hEEA, ctx->U, ctx->sumrs, &sumR)) {
+			ret |= 2;
+			for (i = 0; i < n; i++)
+				valid[i] = ED25519_FN(ed25519_sign_open_hEEA) (ctx->m[i], ctx->mlen[i], ctx->pk[i], ctx->RS[i]) ? 0 : 1;
+		}
+	} else if (n > 1) {
+		ret |= ed25519_sign_open_joint_hEEA(ctx->m, ctx->mlen, NULL, ctx->pk, ctx->RS, n, valid);
+	} else if (n == 1) {
+		valid[0] = ED25519_FN(ed25519_sign_open_hEEA) (ctx->m[0], ctx->mlen[0], ctx->pk[0], ctx->RS[0]) ? 0 : 1;
 	}
 
-	for (i = 0; i < num; i++) {
-		valid[i] = ed25519_sign_open_hgcd (m[i], mlen[i], pk[i], RS[i]) ? 0 : 1;
+	/* move the slot results to the positions of the signatures, slot[i] <= i */
+	for (i = ctx->count; i-- > 0;) {
+		valid[i] = (ctx->slot[i] == SIZE_MAX) ? 0 : valid[ctx->slot[i]];
 		ret |= (valid[i] ^ 1);
 	}
 
+	ctx->count = 0;
+	ctx->slots = 0;
+	ctx->started = 0;
 	return ret;
 }
@@ -0,0 +1,135 @@
+/*
+	Half-aggregation of Ed25519 signatures
+
+	An aggregate of n signatures (R_i, S_i) on (A_i, M_i) keeps the R_i and
+	replaces the S_i by a single scalar, 32 * (n + 1) bytes instead of 64 * n:
+
+		agg = R_1 || ... || R_n || s,    s = sum(z_i * S_i) mod el
+
+	The weights z_i are the half-size scalars of the batch verifier, with U
+	derived from the aggregated signatures instead of drawn at random:
+
+		U   = SHA-512("ed25519 halfagg" || n || R_1 || A_1 || h_1 || ...) mod el
+		z_i = r_i, where r_i * (Uinv * h_i) = t_i mod el (hEEA_q)
+
+	with h_i = H(R_i,A_i,M_i). Then z_i * h_i = U * t_i, z_i and t_i have about
+	127 bits, and [s]B = sum([z_i]R_i) + sum([z_i * h_i]A_i) is checked like a
+	batch chunk, with one Bos-Coster sum over the R_i and one over the A_i:
+
+		[s]B + sum([r_i](-R_i)) + [U]sum([t_i](-A_i)) =? 0
+
+	Every weight depends on all the aggregated signatures through U, as the
+	random-oracle weights of the half-aggregation schemes in the literature
+	do, but they are not the weights of those schemes, so aggregates do not
+	interoperate with them. Aggregation does not verify its inputs.
+*/
+
+size_t
+ED25519_FN(ed25519_halfagg_size) (size_t num) {
+	return 32 * (num + 1);
+}
+
+/*
+ * Computes U, and r_i, t_i into ws for the num signatures; R_i is RS[i] when
+ * aggregating, which also adds r_i * S_i to sumrs, and agg + 32 * i when
+ * verifying
+ */
+static void
+halfagg_scalars(ed25519_batch_workspace *ws, const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS,
+	const unsigned char *agg, size_t num, bignum256modm U, bignum256modm sumrs) {
+	static const char tag[] = "ed25519 halfagg";
+	ed25519_hash_context ctx;
+	unsigned char hram[64], count[8];
+	const unsigned char *R;
+	bignum256modm Uinv;
+	size_t i;
+
+	/* compute h_i <-- H(R_i,A_i,m_i), kept in t until U is known */
+	U64TO8_LE(count, (uint64_t)num);
+	ed25519_hash_init(&ctx);
+	ed25519_hash_update(&ctx, (const unsigned char *)tag, sizeof(tag));
+	ed25519_hash_update(&ctx, count, sizeof(count));
+	for (i = 0; i < num; i++) {
+		R = RS ? RS[i] : agg + 32 * i;
+		ed25519_hram(hram, R, pk[i], m[i], mlen[i]);
+		ed25519_hash_update(&ctx, R, 32);
+		ed25519_hash_update(&ctx, pk[i], 32);
+		ed25519_hash_update(&ctx, hram, 64);
+		expand256_modm(ws->t[i], hram, 64);
+	}
+
+	/* U <-- H(tag, n, R_i, A_i, h_i), Uinv * U = 1 mod el */
+	ed25519_hash_final(&ctx, hram);
+	expand256_modm(U, hram, 64);
+	inv256_modm(Uinv, U);
+
+	for (i = 0; i < num; i++)
+		batch_half_size_scalars(ws, curve25519_half_size_scalar_vartime_hEEA, i, Uinv, RS ? RS[i] : NULL, sumrs);
+}
+
+int
+ED25519_FN(ed25519_halfagg_aggregate) (const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, unsigned char *agg) {
+	ed25519_batch_workspace *ws;
+	bignum256modm U, s = {0};
+	size_t i;
+
+	if (!num)
+		return -1;
+	for (i = 0; i < num; i++)
+		if (ed25519_S_rejected(RS[i] + 32))
+			return -1;
+	if (!(ws = batch_thread_workspace(num)))
+		return -1;
+
+	halfagg_scalars(ws, m, mlen, pk, RS, NULL, num, U, s);
+	for (i = 0; i < num; i++)
+		memcpy(agg + 32 * i, RS[i], 32);
+	contract256_modm(agg + 32 * num, s);
+	return 0;
+}
+
+int
+ED25519_FN(ed25519_halfagg_verify_ws) (ed25519_batch_workspace *ws, const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char *agg, size_t num) {
+	static const unsigned char zero[32] = {0}; /* s is filtered once, with R_1 and A_1 */
+	ge25519 ALIGN(16) sumR;
+	bignum256modm U, s;
+	size_t i;
+
+	if (!num || num > ws->capacity || ed25519_S_rejected(agg + 32 * num))
+		return -1;
+	for (i = 0; i < num; i++)
+		if (ed25519_prefilter_reject(agg + 32 * i, i ? zero : agg + 32 * num, pk[i]))
+			return -1;
+
+	halfagg_scalars(ws, m, mlen, pk, NULL, agg, num, U, NULL);
+	expand256_modm(s, agg + 32 * num, 32);
+
+	/* unpacking (-R_i) and adjust the sign based on the sign of r */
+	for (i = 0; i < num; i++){
+		if (ws->r_isneg[i]){
+			if (!ge25519_unpack_positive_vartime(&ws->points[i], agg + 32 * i))
+				return -1;
+		}else{
+			if (!ge25519_unpack_negative_vartime(&ws->points[i], agg + 32 * i))
+				return -1;
+		}
+	}
+	batch_sum_R(ws, num, &sumR);
+
+	/* unpacking (-A_i) and adjust the sign based on the sign of t */
+	for (i = 0; i < num; i++){
+		if (!ge25519_unpack_pk_vartime(&ws->points[i], pk[i], !ws->t_isneg[i]))
+			return -1;
+	}
+
+	return batch_check_A(ws, ws->points, num, curve25519_half_size_scalar_vartime_hEEA, U, s, &sumR) ? 0 : -1;
+}
+
+int
+ED25519_FN(ed25519_halfagg_verify) (const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char *agg, size_t num) {
+	ed25519_batch_workspace *ws = batch_thread_workspace(num);
+
+	if (!ws)
+		return -1;
+	return ED25519_FN(ed25519_halfagg_verify_ws)(ws, m, mlen, pk, agg, num);
+}
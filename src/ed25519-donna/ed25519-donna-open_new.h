@@ -29,23 +29,64 @@
  */
 
 
-int
-ED25519_FN(ed25519_sign_open_hEEA) (const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS) {
+/*
+ * Verification rules of the half-size verifiers, see ed25519_verify_rules_use.
+ * Decoding is the same under both: like ZIP-215, donna accepts a y >= p and
+ * x = 0 with the sign bit set, and hashes R and A as they were encoded.
+ * The mode is process-wide and read without synchronization, several times
+ * per verification: set it before the threads that verify start, never while
+ * one of them runs.
+ */
+static ed25519_verify_rules ed25519_verify_rules_mode = ED25519_VERIFY_COFACTORLESS;
+
+/* S must be below 2^253, and below el under ZIP-215 */
+static int
+ed25519_S_rejected(const unsigned char S[32]) {
+	if ((S[31] & 224))
+		return 1;
+	return (ed25519_verify_rules_mode == ED25519_VERIFY_ZIP215) && ed25519_S_noncanonical(S);
+}
+
+/*
+ * p == 0, or [8]p == 0 under ZIP-215. The half-size verifiers check [r]E = 0
+ * for an r of about 127 bits, which without the cofactor depends on r mod 8
+ * when E has a small-order part; [8r]E = 0 does not.
+ */
+static int
+ge25519_verify_neutral_vartime(ge25519 *p) {
+	if (ed25519_verify_rules_mode == ED25519_VERIFY_ZIP215) {
+		ge25519_double(p, p);
+		ge25519_double(p, p);
+		ge25519_double(p, p);
+	}
+	return ge25519_is_neutral_vartime(p);
+}
+
+void
+ED25519_FN(ed25519_verify_rules_use) (ed25519_verify_rules rules) {
+	ed25519_verify_rules_mode = rules;
+}
+
+/*
+ * The hEEA verifiers on the 64-byte H(R,A,m), once S and the pre-filter have
+ * been checked: bl_t = 0 takes the balanced r and t of hEEA_q, otherwise
+ * |t| < 2^bl_t and r is on the remaining ~253 - bl_t bits.
+ */
+static int
+ed25519_verify_hram_hEEA(const unsigned char hash[64], const ed25519_public_key pk, const ed25519_signature RS, unsigned bl_t) {
 	ge25519 ALIGN(16) R, A, sumBRA;
-	hash_512bits hash;
 	bignum256modm hram, S1, S2={0}, r, t;
     int r_isneg;
 	int t_isneg;
+	const unsigned char *entry;
 
-	if ((RS[63] & 224))
-		return -1;
-
-	/* hram <-- H(R,A,m) */
-	ed25519_hram(hash, RS, pk, m, mlen);
 	expand256_modm(hram, hash, 64);
 
 	/* compute r and t s.t. rh = t mod el */
-    curve25519_half_size_scalar_vartime_hEEA(r, t, hram, &r_isneg, &t_isneg);
+    if (bl_t == 0)
+        curve25519_half_size_scalar_vartime_hEEA(r, t, hram, &r_isneg, &t_isneg);
+    else
+        curve25519_half_size_scalar_vartime_hEEA_split(r, t, hram, &r_isneg, &t_isneg, bl_t);
     
     /* unpacking (-R) */
     if (!ge25519_unpack_negative_vartime(&R, RS))
@@ -68,12 +109,10 @@ ED25519_FN(ed25519_sign_open_hEEA) (const unsigned char *m, size_t mlen, const e
 		        |         | [|r| * s] B + [|r|](-R) + [|t|](-A)
 		------------------------------------------------------------
 	*/
-	/* unpacking (-A) and adjust the sign based on the previous table */
-    if (r_isneg == t_isneg){
-		if (!ge25519_unpack_negative_vartime(&A, pk))
-			return -1;
-	}else{
-		if (!ge25519_unpack_positive_vartime(&A, pk))
+	/* unpacking (-A) and adjust the sign based on the previous table, unless the store has it */
+    entry = ed25519_pk_store_lookup(pk);
+    if (!entry){
+		if (!ge25519_unpack_pk_vartime(&A, pk, r_isneg == t_isneg))
 			return -1;
 	}
     
@@ -84,21 +123,40 @@ ED25519_FN(ed25519_sign_open_hEEA) (const unsigned char *m, size_t mlen, const e
     mul256_modm(S1, S1, r);
     
     /* split S to S1 and S2, s.t. S = (S2<<126 | S1), bl(S1) = 126, bl(S2) = 127 */
-    S2[0] = (S1[2] >> 14) | ((S1[3] & 0x3FFF) << 42);
-    S2[1] = (S1[3] >> 14) | ((S1[4] & 0x3FFF) << 42);
-    S2[2] = S1[4] >> 14;
-    S1[2] &= 0x3FFF;
-    S1[3] = 0;
-    S1[4] = 0;
+    bignum256modm_split126(S2, S1);
 
 	/* 
 	 * [S]B + (-R) + h(-A) =? 0 ==>
 	 * [rS]B + [r](-R) + [t](-A) =? 0 ==>
 	 * [S1]B + [S2]([2^126]B) + [r](-R) + [t](-A) =? 0 
 	*/
-	ge25519_quadruple_scalarmult_vartime(&sumBRA, &R, &A, r, t, S1, S2);
+	if (entry)
+		ge25519_quadruple_scalarmult_stored_vartime(&sumBRA, &R, entry, r_isneg == t_isneg, r, t, S1, S2);
+	else
+		ge25519_quadruple_scalarmult_vartime(&sumBRA, &R, &A, r, t, S1, S2);
 
-    return ge25519_is_neutral_vartime(&sumBRA) ? 0: -1;
+    return ge25519_verify_neutral_vartime(&sumBRA) ? 0: -1;
+}
+
+/* ed25519_sign_open_hEEA with the 64-byte H(R,A,m) computed by the caller */
+int
+ED25519_FN(ed25519_verify_prehashed_hram) (const unsigned char hash[64], const ed25519_public_key pk, const ed25519_signature RS) {
+	if (ed25519_S_rejected(RS + 32) || ed25519_prefilter_reject(RS, RS + 32, pk))
+		return -1;
+
+	return ed25519_verify_hram_hEEA(hash, pk, RS, 0);
+}
+
+int
+ED25519_FN(ed25519_sign_open_hEEA) (const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS) {
+	hash_512bits hash;
+
+	if (ed25519_S_rejected(RS + 32) || ed25519_prefilter_reject(RS, RS + 32, pk))
+		return -1;
+
+	/* hram <-- H(R,A,m) */
+	ed25519_hram(hash, RS, pk, m, mlen);
+	return ed25519_verify_hram_hEEA(hash, pk, RS, 0);
 }
 
 
@@ -110,7 +168,7 @@ ED25519_FN(ed25519_sign_open_hEEA_samePre) (const unsigned char *m, size_t mlen,
     int r_isneg;
 	int t_isneg;
 
-	if ((RS[63] & 224))
+	if (ed25519_S_rejected(RS + 32) || ed25519_prefilter_reject(RS, RS + 32, pk))
 		return -1;
 
 	/* hram <-- H(R,A,m) */
@@ -142,13 +200,8 @@ ED25519_FN(ed25519_sign_open_hEEA_samePre) (const unsigned char *m, size_t mlen,
 		------------------------------------------------------------
 	*/
 	/* unpacking (-A) and adjust the sign based on the previous table */
-    if (r_isneg == t_isneg){
-		if (!ge25519_unpack_negative_vartime(&A, pk))
-			return -1;
-	}else{
-		if (!ge25519_unpack_positive_vartime(&A, pk))
-			return -1;
-	}
+	if (!ge25519_unpack_pk_vartime(&A, pk, r_isneg == t_isneg))
+		return -1;
     
     /* S */
 	expand256_modm(S1, RS + 32, 32);
@@ -157,12 +210,7 @@ ED25519_FN(ed25519_sign_open_hEEA_samePre) (const unsigned char *m, size_t mlen,
     mul256_modm(S1, S1, r);
     
     /* split S to S1 and S2, s.t. S = (S2<<126 | S1), bl(S1) = 126, bl(S2) = 127 */
-    S2[0] = (S1[2] >> 14) | ((S1[3] & 0x3FFF) << 42);
-    S2[1] = (S1[3] >> 14) | ((S1[4] & 0x3FFF) << 42);
-    S2[2] = S1[4] >> 14;
-    S1[2] &= 0x3FFF;
-    S1[3] = 0;
-    S1[4] = 0;
+    bignum256modm_split126(S2, S1);
 
 	/* 
 	 * [S]B + (-R) + h(-A) =? 0 ==>
@@ -172,11 +220,12 @@ ED25519_FN(ed25519_sign_open_hEEA_samePre) (const unsigned char *m, size_t mlen,
 	// ge25519_quadruple_scalarmult_vartime(&sumBRA, &R, &A, r, t, S1, S2);
 	ge25519_quadruple_scalarmult_samePre_vartime(&sumBRA, &R, &A, r, t, S1, S2);
 
-    return ge25519_is_neutral_vartime(&sumBRA) ? 0: -1;
+    return ge25519_verify_neutral_vartime(&sumBRA) ? 0: -1;
 }
 
 
 
+#if !defined(ED25519_NO_HGCD)
 int
 ED25519_FN(ed25519_sign_open_hgcd) (const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS) {
 	ge25519 ALIGN(16) R, A, sumBRA;
@@ -184,8 +233,9 @@ ED25519_FN(ed25519_sign_open_hgcd) (const unsigned char *m, size_t mlen, const e
 	bignum256modm hram, S1, S2={0}, r, t;
     int r_isneg;
 	int t_isneg;
+	const unsigned char *entry;
 
-	if ((RS[63] & 224))
+	if (ed25519_S_rejected(RS + 32) || ed25519_prefilter_reject(RS, RS + 32, pk))
 		return -1;
 
 	/* hram <-- H(R,A,m) */
@@ -217,12 +267,10 @@ ED25519_FN(ed25519_sign_open_hgcd) (const unsigned char *m, size_t mlen, const e
 		        |         | [|r| * s] B + [|r|](-R) + [|t|](-A)
 		------------------------------------------------------------
 	*/
-	/* unpacking (-A) and adjust the sign based on the previous table */
-    if (r_isneg == t_isneg){
-		if (!ge25519_unpack_negative_vartime(&A, pk))
-			return -1;
-	}else{
-		if (!ge25519_unpack_positive_vartime(&A, pk))
+	/* unpacking (-A) and adjust the sign based on the previous table, unless the store has it */
+    entry = ed25519_pk_store_lookup(pk);
+    if (!entry){
+		if (!ge25519_unpack_pk_vartime(&A, pk, r_isneg == t_isneg))
 			return -1;
 	}
     
@@ -233,19 +281,48 @@ ED25519_FN(ed25519_sign_open_hgcd) (const unsigned char *m, size_t mlen, const e
     mul256_modm(S1, S1, r);
     
     /* split S to S1 and S2, s.t. S = (S2<<126 | S1), bl(S1) = 126, bl(S2) = 127 */
-    S2[0] = (S1[2] >> 14) | ((S1[3] & 0x3FFF) << 42);
-    S2[1] = (S1[3] >> 14) | ((S1[4] & 0x3FFF) << 42);
-    S2[2] = S1[4] >> 14;
-    S1[2] &= 0x3FFF;
-    S1[3] = 0;
-    S1[4] = 0;
+    bignum256modm_split126(S2, S1);
 
 	/* 
 	 * [S]B + (-R) + h(-A) =? 0 ==>
 	 * [rS]B + [r](-R) + [t](-A) =? 0 ==>
 	 * [S1]B + [S2]([2^126]B) + [r](-R) + [t](-A) =? 0 
 	*/
-	ge25519_quadruple_scalarmult_vartime(&sumBRA, &R, &A, r, t, S1, S2);
+	if (entry)
+		ge25519_quadruple_scalarmult_stored_vartime(&sumBRA, &R, entry, r_isneg == t_isneg, r, t, S1, S2);
+	else
+		ge25519_quadruple_scalarmult_vartime(&sumBRA, &R, &A, r, t, S1, S2);
+
+    return ge25519_verify_neutral_vartime(&sumBRA) ? 0: -1;
+}
+#endif
+
 
-    return ge25519_is_neutral_vartime(&sumBRA) ? 0: -1;
-}
\ No newline at end of file
+
+/*
+ * Same as ed25519_sign_open_hEEA, with |t| < 2^bl_t and r on the remaining
+ * ~253 - bl_t bits; bl_t = 0 uses the split picked by the cost model.
+ */
+int
+ED25519_FN(ed25519_sign_open_hEEA_split) (const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS, unsigned bl_t) {
+	hash_512bits hash;
+
+	if (ed25519_S_rejected(RS + 32) || ed25519_prefilter_reject(RS, RS + 32, pk))
+		return -1;
+
+	/* hram <-- H(R,A,m) */
+	ed25519_hram(hash, RS, pk, m, mlen);
+	return ed25519_verify_hram_hEEA(hash, pk, RS, bl_t ? bl_t : ge25519_split_vartime());
+}
+
+/* bit length of t picked by the split cost model */
+unsigned
+ED25519_FN(ed25519_hEEA_split) (void) {
+	return ge25519_split_vartime();
+}
+
+/* predicted cost of the runtime part of a verification with |t| < 2^bl_t */
+uint64_t
+ED25519_FN(ed25519_hEEA_split_cost) (unsigned bl_t) {
+	return ge25519_split_cost_model(bl_t, GE25519_STRAUS_TABLE_COST, GE25519_STRAUS_ADD_COST, GE25519_STRAUS_DBL_COST);
+}
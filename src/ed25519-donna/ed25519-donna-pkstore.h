@@ -0,0 +1,322 @@
+/*
+	Persistent store of precomputed public keys
+
+	A fixed set of public keys is decompressed once, together with a table of
+	odd multiples for each key, and written to a file that later runs mmap
+	read-only. The verifiers look the key up in the active store (see
+	ed25519_pk_store_use) before decompressing it:
+
+	- ed25519_sign_open_hEEA, _hgcd and _split take -A and its table from the
+	  store, so the A stream runs over a static affine table instead of a
+	  runtime one;
+	- the joint and batch verifiers take the decompressed point.
+
+	Keys that are not in the store are decompressed as before.
+
+	File layout, all in host byte order:
+		header      ed25519_pk_store_header, 64 bytes
+		index       buckets x uint32_t, 1 + entry number or 0 when empty,
+		            padded to 64 bytes; open addressing with linear probing
+		            on the first 8 bytes of the key
+		entries     count x entry_size bytes: pk[32], -A as a ge25519, then
+		            the odd multiples [1](-A), [3](-A), ... in affine niels
+		            form, 2^(window - 2) of them, padded to 64 bytes
+
+	The points are stored in the field representation of the build that wrote
+	the file, so a store only opens in a build with the same backend. The
+	file is trusted: the loader checks the header and the sizes, not the
+	points.
+*/
+
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define ED25519_PK_STORE_MAGIC "EDPKST01"
+#define ED25519_PK_STORE_BYTEORDER 0x01020304
+#define ED25519_PK_STORE_WINDOW 6
+#define ED25519_PK_STORE_MAX_WINDOW 8
+
+#if defined(ED25519_ADX)
+	#define ED25519_PK_STORE_BACKEND 3
+#elif defined(ED25519_SSE2)
+	#define ED25519_PK_STORE_BACKEND 2
+#elif defined(ED25519_64BIT)
+	#define ED25519_PK_STORE_BACKEND 1
+#else
+	#define ED25519_PK_STORE_BACKEND 0
+#endif
+
+typedef struct ed25519_pk_store_header_t {
+	char magic[8];
+	uint32_t byteorder;
+	uint32_t backend;
+	uint32_t element_size;
+	uint32_t window;
+	uint64_t count;
+	uint64_t buckets;
+	uint64_t entry_size;
+	uint64_t reserved[2];
+} ed25519_pk_store_header;
+
+struct ed25519_pk_store_t {
+	const unsigned char *map;
+	size_t size;
+	const uint32_t *index;
+	const unsigned char *entries;
+	uint64_t count, mask, entry_size;
+	int window;
+};
+
+#define ed25519_pk_store_round64(x) (((x) + 63) & ~(uint64_t)63)
+
+static uint64_t
+ed25519_pk_store_entry_size(unsigned window) {
+	return ed25519_pk_store_round64(32 + sizeof(ge25519) + ((uint64_t)1 << (window - 2)) * sizeof(ge25519_niels));
+}
+
+static uint64_t
+ed25519_pk_store_slot(const unsigned char pk[32], uint64_t mask) {
+	return ((U8TO64_LE(pk) * 0x9e3779b97f4a7c15ull) >> 32) & mask;
+}
+
+/* entry of pk, or NULL */
+static const unsigned char *
+ed25519_pk_store_find(const struct ed25519_pk_store_t *store, const unsigned char pk[32]) {
+	uint64_t slot = ed25519_pk_store_slot(pk, store->mask), probe, e;
+	const unsigned char *entry;
+
+	for (probe = 0; probe <= store->mask; probe++) {
+		e = store->index[slot];
+		if (!e)
+			return NULL;
+		if (e <= store->count) {
+			entry = store->entries + (e - 1) * store->entry_size;
+			if (!memcmp(entry, pk, 32))
+				return entry;
+		}
+		slot = (slot + 1) & store->mask;
+	}
+	return NULL;
+}
+
+/*
+ * the store consulted by the verifiers, read without synchronization: set it
+ * before the threads that verify start, and close it only after they stopped
+ */
+static const struct ed25519_pk_store_t *ed25519_pk_store_active = NULL;
+
+static const unsigned char *
+ed25519_pk_store_lookup(const unsigned char pk[32]) {
+	return ed25519_pk_store_active ? ed25519_pk_store_find(ed25519_pk_store_active, pk) : NULL;
+}
+
+#define ed25519_pk_store_point(entry) ((const ge25519 *)((entry) + 32))
+#define ed25519_pk_store_table(entry) ((const ge25519_niels *)((entry) + 32 + sizeof(ge25519)))
+
+/* -A (negative) or A for pk, from the active store or decompressed */
+static int
+ge25519_unpack_pk_vartime(ge25519 *r, const unsigned char pk[32], int negative) {
+	const unsigned char *entry = ed25519_pk_store_lookup(pk);
+	bignum25519 ALIGN(16) t;
+
+	if (!entry)
+		return negative ? ge25519_unpack_negative_vartime(r, pk) : ge25519_unpack_positive_vartime(r, pk);
+
+	memcpy(r, ed25519_pk_store_point(entry), sizeof(ge25519));
+	if (!negative) {
+		curve25519_copy(t, r->x);
+		curve25519_neg(r->x, t);
+		curve25519_copy(t, r->t);
+		curve25519_neg(r->t, t);
+	}
+	return 1;
+}
+
+/*
+ * computes [s1]p1 + [s2](-A) (negative) or [s2]A + [s3]basepoint + [s4 * 2^126] basepoint,
+ * with the odd multiples of -A from a store entry as a fourth static stream
+ */
+static void
+ge25519_quadruple_scalarmult_stored_vartime(ge25519 *r, const ge25519 *p1, const unsigned char *entry, int negative, const bignum256modm s1, const bignum256modm s2, const bignum256modm s3, const bignum256modm s4) {
+	const ge25519 *p[1] = {p1};
+	const ge25519_niels *nt[3] = {ge25519_niels_sliding_multiples, ge25519_niels_sliding_multiples2, ed25519_pk_store_table(entry)};
+	const bignum256modm_element_t *ps[1] = {s1}, *ns[3] = {s3, s4, s2};
+	int pw[1], nw[3] = {S2_SWINDOWSIZE, S2_SWINDOWSIZE, ed25519_pk_store_active->window}, nneg[3] = {0, 0, !negative};
+
+	pw[0] = ge25519_straus_window_vartime(s1);
+	ge25519_straus_1x3_vartime(r, p, ps, pw, nt, ns, nw, nneg);
+}
+
+/*
+ * Writes the store of the valid, distinct keys among pks[0..count-1] to
+ * path (through path.tmp and a rename). window is the width of the per-key
+ * tables, 2..8; 0 picks ED25519_PK_STORE_WINDOW. Returns the number of keys
+ * stored, or -1 on error.
+ */
+int64_t
+ED25519_FN(ed25519_pk_store_build) (const char *path, const ed25519_public_key *pks, size_t count, unsigned window) {
+	ed25519_pk_store_header header;
+	ge25519_pniels ALIGN(16) pre[1 << (ED25519_PK_STORE_MAX_WINDOW - 2)];
+	ge25519_niels ALIGN(16) table[1 << (ED25519_PK_STORE_MAX_WINDOW - 2)];
+	ge25519 ALIGN(16) d, *points = NULL;
+	uint32_t *index = NULL;
+	size_t *order = NULL;
+	unsigned char *entry = NULL;
+	char *tmp = NULL;
+	FILE *f = NULL;
+	uint64_t buckets, slot, n = 0, index_size, i, j, e, entries;
+	int64_t ret = -1;
+
+	if (window == 0)
+		window = ED25519_PK_STORE_WINDOW;
+	if (window < 2 || window > ED25519_PK_STORE_MAX_WINDOW || count >= 0x7fffffff)
+		return -1;
+	entries = (uint64_t)1 << (window - 2);
+
+	for (buckets = 16; buckets < 2 * (uint64_t)count; buckets <<= 1)
+		;
+	index_size = ed25519_pk_store_round64(buckets * sizeof(uint32_t));
+
+	index = (uint32_t *)calloc(index_size, 1);
+	order = (size_t *)malloc((count + 1) * sizeof(size_t));
+	points = (ge25519 *)malloc((count + 1) * sizeof(ge25519));
+	entry = (unsigned char *)malloc(ed25519_pk_store_entry_size(window));
+	tmp = (char *)malloc(strlen(path) + 5);
+	if (!index || !order || !points || !entry || !tmp)
+		goto done;
+
+	/* decompress and index the keys, skipping invalid ones and duplicates */
+	for (i = 0; i < count; i++) {
+		if (!ge25519_unpack_negative_vartime(&points[n], pks[i]))
+			continue;
+		slot = ed25519_pk_store_slot(pks[i], buckets - 1);
+		while ((e = index[slot]) != 0 && memcmp(pks[order[e - 1]], pks[i], 32))
+			slot = (slot + 1) & (buckets - 1);
+		if (e)
+			continue;
+		order[n++] = i;
+		index[slot] = (uint32_t)n;
+	}
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, ED25519_PK_STORE_MAGIC, 8);
+	header.byteorder = ED25519_PK_STORE_BYTEORDER;
+	header.backend = ED25519_PK_STORE_BACKEND;
+	header.element_size = sizeof(bignum25519);
+	header.window = window;
+	header.count = n;
+	header.buckets = buckets;
+	header.entry_size = ed25519_pk_store_entry_size(window);
+
+	strcpy(tmp, path);
+	strcat(tmp, ".tmp");
+	if (!(f = fopen(tmp, "wb")))
+		goto done;
+	if (fwrite(&header, sizeof(header), 1, f) != 1 || fwrite(index, index_size, 1, f) != 1)
+		goto done;
+
+	for (i = 0; i < n; i++) {
+		/* odd multiples of -A, built as in the runtime Straus streams */
+		ge25519_full_to_pniels(&pre[0], &points[i]);
+		if (window > 2)
+			ge25519_double(&d, &points[i]);
+		for (j = 0; j + 1 < entries; j++)
+			ge25519_pnielsadd(&pre[j + 1], &d, &pre[j]);
+
+		memset(entry, 0, header.entry_size);
+		memcpy(entry, pks[order[i]], 32);
+		memcpy(entry + 32, &points[i], sizeof(ge25519));
+		ge25519_pniels_to_niels_batch_vartime(table, pre, entries);
+		memcpy(entry + 32 + sizeof(ge25519), table, entries * sizeof(ge25519_niels));
+		if (fwrite(entry, header.entry_size, 1, f) != 1)
+			goto done;
+	}
+
+	if (fclose(f) == 0 && rename(tmp, path) == 0)
+		ret = (int64_t)n;
+	f = NULL;
+
+done:
+	if (f)
+		fclose(f);
+	if (ret < 0 && tmp)
+		remove(tmp);
+	free(index);
+	free(order);
+	free(points);
+	free(entry);
+	free(tmp);
+	return ret;
+}
+
+/* maps a store written by ed25519_pk_store_build in a build with the same backend, or returns NULL */
+struct ed25519_pk_store_t *
+ED25519_FN(ed25519_pk_store_open) (const char *path) {
+	const ed25519_pk_store_header *header;
+	struct ed25519_pk_store_t *store;
+	struct stat st;
+	void *map;
+	uint64_t index_size;
+	int fd;
+
+	if ((fd = open(path, O_RDONLY)) < 0)
+		return NULL;
+	if (fstat(fd, &st) != 0 || (uint64_t)st.st_size < sizeof(ed25519_pk_store_header)) {
+		close(fd);
+		return NULL;
+	}
+	map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return NULL;
+
+	header = (const ed25519_pk_store_header *)map;
+	index_size = ed25519_pk_store_round64(header->buckets * sizeof(uint32_t));
+	if (memcmp(header->magic, ED25519_PK_STORE_MAGIC, 8) ||
+		header->byteorder != ED25519_PK_STORE_BYTEORDER ||
+		header->backend != ED25519_PK_STORE_BACKEND ||
+		header->element_size != sizeof(bignum25519) ||
+		header->window < 2 || header->window > ED25519_PK_STORE_MAX_WINDOW ||
+		header->buckets < 16 || header->buckets > ((uint64_t)1 << 32) || (header->buckets & (header->buckets - 1)) ||
+		header->count >= header->buckets ||
+		header->entry_size != ed25519_pk_store_entry_size(header->window) ||
+		(uint64_t)st.st_size != sizeof(ed25519_pk_store_header) + index_size + header->count * header->entry_size ||
+		!(store = (struct ed25519_pk_store_t *)malloc(sizeof(struct ed25519_pk_store_t)))) {
+		munmap(map, (size_t)st.st_size);
+		return NULL;
+	}
+
+	store->map = (const unsigned char *)map;
+	store->size = (size_t)st.st_size;
+	store->index = (const uint32_t *)(store->map + sizeof(ed25519_pk_store_header));
+	store->entries = store->map + sizeof(ed25519_pk_store_header) + index_size;
+	store->count = header->count;
+	store->mask = header->buckets - 1;
+	store->entry_size = header->entry_size;
+	store->window = (int)header->window;
+	return store;
+}
+
+void
+ED25519_FN(ed25519_pk_store_close) (struct ed25519_pk_store_t *store) {
+	if (!store)
+		return;
+	if (ed25519_pk_store_active == store)
+		ed25519_pk_store_active = NULL;
+	munmap((void *)store->map, store->size);
+	free(store);
+}
+
+/* makes the verifiers consult store (NULL detaches it); call it while no thread verifies */
+void
+ED25519_FN(ed25519_pk_store_use) (const struct ed25519_pk_store_t *store) {
+	ed25519_pk_store_active = store;
+}
+
+size_t
+ED25519_FN(ed25519_pk_store_count) (const struct ed25519_pk_store_t *store) {
+	return (size_t)store->count;
+}
@@ -96,7 +96,7 @@ static inline void U32TO8_LE(unsigned char *p, const uint32_t v) {
 }
 #endif
 
-#if !defined(HAVE_UINT128)
+/* also used by the batch verifiers' ChaCha20 generator on every backend */
 static inline uint32_t U8TO32_LE(const unsigned char *p) {
 	return
 	(((uint32_t)(p[0])      ) | 
@@ -104,7 +104,8 @@ static inline uint32_t U8TO32_LE(const unsigned char *p) {
 	 ((uint32_t)(p[2]) << 16) |
 	 ((uint32_t)(p[3]) << 24));
 }
-#else
+
+/* also used by the half-size code, which works on 64-bit words everywhere */
 static inline uint64_t U8TO64_LE(const unsigned char *p) {
 	return
 	(((uint64_t)(p[0])      ) |
@@ -127,7 +128,6 @@ static inline void U64TO8_LE(unsigned char *p, const uint64_t v) {
 	p[6] = (unsigned char)(v >> 48);
 	p[7] = (unsigned char)(v >> 56);
 }
-#endif
 
 #include <stdlib.h>
 #include <string.h>
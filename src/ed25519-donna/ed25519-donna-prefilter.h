@@ -0,0 +1,135 @@
+/*
+	Pre-filter of the half-size verifiers
+
+	Rules that only read the encodings of R, S and A, checked before H(R,A,M)
+	and before any field or group operation. ed25519_prefilter_use enables
+	them (all are off by default):
+
+	- ED25519_PREFILTER_S_NONCANONICAL: S >= el;
+	- ED25519_PREFILTER_R_NONCANONICAL, _A_NONCANONICAL: the y-coordinate of
+	  R or A is >= p;
+	- ED25519_PREFILTER_R_SMALL_ORDER, _A_SMALL_ORDER: R or A is a point of
+	  order 1, 2, 4 or 8, for either sign of x, including the encodings
+	  y = p and y = p + 1 of y = 0 and y = 1.
+
+	The S rule is also part of the ZIP-215 rules. The point rules are those
+	of strict verifiers and reject signatures that ZIP-215 accepts.
+
+	Every check loads the encoding as 64-bit words and is branch free, a few
+	dozen cycles per signature; only a rejection branches, to count the rules
+	that fired. The batch verifiers run the filter over the whole batch before
+	hashing and only verify the signatures that pass it. The counters are
+	kept per thread, like the blinding generator.
+*/
+
+static unsigned ed25519_prefilter_rules = 0;
+static ED25519_THREAD_LOCAL uint64_t ed25519_prefilter_hits[ED25519_PREFILTER_RULES];
+
+/* el, as 64-bit words */
+static const uint64_t ed25519_prefilter_el[4] = {
+	0x5812631a5cf5d3edull, 0x14def9dea2f79cd6ull, 0x0000000000000000ull, 0x1000000000000000ull
+};
+
+/* y-coordinates of the small-order points, as 64-bit words */
+static const uint64_t ed25519_prefilter_small_order[7][4] = {
+	{0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull}, /* order 4 */
+	{0x0000000000000001ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull}, /* order 1 */
+	{0xb027b2c28f95e826ull, 0xf098eff289f4c345ull, 0x3933c6d305acdfd5ull, 0x05fc536d880238b1ull}, /* order 8 */
+	{0x4fd84d3d706a17c7ull, 0x0f67100d760b3cbaull, 0xc6cc392cfa53202aull, 0x7a03ac9277fdc74eull}, /* order 8 */
+	{0xffffffffffffffecull, 0xffffffffffffffffull, 0xffffffffffffffffull, 0x7fffffffffffffffull}, /* p - 1, order 2 */
+	{0xffffffffffffffedull, 0xffffffffffffffffull, 0xffffffffffffffffull, 0x7fffffffffffffffull}, /* p, order 4 */
+	{0xffffffffffffffeeull, 0xffffffffffffffffull, 0xffffffffffffffffull, 0x7fffffffffffffffull}  /* p + 1, order 1 */
+};
+
+/* 1 if S >= el: the borrow of S - el is 0 */
+static DONNA_INLINE int
+ed25519_S_noncanonical(const unsigned char S[32]) {
+	uint64_t s, borrow = 0;
+	size_t i;
+
+	for (i = 0; i < 4; i++) {
+		s = U8TO64_LE(S + 8 * i);
+		borrow = (uint64_t)(s < ed25519_prefilter_el[i]) | ((uint64_t)(s == ed25519_prefilter_el[i]) & borrow);
+	}
+	return (int)(borrow ^ 1);
+}
+
+/* the y-coordinate of an encoded point, sign bit cleared */
+static DONNA_INLINE void
+ed25519_prefilter_y(uint64_t y[4], const unsigned char p[32]) {
+	y[0] = U8TO64_LE(p);
+	y[1] = U8TO64_LE(p + 8);
+	y[2] = U8TO64_LE(p + 16);
+	y[3] = U8TO64_LE(p + 24) & 0x7fffffffffffffffull;
+}
+
+/* 1 if y >= p = 2^255 - 19 */
+static DONNA_INLINE int
+ed25519_y_noncanonical(const uint64_t y[4]) {
+	return (int)((y[3] == 0x7fffffffffffffffull) & (y[2] == ~0ull) & (y[1] == ~0ull) & (y[0] >= 0xffffffffffffffedull));
+}
+
+/* 1 if y is the y-coordinate of a small-order point */
+static DONNA_INLINE int
+ed25519_y_small_order(const uint64_t y[4]) {
+	uint64_t found = 0;
+	size_t i;
+
+	for (i = 0; i < 7; i++)
+		found |= (uint64_t)((y[0] == ed25519_prefilter_small_order[i][0]) & (y[1] == ed25519_prefilter_small_order[i][1]) &
+			(y[2] == ed25519_prefilter_small_order[i][2]) & (y[3] == ed25519_prefilter_small_order[i][3]));
+	return (int)found;
+}
+
+/* bit rule is set for each rule that (R, S, A) breaks, enabled or not */
+static DONNA_INLINE unsigned
+ed25519_prefilter_flags(const unsigned char R[32], const unsigned char S[32], const unsigned char A[32]) {
+	uint64_t yR[4], yA[4];
+
+	ed25519_prefilter_y(yR, R);
+	ed25519_prefilter_y(yA, A);
+	return ((unsigned)ed25519_S_noncanonical(S) << ED25519_PREFILTER_S_NONCANONICAL) |
+		((unsigned)ed25519_y_noncanonical(yR) << ED25519_PREFILTER_R_NONCANONICAL) |
+		((unsigned)ed25519_y_noncanonical(yA) << ED25519_PREFILTER_A_NONCANONICAL) |
+		((unsigned)ed25519_y_small_order(yR) << ED25519_PREFILTER_R_SMALL_ORDER) |
+		((unsigned)ed25519_y_small_order(yA) << ED25519_PREFILTER_A_SMALL_ORDER);
+}
+
+/* 1 if an enabled rule rejects (R, S, A), which counts every enabled rule it breaks */
+static int
+ed25519_prefilter_reject(const unsigned char R[32], const unsigned char S[32], const unsigned char A[32]) {
+	unsigned flags, rule;
+
+	if (!ed25519_prefilter_rules)
+		return 0;
+	flags = ed25519_prefilter_flags(R, S, A) & ed25519_prefilter_rules;
+	if (!flags)
+		return 0;
+	for (rule = 0; rule < ED25519_PREFILTER_RULES; rule++)
+		ed25519_prefilter_hits[rule] += (flags >> rule) & 1;
+	return 1;
+}
+
+/* valid[i] <-- 0 if the filter rejects signature i and 1 otherwise; returns the number rejected */
+static size_t
+ed25519_prefilter_batch(const unsigned char **pk, const unsigned char **RS, size_t num, int *valid) {
+	size_t i, rejected = 0;
+
+	for (i = 0; i < num; i++) {
+		valid[i] = !ed25519_prefilter_reject(RS[i], RS[i] + 32, pk[i]);
+		rejected += (size_t)(valid[i] ^ 1);
+	}
+	return rejected;
+}
+
+void
+ED25519_FN(ed25519_prefilter_use) (unsigned rules) {
+	ed25519_prefilter_rules = rules & ED25519_PREFILTER_ALL;
+}
+
+void
+ED25519_FN(ed25519_prefilter_counters) (uint64_t counts[ED25519_PREFILTER_RULES], int reset) {
+	memcpy(counts, ed25519_prefilter_hits, sizeof(ed25519_prefilter_hits));
+	if (reset)
+		memset(ed25519_prefilter_hits, 0, sizeof(ed25519_prefilter_hits));
+}
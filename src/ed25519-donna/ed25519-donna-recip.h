@@ -0,0 +1,58 @@
+/*
+	Constant-time inversion backend for the secret-dependent packs of
+	ed25519_sign and ed25519_publickey, selected at compile time:
+
+	ED25519_INVERSE_FLT      curve25519_recip, Fermat's little theorem
+	ED25519_INVERSE_SAFEGCD  inverse25519_skylake, safeGCD (link asm.o, table.o)
+	ED25519_INVERSE_BINGCD   gf_inv, binGCD (link gf25519.o)
+
+	The Makefile builds SAFEGCD (INVERSE_BACKEND). A build that defines
+	none of them gets FLT, the only one that needs nothing else linked.
+
+	The external backends work on the canonical 32-byte encoding, so the
+	conversion is curve25519_contract / curve25519_expand, both constant time.
+*/
+
+#if defined(ED25519_INVERSE_SAFEGCD)
+	#include "../inverse25519/inverse25519skylake-20210110/inverse25519.h"
+#elif defined(ED25519_INVERSE_BINGCD)
+	#include "../inverse25519/bingcd/src/gf25519.h"
+#elif !defined(ED25519_INVERSE_FLT)
+	#define ED25519_INVERSE_FLT
+#endif
+
+static void
+curve25519_recip_consttime(bignum25519 out, const bignum25519 z) {
+#if defined(ED25519_INVERSE_FLT)
+	curve25519_recip(out, z);
+#else
+	unsigned char b[32];
+
+	curve25519_contract(b, z);
+	#if defined(ED25519_INVERSE_SAFEGCD)
+	inverse25519(b, b);
+	#else
+	{
+		gf x;
+
+		gf_decode(&x, b);
+		gf_inv(&x, &x);
+		gf_encode(b, &x);
+	}
+	#endif
+	curve25519_expand(out, b);
+#endif
+}
+
+/* ge25519_pack for secret points, with the selected constant-time inversion */
+static void
+ge25519_pack_consttime(unsigned char r[32], const ge25519 *p) {
+	bignum25519 tx, ty, zi;
+	unsigned char parity[32];
+	curve25519_recip_consttime(zi, p->z);
+	curve25519_mul(tx, p->x, zi);
+	curve25519_mul(ty, p->y, zi);
+	curve25519_contract(r, ty);
+	curve25519_contract(parity, tx);
+	r[31] ^= ((parity[0] & 1) << 7);
+}
@@ -0,0 +1,14 @@
+/*
+	Straus window tuning, generated by `make calibrate`
+*/
+
+#define GE25519_STRAUS_TABLE_COST 324
+#define GE25519_STRAUS_ADD_COST 322
+#define GE25519_STRAUS_DBL_COST 225
+
+/* window width of a runtime stream, indexed by (bit length of its scalar + 7) / 8 */
+static const unsigned char ge25519_straus_window[33] = {
+	2, 2, 2, 2, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5
+};
@@ -12,6 +12,10 @@
 #include "ed25519-donna-portable.h"
 
 #if defined(ED25519_SSE2)
+#elif defined(ED25519_ADX)
+	#if !defined(HAVE_UINT128) || !defined(CPU_X86_64) || !defined(COMPILER_GCC)
+		#error ED25519_ADX needs x86-64 and GCC-style inline assembly
+	#endif
 #else
 	#if defined(HAVE_UINT128) && !defined(ED25519_FORCE_32BIT)
 		#define ED25519_64BIT
@@ -33,7 +37,7 @@
 			#if defined(COMPILER_GCC) 
 				#if defined(ED25519_64BIT)
 					#define ED25519_GCC_64BIT_X86_CHOOSE
-				#else
+				#elif defined(ED25519_32BIT)
 					#define ED25519_GCC_64BIT_32BIT_CHOOSE
 				#endif
 			#endif
@@ -43,6 +47,8 @@
 
 #if defined(ED25519_SSE2)
 	#include "curve25519-donna-sse2.h"
+#elif defined(ED25519_ADX)
+	#include "curve25519-donna-64bit-adx.h"
 #elif defined(ED25519_64BIT)
 	#include "curve25519-donna-64bit.h"
 #else
@@ -96,7 +102,9 @@ typedef struct ge25519_pniels_t {
 
 #include "ed25519-donna-basepoint-table.h"
 
-#if defined(ED25519_64BIT)
+#if defined(ED25519_ADX)
+	#include "ed25519-donna-64bit-adx-tables.h"
+#elif defined(ED25519_64BIT)
 	#include "ed25519-donna-64bit-tables.h"
 	#include "ed25519-donna-64bit-x86.h"
 #else
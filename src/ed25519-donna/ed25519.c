@@ -20,6 +20,7 @@
 #include "ed25519-hash.h"
 
 #include "new_batch_helper.h"
+#include "ed25519-donna-recip.h"
 
 
 /*
@@ -44,8 +45,8 @@ ed25519_hram(hash_512bits hram, const ed25519_signature RS, const ed25519_public
 	ed25519_hash_final(&ctx, hram);
 }
 
-void
-ED25519_FN(ed25519_publickey) (const ed25519_secret_key sk, ed25519_public_key pk) {
+static DONNA_INLINE void
+ed25519_publickey_pack(const ed25519_secret_key sk, ed25519_public_key pk, int donna_pack) {
 	bignum256modm a;
 	ge25519 ALIGN(16) A;
 	hash_512bits extsk;
@@ -54,12 +55,26 @@ ED25519_FN(ed25519_publickey) (const ed25519_secret_key sk, ed25519_public_key p
 	ed25519_extsk(extsk, sk);
 	expand256_modm(a, extsk, 32);
 	ge25519_scalarmult_base_niels(&A, ge25519_niels_base_multiples, a);
-	ge25519_pack(pk, &A);
+	if (donna_pack)
+		ge25519_pack(pk, &A);
+	else
+		ge25519_pack_consttime(pk, &A);
 }
 
+void
+ED25519_FN(ed25519_publickey) (const ed25519_secret_key sk, ed25519_public_key pk) {
+	ed25519_publickey_pack(sk, pk, 0);
+}
 
+/* unmodified donna key generation (Fermat inversion in the pack), the benchmark baseline */
 void
-ED25519_FN(ed25519_sign) (const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_public_key pk, ed25519_signature RS) {
+ED25519_FN(ed25519_publickey_donna) (const ed25519_secret_key sk, ed25519_public_key pk) {
+	ed25519_publickey_pack(sk, pk, 1);
+}
+
+
+static DONNA_INLINE void
+ed25519_sign_pack(const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_public_key pk, ed25519_signature RS, int donna_pack) {
 	ed25519_hash_context ctx;
 	bignum256modm r, S, a;
 	ge25519 ALIGN(16) R;
@@ -76,7 +91,10 @@ ED25519_FN(ed25519_sign) (const unsigned char *m, size_t mlen, const ed25519_sec
 
 	/* R = rB */
 	ge25519_scalarmult_base_niels(&R, ge25519_niels_base_multiples, r);
-	ge25519_pack(RS, &R);
+	if (donna_pack)
+		ge25519_pack(RS, &R);
+	else
+		ge25519_pack_consttime(RS, &R);
 
 	/* S = H(R,A,m).. */
 	ed25519_hram(hram, RS, pk, m, mlen);
@@ -93,8 +111,19 @@ ED25519_FN(ed25519_sign) (const unsigned char *m, size_t mlen, const ed25519_sec
 	contract256_modm(RS + 32, S);
 }
 
-int
-ED25519_FN(ed25519_sign_open) (const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS) {
+void
+ED25519_FN(ed25519_sign) (const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_public_key pk, ed25519_signature RS) {
+	ed25519_sign_pack(m, mlen, sk, pk, RS, 0);
+}
+
+/* unmodified donna signing (Fermat inversion in the pack), the benchmark baseline */
+void
+ED25519_FN(ed25519_sign_donna) (const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_public_key pk, ed25519_signature RS) {
+	ed25519_sign_pack(m, mlen, sk, pk, RS, 1);
+}
+
+static DONNA_INLINE int
+ed25519_sign_open_checkR(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS, int vartime_pack) {
 	ge25519 ALIGN(16) R, A;
 	hash_512bits hash;
 	bignum256modm hram, S;
@@ -112,21 +141,57 @@ ED25519_FN(ed25519_sign_open) (const unsigned char *m, size_t mlen, const ed2551
 
 	/* SB - H(R,A,m)A */
 	ge25519_double_scalarmult_vartime(&R, &A, hram, S);
-	ge25519_pack(checkR, &R);
+
+	/* R is public, so it is packed with the vartime EEA_q inversion */
+	if (vartime_pack)
+		ge25519_pack_vartime(checkR, &R);
+	else
+		ge25519_pack(checkR, &R);
 
 	/* check that R = SB - H(R,A,m)A */
 	return ed25519_verify(RS, checkR, 32) ? 0 : -1;
 }
 
+int
+ED25519_FN(ed25519_sign_open) (const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS) {
+	return ed25519_sign_open_checkR(m, mlen, pk, RS, 1);
+}
+
+/* unmodified donna verification (Fermat inversion in the final pack), the benchmark baseline */
+int
+ED25519_FN(ed25519_sign_open_donna) (const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS) {
+	return ed25519_sign_open_checkR(m, mlen, pk, RS, 0);
+}
+
 
 #include "ed25519-donna-batchverify.h"
 
+/*
+	Persistent store of precomputed public keys, consulted by the verifiers below
+*/
+#include "ed25519-donna-pkstore.h"
+
+/*
+	Blinding randomness of the batch verifiers below
+*/
+#include "ed25519-donna-batch-rng.h"
+
+/*
+	Pre-filter on the encodings, run by the verifiers below before hashing
+*/
+#include "ed25519-donna-prefilter.h"
+
 /*
 	New open and batchverify using Half-size scalar
 */
 #include "ed25519-donna-open_new.h"
 #include "ed25519-donna-batchverify_new.h"
 
+/*
+	Half-aggregated signatures, verified like a batch
+*/
+#include "ed25519-donna-halfagg.h"
+
 
 /*
 	Fast Curve25519 basepoint scalar multiplication
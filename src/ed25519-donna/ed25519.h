@@ -2,6 +2,7 @@
 #define ED25519_H
 
 #include <stdlib.h>
+#include <stdint.h>
 
 #if defined(__cplusplus)
 extern "C" {
@@ -15,14 +16,102 @@ typedef unsigned char curved25519_key[32];
 
 void ed25519_publickey(const ed25519_secret_key sk, ed25519_public_key pk);
 int ed25519_sign_open(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
+int ed25519_sign_open_donna(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
 void ed25519_sign(const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_public_key pk, ed25519_signature RS);
+void ed25519_publickey_donna(const ed25519_secret_key sk, ed25519_public_key pk);
+void ed25519_sign_donna(const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_public_key pk, ed25519_signature RS);
 int ed25519_sign_open_batch(const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid);
 
 int ed25519_sign_open_hEEA(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
+int ed25519_sign_open_hEEA_split(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS, unsigned bl_t);
+unsigned ed25519_hEEA_split(void);
+uint64_t ed25519_hEEA_split_cost(unsigned bl_t);
 int ed25519_sign_open_hEEA_samePre(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
-int ed25519_sign_open_hgcd(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
+int ed25519_verify_prehashed_hram(const unsigned char hram[64], const ed25519_public_key pk, const ed25519_signature RS);
 int ed25519_sign_open_batch_hEEA(const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid);
+int ed25519_sign_open_joint2_hEEA(const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, int *valid);
+int ed25519_sign_open_joint3_hEEA(const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, int *valid);
+
+typedef struct ed25519_batch_workspace_t ed25519_batch_workspace;
+size_t ed25519_batch_workspace_size(size_t capacity);
+ed25519_batch_workspace *ed25519_batch_workspace_init(void *mem, size_t size, size_t capacity);
+ed25519_batch_workspace *ed25519_batch_workspace_create(size_t capacity);
+void ed25519_batch_workspace_free(ed25519_batch_workspace *ws);
+size_t ed25519_batch_workspace_capacity(const ed25519_batch_workspace *ws);
+/* the entry points without _ws keep one workspace per thread, freed by this */
+void ed25519_batch_thread_workspace_free(void);
+int ed25519_sign_open_batch_hEEA_ws(ed25519_batch_workspace *ws, const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid);
+/* the GMP hgcd reducer reads 64-bit limbs; 32-bit builds define ED25519_NO_HGCD */
+#if !defined(ED25519_NO_HGCD)
+int ed25519_sign_open_hgcd(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
 int ed25519_sign_open_batch_hgcd(const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid);
+int ed25519_sign_open_batch_hgcd_ws(ed25519_batch_workspace *ws, const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid);
+#endif
+int ed25519_verify_prehashed_hram_batch(const unsigned char **hram, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid);
+int ed25519_verify_prehashed_hram_batch_ws(ed25519_batch_workspace *ws, const unsigned char **hram, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid);
+
+typedef enum ed25519_batch_half_size_t {
+	ED25519_BATCH_HEEA = 0,
+	ED25519_BATCH_HGCD
+} ed25519_batch_half_size;
+typedef struct ed25519_batch_config_t {
+	size_t chunk_size;	/* signatures per Bos-Coster heap, at most the workspace capacity; 4 to 4096 */
+	size_t min_batch_size;	/* fewer signatures go to the joint and single verifiers; 4 to chunk_size */
+	ed25519_batch_half_size half_size;	/* used by ed25519_sign_open_batch_auto */
+} ed25519_batch_config;
+void ed25519_batch_config_use(const ed25519_batch_config *config);
+void ed25519_batch_config_get(ed25519_batch_config *config);
+void ed25519_batch_calibrate(uint64_t (*ticks)(void), ed25519_batch_config *config);
+int ed25519_sign_open_batch_auto(const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid);
+
+typedef struct ed25519_batch_ctx_t ed25519_batch_ctx;
+size_t ed25519_batch_ctx_size(size_t capacity);
+ed25519_batch_ctx *ed25519_batch_ctx_init(void *mem, size_t size, size_t capacity);
+ed25519_batch_ctx *ed25519_batch_ctx_create(size_t capacity);
+void ed25519_batch_ctx_free(ed25519_batch_ctx *ctx);
+size_t ed25519_batch_ctx_count(const ed25519_batch_ctx *ctx);
+int ed25519_batch_ctx_add(ed25519_batch_ctx *ctx, const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
+int ed25519_batch_ctx_finalize(ed25519_batch_ctx *ctx, int *valid);
+
+size_t ed25519_halfagg_size(size_t num);
+int ed25519_halfagg_aggregate(const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, unsigned char *agg);
+int ed25519_halfagg_verify(const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char *agg, size_t num);
+int ed25519_halfagg_verify_ws(ed25519_batch_workspace *ws, const unsigned char **m, size_t *mlen, const unsigned char **pk, const unsigned char *agg, size_t num);
+
+typedef enum ed25519_batch_rng_t {
+	ED25519_BATCH_RNG_DRBG = 0,	/* per-thread ChaCha20 seeded once (default) */
+	ED25519_BATCH_RNG_SYSTEM,	/* ed25519_randombytes_unsafe for every chunk */
+	ED25519_BATCH_RNG_TRANSCRIPT	/* SHA-512 of the batch, reproducible */
+} ed25519_batch_rng;
+void ed25519_batch_rng_use(ed25519_batch_rng mode);
+void ed25519_randombytes_drbg(void *out, size_t count);
+
+typedef enum ed25519_verify_rules_t {
+	ED25519_VERIFY_COFACTORLESS = 0,	/* [S]B = R + [h]A (default) */
+	ED25519_VERIFY_ZIP215	/* [8][S]B = [8]R + [8][h]A, S < el; batch and single results agree */
+} ed25519_verify_rules;
+void ed25519_verify_rules_use(ed25519_verify_rules rules);	/* process-wide; set before verifying threads start */
+
+typedef enum ed25519_prefilter_rule_t {
+	ED25519_PREFILTER_S_NONCANONICAL = 0,	/* S >= el */
+	ED25519_PREFILTER_R_NONCANONICAL,	/* y of R >= p */
+	ED25519_PREFILTER_A_NONCANONICAL,	/* y of A >= p */
+	ED25519_PREFILTER_R_SMALL_ORDER,	/* R of order 1, 2, 4 or 8 */
+	ED25519_PREFILTER_A_SMALL_ORDER,	/* A of order 1, 2, 4 or 8 */
+	ED25519_PREFILTER_RULES
+} ed25519_prefilter_rule;
+#define ED25519_PREFILTER_ALL ((1u << ED25519_PREFILTER_RULES) - 1)
+void ed25519_prefilter_use(unsigned rules);
+void ed25519_prefilter_counters(uint64_t counts[ED25519_PREFILTER_RULES], int reset);
+
+void ed25519_straus_calibrate(uint64_t (*ticks)(void), uint64_t *table_cost, uint64_t *add_cost, uint64_t *dbl_cost, unsigned char *window);
+
+typedef struct ed25519_pk_store_t ed25519_pk_store;
+int64_t ed25519_pk_store_build(const char *path, const ed25519_public_key *pks, size_t count, unsigned window);
+ed25519_pk_store *ed25519_pk_store_open(const char *path);
+void ed25519_pk_store_close(ed25519_pk_store *store);
+void ed25519_pk_store_use(const ed25519_pk_store *store);	/* process-wide; set before verifying threads start */
+size_t ed25519_pk_store_count(const ed25519_pk_store *store);
 
 void ed25519_randombytes_unsafe(void *out, size_t count);
 
@@ -30,7 +30,11 @@
 
 #include <gmp.h>
 #include "../half_size/curve25519/curve25519_hEEA_vartime.h"
+#include "../half_size/curve25519/curve25519_hEEA32_vartime.h"
+#include "../half_size/curve25519/curve25519_hEEA_lehmer_vartime.h"
 #include "../half_size/curve25519/curve25519_hgcd_vartime.h"
+#include "../inverse25519/EEA_q/inverse25519_EEA_vartime.h"
+#include "../portable_intrinsics.h"
 
 #define n_words_bignum256modm bignum256modm_limb_size
 #define n_bytes_in_word_bignum256modm sizeof(bignum256modm_element_t)
@@ -38,25 +42,108 @@
 #define bignum256modm_2_mpz(out, in) mpz_import(out, n_words_bignum256modm, -1, n_bytes_in_word_bignum256modm, 0, nails_bits_bignum256modm_2_mpz, in);
 
 
+/*
+ * The half-size reducers work on 4 x 64-bit words, whatever the limb size
+ * of bignum256modm (56 bits on 64-bit builds, 30 bits on 32-bit ones);
+ * the loops below unroll to the plain shift-and-mask code. With 30-bit
+ * limbs, curve25519_half_size_scalar_vartime_hEEA uses the 8 x 32-bit
+ * word reducer instead.
+ */
+#define bignum256modm_limb_mask ((((bignum256modm_element_t)1) << bignum256modm_bits_per_limb) - 1)
+
 /* bignum256modm to uint_64 */
-void bignum256modm_2_u64(uint64_t *out, const bignum256modm in){
-    out[0] = (in[0]      ) | ((in[1] & 0xFF) << 56);
-    out[1] = (in[1] >>  8) | ((in[2] & 0xFFFF) << 48);
-    out[2] = (in[2] >> 16) | ((in[3] & 0xFFFFFF) << 40);
-    out[3] = (in[3] >> 24) | ((in[4] & 0xFFFFFFFF) << 32);
+static void bignum256modm_2_u64(uint64_t *out, const bignum256modm in){
+    size_t i, k, s;
+
+    out[0] = out[1] = out[2] = out[3] = 0;
+    for (i = 0; i < bignum256modm_limb_size; i++) {
+        k = (i * bignum256modm_bits_per_limb) / 64;
+        s = (i * bignum256modm_bits_per_limb) % 64;
+        if (k >= 4)
+            break;
+        out[k] |= (uint64_t)in[i] << s;
+        if (s + bignum256modm_bits_per_limb > 64 && k + 1 < 4)
+            out[k + 1] |= (uint64_t)in[i] >> (64 - s);
+    }
 }
 
 /* uint_64 to bignum256modm */
-void u64_2_bignum256modm(bignum256modm out, const uint64_t *in){
-    out[0] = in[0] & 0xFFFFFFFFFFFFFF;
-    out[1] = (in[0] >> 56) | ((in[1] & 0xFFFFFFFFFFFF) << 8);
-    out[2] = (in[1] >> 48) | ((in[2] & 0xFFFFFFFFFF) << 16);
-    out[3] = (in[2] >> 40) | ((in[3] & 0xFFFFFFFF) << 24);
-    out[4] = in[3] >> 32;
+static void u64_2_bignum256modm(bignum256modm out, const uint64_t *in){
+    size_t i, k, s;
+    uint64_t x;
+
+    for (i = 0; i < bignum256modm_limb_size; i++) {
+        k = (i * bignum256modm_bits_per_limb) / 64;
+        s = (i * bignum256modm_bits_per_limb) % 64;
+        x = (k < 4) ? in[k] >> s : 0;
+        if (s + bignum256modm_bits_per_limb > 64 && k + 1 < 4)
+            x |= in[k + 1] << (64 - s);
+        out[i] = (bignum256modm_element_t)x & bignum256modm_limb_mask;
+    }
+}
+
+#if (bignum256modm_bits_per_limb == 30)
+/* bignum256modm to uint_32 */
+static void bignum256modm_2_u32(uint32_t *out, const bignum256modm in){
+    size_t i, k, s;
+
+    memset(out, 0, 8 * sizeof(uint32_t));
+    for (i = 0; i < bignum256modm_limb_size; i++) {
+        k = (i * bignum256modm_bits_per_limb) / 32;
+        s = (i * bignum256modm_bits_per_limb) % 32;
+        if (k >= 8)
+            break;
+        out[k] |= (uint32_t)in[i] << s;
+        if (s + bignum256modm_bits_per_limb > 32 && k + 1 < 8)
+            out[k + 1] |= (uint32_t)in[i] >> (32 - s);
+    }
+}
+
+/* uint_32 to bignum256modm */
+static void u32_2_bignum256modm(bignum256modm out, const uint32_t *in){
+    size_t i, k, s;
+    uint32_t x;
+
+    for (i = 0; i < bignum256modm_limb_size; i++) {
+        k = (i * bignum256modm_bits_per_limb) / 32;
+        s = (i * bignum256modm_bits_per_limb) % 32;
+        x = (k < 8) ? in[k] >> s : 0;
+        if (s + bignum256modm_bits_per_limb > 32 && k + 1 < 8)
+            x |= in[k + 1] << (32 - s);
+        out[i] = (bignum256modm_element_t)x & bignum256modm_limb_mask;
+    }
+}
+
+/* a <-- -a, a signed n-word integer */
+static void u32_neg(uint32_t *a, size_t n){
+    size_t i;
+    uint32_t carry = 1;
+
+    for (i = 0; i < n; i++) {
+        a[i] = ~a[i] + carry;
+        carry &= (a[i] == 0);
+    }
+}
+#endif
+
+/* split S to S1 and S2, s.t. S = (S2<<126 | S1): S2 <-- S >> 126, S <-- S mod 2^126 */
+static void
+bignum256modm_split126(bignum256modm S2, bignum256modm S){
+    const size_t k = 126 / bignum256modm_bits_per_limb, s = 126 % bignum256modm_bits_per_limb;
+    size_t i;
+
+    for (i = 0; i < bignum256modm_limb_size; i++) {
+        S2[i] = (i + k < bignum256modm_limb_size) ? S[i + k] >> s : 0;
+        if (s && i + k + 1 < bignum256modm_limb_size)
+            S2[i] |= (S[i + k + 1] << (bignum256modm_bits_per_limb - s)) & bignum256modm_limb_mask;
+    }
+    S[k] &= (((bignum256modm_element_t)1) << s) - 1;
+    for (i = k + 1; i < bignum256modm_limb_size; i++)
+        S[i] = 0;
 }
 
 /* mpz to bignum256modm */
-void mpz_2_bignum256modm(bignum256modm out, const mpz_t in) {
+static void mpz_2_bignum256modm(bignum256modm out, const mpz_t in) {
     size_t count,i;
     mpz_export((void *) out, &count, -1, n_bytes_in_word_bignum256modm, 0, nails_bits_bignum256modm_2_mpz, in);
     if (count < n_words_bignum256modm){
@@ -68,35 +155,24 @@ void mpz_2_bignum256modm(bignum256modm out, const mpz_t in) {
 
 
 /* bignum256modm inverse mod el */
-void inv256_modm(bignum256modm out, bignum256modm in){
-    static mp_limb_t __m[4] = {
-    0x5812631a5cf5d3ed,
-    0x14def9dea2f79cd6,
-    0x0000000000000000,
-    0x1000000000000000
-    };
-
-	__mpz_struct _m = {
-    	._mp_alloc = 4,
-    	._mp_size = 4,
-    	._mp_d = __m
-	};
-	mpz_t m = { _m };
-    mpz_t x, y;
-    mpz_inits(x,y, NULL);
+static void inv256_modm(bignum256modm out, bignum256modm in){
+    mpz_t m, x, y;
+    mpz_inits(m, x, y, NULL);
+    bignum256modm_2_mpz(m, modm_m);
     bignum256modm_2_mpz(x, in);
     mpz_invert(y, x, m);
     mpz_2_bignum256modm(out, y);
+    mpz_clears(m, x, y, NULL);
 };
 
 /* ge25519_unpack_positive_vartime*/
 static int
 ge25519_unpack_positive_vartime(ge25519 *r, const unsigned char p[32]) {
 	static const unsigned char zero[32] = {0};
-	static const bignum25519 one = {1};
+	static const bignum25519 ALIGN(16) one = {1};
 	unsigned char parity = p[31] >> 7;
 	unsigned char check[32];
-	bignum25519 t, root, num, den, d3;
+	bignum25519 ALIGN(16) t, root, num, den, d3;
 
 	curve25519_expand(r->y, p);
 	curve25519_copy(r->z, one);
@@ -141,7 +217,22 @@ ge25519_unpack_positive_vartime(ge25519 *r, const unsigned char p[32]) {
 }
 
 /* half_size_scalar */
-void curve25519_half_size_scalar_vartime_hEEA(bignum256modm r, bignum256modm t, bignum256modm v, int *r_negative, int *t_negative){
+#if (bignum256modm_bits_per_limb == 30)
+static void curve25519_half_size_scalar_vartime_hEEA(bignum256modm r, bignum256modm t, bignum256modm v, int *r_negative, int *t_negative){
+    uint32_t b[8], c0[8] = {0}, c1[8] = {0};
+    bignum256modm_2_u32(b, v);
+    curve25519_hEEA32_vartime(c0, c1, b);
+    *t_negative = c0[3] >> 31;
+    if (*t_negative)
+        u32_neg(c0, 4);
+    *r_negative = c1[3] >> 31;
+    if (*r_negative)
+        u32_neg(c1, 4);
+    u32_2_bignum256modm(t, c0);
+    u32_2_bignum256modm(r, c1);
+}
+#else
+static void curve25519_half_size_scalar_vartime_hEEA(bignum256modm r, bignum256modm t, bignum256modm v, int *r_negative, int *t_negative){
     uint64_t b[4], c0[4] = {0}, c1[4] = {0};
     bignum256modm_2_u64(b, v);
     curve25519_hEEA_vartime(c0, c1, b);
@@ -164,8 +255,53 @@ void curve25519_half_size_scalar_vartime_hEEA(bignum256modm r, bignum256modm t,
     u64_2_bignum256modm(t, c0);
     u64_2_bignum256modm(r, c1);
 }
-/* half_size_scalar */
-void curve25519_half_size_scalar_vartime_hgcd(bignum256modm r, bignum256modm t, bignum256modm v, int *r_negative, int *t_negative){
+#endif
+/*
+ * same, with |t| < 2^bl_t and r on the remaining ~253 - bl_t bits; if r
+ * misses its bound, the balanced split of curve25519_hEEA_vartime instead
+ */
+static void curve25519_half_size_scalar_vartime_hEEA_split(bignum256modm r, bignum256modm t, bignum256modm v, int *r_negative, int *t_negative, unsigned bl_t){
+    uint64_t b[4], c0[4] = {0}, c1[4] = {0};
+    bignum256modm_2_u64(b, v);
+    if (curve25519_hEEA_target_vartime(c0, c1, b, bl_t, 253 - bl_t) != 0) {
+        curve25519_half_size_scalar_vartime_hEEA(r, t, v, r_negative, t_negative);
+        return;
+    }
+    *t_negative = c0[2] >> 63;
+	if (*t_negative){
+		c0[0] = ~c0[0];
+		c0[1] = ~c0[1];
+		c0[2] = ~c0[2];
+		if (++c0[0] == 0) {
+			if (++c0[1] == 0) {
+				c0[2]++;
+			}
+		}
+	}
+	*r_negative = c1[2] >> 63;
+	if (*r_negative){
+		c1[0] = ~c1[0];
+		c1[1] = ~c1[1];
+		c1[2] = ~c1[2];
+		if (++c1[0] == 0) {
+			if (++c1[1] == 0) {
+				c1[2]++;
+			}
+		}
+	}
+    u64_2_bignum256modm(t, c0);
+    u64_2_bignum256modm(r, c1);
+}
+/*
+ * half_size_scalar. The hgcd reducer reads GMP limbs as 64-bit words, so
+ * with 32-bit GMP limbs (32-bit builds) it is not linked in and the hgcd
+ * verifiers are left out with ED25519_NO_HGCD.
+ */
+#if !defined(ED25519_NO_HGCD)
+#if (GMP_LIMB_BITS != 64)
+#error "the hgcd verifiers need 64-bit GMP limbs, build with -DED25519_NO_HGCD"
+#endif
+static void curve25519_half_size_scalar_vartime_hgcd(bignum256modm r, bignum256modm t, bignum256modm v, int *r_negative, int *t_negative){
     uint64_t b[4], c0[4] = {0}, c1[4] = {0};
     bignum256modm_2_u64(b, v);
 	int c0_size, c1_size;
@@ -190,9 +326,108 @@ void curve25519_half_size_scalar_vartime_hgcd(bignum256modm r, bignum256modm t,
     u64_2_bignum256modm(t, c0);
     u64_2_bignum256modm(r, c1);
 }
+#endif
+
+/* out += a * b, s.t. b is a signed n-limb integer and out is a signed 4-limb integer */
+static void
+mul_add_u64_signed(uint64_t out[4], uint64_t a, const uint64_t *b, size_t n){
+	uint64_t sign = (uint64_t)0 - (b[n - 1] >> 63);
+	uint64_t bi, lo, w, carry = 0, cc = 0;
+	size_t i;
+
+	for (i = 0; i < 4; i++) {
+		bi = (i < n) ? b[i] : sign;
+		lo = muladd_u64(a, bi, carry, 0, &carry);
+		w = out[i] + cc;
+		cc = (w < cc);
+		out[i] = w + lo;
+		cc += (out[i] < w);
+	}
+}
 
+/* a <-- -a, s.t. a is a signed n-limb integer */
+static void
+neg_u64(uint64_t *a, size_t n){
+	size_t i;
+	uint64_t cc = 1;
+	for (i = 0; i < n; i++) {
+		a[i] = ~a[i] + cc;
+		cc &= (a[i] == 0);
+	}
+}
 
-/* 2^126 B*/
+/*
+ * half_size_scalar randomized by rnd:
+ * (r, t) = alpha * (c1, c0) + beta * (c3, c2), where (c1, c0) and (c3, c2)
+ * are the two last rows of hEEA and alpha, beta are the two 64-bit halves
+ * of rnd. It still holds r * v = t mod el, with bl(r), bl(t) <= 195 (about
+ * 191 in practice); see ed25519_sign_open_joint_hEEA for why 128-bit alpha
+ * and beta need that length.
+ */
+static void curve25519_half_size_scalar_vartime_hEEA_randomized(bignum256modm r, bignum256modm t, bignum256modm v, const unsigned char rnd[16], int *r_negative, int *t_negative){
+    uint64_t b[4], c0[4] = {0}, c1[4] = {0}, c2[4] = {0}, c3[4] = {0};
+    uint64_t r_u64[4] = {0}, t_u64[4] = {0};
+    uint64_t alpha = U8TO64_LE(rnd), beta = U8TO64_LE(rnd + 8);
+    bignum256modm_2_u64(b, v);
+    curve25519_hEEA_basis_vartime(c0, c1, c2, c3, b);
+
+    mul_add_u64_signed(r_u64, alpha, c1, 2);
+    mul_add_u64_signed(r_u64, beta, c3, 2);
+    mul_add_u64_signed(t_u64, alpha, c0, 2);
+    mul_add_u64_signed(t_u64, beta, c2, 3);
+
+    *r_negative = r_u64[3] >> 63;
+	if (*r_negative)
+		neg_u64(r_u64, 4);
+    *t_negative = t_u64[3] >> 63;
+	if (*t_negative)
+		neg_u64(t_u64, 4);
+    u64_2_bignum256modm(t, t_u64);
+    u64_2_bignum256modm(r, r_u64);
+}
+
+
+/*
+ * 2^126 B, in the 4x64 form of the ADX backend, the radix-2^51 form of the
+ * 64-bit backend, or the radix-2^25.5 form shared by the 32-bit and SSE2
+ * backends
+ */
+#if defined(ED25519_ADX)
+static const ge25519_niels ge25519_niels_sliding_multiples2[32] = {
+    {{0x535fd60613037524,0xe210adf6b0fbc26a,0xac8d0a9b23e990ae,0x47204d08d72fdbf9},{0x07242eb30d4b497f,0x1ef96306b9bccc87,0x37950934d8116f45,0x05468d6201405b04},{0x00f565a9f93267de,0xcecfd78dc0d58e8a,0xa215e2dcf318e28e,0x4599ee919b633352}},
+    {{0xa413e91d6a54c980,0x554a7725f510d98f,0x6ac286ac5a0f6246,0x105ba38985c825bf},{0x348f016a267dad09,0x2f58d6c9a2b7d363,0x9775ba594e072213,0x759d087ff9e6a650},{0xbfab80dd9d8a5ddb,0x16ef6259905824c7,0x63fe716a32ab64b8,0x5461548ae00aebfb}},
+    {{0xd36e9de9527493ab,0xde3352d1c21ff4f4,0xc7b4ad917730750c,0x10bef1d8a6961f7c},{0x87787f5d47d18c38,0x53546abbd8e3da47,0xa8c660982d520543,0x476fc511210d50e2},{0x60e8d28d62a1b8c1,0x92359afa6b1f9692,0xec7713680282b49e,0x5e9c111f1bbddc7e}},
+    {{0x952b17abc651ecc4,0xce3ffc62dadcd52b,0x8d70f0636f22203e,0x212ff1fa04498441},{0x28e90b75a08d0c28,0xeba046128f5df845,0x35992f09a224b74b,0x489ad71d185198b7},{0x063995799f52209f,0x3ca2a85679f25d9f,0x85940d15bd06f1e3,0x57df53c1085ab64e}},
+    {{0x73aafb343143df91,0xe5859f17155d89c3,0x74fc88694a647255,0x526642f7b8b9bfe5},{0xfa776f0a4835ea15,0x47d27a58e4f9270a,0x79fd9cb6e378e533,0x3cf0ec6da74182dc},{0xa5f4c6ea23d63436,0x618f91151817387d,0x025249149f4f1074,0x4e9b5b1c1b00107f}},
+    {{0x08227aca52792fdc,0x70f8f733bb457f0a,0xac21d7fe578f44b9,0x77781e77abe0fd26},{0x5fc3072292c284bf,0xfa2300bc5dc02047,0xa5935f9721f47787,0x55162f70acd5778b},{0xde96e29b5d6c8a2e,0x9b07373a5ac9305c,0x95a48e016ad8e785,0x0c15656b2383a618}},
+    {{0xe5398f2ede49bb66,0x6d2ebac5103d8f09,0xaa7b2e8c279c466c,0x5612e6ff2d20237d},{0xada9adb8c2ab09b0,0x301866b6baabba96,0x2eb195bf55e13d52,0x5a5a0fa21d62aa90},{0x1d97be5c45379ca1,0xa9e1aafd233e282d,0x014034679c561d97,0x16c56fb9e6b60277}},
+    {{0x6f5961e9086365cd,0x899aa8cc1583e782,0x67133c948bdf0e9e,0x241d6697a0c10f60},{0x5f627e63f3be17be,0x422c51bf7a5f9dc4,0x23baca002d5e9fc9,0x60f451fcab5b6392},{0xf6194cf1a7efff7b,0xb98cd6814d8d4b44,0x30d10fb223eca363,0x4bd0b8881a482013}},
+    {{0x5ee6dfa4449a9164,0xcf977908fa860950,0x22b5056b7b0eeae1,0x382c794f610b7cb0},{0xa29693039b778df1,0x428af1d6ca5eb2d7,0xc5361cccfac26c15,0x1d6b2f9986fdcf5b},{0xd09e6dfbf2263b59,0xcf1d467ad741ff0e,0x3141bb90abd8c8e2,0x2a8dbf0931987e13}},
+    {{0x136bd68616f7433c,0x1f06c3d0662a613c,0x313a9e470934a4b2,0x4f9e0c9864502ccd},{0x22afa5498bea9a69,0x1e2645fcfa1cba07,0xd4a1795b20282bea,0x5923d05ff17c0fcc},{0x319444d2573f0ee9,0x33206faabd07309b,0x4aa028acd5d9c3e0,0x4eaf009ad26137bd}},
+    {{0xa6b701b2085f0eef,0x6f615ec263ffb36b,0xb729253c3c562602,0x626a05d50d4e6397},{0xf2dfca37420e18c0,0x8355b76824cda0f0,0xc2312dfa98d2ed1a,0x5b43e6275b9f5e46},{0x056a3e730e6fc24f,0x52ab5764011fa43f,0x7ca875abd36c28de,0x71288f1b8759b1d3}},
+    {{0x9e303a2c0d3e47b0,0x0105b8c85ccfc096,0xee4654212a51378d,0x6ec17664ba6bbb8e},{0x160ba5eb9692e387,0xdf2c5fecc98905b3,0xd623ab04d558c20e,0x2c9254222b62ea66},{0x1ed607207d1bef26,0x4ee4248b0a791fad,0x39eef6894b96bf95,0x712b8e3986acdbe5}},
+    {{0x1a0d2b3cd8a711fc,0xfb951e165e0af1ca,0xac6a55a86740af42,0x356dd9e4ae62f112},{0x4cab2db0ca1b92db,0xdf23294b2e7e961b,0x94cdb13658a5f9f2,0x6348575c2567275e},{0x8a7241c2ef612f4f,0x02dc8f951e0c72f2,0x01c5bf14b36e4ea4,0x7124b72e418a45fd}},
+    {{0x932217e9928db2f7,0x57c5fa0e81337f83,0xd8c9b67568e356b7,0x4a5b586a1ddc4202},{0x6eb712f87fd2ccf4,0x3e4804b2f9f5f547,0x10ef4b8cc51a2ca7,0x74a03e7701f30387},{0x421b3aa637f2d184,0x5b3cce0392599949,0x68496fca17b34169,0x607dc2e9a157cd73}},
+    {{0x1b8e3d77d0c4ee14,0x15eae2e3c1c9c445,0x703795d2752c49a1,0x0564a1c113a9746d},{0xa10e59e007d81be4,0x9cc3529dcb5977f0,0x1af06a222ed34ee6,0x66f0575336154c37},{0x430b88dcf109d53e,0x2574fb0aad6a556d,0xb12b25e2fbf2f2bf,0x11585acec385f6cd}},
+    {{0xc0a1f19f78c044db,0x06a0f4db40355363,0x1d40fdba516aad14,0x0e19c01cc1554fef},{0xa4a2d01e6cef9d4e,0xfdcfd927c48c030a,0x0fa4f2b2cb05bd5b,0x333c2319a1cdb580},{0xbe7235ae2f695126,0x8e0d17df5ec33455,0xdc7e390f87fa00e4,0x6ed7c6cd428b0f2c}},
+    {{0xf967caaf2802991b,0xe97dc2d939a86540,0xba3dd2688d2dd79e,0x27677fa3055f2abd},{0xb5035f61f09b366e,0x030a25f4d087d539,0x3c3942de1f2b11f1,0x5a5c9bca68cd1db3},{0xa905ad9a8b9ad766,0xa09ec673f6318d7c,0xfb8550583b6492a2,0x57e763e2e93a9650}},
+    {{0xa27e440add4bc8ab,0x8406a715c84f0392,0x96229ed992d71514,0x43dc66163e30f793},{0x031b9f6d612eb4d0,0x0f8e2fe07327a66d,0xfda7c99bbffade56,0x16b1400b9d9c588c},{0x086dcf10e4020b7c,0xa38ac7bd6f2fdca7,0xb1fb91d02d45b0bc,0x5968804e08936393}},
+    {{0x45be3cbf6e40f5a6,0x3c839db9e5405938,0x7f4459827ef880e8,0x0b936019169e632c},{0x6d0c9d308ef60c17,0x8a45ce596f4afc1a,0x0c03f4b7ba662c2c,0x7258c5e68b5baffb},{0x8999531cf5138d59,0xa3e2ee7083e1f94b,0xb992c195369bf502,0x55c1d4a3351f2cbe}},
+    {{0x8dd9f0d8da83fe1b,0x0299d7567f2006d6,0xf64d4181a4442339,0x53b5625b6820fb84},{0x573d54db2e2d20fa,0xa6b7c096ff6f61bd,0x602227227aedb2bf,0x0d6a94758392441c},{0x560ce930171834f7,0x2ab602b03db454a7,0x1e8c645b8b7382a0,0x6044faf707b743af}},
+    {{0x5538904c4750a99d,0x1b80a8682f33b948,0x4404b04168ce17d2,0x42659d40d3270f3a},{0x6750baf461600752,0xc474350e368ed175,0x6cde203d32e0ac3c,0x16ce2a475bd5a52d},{0x2ee569521c20fa07,0x86ee8bd3f6740d1c,0x86f850c3ce928aa7,0x55066e8d2d80de43}},
+    {{0x42f3323e7b9c269d,0x85b7f36212b9a6a7,0xbea2a0a241b2faa7,0x518b5023bf335cd9},{0xf0713889e8cab503,0x99c825002fe27519,0xe36cac2e1febfbbc,0x47c62feef0e230b6},{0x51fd38b15b00d1bc,0x4add1ef7fca8c71f,0xa0edfd046b24eaa8,0x60683c3e63bd7ff9}},
+    {{0xe53996c2846a0574,0x655d0b8909788b80,0x94d5d25807d7443c,0x00512861f11d9570},{0x589f621dd41d8fd8,0xf6dc8da3b4451e39,0x9caff06bd074a91d,0x1277ac6f337f3fd1},{0xdee6d666646682d4,0xa702a31c432267df,0xd5cf4041461e6f15,0x0d7683c6e01cd282}},
+    {{0x29a21334f8ebdfe0,0x6e5254ed6b3095f4,0x2cfa168a59b7a1be,0x638a96f588500c4a},{0x163c22d17e5d0176,0xaadcad32963345ba,0x55be7775c3e872eb,0x54300374a5e1d377},{0x5b7374cf693957a1,0x61bec674e0dbe564,0x70e089607dad6968,0x340db2ba2ea96ba4}},
+    {{0xd75fb4ffa8b7c8bf,0xe49acbfee153ca4e,0x1559ea1bf7de79ee,0x27292ced9b817042},{0x4d6306e805f3f6c7,0xb6094487472804f5,0x1f15990026da4971,0x329c9d10a90439c8},{0x58859805ce47a565,0x4fd5ab44eda69357,0x5cd6f3ab5f79a0e9,0x390a93b3622c522f}},
+    {{0xc29650a504820d54,0x3297c476121907f3,0xb0ff0eed1f310f1b,0x0a597ed6425c1356},{0x320beac3c00a848d,0x2cc3ccff063bce14,0x27d51dee372a61f1,0x4400ffc9e28e1c29},{0xc33c33e40b727304,0x5d8fe28ad28ebc29,0x83acc2ff1f19fdc5,0x34a1898faadc89b9}},
+    {{0x5519cdb3f141949e,0xce31bb8b7c9e5e31,0x332482c5deabf2d2,0x27619519526feddd},{0x536f52e0533be6d8,0x6309ee68ac98d44d,0x2e2cc1ed985cb879,0x6d8a6d74898df082},{0x0cd9afbb604976a8,0xe6707aa003b751e4,0x63ed1f889435dae3,0x040116617167a836}},
+    {{0xb815080d234ee25c,0x666bdae370ebcecc,0xb75b7c74afebe414,0x62772d2affd09470},{0xd900c4f4fc794eb8,0x9668338c81d478dd,0x97e09743195e7621,0x7e2d5cb6049e0b8d},{0x9f317116425389a7,0x6e1df3d288ef30d3,0x89aae133c149fed9,0x4ecf62ab8fb470a0}},
+    {{0xac6064bbcb80e261,0x3c8460d76216e276,0x04d8482d935c474f,0x12e8463c36dff92d},{0xd671c8736a531682,0xb7049a292c995a3b,0x5aeba1bbfef00fca,0x19d994c407845bf5},{0x1e896da604a9839c,0xf943bfed0ec0f427,0x1bdf9d8038b0edd3,0x570271f677c38571}},
+    {{0x2fa5dc5a6eecbe50,0xf264e2264b64bedb,0x0dd5a42f39881e6f,0x4fb180f4af23036e},{0x64b5a7a4e013d531,0x409f968474b983b8,0x33cca49b2edb29f9,0x30a43d672f7d1d43},{0x92b8abe1152a5ebf,0x502248a0c486e850,0x6a8b1ddea9e4763f,0x5354e47ac0f8b81c}},
+    {{0x19d290854a246e5d,0xb1eba00ab5c97066,0x70d85adb7d1b08eb,0x5b80e635e88839e1},{0x12648b301987243c,0x2bc96a89ba11cd68,0x6fa44d6fc57ee3d9,0x2a16b0718326290c},{0x1635176b03972c7f,0x615b5420602a6fe5,0x66dc9befee401045,0x0afcba6e89af5b18}},
+    {{0x33053ccd3bf9092f,0x0f6c5d6c5eaf2044,0xea6c3aab208c5185,0x0e8644d95fb23f6c},{0x5c1dc0e23dde23d2,0xc1cfc6d8a96eccf8,0xa86d12c4beaa6ce9,0x388a8e62af42cc80},{0xd3ade7a5f60f452b,0xf62a2716de998025,0xdca4e548530595e5,0x79f06033f05a1616}}
+};
+#elif defined(ED25519_64BIT)
 static const ge25519_niels ge25519_niels_sliding_multiples2[32] = {
     {{0x0007d60613037524,0x0006d61f784d4a6b,0x0007a642bb8842b7,0x0005fcd646854d91,0x00047204d08d72fd},{0x00042eb30d4b497f,0x0000d7379990e0e4,0x000045bd147be58c,0x0005821bca849a6c,0x00005468d6201405},{0x000565a9f93267de,0x0001b81ab1d1401e,0x0004638a3b3b3f5e,0x0001a9510af16e79,0x0004599ee919b633}},
     {{0x0003e91d6a54c980,0x0004bea21b31f482,0x00003d89195529dc,0x0002dfb56143562d,0x000105ba38985c82},{0x0007016a267dad09,0x00013456fa6c6691,0x00001c884cbd635b,0x0003284bbadd2ca7,0x000759d087ff9e6a},{0x000380dd9d8a5ddb,0x0003320b0498f7f5,0x0002ad92e05bbd89,0x0005fdb1ff38b519,0x0005461548ae00ae}},
@@ -227,193 +462,420 @@ static const ge25519_niels ge25519_niels_sliding_multiples2[32] = {
     {{0x000290854a246e5d,0x000156b92e0cc33a,0x00046c23aec7ae80,0x0004f0b86c2d6dbe,0x0005b80e635e8883},{0x00048b301987243c,0x0001374239ad024c,0x0005fb8f64af25aa,0x00048637d226b7e2,0x0002a16b07183262},{0x0005176b03972c7f,0x00040c054dfca2c6,0x0001004115856d50,0x00058c336e4df7f7,0x0000afcba6e89af5}},
     {{0x00053ccd3bf9092f,0x00058bd5e4088660,0x00023146143db175,0x0007b675361d5590,0x0000e8644d95fb23},{0x0005c0e23dde23d2,0x0003152dd99f0b83,0x0002a9b3a7073f1b,0x000640543689625f,0x000388a8e62af42c},{0x0005e7a5f60f452b,0x0002dbd33004ba75,0x0004165797d8a89c,0x00030b6e5272a429,0x00079f06033f05a1}}
 };
+#else
+static const ge25519_niels ALIGN(16) ge25519_niels_sliding_multiples2[32] = {
+    {{0x03037524,0x01f58184,0x004d4a6b,0x01b587de,0x038842b7,0x01e990ae,0x02854d91,0x017f3591,0x008d72fd,0x011c8134},{0x014b497f,0x010bacc3,0x0190e0e4,0x0035cde6,0x007be58c,0x00116f45,0x02849a6c,0x016086f2,0x02201405,0x00151a35},{0x013267de,0x01596a7e,0x01d1401e,0x006e06ac,0x033b3f5e,0x0118e28e,0x02f16e79,0x006a5442,0x0119b633,0x011667ba}},
+    {{0x0254c980,0x00fa475a,0x0331f482,0x012fa886,0x015529dc,0x000f6246,0x0143562d,0x00b7ed58,0x00985c82,0x00416e8e},{0x027dad09,0x01c05a89,0x026c6691,0x004d15be,0x00bd635b,0x00072213,0x02dd2ca7,0x00ca12ee,0x03ff9e6a,0x01d67421},{0x018a5ddb,0x00e03767,0x0098f7f5,0x00cc82c1,0x005bbd89,0x00ab64b8,0x0338b519,0x017f6c7f,0x00ae00ae,0x01518552}},
+    {{0x027493ab,0x01a77a54,0x029e9a6d,0x008e10ff,0x0378cd4b,0x0130750c,0x0256c8bb,0x01ef98f6,0x018a6961,0x0042fbc7},{0x03d18c38,0x001fd751,0x0348f0ef,0x01dec71e,0x014d51aa,0x01520543,0x03304c16,0x001c5518,0x011210d5,0x011dbf14},{0x02a1b8c1,0x0034a358,0x02d24c1d,0x01d358fc,0x0248d66b,0x0082b49e,0x0389b401,0x018fdd8e,0x01f1bbdd,0x017a7044}},
+    {{0x0251ecc4,0x00c5eaf1,0x02a572a5,0x0116d6e6,0x0338fff1,0x0122203e,0x007831b7,0x008831ae,0x03a04498,0x0084bfc7},{0x008d0c28,0x0042dd68,0x0308a51d,0x00947aef,0x03ae8118,0x0024b74b,0x009784d1,0x0116e6b3,0x01d18519,0x01226b5c},{0x0352209f,0x00655e67,0x03b3e0c7,0x00b3cf92,0x00f28aa1,0x0106f1e3,0x02068ade,0x00c9d0b2,0x001085ab,0x015f7d4f}},
+    {{0x0143df91,0x00becd0c,0x01386e75,0x00b8aaec,0x0396167c,0x00647255,0x024434a5,0x01fcae9f,0x037b8b9b,0x0149990b},{0x0035ea15,0x01dbc292,0x00e15f4e,0x00c727c9,0x011f49e9,0x0178e533,0x02ce5b71,0x005b8f3f,0x02da7418,0x00f3c3b1},{0x03d63436,0x0131ba88,0x030fb4be,0x00a8c0b9,0x01863e44,0x014f1074,0x01248a4f,0x000fe04a,0x01c1b001,0x013a6d6c}},
+    {{0x02792fdc,0x009eb294,0x03e14104,0x019dda2b,0x01c3e3dc,0x018f44b9,0x00ebff2b,0x01a4d584,0x037abe0f,0x01dde079},{0x02c284bf,0x00c1c8a4,0x0008ebf8,0x01e2ee01,0x03e88c02,0x01f47787,0x01afcb90,0x00f174b2,0x030acd57,0x015458bd},{0x016c8a2e,0x01b8a6d7,0x020b9bd2,0x01d2d649,0x026c1cdc,0x00d8e785,0x024700b5,0x00c312b4,0x02b2383a,0x00305595}},
+    {{0x0249bb66,0x0063cbb7,0x01e13ca7,0x002881ec,0x01b4baeb,0x019c466c,0x01974613,0x006fb54f,0x03f2d202,0x01584b9b},{0x02ab09b0,0x006b6e30,0x0352d5b5,0x01b5d55d,0x00c0619a,0x01e13d52,0x00cadfaa,0x015205d6,0x0221d62a,0x0169683e},{0x01379ca1,0x01ef9711,0x0105a3b2,0x01e919f1,0x02a786ab,0x00561d97,0x001a33ce,0x004ee028,0x039e6b60,0x005b15be}},
+    {{0x006365cd,0x00587a42,0x00f04deb,0x0060ac1f,0x02266aa3,0x01df0e9e,0x019e4a45,0x01ec0ce2,0x017a0c10,0x0090759a},{0x03be17be,0x009f98fc,0x03b88bec,0x01fbd2fc,0x0108b146,0x015e9fc9,0x01650016,0x00724477,0x03cab5b6,0x0183d147},{0x03efff7b,0x00533c69,0x01689ec3,0x000a6c6a,0x02e6335a,0x01eca363,0x0087d911,0x0002661a,0x0081a482,0x012f42e2}},
+    {{0x009a9164,0x01b7e911,0x012a0bdc,0x0047d430,0x033e5de4,0x010eeae1,0x0282b5bd,0x01960456,0x00f610b7,0x00e0b1e5},{0x03778df1,0x01a4c0e6,0x025af452,0x00b652f5,0x010a2bc7,0x00c26c15,0x030e667d,0x01eb78a6,0x01986fdc,0x0075acbe},{0x02263b59,0x019b7efc,0x03e1da13,0x01d6ba0f,0x033c7519,0x01d8c8e2,0x00ddc855,0x01c26628,0x00931987,0x00aa36fc}},
+    {{0x02f7433c,0x00f5a185,0x0027826d,0x00833153,0x007c1b0f,0x0134a4b2,0x014f2384,0x0199a627,0x01864502,0x013e7832},{0x03ea9a69,0x01e95262,0x0340e455,0x01e7d0e5,0x00789917,0x00282bea,0x00bcad90,0x01f99a94,0x01ff17c0,0x01648f41},{0x033f0ee9,0x01113495,0x02136632,0x0155e839,0x00cc81be,0x01d9c3e0,0x0014566a,0x00f7a954,0x01ad2613,0x013abc02}},
+    {{0x005f0eef,0x01c06c82,0x026d74d6,0x00131ffd,0x01bd857b,0x00562602,0x00929e1e,0x0072f6e5,0x0150d4e6,0x0189a817},{0x020e18c0,0x01f28dd0,0x001e1e5b,0x0141266d,0x020d56dd,0x00d2ed1a,0x0096fd4c,0x01c8d846,0x0275b9f5,0x016d0f98},{0x026fc24f,0x008f9cc3,0x0087e0ad,0x012008fd,0x014aad5d,0x016c28de,0x003ad5e9,0x003a6f95,0x01b8759b,0x01c4a23c}},
+    {{0x013e47b0,0x000e8b03,0x0012d3c6,0x0042e67e,0x000416e3,0x0051378d,0x032a1095,0x0171ddc8,0x024ba6bb,0x01bb05d9},{0x0292e387,0x00e97ae5,0x00b662c1,0x01664c48,0x037cb17f,0x0158c20e,0x01d5826a,0x014cdac4,0x0222b62e,0x00b24950},{0x011bef26,0x0181c81f,0x03f5a3da,0x005853c8,0x013b9092,0x0196bf95,0x037b44a5,0x017ca73d,0x03986acd,0x01c4ae38}},
+    {{0x00a711fc,0x014acf36,0x02394341,0x00b2f057,0x03ee5478,0x0140af42,0x012ad433,0x0022558d,0x024ae62f,0x00d5b767},{0x021b92db,0x00cb6c32,0x02c36995,0x005973f4,0x037c8ca5,0x00a5f9f2,0x02d89b2c,0x00ebd299,0x01c25672,0x018d215d},{0x03612f4f,0x009070bb,0x025e514e,0x00a8f063,0x000b723e,0x016e4ea4,0x02df8a59,0x00bfa038,0x02e418a4,0x01c492dc}},
+    {{0x028db2f7,0x0085fa64,0x03f07264,0x0074099b,0x015f17e8,0x00e356b7,0x00db3ab4,0x00405b19,0x02a1ddc4,0x01296d61},{0x03d2ccf4,0x01c4be1f,0x02a8edd6,0x0197cfaf,0x00f92012,0x011a2ca7,0x03a5c662,0x0070e21d,0x03701f30,0x01d280f9},{0x03f2d184,0x00cea98d,0x03292843,0x001c92cc,0x016cf338,0x01b34169,0x00b7e50b,0x01ae6d09,0x029a157c,0x0181f70b}},
+    {{0x00c4ee14,0x018f5df4,0x0088a371,0x011e0e4e,0x0057ab8b,0x012c49a1,0x03cae93a,0x008dae06,0x00113a97,0x00159287},{0x03d81be4,0x01967801,0x02fe1421,0x00ee5acb,0x02730d4a,0x00d34ee6,0x00351117,0x0186e35e,0x01336154,0x019bc15d},{0x0109d53e,0x00e2373c,0x02ada861,0x00556b52,0x0095d3ec,0x01f2f2bf,0x0192f17d,0x00d9b625,0x00ec385f,0x0045616b}},
+    {{0x00c044db,0x007c67de,0x026c7814,0x00da01aa,0x001a83d3,0x016aad14,0x007edd28,0x01fde3a8,0x01cc1554,0x00386700},{0x00ef9d4e,0x00b4079b,0x00615494,0x013e2460,0x03f73f64,0x0105bd5b,0x02795965,0x00b001f4,0x019a1cdb,0x00ccf08c},{0x03695126,0x008d6b8b,0x028ab7ce,0x00faf619,0x0238345f,0x01fa00e4,0x031c87c3,0x01e59b8f,0x00d428b0,0x01bb5f1b}},
+    {{0x0002991b,0x01f2abca,0x00a81f2c,0x00c9cd43,0x03a5f70b,0x012dd79e,0x02e93446,0x0157b747,0x023055f2,0x009d9dfe},{0x009b366e,0x00d7d87c,0x02a736a0,0x01a6843e,0x000c2897,0x012b11f1,0x00a16f0f,0x01b66787,0x00a68cd1,0x0169726f},{0x039ad766,0x016b66a2,0x01af9520,0x019fb18c,0x02827b19,0x016492a2,0x02a82c1d,0x00ca1f70,0x022e93a9,0x015f9d8f}},
+    {{0x014bc8ab,0x019102b7,0x0072544f,0x00ae4278,0x02101a9c,0x00d71514,0x014f6cc9,0x00f272c4,0x0163e30f,0x010f7198},{0x012eb4d0,0x00e7db58,0x00cda063,0x0103993d,0x003e38bf,0x01fade56,0x03e4cddf,0x01119fb4,0x00b9d9c5,0x005ac500},{0x00020b7c,0x0173c439,0x0394e10d,0x01eb797e,0x028e2b1e,0x0145b0bc,0x01c8e816,0x0072763f,0x00e08936,0x0165a201}},
+    {{0x0240f5a6,0x018f2fdb,0x032708b7,0x01cf2a02,0x00f20e76,0x00f880e8,0x022cc13f,0x00658fe8,0x019169e6,0x002e4d80},{0x02f60c17,0x01274c23,0x03834da1,0x00cb7a57,0x02291739,0x00662c2c,0x01fa5bdd,0x01ff6180,0x0268b5ba,0x01c96317},{0x01138d59,0x0054c73d,0x03297133,0x01841f0f,0x028f8bb9,0x009bf502,0x0160ca9b,0x0197d732,0x023351f2,0x01570752}},
+    {{0x0283fe1b,0x007c3636,0x00dad1bb,0x00b3f900,0x000a675d,0x00442339,0x02a0c0d2,0x01709ec9,0x01b6820f,0x014ed589},{0x022d20fa,0x015536cb,0x0037aae7,0x00b7fb7b,0x029adf02,0x00edb2bf,0x0113913d,0x00838c04,0x03583924,0x0035aa51},{0x031834f7,0x013a4c05,0x0294eac1,0x0181eda2,0x00aad80a,0x017382a0,0x02322dc5,0x0075e3d1,0x03707b74,0x018113eb}},
+    {{0x0350a99d,0x00241311,0x03290aa7,0x0141799d,0x006e02a1,0x00ce17d2,0x025820b4,0x01e74880,0x000d3270,0x01099675},{0x01600752,0x002ebd18,0x022eacea,0x0071b476,0x0311d0d4,0x00e0ac3c,0x03101e99,0x00a5ad9b,0x0075bd5a,0x005b38a9},{0x0020fa07,0x015a5487,0x01a385dc,0x009fb3a0,0x021bba2f,0x00928aa7,0x002861e7,0x01c870df,0x00d2d80d,0x015419ba}},
+    {{0x039c269d,0x00cc8f9e,0x00d4e85e,0x011095cd,0x0216dfcd,0x01b2faa7,0x01505120,0x019b37d4,0x023bf335,0x01462d40},{0x00cab503,0x004e227a,0x02a33e0e,0x00017f13,0x02672094,0x01ebfbbc,0x0256170f,0x0016dc6d,0x02ef0e23,0x011f18bf},{0x0300d1bc,0x014e2c56,0x00e3ea3f,0x01bfe546,0x012b747b,0x0124eaa8,0x02fe8235,0x01ff341d,0x03e63bd7,0x0181a0f0}},
+    {{0x006a0574,0x0065b0a1,0x01701ca7,0x00484bc4,0x0195742e,0x01d7443c,0x02e92c03,0x00ae129a,0x021f11d9,0x000144a1},{0x001d8fd8,0x01d88775,0x03c72b13,0x011da228,0x03db7236,0x0074a91d,0x03f835e8,0x01fa3395,0x02f337f3,0x0049deb1},{0x006682d4,0x01b59999,0x00fbfbdc,0x00e21913,0x029c0a8c,0x001e6f15,0x03a020a3,0x00505ab9,0x006e01cd,0x0035da0f}},
+    {{0x00ebdfe0,0x0084cd3e,0x02be8534,0x016b5984,0x01b94953,0x01b7a1be,0x010b452c,0x0189459f,0x03588500,0x018e2a5b},{0x025d0176,0x0108b45f,0x00b742c7,0x0194b19a,0x02ab72b4,0x01e872eb,0x033bbae1,0x006eeab7,0x034a5e1d,0x0150c00d},{0x013957a1,0x00dd33da,0x00ac8b6e,0x01a706df,0x0186fb19,0x01ad6968,0x0044b03e,0x01748e1c,0x03a2ea96,0x00d036ca}},
+    {{0x00b7c8bf,0x01ed3fea,0x0149daeb,0x01f70a9e,0x03926b2f,0x01de79ee,0x00f50dfb,0x000842ab,0x02d9b817,0x009ca4b3},{0x01f3f6c7,0x00c1ba01,0x009ea9ac,0x003a3940,0x02d82512,0x00da4971,0x02cc8013,0x013903e2,0x010a9043,0x00ca7274},{0x0247a565,0x01660173,0x026aeb10,0x00276d34,0x013f56ad,0x0179a0e9,0x0379d5af,0x0045eb9a,0x033622c5,0x00e42a4e}},
+    {{0x00820d54,0x01942941,0x00fe7852,0x01b090c8,0x00ca5f11,0x01310f1b,0x0387768f,0x006ad61f,0x016425c1,0x002965fb},{0x000a848d,0x00fab0f0,0x01c28641,0x01f831de,0x00b30f33,0x012a61f1,0x028ef71b,0x018524fa,0x009e28e1,0x011003ff},{0x03727304,0x010cf902,0x03853867,0x00569475,0x01763f8a,0x0119fdc5,0x02617f8f,0x01373075,0x00faadc8,0x00d28626}},
+    {{0x0141949e,0x00736cfc,0x03c62aa3,0x005be4f2,0x0338c6ee,0x00abf2d2,0x024162ef,0x01bba664,0x019526fe,0x009d8654},{0x033be6d8,0x01d4b814,0x0289aa6d,0x014564c6,0x018c27b9,0x005cb879,0x0260f6cc,0x001045c5,0x034898df,0x01b629b5},{0x004976a8,0x006beed8,0x023c819b,0x01001dba,0x0399c1ea,0x0035dae3,0x028fc44a,0x0106cc7d,0x0217167a,0x00100459}},
+    {{0x034ee25c,0x01420348,0x01d99702,0x011b875e,0x0199af6b,0x01ebe414,0x01be3a57,0x008e16eb,0x02affd09,0x0189dcb4},{0x00794eb8,0x00313d3f,0x031bbb20,0x00640ea3,0x0259a0ce,0x015e7621,0x004ba18c,0x0171b2fc,0x036049e0,0x01f8b572},{0x025389a7,0x005c4590,0x021a73e6,0x00944779,0x01b877cf,0x0149fed9,0x017099e0,0x00141135,0x02b8fb47,0x013b3d8a}},
+    {{0x0380e261,0x00192ef2,0x004ed58c,0x00bb10b7,0x00f21183,0x015c474f,0x002416c9,0x0125a09b,0x03c36dff,0x004ba118},{0x02531682,0x00721cda,0x03477ace,0x014964ca,0x02dc1268,0x00f00fca,0x01d0ddff,0x017eab5d,0x00407845,0x00676653},{0x00a9839c,0x005b6981,0x0284e3d1,0x01687607,0x03e50eff,0x00b0edd3,0x03cec01c,0x00ae237b,0x03677c38,0x015c09c7}},
+    {{0x02ecbe50,0x0177169b,0x03db65f4,0x01325b25,0x03c99388,0x01881e6f,0x02d2179c,0x006dc1ba,0x034af230,0x013ec603},{0x0013d531,0x0169e938,0x00770c96,0x0023a5cc,0x01027e5a,0x00db29f9,0x02524d97,0x01a86679,0x0272f7d1,0x00c290f5},{0x012a5ebf,0x002af845,0x010a1257,0x01062437,0x01408922,0x01e4763f,0x018eef54,0x01038d51,0x03ac0f8b,0x014d5391}},
+    {{0x02246e5d,0x00a42152,0x020cc33a,0x0055ae4b,0x02c7ae80,0x011b08eb,0x002d6dbe,0x013c2e1b,0x035e8883,0x016e0398},{0x0187243c,0x0122cc06,0x01ad024c,0x004dd08e,0x00af25aa,0x017ee3d9,0x0226b7e2,0x01218df4,0x03183262,0x00a85ac1},{0x03972c7f,0x0145dac0,0x01fca2c6,0x01030153,0x01856d50,0x00401045,0x024df7f7,0x01630cdb,0x02e89af5,0x002bf2e9}},
+    {{0x03f9092f,0x014f334e,0x00088660,0x0162f579,0x003db175,0x008c5185,0x021d5590,0x01ed9d4d,0x0195fb23,0x003a1913},{0x01de23d2,0x0170388f,0x019f0b83,0x00c54b76,0x03073f1b,0x00aa6ce9,0x0289625f,0x0190150d,0x022af42c,0x00e22a39},{0x020f452b,0x0179e97d,0x0004ba75,0x00b6f4cc,0x03d8a89c,0x010595e5,0x0272a429,0x00c2db94,0x033f05a1,0x01e7c180}}
+};
+#endif
 
 
-// /* computes [s1]p1 + [s2]p2 + [s3]basepoint */
-// static void 
-// ge25519_triple_scalarmult_vartime(ge25519 *r, const ge25519 *p1, const ge25519 *p2, const bignum256modm s1, const bignum256modm s2, const bignum256modm s3) {
-// 	signed char slide1[256], slide2[256], slide3[256];
-// 	ge25519_pniels pre1[S1_TABLE_SIZE], pre2[S1_TABLE_SIZE];
-// 	ge25519 d1, d2;
-// 	ge25519_p1p1 t;
-// 	int32_t i;
-
-// 	contract256_slidingwindow_modm(slide1, s1, S1_SWINDOWSIZE);
-// 	contract256_slidingwindow_modm(slide2, s2, S1_SWINDOWSIZE);
-// 	contract256_slidingwindow_modm(slide3, s3, S2_SWINDOWSIZE);
-    
-
-// 	ge25519_double(&d1, p1);
-// 	ge25519_full_to_pniels(pre1, p1);
-// 	ge25519_double(&d2, p2);
-// 	ge25519_full_to_pniels(pre2, p2);
-// 	for (i = 0; i < S1_TABLE_SIZE - 1; i++){
-// 		ge25519_pnielsadd(&pre1[i+1], &d1, &pre1[i]);
-// 		ge25519_pnielsadd(&pre2[i+1], &d2, &pre2[i]);
-//     }
-
-// 	/* set neutral */
-// 	memset(r, 0, sizeof(ge25519));
-// 	r->y[0] = 1;
-// 	r->z[0] = 1;
-
-// 	i = 255;
-// 	while ((i >= 0) && !(slide1[i] | slide2[i] | slide3[i]))
-// 		i--;
-
-// 	for (; i >= 0; i--) {
-// 		ge25519_double_p1p1(&t, r);
-// 		if (slide1[i]) {
-// 			ge25519_p1p1_to_full(r, &t);
-//             ge25519_pnielsadd_p1p1(&t, r, &pre1[abs(slide1[i]) / 2], (unsigned char)slide1[i] >> 7);
-// 		}
-
-// 		if (slide2[i]) {
-// 			ge25519_p1p1_to_full(r, &t);
-// 			ge25519_pnielsadd_p1p1(&t, r, &pre2[abs(slide2[i]) / 2], (unsigned char)slide2[i] >> 7);
-// 		}
-
-// 		if (slide3[i]) {
-// 			ge25519_p1p1_to_full(r, &t);
-// 			ge25519_nielsadd2_p1p1(&t, r, &ge25519_niels_sliding_multiples[abs(slide3[i]) / 2], (unsigned char)slide3[i] >> 7);
-// 		}
-
-// 		ge25519_p1p1_to_partial(r, &t);
-// 	}
-// }
+/*
+ * Window selection for the runtime streams. The half-size scalars are only
+ * ~127 bits long, so building the table is a much larger share of the cost
+ * than for donna's 253-bit scalars. A window w costs
+ *   table: (2^(w-2) - 1) pnielsadd, plus a doubling if w > 2
+ *   loop:  bl / (w + 1) additions on average for a bl-bit scalar
+ * and ge25519_straus_window[] holds the cheapest w per 8-bit bucket of bl,
+ * from the costs measured by ed25519_straus_calibrate().
+ */
+#include "ed25519-donna-straus-windows.h"
 
-/* computes [s1]p1 + [s2]p2 + [s3]basepoint + [s4 * 2^126] basepoint*/
-static void 
-ge25519_quadruple_scalarmult_vartime(ge25519 *r, const ge25519 *p1, const ge25519 *p2, const bignum256modm s1, const bignum256modm s2, const bignum256modm s3, const bignum256modm s4) {
-	signed char slide1[256], slide2[256], slide3[256], slide4[256];
-	ge25519_pniels pre1[S1_TABLE_SIZE], pre2[S1_TABLE_SIZE];
-	ge25519 d1, d2;
-	ge25519_p1p1 t;
-	int32_t i;
-
-	contract256_slidingwindow_modm(slide1, s1, S1_SWINDOWSIZE);
-	contract256_slidingwindow_modm(slide2, s2, S1_SWINDOWSIZE);
-	contract256_slidingwindow_modm(slide3, s3, S2_SWINDOWSIZE);
-	contract256_slidingwindow_modm(slide4, s4, S2_SWINDOWSIZE);
-    
-	ge25519_double(&d1, p1);
-	ge25519_full_to_pniels(pre1, p1);
-	ge25519_double(&d2, p2);
-	ge25519_full_to_pniels(pre2, p2);
-	for (i = 0; i < S1_TABLE_SIZE - 1; i++){
-		ge25519_pnielsadd(&pre1[i+1], &d1, &pre1[i]);
-		ge25519_pnielsadd(&pre2[i+1], &d2, &pre2[i]);
-    }
+/* largest window of a runtime stream, i.e. tables of up to 16 pniels */
+#define GE25519_STRAUS_MAX_WINDOW 6
+
+static int
+ge25519_straus_window_model(size_t bl, uint64_t table_cost, uint64_t add_cost) {
+	uint64_t cost, best_cost = (uint64_t)-1;
+	int w, best = 2;
+
+	for (w = 2; w <= GE25519_STRAUS_MAX_WINDOW; w++) {
+		cost = ((1 << (w - 2)) - 1 + (w > 2)) * table_cost + (bl * add_cost) / (w + 1);
+		if (cost < best_cost) {
+			best_cost = cost;
+			best = w;
+		}
+	}
+	return best;
+}
 
-	/* set neutral */
-	memset(r, 0, sizeof(ge25519));
-	r->y[0] = 1;
-	r->z[0] = 1;
+/* bit length of a reduced scalar */
+static DONNA_INLINE size_t
+bignum256modm_bitlength(const bignum256modm s) {
+	int i;
 
-	i = 255;
-	while ((i >= 0) && !(slide1[i] | slide2[i] | slide3[i] | slide4[i]))
-		i--;
+	for (i = bignum256modm_limb_size - 1; i >= 0; i--)
+		if (s[i])
+			return i * bignum256modm_bits_per_limb + 64 - __builtin_clzll(s[i]);
+	return 0;
+}
 
-	for (; i >= 0; i--) {
-		ge25519_double_p1p1(&t, r);
+static DONNA_INLINE int
+ge25519_straus_window_vartime(const bignum256modm s) {
+	return ge25519_straus_window[(bignum256modm_bitlength(s) + 7) >> 3];
+}
 
-		if (slide1[i]) {
-			ge25519_p1p1_to_full(r, &t);
-            ge25519_pnielsadd_p1p1(&t, r, &pre1[abs(slide1[i]) / 2], (unsigned char)slide1[i] >> 7);
-		}
+/*
+ * Split of the single verification: t (the A stream) gets bl_t bits and r
+ * (the R stream) about 253 - bl_t. The static base-point streams do not
+ * depend on the split, so the model only counts the doubling chain, set by
+ * the longest runtime stream, and the runtime tables and additions.
+ * -DED25519_HEEA_SPLIT=n forces bl_t = n; 0 lets the model pick it.
+ */
+#if !defined(ED25519_HEEA_SPLIT)
+	#define ED25519_HEEA_SPLIT 0
+#endif
+
+#define GE25519_SPLIT_MIN 112
+#define GE25519_SPLIT_MAX 142
+
+static uint64_t
+ge25519_split_cost_model(size_t bl_t, uint64_t table_cost, uint64_t add_cost, uint64_t dbl_cost) {
+	size_t bl[2] = {253 - bl_t, bl_t}, chain = 127;
+	uint64_t cost = 0;
+	int j, w;
+
+	for (j = 0; j < 2; j++) {
+		w = ge25519_straus_window_model(bl[j], table_cost, add_cost);
+		cost += ((1 << (w - 2)) - 1 + (w > 2)) * table_cost + (bl[j] * add_cost) / (w + 1);
+		if (bl[j] > chain)
+			chain = bl[j];
+	}
+	return cost + chain * dbl_cost;
+}
 
-		if (slide2[i]) {
-			ge25519_p1p1_to_full(r, &t);
-			ge25519_pnielsadd_p1p1(&t, r, &pre2[abs(slide2[i]) / 2], (unsigned char)slide2[i] >> 7);
+/* bit length of t picked by the model, computed once */
+static unsigned
+ge25519_split_vartime(void) {
+	static unsigned split = 0;
+	uint64_t cost, best_cost = (uint64_t)-1;
+	unsigned bl;
+
+	if (ED25519_HEEA_SPLIT)
+		return ED25519_HEEA_SPLIT;
+	if (split)
+		return split;
+	for (bl = GE25519_SPLIT_MIN; bl <= GE25519_SPLIT_MAX; bl++) {
+		cost = ge25519_split_cost_model(bl, GE25519_STRAUS_TABLE_COST, GE25519_STRAUS_ADD_COST, GE25519_STRAUS_DBL_COST);
+		if (cost < best_cost) {
+			best_cost = cost;
+			split = bl;
 		}
+	}
+	return split;
+}
 
-		if (slide3[i]) {
-			ge25519_p1p1_to_full(r, &t);
-			ge25519_nielsadd2_p1p1(&t, r, &ge25519_niels_sliding_multiples[abs(slide3[i]) / 2], (unsigned char)slide3[i] >> 7);
-		}
+/* out = 1/z for a public z, with EEA_q on the 4x64 representation */
+static void
+curve25519_recip_vartime(bignum25519 out, const bignum25519 z) {
+#if defined(ED25519_ADX)
+	/* already 4x64 words, only the full reduction is needed */
+	bignum25519 x;
+
+	curve25519_freeze(x, z);
+	inverse25519_EEA_vartime(out, x);
+#else
+	unsigned char b[32];
+	uint64_t x[4], y[4];
+	size_t i;
+
+	curve25519_contract(b, z);
+	for (i = 0; i < 4; i++)
+		x[i] = U8TO64_LE(b + 8 * i);
+	inverse25519_EEA_vartime(y, x);
+	for (i = 0; i < 4; i++)
+		U64TO8_LE(b + 8 * i, y[i]);
+	curve25519_expand(out, b);
+#endif
+}
+
+/* ge25519_pack for public points, with the vartime inversion */
+static void
+ge25519_pack_vartime(unsigned char r[32], const ge25519 *p) {
+	bignum25519 ALIGN(16) tx, ty, zi;
+	unsigned char parity[32];
+	curve25519_recip_vartime(zi, p->z);
+	curve25519_mul(tx, p->x, zi);
+	curve25519_mul(ty, p->y, zi);
+	curve25519_contract(r, ty);
+	curve25519_contract(parity, tx);
+	r[31] ^= ((parity[0] & 1) << 7);
+}
+
+/*
+ * Normalizes n pniels to affine niels with a single inversion (Montgomery's
+ * trick): 3(n - 1) multiplications for the inverses, 3 per entry to scale.
+ */
+static void
+ge25519_pniels_to_niels_batch_vartime(ge25519_niels *out, const ge25519_pniels *in, size_t n) {
+	bignum25519 ALIGN(16) acc[n], inv;
+	size_t i;
+
+	curve25519_copy(acc[0], in[0].z);
+	for (i = 1; i < n; i++)
+		curve25519_mul(acc[i], acc[i-1], in[i].z);
+
+	curve25519_recip_vartime(inv, acc[n-1]);
+
+	/* acc[i] <- 1/z_i */
+	for (i = n - 1; i > 0; i--) {
+		curve25519_mul(acc[i], inv, acc[i-1]);
+		curve25519_mul(inv, inv, in[i].z);
+	}
+	curve25519_copy(acc[0], inv);
+
+	for (i = 0; i < n; i++) {
+		curve25519_mul(out[i].ysubx, in[i].ysubx, acc[i]);
+		curve25519_mul(out[i].xaddy, in[i].xaddy, acc[i]);
+		curve25519_mul(out[i].t2d, in[i].t2d, acc[i]);
+	}
+}
+
+/*
+ * Interleaved (Straus) multi-scalar multiplication with sliding windows.
+ *
+ * DEF_GE25519_STRAUS_VARTIME(name, npniels, nniels, wmax) generates
+ *   name(r, p, ps, pw, nt, ns, nw, nneg):
+ *   r = sum([ps[j]]p[j]) + sum([+-ns[j]]T[j])
+ * with npniels runtime streams, whose tables of odd multiples of p[j] are
+ * built in pniels form with window pw[j] <= wmax, and nniels streams over
+ * static niels tables nt[j] of window nw[j], negated where nneg[j] is set
+ * (nneg may be NULL). All streams share a single
+ * doubling chain. The stream counts and the table storage are fixed per
+ * instance; the generated function is forced inline, so callers passing
+ * constant windows and tables get a fully specialized loop.
+ *
+ * The runtime tables are packed one after the other. They stay in pniels
+ * form: normalizing them to affine niels costs an inversion plus ~6
+ * multiplications per entry, and saves one multiplication per addition,
+ * which none of the shapes below has enough additions to recover.
+ */
+#define DEF_GE25519_STRAUS_VARTIME(name, npniels, nniels, wmax) \
+static DONNA_INLINE void \
+name(ge25519 *r, const ge25519 *const *p, const bignum256modm_element_t *const *ps, const int *pw, \
+	const ge25519_niels *const *nt, const bignum256modm_element_t *const *ns, const int *nw, const int *nneg) { \
+	signed char pslide[npniels][256], nslide[nniels][256]; \
+	ge25519_pniels ALIGN(16) pre[(npniels) << ((wmax) - 2)]; \
+	size_t off[npniels]; \
+	ge25519 ALIGN(16) d; \
+	ge25519_p1p1 ALIGN(16) t; \
+	signed char any; \
+	size_t j, entries = 0; \
+	int32_t i; \
+ \
+	for (j = 0; j < (nniels); j++) { \
+		contract256_slidingwindow_modm(nslide[j], ns[j], nw[j]); \
+		if (nneg && nneg[j]) \
+			for (i = 0; i < 256; i++) \
+				nslide[j][i] = -nslide[j][i]; \
+	} \
+ \
+	for (j = 0; j < (npniels); j++) { \
+		contract256_slidingwindow_modm(pslide[j], ps[j], pw[j]); \
+		off[j] = entries; \
+		ge25519_full_to_pniels(&pre[entries], p[j]); \
+		if (pw[j] > 2) \
+			ge25519_double(&d, p[j]); \
+		for (i = 0; i < (1 << (pw[j] - 2)) - 1; i++) \
+			ge25519_pnielsadd(&pre[entries+i+1], &d, &pre[entries+i]); \
+		entries += (size_t)1 << (pw[j] - 2); \
+	} \
+ \
+	/* set neutral */ \
+	memset(r, 0, sizeof(ge25519)); \
+	r->y[0] = 1; \
+	r->z[0] = 1; \
+ \
+	/* start at the highest non-zero digit of all streams */ \
+	for (i = 255; i >= 0; i--) { \
+		any = 0; \
+		for (j = 0; j < (npniels); j++) \
+			any |= pslide[j][i]; \
+		for (j = 0; j < (nniels); j++) \
+			any |= nslide[j][i]; \
+		if (any) \
+			break; \
+	} \
+ \
+	for (; i >= 0; i--) { \
+		ge25519_double_p1p1(&t, r); \
+ \
+		for (j = 0; j < (npniels); j++) { \
+			if (pslide[j][i]) { \
+				ge25519_p1p1_to_full(r, &t); \
+				ge25519_pnielsadd_p1p1(&t, r, &pre[off[j] + abs(pslide[j][i]) / 2], (unsigned char)pslide[j][i] >> 7); \
+			} \
+		} \
+ \
+		for (j = 0; j < (nniels); j++) { \
+			if (nslide[j][i]) { \
+				ge25519_p1p1_to_full(r, &t); \
+				ge25519_nielsadd2_p1p1(&t, r, &nt[j][abs(nslide[j][i]) / 2], (unsigned char)nslide[j][i] >> 7); \
+			} \
+		} \
+ \
+		ge25519_p1p1_to_partial(r, &t); \
+	} \
+}
 
-		if (slide4[i]) {
-			ge25519_p1p1_to_full(r, &t);
-			ge25519_nielsadd2_p1p1(&t, r, &ge25519_niels_sliding_multiples2[abs(slide4[i]) / 2], (unsigned char)slide4[i] >> 7);
+/* shapes used by the verifiers: runtime streams x static streams */
+DEF_GE25519_STRAUS_VARTIME(ge25519_straus_1x3_vartime, 1, 3, GE25519_STRAUS_MAX_WINDOW)
+DEF_GE25519_STRAUS_VARTIME(ge25519_straus_2x2_vartime, 2, 2, GE25519_STRAUS_MAX_WINDOW)
+DEF_GE25519_STRAUS_VARTIME(ge25519_straus_3x1_vartime, 3, 1, GE25519_STRAUS_MAX_WINDOW)
+DEF_GE25519_STRAUS_VARTIME(ge25519_straus_4x2_vartime, 4, 2, GE25519_STRAUS_MAX_WINDOW)
+DEF_GE25519_STRAUS_VARTIME(ge25519_straus_6x2_vartime, 6, 2, GE25519_STRAUS_MAX_WINDOW)
+
+/* static streams over the basepoint: [s]basepoint and [s * 2^126] basepoint */
+static const ge25519_niels *const ge25519_straus_base_tables[2] = {ge25519_niels_sliding_multiples, ge25519_niels_sliding_multiples2};
+static const int ge25519_straus_base_windows[2] = {S2_SWINDOWSIZE, S2_SWINDOWSIZE};
+
+/*
+ * Measures the cost of a table entry, of a loop addition and of a doubling
+ * with the given cycle counter, and fills window[] (33 entries) from the
+ * cost model.
+ */
+void
+ED25519_FN(ed25519_straus_calibrate) (uint64_t (*ticks)(void), uint64_t *table_cost, uint64_t *add_cost, uint64_t *dbl_cost, unsigned char *window) {
+	ge25519_pniels ALIGN(16) pre[2];
+	ge25519 ALIGN(16) r;
+	ge25519_p1p1 ALIGN(16) t;
+	uint64_t t_begin, t_table = (uint64_t)-1, t_add = (uint64_t)-1, t_dbl = (uint64_t)-1, e;
+	size_t i, j;
+
+	ge25519_full_to_pniels(&pre[0], &ge25519_basepoint);
+	r = ge25519_basepoint;
+	for (j = 0; j < 64; j++) {
+		t_begin = ticks();
+		for (i = 0; i < 64; i++)
+			ge25519_pnielsadd(&pre[(i + 1) & 1], &r, &pre[i & 1]);
+		e = ticks() - t_begin;
+		if (e < t_table)
+			t_table = e;
+
+		t_begin = ticks();
+		for (i = 0; i < 64; i++) {
+			ge25519_pnielsadd_p1p1(&t, &r, &pre[i & 1], (unsigned char)i & 1);
+			ge25519_p1p1_to_full(&r, &t);
+		}
+		e = ticks() - t_begin;
+		if (e < t_add)
+			t_add = e;
+
+		t_begin = ticks();
+		for (i = 0; i < 64; i++) {
+			ge25519_double_p1p1(&t, &r);
+			ge25519_p1p1_to_partial(&r, &t);
 		}
+		e = ticks() - t_begin;
+		if (e < t_dbl)
+			t_dbl = e;
+	}
+
+	*table_cost = (t_table + 32) / 64;
+	*add_cost = (t_add + 32) / 64;
+	*dbl_cost = (t_dbl + 32) / 64;
+	for (i = 0; i <= 32; i++)
+		window[i] = (unsigned char)ge25519_straus_window_model(8 * i, *table_cost, *add_cost);
+}
 
-		ge25519_p1p1_to_partial(r, &t);
+/* computes [s1]p1 + [s2]p2 + [s3]basepoint + [s4 * 2^126] basepoint*/
+static void 
+ge25519_quadruple_scalarmult_vartime(ge25519 *r, const ge25519 *p1, const ge25519 *p2, const bignum256modm s1, const bignum256modm s2, const bignum256modm s3, const bignum256modm s4) {
+	const ge25519 *p[2] = {p1, p2};
+	const bignum256modm_element_t *ps[2] = {s1, s2}, *ns[2] = {s3, s4};
+	int pw[2];
+
+	pw[0] = ge25519_straus_window_vartime(s1);
+	pw[1] = ge25519_straus_window_vartime(s2);
+	ge25519_straus_2x2_vartime(r, p, ps, pw, ge25519_straus_base_tables, ns, ge25519_straus_base_windows, NULL);
+}
+
+/* maximum number of runtime points in ge25519_joint_scalarmult_vartime */
+#define joint_max_points 6
+
+/* computes sum([s[i]]p[i]) + [s1]basepoint + [s2 * 2^126] basepoint, count is 4 or joint_max_points */
+static void
+ge25519_joint_scalarmult_vartime(ge25519 *r, const ge25519 *p, const bignum256modm *s, size_t count, const bignum256modm s1, const bignum256modm s2) {
+	const ge25519 *pp[joint_max_points];
+	const bignum256modm_element_t *ps[joint_max_points], *ns[2] = {s1, s2};
+	int pw[joint_max_points];
+	size_t j;
+
+	for (j = 0; j < count; j++) {
+		pp[j] = &p[j];
+		ps[j] = s[j];
+		pw[j] = ge25519_straus_window_vartime(s[j]);
 	}
+
+	if (count == 4)
+		ge25519_straus_4x2_vartime(r, pp, ps, pw, ge25519_straus_base_tables, ns, ge25519_straus_base_windows, NULL);
+	else
+		ge25519_straus_6x2_vartime(r, pp, ps, pw, ge25519_straus_base_tables, ns, ge25519_straus_base_windows, NULL);
 }
 
 /* B_par = [2^126] basepoint */
+#if defined(ED25519_ADX)
+static const ge25519 ge25519_B_par = {
+    {0x59e22c567d23ea24,0x1e745a880460850e,0x4583ff4cda13ef4b,0x1f13202c95083f85},
+    {0xad42025c90275f48,0x0085087eb55c4778,0xf21109e7fdfd7ffa,0x66336d356c381b7e},
+    {0x0000000000000001,0x0000000000000000,0x0000000000000000,0x0000000000000000},
+    {0x41a98564b1c35b4d,0x454d90ff21b5df6c,0x300d4234cc094ed1,0x58f25481ba473785}
+	};
+#elif defined(ED25519_64BIT)
 static const ge25519 ge25519_B_par = {
     {0x00022c567d23ea24,0x0001008c10a1cb3c,0x00004fbd2c79d16a,0x0007c2a2c1ffa66d,0x0001f13202c95083},
     {0x0002025c90275f48,0x0007d6ab88ef15a8,0x0007f5ffe8021421,0x0005bf790884f3fe,0x00066336d356c381},
     {0x0000000000000001,0x0000000000000000,0x0000000000000000,0x0000000000000000,0x0000000000000000},
     {0x00018564b1c35b4d,0x0007e436bbed8835,0x0000253b45153643,0x0003c29806a11a66,0x00058f25481ba473}
 	};
+#else
+static const ge25519 ALIGN(16) ge25519_B_par = {
+    {0x0123ea24,0x008b159f,0x00a1cb3c,0x00402304,0x0079d16a,0x0013ef4b,0x01ffa66d,0x01f0a8b0,0x02c95083,0x007c4c80},
+    {0x00275f48,0x00809724,0x00ef15a8,0x01f5aae2,0x00021421,0x01fd7ffa,0x0084f3fe,0x016fde42,0x0356c381,0x0198cdb4},
+    {0x00000001,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000},
+    {0x01c35b4d,0x0061592c,0x03ed8835,0x01f90dae,0x01153643,0x00094ed1,0x02a11a66,0x00f0a601,0x001ba473,0x0163c952}
+	};
+#endif
 	
-/* computes [s1]p1 + [s2]p2 + [s3]basepoint + [s4 * 2^126] basepoint*/
+/* computes [s1]p1 + [s2]p2 + [s3]basepoint + [s4 * 2^126] basepoint, with [2^126] basepoint as a runtime table */
 static void 
 ge25519_quadruple_scalarmult_samePre_vartime(ge25519 *r, const ge25519 *p1, const ge25519 *p2, const bignum256modm s1, const bignum256modm s2, const bignum256modm s3, const bignum256modm s4) {
-	signed char slide1[256], slide2[256], slide3[256], slide4[256];
-	ge25519_pniels pre1[S1_TABLE_SIZE], pre2[S1_TABLE_SIZE], pre4[S1_TABLE_SIZE];
-	ge25519 d1, d2, d4;
-	ge25519_p1p1 t;
-	int32_t i;
-
-	contract256_slidingwindow_modm(slide1, s1, S1_SWINDOWSIZE);
-	contract256_slidingwindow_modm(slide2, s2, S1_SWINDOWSIZE);
-	contract256_slidingwindow_modm(slide3, s3, S2_SWINDOWSIZE);
-	contract256_slidingwindow_modm(slide4, s4, S1_SWINDOWSIZE);
-    
-	ge25519_double(&d1, p1);
-	ge25519_full_to_pniels(pre1, p1);
-	ge25519_double(&d2, p2);
-	ge25519_full_to_pniels(pre2, p2);
-	ge25519_double(&d4, &ge25519_B_par);
-	ge25519_full_to_pniels(pre4, &ge25519_B_par);
-
-
-
-	for (i = 0; i < S1_TABLE_SIZE - 1; i++){
-		ge25519_pnielsadd(&pre1[i+1], &d1, &pre1[i]);
-		ge25519_pnielsadd(&pre2[i+1], &d2, &pre2[i]);
-		ge25519_pnielsadd(&pre4[i+1], &d4, &pre4[i]);
-    }
-
-	/* set neutral */
-	memset(r, 0, sizeof(ge25519));
-	r->y[0] = 1;
-	r->z[0] = 1;
-
-	i = 255;
-	while ((i >= 0) && !(slide1[i] | slide2[i] | slide3[i] | slide4[i]))
-		i--;
-
-	for (; i >= 0; i--) {
-		ge25519_double_p1p1(&t, r);
-
-		if (slide1[i]) {
-			ge25519_p1p1_to_full(r, &t);
-            ge25519_pnielsadd_p1p1(&t, r, &pre1[abs(slide1[i]) / 2], (unsigned char)slide1[i] >> 7);
-		}
-
-		if (slide2[i]) {
-			ge25519_p1p1_to_full(r, &t);
-			ge25519_pnielsadd_p1p1(&t, r, &pre2[abs(slide2[i]) / 2], (unsigned char)slide2[i] >> 7);
-		}
-
-		if (slide3[i]) {
-			ge25519_p1p1_to_full(r, &t);
-			ge25519_nielsadd2_p1p1(&t, r, &ge25519_niels_sliding_multiples[abs(slide3[i]) / 2], (unsigned char)slide3[i] >> 7);
-		}
-
-		// if (slide4[i]) {
-		// 	ge25519_p1p1_to_full(r, &t);
-		// 	ge25519_nielsadd2_p1p1(&t, r, &ge25519_niels_sliding_multiples2[abs(slide4[i]) / 2], (unsigned char)slide4[i] >> 7);
-		// }
-		if (slide4[i]) {
-			ge25519_p1p1_to_full(r, &t);
-			ge25519_pnielsadd_p1p1(&t, r, &pre4[abs(slide4[i]) / 2], (unsigned char)slide4[i] >> 7);
-		}
-
-		ge25519_p1p1_to_partial(r, &t);
-	}
+	const ge25519 *p[3] = {p1, p2, &ge25519_B_par};
+	const bignum256modm_element_t *ps[3] = {s1, s2, s4}, *ns[1] = {s3};
+	int pw[3];
+
+	pw[0] = ge25519_straus_window_vartime(s1);
+	pw[1] = ge25519_straus_window_vartime(s2);
+	pw[2] = ge25519_straus_window_vartime(s4);
+	ge25519_straus_3x1_vartime(r, p, ps, pw, ge25519_straus_base_tables, ns, ge25519_straus_base_windows, NULL);
 }
\ No newline at end of file
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2024 xxxxxxxxxx (xxxxx@xxxxx). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following disclaimer
+ *    in the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Google Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * curve25519_hEEA_vartime on 32-bit words, for 32-bit targets: the same
+ * reduction, step for step, but on 8-word r and 4-word t, with the carries
+ * in 64-bit accumulators instead of the 64-bit add/sub-with-carry
+ * intrinsics. r shrinks by one word whenever both rows fit in fewer words.
+ */
+
+#include "curve25519_hEEA32_vartime.h"
+
+#define UNLIKELY(cond)  __builtin_expect ((cond) != 0, 0)
+
+
+/* a -= lshift(b, s), on n words; truncation happens if the result does not fit */
+static void
+sub_lshift32(uint32_t *a, const uint32_t *b, size_t n, unsigned s)
+{
+	size_t i, k = s >> 5;
+	uint32_t w, e = 0, borrow = 0;
+	uint64_t d;
+
+	s &= 31;
+	for (i = k; i < n; i ++) {
+		w = b[i - k];
+		d = (uint64_t)a[i] - ((w << s) | e) - borrow;
+		e = s ? w >> (32 - s) : 0;
+		a[i] = (uint32_t)d;
+		borrow = (uint32_t)(d >> 63);
+	}
+}
+
+/* a += lshift(b, s), on n words; truncation happens if the result does not fit */
+static void
+add_lshift32(uint32_t *a, const uint32_t *b, size_t n, unsigned s)
+{
+	size_t i, k = s >> 5;
+	uint32_t w, e = 0, carry = 0;
+	uint64_t d;
+
+	s &= 31;
+	for (i = k; i < n; i ++) {
+		w = b[i - k];
+		d = (uint64_t)a[i] + ((w << s) | e) + carry;
+		e = s ? w >> (32 - s) : 0;
+		a[i] = (uint32_t)d;
+		carry = (uint32_t)(d >> 32);
+	}
+}
+
+/* bit length of |a| (of ~a if a < 0), a signed n-word integer */
+static unsigned
+bitlength32(const uint32_t *a, size_t n)
+{
+	uint32_t mask = (uint32_t)0 - (a[n - 1] >> 31);
+
+	while (n > 0 && (a[n - 1] ^ mask) == 0)
+		n --;
+	if (n == 0)
+		return 0;
+	return (unsigned)(n << 5) - (unsigned)__builtin_clz(a[n - 1] ^ mask);
+}
+
+/*
+ * return c0 and c1 s.t. c1 * v = c0 mod el
+ * v on 8 words, c0 and c1 signed on 4 words
+ */
+void
+curve25519_hEEA32_vartime(
+	uint32_t *c0, uint32_t *c1, const uint32_t *v)
+{
+	/*
+	el = 2**252+27742317777372353535851937790883648493
+	   = 0x1000000000000000000000000000000014def9dea2f79cd65812631a5cf5d3ed
+	253 = el.bit_length()
+	*/
+	static const uint32_t L[8] = {
+		0x5cf5d3ed, 0x5812631a, 0xa2f79cd6, 0x14def9de,
+		0x00000000, 0x00000000, 0x00000000, 0x10000000
+	};
+	uint32_t rows_r[3][8], rows_t[3][4];
+	uint32_t *r2 = rows_r[0], *r1 = rows_r[1], *r = rows_r[2], *p;
+	uint32_t *t2 = rows_t[0], *t1 = rows_t[1], *t = rows_t[2];
+	unsigned bl_r2, bl_r1, bl_r, s;
+	size_t n = 8;
+
+	/* see curve25519_hEEA_vartime for the algorithm */
+	memcpy(r2, L, sizeof L);
+	memcpy(r1, v, 8 * sizeof v[0]);
+	memset(t2, 0, 4 * sizeof t2[0]);
+	memset(t1, 0, 4 * sizeof t1[0]);
+	t1[0] = 1;
+
+	bl_r2 = 253;
+	bl_r1 = bitlength32(r1, n);
+
+	for (;;) {
+		/*
+		 * Both rows fit in n - 1 words once bl_r2 < 32 * (n - 1). As
+		 * curve25519_hEEA_vartime, only stop once r2 is below 192 bits.
+		 */
+		while (bl_r2 < 32 * (n - 1))
+			n --;
+		if (UNLIKELY(n <= 6 && bl_r1 <= 127))
+			break;
+
+		s = bl_r2 - bl_r1;
+		memcpy(r, r2, n * sizeof r[0]);
+		memcpy(t, t2, 4 * sizeof t[0]);
+		if ((r2[n - 1] >> 31) == (r1[n - 1] >> 31)) {
+			sub_lshift32(r, r1, n, s);
+			sub_lshift32(t, t1, 4, s);
+		} else {
+			add_lshift32(r, r1, n, s);
+			add_lshift32(t, t1, 4, s);
+		}
+
+		bl_r = bitlength32(r, n);
+		if (UNLIKELY(bl_r > bl_r1)) {
+			p = r2; r2 = r; r = p;
+			p = t2; t2 = t; t = p;
+			bl_r2 = bl_r;
+		} else {
+			p = r2; r2 = r1; r1 = r; r = p;
+			p = t2; t2 = t1; t1 = t; t = p;
+			bl_r2 = bl_r1;
+			bl_r1 = bl_r;
+		}
+	}
+
+	memcpy(c0, r1, 4 * sizeof c0[0]);
+	memcpy(c1, t1, 4 * sizeof c1[0]);
+}
@@ -0,0 +1,5 @@
+#include <stdint.h>
+#include <string.h>
+
+void curve25519_hEEA32_vartime(
+	uint32_t *, uint32_t *, const uint32_t *);
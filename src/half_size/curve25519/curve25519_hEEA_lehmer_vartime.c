@@ -0,0 +1,414 @@
+/*
+ * Copyright (c) 2024 xxxxxxxxxx (xxxxx@xxxxx). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following disclaimer
+ *    in the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Google Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Lehmer-style variant of curve25519_hEEA_vartime: the approximate-quotient
+ * steps run on 128-bit leading-word approximations of r2 and r1, the
+ * transition matrix is accumulated in 64-bit words, and it is applied to
+ * the multiprecision r and t only once per inner run.
+ */
+
+#include <assert.h>
+#include "curve25519_hEEA_lehmer_vartime.h"
+
+/*
+ * We use the intrinsic functions (see portable_intrinsics.h):
+ *   lzcnt_u64(), addcarry_u64(), subborrow_u64(), muladd_u64().
+ */
+#include "../../portable_intrinsics.h"
+
+#define UNLIKELY(cond)  __builtin_expect ((cond) != 0, 0)
+
+/* default output bit length of r1 (and roughly of t1) */
+#define HEEA_TARGET 127
+
+/*
+ * The inner loop stops GUARD bits above the target, so that the last
+ * steps, which decide where the reduction stops, are exact.
+ */
+#define HEEA_LEHMER_GUARD 8
+
+/*
+ * Bits of precision kept between the approximations and their error
+ * bound; below this, the inner loop stops and the matrix is applied.
+ */
+#define HEEA_LEHMER_MARGIN 32
+
+
+/* a <- a -/+ lshift(b, s) over 4 limbs, with truncation */
+DEF_OP_LSHIFT(add_lshift_4, addcarry_u64, 4)
+DEF_OP_LSHIFT(sub_lshift_4, subborrow_u64, 4)
+
+/*
+ * Bit length of a signed 4-limb value, with the convention of BITLENGTH
+ * in curve25519_hEEA_vartime.c (one's complement for negative values).
+ */
+static inline unsigned
+bitlength_4(const uint64_t *a)
+{
+	unsigned long long mask = -(a[3] >> 63);
+
+	if (a[3] ^ mask)
+		return 256 - (unsigned)lzcnt_u64(a[3] ^ mask);
+	if (a[2] ^ mask)
+		return 192 - (unsigned)lzcnt_u64(a[2] ^ mask);
+	if (a[1] ^ mask)
+		return 128 - (unsigned)lzcnt_u64(a[1] ^ mask);
+	return 64 - (unsigned)lzcnt_u64(a[0] ^ mask);
+}
+
+#if defined(__SIZEOF_INT128__)
+
+/* same convention, for a signed 128-bit value */
+static inline unsigned
+bitlength_128(__int128 a)
+{
+	unsigned __int128 w = (unsigned __int128)(a ^ (a >> 127));
+	uint64_t hi = (uint64_t)(w >> 64);
+
+	if (hi)
+		return 128 - (unsigned)lzcnt_u64(hi);
+	return 64 - (unsigned)lzcnt_u64((uint64_t)w);
+}
+
+/* same convention, for |u| | |v| of two signed 64-bit values */
+static inline unsigned
+bitlength_pair(int64_t u, int64_t v)
+{
+	return 64 - (unsigned)lzcnt_u64((uint64_t)(u ^ (u >> 63)) | (uint64_t)(v ^ (v >> 63)));
+}
+
+/* bits [k, k + 128) of a signed 4-limb value, for k <= 128 */
+static inline __int128
+extract_128(const uint64_t *a, unsigned k)
+{
+	unsigned i = k >> 6, s = k & 63;
+	unsigned __int128 lo, hi;
+
+	lo = (unsigned __int128)a[i] | ((unsigned __int128)a[i + 1] << 64);
+	if (s == 0)
+		return (__int128)lo;
+	hi = (i + 2 < 4) ? a[i + 2] : (uint64_t)-(a[3] >> 63);
+	return (__int128)((lo >> s) | ((unsigned __int128)hi << (128 - s)));
+}
+
+#endif
+
+/* d = u * a over n limbs (mod 2^(64 n)), u signed */
+static inline void
+mul_nx1(uint64_t *d, const uint64_t *a, int64_t u, int n)
+{
+	uint64_t m = (u < 0) ? -(uint64_t)u : (uint64_t)u, c = 0;
+	unsigned char cc;
+	int i;
+
+	for (i = 0; i < n; i ++)
+		d[i] = muladd_u64(a[i], m, c, 0, &c);
+	if (u < 0) {
+		cc = 0;
+		for (i = 0; i < n; i ++)
+			cc = subborrow_u64(cc, 0, d[i], (unsigned long long *)&d[i]);
+	}
+}
+
+/*
+ * (r2, r1) <- (u2 * r2 + v2 * r1, u1 * r2 + v1 * r1), same for t.
+ * The new values are not longer than the old ones, so once r2 fits in
+ * 3 limbs the products are computed on 3 limbs and the top limb is only
+ * sign-extended (the shrink stage of hEEA_q). t is kept on 3 limbs, which
+ * is enough for any target split.
+ */
+static inline void
+apply_matrix(uint64_t *r2, uint64_t *r1, uint64_t *t2, uint64_t *t1,
+	const int64_t *m, int n)
+{
+	uint64_t a[4], b[4], c[4], d[4];
+	unsigned char cc;
+	int i;
+
+	mul_nx1(a, r2, m[0], n);
+	mul_nx1(b, r1, m[1], n);
+	mul_nx1(c, r2, m[2], n);
+	mul_nx1(d, r1, m[3], n);
+	cc = 0;
+	for (i = 0; i < n; i ++)
+		cc = addcarry_u64(cc, a[i], b[i], (unsigned long long *)&r2[i]);
+	cc = 0;
+	for (i = 0; i < n; i ++)
+		cc = addcarry_u64(cc, c[i], d[i], (unsigned long long *)&r1[i]);
+	if (n == 3) {
+		r2[3] = -(r2[2] >> 63);
+		r1[3] = -(r1[2] >> 63);
+	}
+
+	mul_nx1(a, t2, m[0], 3);
+	mul_nx1(b, t1, m[1], 3);
+	mul_nx1(c, t2, m[2], 3);
+	mul_nx1(d, t1, m[3], 3);
+	cc = 0;
+	for (i = 0; i < 3; i ++)
+		cc = addcarry_u64(cc, a[i], b[i], (unsigned long long *)&t2[i]);
+	cc = 0;
+	for (i = 0; i < 3; i ++)
+		cc = addcarry_u64(cc, c[i], d[i], (unsigned long long *)&t1[i]);
+	t2[3] = -(t2[2] >> 63);
+	t1[3] = -(t1[2] >> 63);
+}
+
+/* one exact step of hEEA_q on the 4-limb state */
+static inline void
+exact_step(uint64_t *r2, uint64_t *r1, uint64_t *t2, uint64_t *t1,
+	unsigned *bl_r2, unsigned *bl_r1)
+{
+	uint64_t r[4], t[4];
+	unsigned s, bl_r;
+	int sub;
+
+	s = *bl_r2 - *bl_r1;
+	sub = (r2[3] >> 63) == (r1[3] >> 63);
+	memcpy(r, r2, sizeof r);
+	memcpy(t, t2, sizeof t);
+	if (sub) {
+		sub_lshift_4(r, r1, s);
+		sub_lshift_4(t, t1, s);
+	} else {
+		add_lshift_4(r, r1, s);
+		add_lshift_4(t, t1, s);
+	}
+
+	bl_r = bitlength_4(r);
+	if (bl_r > *bl_r1) {
+		memcpy(r2, r, sizeof r);
+		memcpy(t2, t, sizeof t);
+		*bl_r2 = bl_r;
+	} else {
+		memcpy(r2, r1, sizeof r);
+		memcpy(r1, r, sizeof r);
+		memcpy(t2, t1, sizeof t);
+		memcpy(t1, t, sizeof t);
+		*bl_r2 = *bl_r1;
+		*bl_r1 = bl_r;
+	}
+}
+
+#if defined(__SIZEOF_INT128__)
+
+/*
+ * Runs the approximate-quotient steps on A = r2 >> k, B = r1 >> k, and
+ * returns the transition matrix (u2, v2; u1, v1) s.t. the new r2 is
+ * u2 * r2 + v2 * r1 and the new r1 is u1 * r2 + v1 * r1.
+ * With floor approximations, the approximation of row i is off by less
+ * than |u_i| + |v_i| <= 2^(m_i + 1) (m_i = bit length of the row), so the
+ * loop stops while B still has HEEA_LEHMER_MARGIN bits above that bound.
+ * The signed arithmetic shift keeps the bit lengths exact at the start:
+ * bl(x >> k) = bl(x) - k.
+ */
+static inline unsigned
+lehmer_inner(__int128 A, __int128 B, unsigned bl_A, unsigned bl_B,
+	unsigned bl_stop, int64_t *m)
+{
+	int64_t u2 = 1, v2 = 0, u1 = 0, v1 = 1, u, v;
+	unsigned m2 = 1, m1 = 1, mx, bl_R, s, steps = 0;
+	__int128 R;
+
+	for (;;) {
+		mx = m2 > m1 ? m2 : m1;
+		if (bl_B <= bl_stop || bl_B < mx + 1 + HEEA_LEHMER_MARGIN)
+			break;
+		s = bl_A - bl_B;
+		if (mx + s + 1 >= 63)
+			break;
+
+		if ((A < 0) == (B < 0)) {
+			R = (__int128)((unsigned __int128)A - ((unsigned __int128)B << s));
+			u = (int64_t)((uint64_t)u2 - ((uint64_t)u1 << s));
+			v = (int64_t)((uint64_t)v2 - ((uint64_t)v1 << s));
+		} else {
+			R = (__int128)((unsigned __int128)A + ((unsigned __int128)B << s));
+			u = (int64_t)((uint64_t)u2 + ((uint64_t)u1 << s));
+			v = (int64_t)((uint64_t)v2 + ((uint64_t)v1 << s));
+		}
+
+		bl_R = bitlength_128(R);
+		if (bl_R > bl_B) {
+			A = R; u2 = u; v2 = v;
+			bl_A = bl_R;
+			m2 = bitlength_pair(u2, v2);
+		} else {
+			A = B; u2 = u1; v2 = v1;
+			B = R; u1 = u; v1 = v;
+			bl_A = bl_B;
+			bl_B = bl_R;
+			m2 = m1;
+			m1 = bitlength_pair(u1, v1);
+		}
+		steps ++;
+	}
+
+	m[0] = u2; m[1] = v2; m[2] = u1; m[3] = v1;
+	return steps;
+}
+
+#endif
+
+/*
+ * Runs the reduction until the first row with bl(r1) <= target, and
+ * leaves that row in r1 and t1 (t1 * v = r1 mod el, 4-limb signed).
+ */
+static inline void
+curve25519_hEEA_lehmer_rows(
+	uint64_t *r1, uint64_t *t1, const uint64_t *v, unsigned target)
+{
+	/* el = 2**252+27742317777372353535851937790883648493 */
+	static const uint64_t L[] = {
+		0x5812631a5cf5d3ed,
+		0x14def9dea2f79cd6,
+		0x0000000000000000,
+		0x1000000000000000
+	};
+
+	uint64_t r2[4], t2[4];
+	unsigned bl_r2, bl_r1;
+#if defined(__SIZEOF_INT128__)
+	uint64_t r[4], t[4];
+	unsigned bl_r, k, stop;
+	int64_t m[4];
+#endif
+
+	memcpy(r2, L, sizeof r2);
+	memcpy(r1, v, sizeof r2);
+	memset(t2, 0, sizeof t2);
+	memset(t1, 0, sizeof t2);
+	t1[0] = 1;
+
+	bl_r2 = 253;
+	bl_r1 = bitlength_4(r1);
+
+#if defined(__SIZEOF_INT128__)
+	/*
+	 * Lehmer phase, while r1 is GUARD bits above the target: k keeps
+	 * A on 126 bits (127 with the sign). Without a 128-bit type (32-bit
+	 * targets) the whole reduction runs on exact steps, as hEEA_q does.
+	 */
+	while (bl_r1 > target + HEEA_LEHMER_GUARD) {
+		k = bl_r2 > 126 ? bl_r2 - 126 : 0;
+		stop = target + HEEA_LEHMER_GUARD > k ? target + HEEA_LEHMER_GUARD - k : 0;
+		if (UNLIKELY(lehmer_inner(extract_128(r2, k), extract_128(r1, k),
+			bl_r2 - k, bl_r1 - k, stop, m) == 0)) {
+			/*
+			 * No step could be taken on the approximations (r1 is
+			 * much shorter than r2): one exact step instead.
+			 */
+			exact_step(r2, r1, t2, t1, &bl_r2, &bl_r1);
+			continue;
+		}
+
+		apply_matrix(r2, r1, t2, t1, m, bl_r2 < 192 ? 3 : 4);
+		bl_r2 = bitlength_4(r2);
+		bl_r1 = bitlength_4(r1);
+
+		/*
+		 * A decision taken on approximations may, very rarely, leave
+		 * r1 above r2; the rows are swapped back, since any order
+		 * keeps c1 * v = c0 mod el.
+		 */
+		if (UNLIKELY(bl_r1 > bl_r2)) {
+			memcpy(r, r2, sizeof r);
+			memcpy(r2, r1, sizeof r);
+			memcpy(r1, r, sizeof r);
+			memcpy(t, t2, sizeof t);
+			memcpy(t2, t1, sizeof t);
+			memcpy(t1, t, sizeof t);
+			bl_r = bl_r2; bl_r2 = bl_r1; bl_r1 = bl_r;
+		}
+	}
+#endif
+
+	/* exact phase: the last GUARD bits, with the stopping rule of hEEA_q */
+	while (bl_r1 > target)
+		exact_step(r2, r1, t2, t1, &bl_r2, &bl_r1);
+}
+
+/*
+ * Sign extension of limb i - 1 in limbs i to 3: a signed 4-limb value that
+ * passes fits in i limbs.
+ */
+static inline int
+fits_limbs(const uint64_t *a, int i)
+{
+	uint64_t mask = -(a[i - 1] >> 63);
+
+	for (; i < 4; i ++)
+		if (a[i] != mask)
+			return 0;
+	return 1;
+}
+
+/*
+ * return c0 and c1 s.t. c1 * v = c0 mod el
+ *
+ * c0 and c1 are cut to 2 limbs. r1 has bl <= 127 at the stop. The rows
+ * keep r2 * t1 - r1 * t2 = +-el, and as in the EEA |r1 * t2| < el, so
+ * |t1| < 2 el / |r2|. The row before the stop had bl(r2) >= 128, hence
+ * |t1| < 2^254 / 2^127 = 2^127, which is a signed 2-limb value.
+ */
+void
+curve25519_hEEA_lehmer_vartime(
+	uint64_t *c0, uint64_t *c1, const uint64_t *v)
+{
+	uint64_t r1[4], t1[4];
+
+	curve25519_hEEA_lehmer_rows(r1, t1, v, HEEA_TARGET);
+	assert(fits_limbs(r1, 2) && fits_limbs(t1, 2));
+	c0[0] = r1[0];
+	c0[1] = r1[1];
+	c1[0] = t1[0];
+	c1[1] = t1[1];
+}
+
+/*
+ * return c0 and c1 s.t. c1 * v = c0 mod el, with explicit bit-length
+ * targets: the reduction stops at the first row with |c0| < 2^bl_c0, and
+ * returns 0 if |c1| < 2^bl_c1 there, -1 otherwise. c1 then has at most
+ * about 252 - bl_c0 bits, so a split with bl_c0 + bl_c1 >= 253 succeeds.
+ * c0 and c1 are 3-limb signed values; 64 < bl_c0 <= 190.
+ */
+int
+curve25519_hEEA_target_vartime(
+	uint64_t *c0, uint64_t *c1, const uint64_t *v, unsigned bl_c0, unsigned bl_c1)
+{
+	uint64_t r1[4], t1[4];
+
+	curve25519_hEEA_lehmer_rows(r1, t1, v, bl_c0);
+	assert(fits_limbs(r1, 3) && (bitlength_4(t1) > bl_c1 || fits_limbs(t1, 3)));
+	memcpy(c0, r1, 3 * sizeof c0[0]);
+	memcpy(c1, t1, 3 * sizeof c1[0]);
+	return bitlength_4(t1) <= bl_c1 ? 0 : -1;
+}
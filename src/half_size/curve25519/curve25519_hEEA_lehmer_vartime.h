@@ -0,0 +1,8 @@
+#include <stdint.h>
+#include <string.h>
+
+void curve25519_hEEA_lehmer_vartime(
+	uint64_t *, uint64_t *, const uint64_t *);
+
+int curve25519_hEEA_target_vartime(
+	uint64_t *, uint64_t *, const uint64_t *, unsigned, unsigned);
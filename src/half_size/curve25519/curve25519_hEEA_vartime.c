@@ -35,76 +35,33 @@
 #include "curve25519_hEEA_vartime.h"
 
 /*
- * We use the intrinsic functions:
- *   _lzcnt_u32(), _lzcnt_u64(), _addcarry_u64(), _subborrow_u64().
+ * We use the intrinsic functions (see portable_intrinsics.h):
+ *   lzcnt_u64(), addcarry_u64(), subborrow_u64().
  */
-#include <immintrin.h>
+#include "../../portable_intrinsics.h"
 
 #define UNLIKELY(cond)  __builtin_expect ((cond) != 0, 0)
 
 
-/*
- * This macro defines a function with prototype:
- *  static inline void name(uint64_t *a, const uint64_t *b, unsigned s)
- * It adds lshift(b,s) to a (if intrinsic_op is _addcarry_u64), or
- * subtracts lshift(b,s) from a (if intrinsic_op is _subborrow_u64).
- * Both values consist of 'size' limbs. Truncation happens if the result
- * does not fit in the output.
- */
-#define DEF_OP_LSHIFT(name, intrinsic_op, size) \
-static void \
-name(uint64_t *a, const uint64_t *b, unsigned s) \
-{ \
-	uint64_t b2[(size)]; \
-	unsigned char cc; \
-	unsigned long long w, w2, e; \
-	size_t i; \
- \
- 	if (s >= 64) { \
-		unsigned k; \
- \
-		k = s >> 6; \
-		s &= 63; \
-		if (k >= (size)) { \
-			return; \
-		} \
-		memset(b2, 0, k * sizeof b2[0]); \
-		memcpy(b2 + k, b, ((size) - k) * sizeof b2[0]); \
-		b = b2; \
-	} \
-	if (s == 0) { \
-		cc = 0; \
-		for (i = 0; i < (size); i ++) { \
-			cc = intrinsic_op(cc, a[i], b[i], &w); \
-			a[i] = w; \
-		} \
-	} else { \
-		cc = 0; \
-		e = 0; \
-		for (i = 0; i < (size); i ++) { \
-			w = b[i]; \
-			cc = intrinsic_op(cc, a[i], (w << s) | e, &w2); \
-			e = w >> (64 - s); \
-			a[i] = w2; \
-		} \
-	} \
-}
-
 
-DEF_OP_LSHIFT(add_lshift_4, _addcarry_u64, 4)
-DEF_OP_LSHIFT(sub_lshift_4, _subborrow_u64, 4)
-DEF_OP_LSHIFT(add_lshift_3, _addcarry_u64, 3)
-DEF_OP_LSHIFT(sub_lshift_3, _subborrow_u64, 3)
-DEF_OP_LSHIFT(add_lshift_2, _addcarry_u64, 2)
-DEF_OP_LSHIFT(sub_lshift_2, _subborrow_u64, 2)
+DEF_OP_LSHIFT(add_lshift_4, addcarry_u64, 4)
+DEF_OP_LSHIFT(sub_lshift_4, subborrow_u64, 4)
+DEF_OP_LSHIFT(add_lshift_3, addcarry_u64, 3)
+DEF_OP_LSHIFT(sub_lshift_3, subborrow_u64, 3)
+DEF_OP_LSHIFT(add_lshift_2, addcarry_u64, 2)
+DEF_OP_LSHIFT(sub_lshift_2, subborrow_u64, 2)
 
 
 
 
-/* return c0 and c1 s.t. c1 * v = c0 mod el */
-void
-curve25519_hEEA_vartime(
-	uint64_t *c0, uint64_t *c1, const uint64_t *v)
+/*
+ * return c0 and c1 s.t. c1 * v = c0 mod el
+ * if c2 != NULL, also return the previous row (c2, c3) of the reduction,
+ * s.t. c3 * v = c2 mod el (c2 on 3 limbs, c3 on 2 limbs)
+ */
+static inline __attribute__((always_inline)) void
+curve25519_hEEA_rows_vartime(
+	uint64_t *c0, uint64_t *c1, uint64_t *c2, uint64_t *c3, const uint64_t *v)
 {
 
 	unsigned long long r2_0, r2_1, r2_2, r2_3;
@@ -208,7 +165,7 @@ curve25519_hEEA_vartime(
 		bitlength_top |= \
 			bitlength_word & -(unsigned long long)bitlength_flag; \
 		bitlength_acc -= bitlength_flag; \
-		(size) = (bitlength_acc << 6) - _lzcnt_u64(bitlength_top); \
+		(size) = (bitlength_acc << 6) - lzcnt_u64(bitlength_top); \
 	} while (0)	
 	
 	BITLENGTH(bl_r1, r1_);
@@ -294,58 +251,58 @@ curve25519_hEEA_vartime(
 	unsigned long long r_0, r_1, r_2, r_3, t_0, t_1;
 		if ((r2_3 >> 63) == (r1_3 >> 63)){
 			if (s == 0) {
-				cc = _subborrow_u64(0, r2_0, r1_0, &r_0);
-				cc = _subborrow_u64(cc, r2_1, r1_1, &r_1);
-				cc = _subborrow_u64(cc, r2_2, r1_2, &r_2);
-				(void)_subborrow_u64(cc, r2_3, r1_3, &r_3);
+				cc = subborrow_u64(0, r2_0, r1_0, &r_0);
+				cc = subborrow_u64(cc, r2_1, r1_1, &r_1);
+				cc = subborrow_u64(cc, r2_2, r1_2, &r_2);
+				(void)subborrow_u64(cc, r2_3, r1_3, &r_3);
 
-				cc = _subborrow_u64(0, t2_0, t1_0, &t_0);
-				(void)_subborrow_u64(cc, t2_1, t1_1, &t_1);
+				cc = subborrow_u64(0, t2_0, t1_0, &t_0);
+				(void)subborrow_u64(cc, t2_1, t1_1, &t_1);
 
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				cc = _subborrow_u64(0, r2_0,
+				cc = subborrow_u64(0, r2_0,
 					(r1_0 << s), &r_0);
-				cc = _subborrow_u64(cc, r2_1,
+				cc = subborrow_u64(cc, r2_1,
 					(r1_1 << s) | (r1_0 >> rs), &r_1);
-				cc = _subborrow_u64(cc, r2_2,
+				cc = subborrow_u64(cc, r2_2,
 					(r1_2 << s) | (r1_1 >> rs), &r_2);
-				(void)_subborrow_u64(cc, r2_3,
+				(void)subborrow_u64(cc, r2_3,
 					(r1_3 << s) | (r1_2 >> rs), &r_3);
 
-				cc = _subborrow_u64(0, t2_0,
+				cc = subborrow_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				(void)_subborrow_u64(cc, t2_1,
+				(void)subborrow_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
 			}
 		} else {
 			if (s == 0) {
-				cc = _addcarry_u64(0, r2_0, r1_0, &r_0);
-				cc = _addcarry_u64(cc, r2_1, r1_1, &r_1);
-				cc = _addcarry_u64(cc, r2_2, r1_2, &r_2);
-				(void)_addcarry_u64(cc, r2_3, r1_3, &r_3);
+				cc = addcarry_u64(0, r2_0, r1_0, &r_0);
+				cc = addcarry_u64(cc, r2_1, r1_1, &r_1);
+				cc = addcarry_u64(cc, r2_2, r1_2, &r_2);
+				(void)addcarry_u64(cc, r2_3, r1_3, &r_3);
 
-				cc = _addcarry_u64(0, t2_0, t1_0, &t_0);
-				(void)_addcarry_u64(cc, t2_1, t1_1, &t_1);
+				cc = addcarry_u64(0, t2_0, t1_0, &t_0);
+				(void)addcarry_u64(cc, t2_1, t1_1, &t_1);
 
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				cc = _addcarry_u64(0, r2_0,
+				cc = addcarry_u64(0, r2_0,
 					(r1_0 << s), &r_0);
-				cc = _addcarry_u64(cc, r2_1,
+				cc = addcarry_u64(cc, r2_1,
 					(r1_1 << s) | (r1_0 >> rs), &r_1);
-				cc = _addcarry_u64(cc, r2_2,
+				cc = addcarry_u64(cc, r2_2,
 					(r1_2 << s) | (r1_1 >> rs), &r_2);
-				(void)_addcarry_u64(cc, r2_3,
+				(void)addcarry_u64(cc, r2_3,
 					(r1_3 << s) | (r1_2 >> rs), &r_3);
 
-				cc = _addcarry_u64(0, t2_0,
+				cc = addcarry_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				(void)_addcarry_u64(cc, t2_1,
+				(void)addcarry_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
 			}
 		}
@@ -406,7 +363,7 @@ curve25519_hEEA_vartime(
 			bitlength_word & -(unsigned long long)bitlength_flag; \
 		bitlength_acc -= bitlength_flag; \
 		bitlength_flag &= (bitlength_word == 0); \
-		(size) = (bitlength_acc << 6) - _lzcnt_u64(bitlength_top); \
+		(size) = (bitlength_acc << 6) - lzcnt_u64(bitlength_top); \
 	} while (0)
 	
 		/*
@@ -417,6 +374,13 @@ curve25519_hEEA_vartime(
 			c0[1] = r1_1;
 			c1[0] = t1_0;
 			c1[1] = t1_1;
+			if (c2 != NULL) {
+				c2[0] = r2_0;
+				c2[1] = r2_1;
+				c2[2] = r2_2;
+				c3[0] = t2_0;
+				c3[1] = t2_1;
+			}
 			return;
 		}
 
@@ -492,51 +456,51 @@ curve25519_hEEA_vartime(
 	unsigned long long r_0, r_1, r_2, t_0, t_1;
 		if ((r2_2 >> 63) == (r1_2 >> 63)){
 			if (s == 0) {
-				cc = _subborrow_u64(0, r2_0, r1_0, &r_0);
-				cc = _subborrow_u64(cc, r2_1, r1_1, &r_1);
-				(void)_subborrow_u64(cc, r2_2, r1_2, &r_2);
+				cc = subborrow_u64(0, r2_0, r1_0, &r_0);
+				cc = subborrow_u64(cc, r2_1, r1_1, &r_1);
+				(void)subborrow_u64(cc, r2_2, r1_2, &r_2);
 
-				cc = _subborrow_u64(0, t2_0, t1_0, &t_0);
-				(void)_subborrow_u64(cc, t2_1, t1_1, &t_1);
+				cc = subborrow_u64(0, t2_0, t1_0, &t_0);
+				(void)subborrow_u64(cc, t2_1, t1_1, &t_1);
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				cc = _subborrow_u64(0, r2_0,
+				cc = subborrow_u64(0, r2_0,
 					(r1_0 << s), &r_0);
-				cc = _subborrow_u64(cc, r2_1,
+				cc = subborrow_u64(cc, r2_1,
 					(r1_1 << s) | (r1_0 >> rs), &r_1);
-				(void)_subborrow_u64(cc, r2_2,
+				(void)subborrow_u64(cc, r2_2,
 					(r1_2 << s) | (r1_1 >> rs), &r_2);
 
-				cc = _subborrow_u64(0, t2_0,
+				cc = subborrow_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				(void)_subborrow_u64(cc, t2_1,
+				(void)subborrow_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
 			}
 		} else {
 			if (s == 0) {
-				cc = _addcarry_u64(0, r2_0, r1_0, &r_0);
-				cc = _addcarry_u64(cc, r2_1, r1_1, &r_1);
-				(void)_addcarry_u64(cc, r2_2, r1_2, &r_2);
+				cc = addcarry_u64(0, r2_0, r1_0, &r_0);
+				cc = addcarry_u64(cc, r2_1, r1_1, &r_1);
+				(void)addcarry_u64(cc, r2_2, r1_2, &r_2);
 
-				cc = _addcarry_u64(0, t2_0, t1_0, &t_0);
-				(void)_addcarry_u64(cc, t2_1, t1_1, &t_1);
+				cc = addcarry_u64(0, t2_0, t1_0, &t_0);
+				(void)addcarry_u64(cc, t2_1, t1_1, &t_1);
 				
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				cc = _addcarry_u64(0, r2_0,
+				cc = addcarry_u64(0, r2_0,
 					(r1_0 << s), &r_0);
-				cc = _addcarry_u64(cc, r2_1,
+				cc = addcarry_u64(cc, r2_1,
 					(r1_1 << s) | (r1_0 >> rs), &r_1);
-				(void)_addcarry_u64(cc, r2_2,
+				(void)addcarry_u64(cc, r2_2,
 					(r1_2 << s) | (r1_1 >> rs), &r_2);
 				
-				cc = _addcarry_u64(0, t2_0,
+				cc = addcarry_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				(void)_addcarry_u64(cc, t2_1,
+				(void)addcarry_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
 			}
 		}
@@ -571,4 +535,24 @@ curve25519_hEEA_vartime(
 
 #undef BITLENGTH
 #undef BITLENGTH_SHRUNK
-}
\ No newline at end of file
+}
+
+/* return c0 and c1 s.t. c1 * v = c0 mod el */
+void
+curve25519_hEEA_vartime(
+	uint64_t *c0, uint64_t *c1, const uint64_t *v)
+{
+	curve25519_hEEA_rows_vartime(c0, c1, NULL, NULL, v);
+}
+
+/*
+ * return the two last rows of the reduction, (c0, c1) and (c2, c3), s.t.
+ * c1 * v = c0 mod el and c3 * v = c2 mod el. Both rows are short vectors
+ * of the lattice {(c, c * v mod el)} and together form a basis of it.
+ */
+void
+curve25519_hEEA_basis_vartime(
+	uint64_t *c0, uint64_t *c1, uint64_t *c2, uint64_t *c3, const uint64_t *v)
+{
+	curve25519_hEEA_rows_vartime(c0, c1, c2, c3, v);
+}
@@ -2,4 +2,7 @@
 #include <string.h>
 
 void curve25519_hEEA_vartime(
-	uint64_t *, uint64_t *, const uint64_t *);
\ No newline at end of file
+	uint64_t *, uint64_t *, const uint64_t *);
+
+void curve25519_hEEA_basis_vartime(
+	uint64_t *, uint64_t *, uint64_t *, uint64_t *, const uint64_t *);
\ No newline at end of file
@@ -51,10 +51,14 @@ mp_size_t final_step(mp_ptr rp, mp_ptr ap, mp_ptr bp, mp_size_t n, struct hgcd_m
 
 
 
-/* return c0 and c1 s.t. c1 * v = c0 mod el */
-void
-curve25519_hgcd_vartime(
-	uint64_t *c0, uint64_t *c1, const uint64_t *v, int *c0_size, int *c1_size)
+/*
+ * return c0 and c1 s.t. c1 * v = c0 mod el, stopping at the first row with
+ * bl(c0) <= target; the return value is the bit length of |c1|
+ */
+static int
+curve25519_hgcd_rows_vartime(
+	uint64_t *c0, uint64_t *c1, const uint64_t *v, int *c0_size, int *c1_size,
+	unsigned target)
 {
     mp_size_t n = 4; // Number of limbs
     
@@ -114,7 +118,8 @@ curve25519_hgcd_vartime(
     }
 
     for(;;){
-    	if (mpz_sizeinbase(r1, 2) <= 127) {
+    	if (mpz_sizeinbase(r1, 2) <= target) {
+            int bl_c1 = (int)mpz_sizeinbase(t1, 2);
             for(int i=0; i<r1->_mp_size;i++){
                 c0[i] = r1->_mp_d[i];
             }
@@ -133,7 +138,7 @@ curve25519_hgcd_vartime(
             }
         
 			mpz_clears(q, r1, r2, t1, t2, NULL);
-			return;
+			return bl_c1;
 		}
         mpz_tdiv_qr(q, r2, r2, r1);
         mpz_swap(r2, r1);
@@ -143,6 +148,28 @@ curve25519_hgcd_vartime(
 }
 
 
+/* return c0 and c1 s.t. c1 * v = c0 mod el */
+void
+curve25519_hgcd_vartime(
+	uint64_t *c0, uint64_t *c1, const uint64_t *v, int *c0_size, int *c1_size)
+{
+    (void)curve25519_hgcd_rows_vartime(c0, c1, v, c0_size, c1_size, 127);
+}
+
+/*
+ * same, with explicit bit-length targets: c0 is the first row after the
+ * hgcd step with |c0| < 2^bl_c0, and it returns 0 if |c1| < 2^bl_c1,
+ * -1 otherwise.
+ * c0 and c1 need room for 4 limbs.
+ */
+int
+curve25519_hgcd_target_vartime(
+	uint64_t *c0, uint64_t *c1, const uint64_t *v, int *c0_size, int *c1_size,
+	unsigned bl_c0, unsigned bl_c1)
+{
+    return curve25519_hgcd_rows_vartime(c0, c1, v, c0_size, c1_size, bl_c0) <= (int)bl_c1 ? 0 : -1;
+}
+
 /* return c0 and c1 s.t. c1 * v = c0 mod el */
 void
 curve25519_hgcd_vartime_enhance1(
@@ -3,6 +3,9 @@
 void curve25519_hgcd_vartime(
 	uint64_t *, uint64_t *, const uint64_t *, int *, int *);
 
+int curve25519_hgcd_target_vartime(
+	uint64_t *, uint64_t *, const uint64_t *, int *, int *, unsigned, unsigned);
+
 void curve25519_hgcd_vartime_enhance1(
 	uint64_t *, uint64_t *, const uint64_t *, int *, int *);
 
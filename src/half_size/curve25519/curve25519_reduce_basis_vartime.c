@@ -36,10 +36,10 @@
 #include "curve25519_reduce_basis_vartime.h"
 
 /*
- * We use the intrinsic functions:
- *   _lzcnt_u32(), _lzcnt_u64(), _addcarry_u64(), _subborrow_u64().
+ * We use the intrinsic functions (see portable_intrinsics.h):
+ *   lzcnt_u64(), addcarry_u64(), subborrow_u64(), muladd_u64().
  */
-#include <immintrin.h>
+#include "../../portable_intrinsics.h"
 
 /*
  * For lattice basis reduction, we use an other representation with
@@ -63,70 +63,17 @@ mul(uint64_t *d, const uint64_t *a, const uint64_t *b)
 		uint64_t cc;
 
 		cc = 0;
-		for (j = 0; j < 4; j ++) {
-			unsigned __int128 z;
-
-			z = (unsigned __int128)a[i] * (unsigned __int128)b[j]
-				+ (unsigned __int128)t[i + j] + cc;
-			t[i + j] = (uint64_t)z;
-			cc = (uint64_t)(z >> 64);
-		}
+		for (j = 0; j < 4; j ++)
+			t[i + j] = muladd_u64(a[i], b[j], t[i + j], cc, &cc);
 		t[i + 4] = cc;
 	}
 	memcpy(d, t, sizeof t);
 }
 
-/*
- * This macro defines a function with prototype:
- *  static inline void name(uint64_t *a, const uint64_t *b, unsigned s)
- * It adds lshift(b,s) to a (if intrinsic_op is _addcarry_u64), or
- * subtracts lshift(b,s) from a (if intrinsic_op is _subborrow_u64).
- * Both values consist of 'size' limbs. Truncation happens if the result
- * does not fit in the output.
- */
-#define DEF_OP_LSHIFT(name, intrinsic_op, size) \
-static void \
-name(uint64_t *a, const uint64_t *b, unsigned s) \
-{ \
-	uint64_t b2[(size)]; \
-	unsigned char cc; \
-	unsigned long long w, w2, e; \
-	size_t i; \
- \
- 	if (s >= 64) { \
-		unsigned k; \
- \
-		k = s >> 6; \
-		s &= 63; \
-		if (k >= (size)) { \
-			return; \
-		} \
-		memset(b2, 0, k * sizeof b2[0]); \
-		memcpy(b2 + k, b, ((size) - k) * sizeof b2[0]); \
-		b = b2; \
-	} \
-	if (s == 0) { \
-		cc = 0; \
-		for (i = 0; i < (size); i ++) { \
-			cc = intrinsic_op(cc, a[i], b[i], &w); \
-			a[i] = w; \
-		} \
-	} else { \
-		cc = 0; \
-		e = 0; \
-		for (i = 0; i < (size); i ++) { \
-			w = b[i]; \
-			cc = intrinsic_op(cc, a[i], (w << s) | e, &w2); \
-			e = w >> (64 - s); \
-			a[i] = w2; \
-		} \
-	} \
-}
-
-DEF_OP_LSHIFT(add_lshift_small, _addcarry_u64, 2)
-DEF_OP_LSHIFT(sub_lshift_small, _subborrow_u64, 2)
-DEF_OP_LSHIFT(add_lshift_large, _addcarry_u64, 8)
-DEF_OP_LSHIFT(sub_lshift_large, _subborrow_u64, 8)
+DEF_OP_LSHIFT(add_lshift_small, addcarry_u64, 2)
+DEF_OP_LSHIFT(sub_lshift_small, subborrow_u64, 2)
+DEF_OP_LSHIFT(add_lshift_large, addcarry_u64, 8)
+DEF_OP_LSHIFT(sub_lshift_large, subborrow_u64, 8)
 
 
 
@@ -207,14 +154,14 @@ curve25519_reduce_basis_vartime(
 
 	mul(tmp_l, tmp_b, tmp_b);
 
-	cc = _addcarry_u64(0, tmp_l[0], 1, &nv_0);
-	cc = _addcarry_u64(cc, tmp_l[1], 0, &nv_1);
-	cc = _addcarry_u64(cc, tmp_l[2], 0, &nv_2);
-	cc = _addcarry_u64(cc, tmp_l[3], 0, &nv_3);
-	cc = _addcarry_u64(cc, tmp_l[4], 0, &nv_4);
-	cc = _addcarry_u64(cc, tmp_l[5], 0, &nv_5);
-	cc = _addcarry_u64(cc, tmp_l[6], 0, &nv_6);
-	(void)_addcarry_u64(cc, tmp_l[7], 0, &nv_7);
+	cc = addcarry_u64(0, tmp_l[0], 1, &nv_0);
+	cc = addcarry_u64(cc, tmp_l[1], 0, &nv_1);
+	cc = addcarry_u64(cc, tmp_l[2], 0, &nv_2);
+	cc = addcarry_u64(cc, tmp_l[3], 0, &nv_3);
+	cc = addcarry_u64(cc, tmp_l[4], 0, &nv_4);
+	cc = addcarry_u64(cc, tmp_l[5], 0, &nv_5);
+	cc = addcarry_u64(cc, tmp_l[6], 0, &nv_6);
+	(void)addcarry_u64(cc, tmp_l[7], 0, &nv_7);
 
 	mul(tmp_l, order_u64, tmp_b);
 	
@@ -254,14 +201,14 @@ curve25519_reduce_basis_vartime(
 		/*
 		 * If nu < nv, then swap(u,v) and swap(nu,nv).
 		 */
-		cc = _subborrow_u64(0, nu_0, nv_0, &w);
-		cc = _subborrow_u64(cc, nu_1, nv_1, &w);
-		cc = _subborrow_u64(cc, nu_2, nv_2, &w);
-		cc = _subborrow_u64(cc, nu_3, nv_3, &w);
-		cc = _subborrow_u64(cc, nu_4, nv_4, &w);
-		cc = _subborrow_u64(cc, nu_5, nv_5, &w);
-		cc = _subborrow_u64(cc, nu_6, nv_6, &w);
-		cc = _subborrow_u64(cc, nu_7, nv_7, &w);
+		cc = subborrow_u64(0, nu_0, nv_0, &w);
+		cc = subborrow_u64(cc, nu_1, nv_1, &w);
+		cc = subborrow_u64(cc, nu_2, nv_2, &w);
+		cc = subborrow_u64(cc, nu_3, nv_3, &w);
+		cc = subborrow_u64(cc, nu_4, nv_4, &w);
+		cc = subborrow_u64(cc, nu_5, nv_5, &w);
+		cc = subborrow_u64(cc, nu_6, nv_6, &w);
+		cc = subborrow_u64(cc, nu_7, nv_7, &w);
 		m = -(unsigned long long)cc;
 
 #define SWAPCOND(x, y, ctlmask)   do { \
@@ -342,7 +289,7 @@ curve25519_reduce_basis_vartime(
 		bitlength_top |= \
 			bitlength_word & -(unsigned long long)bitlength_flag; \
 		bitlength_acc -= bitlength_flag; \
-		(size) = (bitlength_acc << 6) - _lzcnt_u64(bitlength_top); \
+		(size) = (bitlength_acc << 6) - lzcnt_u64(bitlength_top); \
 	} while (0)
 
 		BITLENGTH(bl_nv, nv_);
@@ -467,46 +414,46 @@ curve25519_reduce_basis_vartime(
 
 		if ((sp_7 >> 63) == 0) {
 			if (s == 0) {
-				cc = _subborrow_u64(0, u0_0, v0_0, &u0_0);
-				(void)_subborrow_u64(cc, u0_1, v0_1, &u0_1);
-
-				cc = _subborrow_u64(0, u1_0, v1_0, &u1_0);
-				(void)_subborrow_u64(cc, u1_1, v1_1, &u1_1);
-
-				cc = _addcarry_u64(0, nu_0, nv_0, &nu_0);
-				cc = _addcarry_u64(cc, nu_1, nv_1, &nu_1);
-				cc = _addcarry_u64(cc, nu_2, nv_2, &nu_2);
-				cc = _addcarry_u64(cc, nu_3, nv_3, &nu_3);
-				cc = _addcarry_u64(cc, nu_4, nv_4, &nu_4);
-				cc = _addcarry_u64(cc, nu_5, nv_5, &nu_5);
-				cc = _addcarry_u64(cc, nu_6, nv_6, &nu_6);
-				(void)_addcarry_u64(cc, nu_7, nv_7, &nu_7);
-
-				cc = _subborrow_u64(0, nu_0,
+				cc = subborrow_u64(0, u0_0, v0_0, &u0_0);
+				(void)subborrow_u64(cc, u0_1, v0_1, &u0_1);
+
+				cc = subborrow_u64(0, u1_0, v1_0, &u1_0);
+				(void)subborrow_u64(cc, u1_1, v1_1, &u1_1);
+
+				cc = addcarry_u64(0, nu_0, nv_0, &nu_0);
+				cc = addcarry_u64(cc, nu_1, nv_1, &nu_1);
+				cc = addcarry_u64(cc, nu_2, nv_2, &nu_2);
+				cc = addcarry_u64(cc, nu_3, nv_3, &nu_3);
+				cc = addcarry_u64(cc, nu_4, nv_4, &nu_4);
+				cc = addcarry_u64(cc, nu_5, nv_5, &nu_5);
+				cc = addcarry_u64(cc, nu_6, nv_6, &nu_6);
+				(void)addcarry_u64(cc, nu_7, nv_7, &nu_7);
+
+				cc = subborrow_u64(0, nu_0,
 					(sp_0 << 1), &nu_0);
-				cc = _subborrow_u64(cc, nu_1,
+				cc = subborrow_u64(cc, nu_1,
 					(sp_1 << 1) | (sp_0 >> 63), &nu_1);
-				cc = _subborrow_u64(cc, nu_2,
+				cc = subborrow_u64(cc, nu_2,
 					(sp_2 << 1) | (sp_1 >> 63), &nu_2);
-				cc = _subborrow_u64(cc, nu_3,
+				cc = subborrow_u64(cc, nu_3,
 					(sp_3 << 1) | (sp_2 >> 63), &nu_3);
-				cc = _subborrow_u64(cc, nu_4,
+				cc = subborrow_u64(cc, nu_4,
 					(sp_4 << 1) | (sp_3 >> 63), &nu_4);
-				cc = _subborrow_u64(cc, nu_5,
+				cc = subborrow_u64(cc, nu_5,
 					(sp_5 << 1) | (sp_4 >> 63), &nu_5);
-				cc = _subborrow_u64(cc, nu_6,
+				cc = subborrow_u64(cc, nu_6,
 					(sp_6 << 1) | (sp_5 >> 63), &nu_6);
-				(void)_subborrow_u64(cc, nu_7,
+				(void)subborrow_u64(cc, nu_7,
 					(sp_7 << 1) | (sp_6 >> 63), &nu_7);
 
-				cc = _subborrow_u64(0, sp_0, nv_0, &sp_0);
-				cc = _subborrow_u64(cc, sp_1, nv_1, &sp_1);
-				cc = _subborrow_u64(cc, sp_2, nv_2, &sp_2);
-				cc = _subborrow_u64(cc, sp_3, nv_3, &sp_3);
-				cc = _subborrow_u64(cc, sp_4, nv_4, &sp_4);
-				cc = _subborrow_u64(cc, sp_5, nv_5, &sp_5);
-				cc = _subborrow_u64(cc, sp_6, nv_6, &sp_6);
-				(void)_subborrow_u64(cc, sp_7, nv_7, &sp_7);
+				cc = subborrow_u64(0, sp_0, nv_0, &sp_0);
+				cc = subborrow_u64(cc, sp_1, nv_1, &sp_1);
+				cc = subborrow_u64(cc, sp_2, nv_2, &sp_2);
+				cc = subborrow_u64(cc, sp_3, nv_3, &sp_3);
+				cc = subborrow_u64(cc, sp_4, nv_4, &sp_4);
+				cc = subborrow_u64(cc, sp_5, nv_5, &sp_5);
+				cc = subborrow_u64(cc, sp_6, nv_6, &sp_6);
+				(void)subborrow_u64(cc, sp_7, nv_7, &sp_7);
 			} else {
 				unsigned rs, s1, rs1, s2, rs2;
 
@@ -516,109 +463,109 @@ curve25519_reduce_basis_vartime(
 				s2 = s << 1;
 				rs2 = 64 - s2;
 
-				cc = _subborrow_u64(0, u0_0,
+				cc = subborrow_u64(0, u0_0,
 					(v0_0 << s), &u0_0);
-				(void)_subborrow_u64(cc, u0_1,
+				(void)subborrow_u64(cc, u0_1,
 					(v0_1 << s) | (v0_0 >> rs), &u0_1);
 
-				cc = _subborrow_u64(0, u1_0,
+				cc = subborrow_u64(0, u1_0,
 					(v1_0 << s), &u1_0);
-				(void)_subborrow_u64(cc, u1_1,
+				(void)subborrow_u64(cc, u1_1,
 					(v1_1 << s) | (v1_0 >> rs), &u1_1);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(nv_0 << s2), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(nv_1 << s2) | (nv_0 >> rs2), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(nv_2 << s2) | (nv_1 >> rs2), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(nv_3 << s2) | (nv_2 >> rs2), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(nv_4 << s2) | (nv_3 >> rs2), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(nv_5 << s2) | (nv_4 >> rs2), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(nv_6 << s2) | (nv_5 >> rs2), &nu_6);
-				(void)_addcarry_u64(cc, nu_7,
+				(void)addcarry_u64(cc, nu_7,
 					(nv_7 << s2) | (nv_6 >> rs2), &nu_7);
 
-				cc = _subborrow_u64(0, nu_0,
+				cc = subborrow_u64(0, nu_0,
 					(sp_0 << s1), &nu_0);
-				cc = _subborrow_u64(cc, nu_1,
+				cc = subborrow_u64(cc, nu_1,
 					(sp_1 << s1) | (sp_0 >> rs1), &nu_1);
-				cc = _subborrow_u64(cc, nu_2,
+				cc = subborrow_u64(cc, nu_2,
 					(sp_2 << s1) | (sp_1 >> rs1), &nu_2);
-				cc = _subborrow_u64(cc, nu_3,
+				cc = subborrow_u64(cc, nu_3,
 					(sp_3 << s1) | (sp_2 >> rs1), &nu_3);
-				cc = _subborrow_u64(cc, nu_4,
+				cc = subborrow_u64(cc, nu_4,
 					(sp_4 << s1) | (sp_3 >> rs1), &nu_4);
-				cc = _subborrow_u64(cc, nu_5,
+				cc = subborrow_u64(cc, nu_5,
 					(sp_5 << s1) | (sp_4 >> rs1), &nu_5);
-				cc = _subborrow_u64(cc, nu_6,
+				cc = subborrow_u64(cc, nu_6,
 					(sp_6 << s1) | (sp_5 >> rs1), &nu_6);
-				(void)_subborrow_u64(cc, nu_7,
+				(void)subborrow_u64(cc, nu_7,
 					(sp_7 << s1) | (sp_6 >> rs1), &nu_7);
 
-				cc = _subborrow_u64(0, sp_0,
+				cc = subborrow_u64(0, sp_0,
 					(nv_0 << s), &sp_0);
-				cc = _subborrow_u64(cc, sp_1,
+				cc = subborrow_u64(cc, sp_1,
 					(nv_1 << s) | (nv_0 >> rs), &sp_1);
-				cc = _subborrow_u64(cc, sp_2,
+				cc = subborrow_u64(cc, sp_2,
 					(nv_2 << s) | (nv_1 >> rs), &sp_2);
-				cc = _subborrow_u64(cc, sp_3,
+				cc = subborrow_u64(cc, sp_3,
 					(nv_3 << s) | (nv_2 >> rs), &sp_3);
-				cc = _subborrow_u64(cc, sp_4,
+				cc = subborrow_u64(cc, sp_4,
 					(nv_4 << s) | (nv_3 >> rs), &sp_4);
-				cc = _subborrow_u64(cc, sp_5,
+				cc = subborrow_u64(cc, sp_5,
 					(nv_5 << s) | (nv_4 >> rs), &sp_5);
-				cc = _subborrow_u64(cc, sp_6,
+				cc = subborrow_u64(cc, sp_6,
 					(nv_6 << s) | (nv_5 >> rs), &sp_6);
-				(void)_subborrow_u64(cc, sp_7,
+				(void)subborrow_u64(cc, sp_7,
 					(nv_7 << s) | (nv_6 >> rs), &sp_7);
 			}
 		} else {
 			if (s == 0) {
-				cc = _addcarry_u64(0, u0_0, v0_0, &u0_0);
-				(void)_addcarry_u64(cc, u0_1, v0_1, &u0_1);
-
-				cc = _addcarry_u64(0, u1_0, v1_0, &u1_0);
-				(void)_addcarry_u64(cc, u1_1, v1_1, &u1_1);
-
-				cc = _addcarry_u64(0, nu_0, nv_0, &nu_0);
-				cc = _addcarry_u64(cc, nu_1, nv_1, &nu_1);
-				cc = _addcarry_u64(cc, nu_2, nv_2, &nu_2);
-				cc = _addcarry_u64(cc, nu_3, nv_3, &nu_3);
-				cc = _addcarry_u64(cc, nu_4, nv_4, &nu_4);
-				cc = _addcarry_u64(cc, nu_5, nv_5, &nu_5);
-				cc = _addcarry_u64(cc, nu_6, nv_6, &nu_6);
-				(void)_addcarry_u64(cc, nu_7, nv_7, &nu_7);
-
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, u0_0, v0_0, &u0_0);
+				(void)addcarry_u64(cc, u0_1, v0_1, &u0_1);
+
+				cc = addcarry_u64(0, u1_0, v1_0, &u1_0);
+				(void)addcarry_u64(cc, u1_1, v1_1, &u1_1);
+
+				cc = addcarry_u64(0, nu_0, nv_0, &nu_0);
+				cc = addcarry_u64(cc, nu_1, nv_1, &nu_1);
+				cc = addcarry_u64(cc, nu_2, nv_2, &nu_2);
+				cc = addcarry_u64(cc, nu_3, nv_3, &nu_3);
+				cc = addcarry_u64(cc, nu_4, nv_4, &nu_4);
+				cc = addcarry_u64(cc, nu_5, nv_5, &nu_5);
+				cc = addcarry_u64(cc, nu_6, nv_6, &nu_6);
+				(void)addcarry_u64(cc, nu_7, nv_7, &nu_7);
+
+				cc = addcarry_u64(0, nu_0,
 					(sp_0 << 1), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(sp_1 << 1) | (sp_0 >> 63), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(sp_2 << 1) | (sp_1 >> 63), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(sp_3 << 1) | (sp_2 >> 63), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(sp_4 << 1) | (sp_3 >> 63), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(sp_5 << 1) | (sp_4 >> 63), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(sp_6 << 1) | (sp_5 >> 63), &nu_6);
-				(void)_addcarry_u64(cc, nu_7,
+				(void)addcarry_u64(cc, nu_7,
 					(sp_7 << 1) | (sp_6 >> 63), &nu_7);
 
-				cc = _addcarry_u64(0, sp_0, nv_0, &sp_0);
-				cc = _addcarry_u64(cc, sp_1, nv_1, &sp_1);
-				cc = _addcarry_u64(cc, sp_2, nv_2, &sp_2);
-				cc = _addcarry_u64(cc, sp_3, nv_3, &sp_3);
-				cc = _addcarry_u64(cc, sp_4, nv_4, &sp_4);
-				cc = _addcarry_u64(cc, sp_5, nv_5, &sp_5);
-				cc = _addcarry_u64(cc, sp_6, nv_6, &sp_6);
-				(void)_addcarry_u64(cc, sp_7, nv_7, &sp_7);
+				cc = addcarry_u64(0, sp_0, nv_0, &sp_0);
+				cc = addcarry_u64(cc, sp_1, nv_1, &sp_1);
+				cc = addcarry_u64(cc, sp_2, nv_2, &sp_2);
+				cc = addcarry_u64(cc, sp_3, nv_3, &sp_3);
+				cc = addcarry_u64(cc, sp_4, nv_4, &sp_4);
+				cc = addcarry_u64(cc, sp_5, nv_5, &sp_5);
+				cc = addcarry_u64(cc, sp_6, nv_6, &sp_6);
+				(void)addcarry_u64(cc, sp_7, nv_7, &sp_7);
 			} else {
 				unsigned rs, s1, rs1, s2, rs2;
 
@@ -628,65 +575,65 @@ curve25519_reduce_basis_vartime(
 				s2 = s << 1;
 				rs2 = 64 - s2;
 
-				cc = _addcarry_u64(0, u0_0,
+				cc = addcarry_u64(0, u0_0,
 					(v0_0 << s), &u0_0);
-				(void)_addcarry_u64(cc, u0_1,
+				(void)addcarry_u64(cc, u0_1,
 					(v0_1 << s) | (v0_0 >> rs), &u0_1);
 
-				cc = _addcarry_u64(0, u1_0,
+				cc = addcarry_u64(0, u1_0,
 					(v1_0 << s), &u1_0);
-				(void)_addcarry_u64(cc, u1_1,
+				(void)addcarry_u64(cc, u1_1,
 					(v1_1 << s) | (v1_0 >> rs), &u1_1);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(nv_0 << s2), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(nv_1 << s2) | (nv_0 >> rs2), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(nv_2 << s2) | (nv_1 >> rs2), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(nv_3 << s2) | (nv_2 >> rs2), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(nv_4 << s2) | (nv_3 >> rs2), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(nv_5 << s2) | (nv_4 >> rs2), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(nv_6 << s2) | (nv_5 >> rs2), &nu_6);
-				(void)_addcarry_u64(cc, nu_7,
+				(void)addcarry_u64(cc, nu_7,
 					(nv_7 << s2) | (nv_6 >> rs2), &nu_7);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(sp_0 << s1), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(sp_1 << s1) | (sp_0 >> rs1), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(sp_2 << s1) | (sp_1 >> rs1), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(sp_3 << s1) | (sp_2 >> rs1), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(sp_4 << s1) | (sp_3 >> rs1), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(sp_5 << s1) | (sp_4 >> rs1), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(sp_6 << s1) | (sp_5 >> rs1), &nu_6);
-				(void)_addcarry_u64(cc, nu_7,
+				(void)addcarry_u64(cc, nu_7,
 					(sp_7 << s1) | (sp_6 >> rs1), &nu_7);
 
-				cc = _addcarry_u64(0, sp_0,
+				cc = addcarry_u64(0, sp_0,
 					(nv_0 << s), &sp_0);
-				cc = _addcarry_u64(cc, sp_1,
+				cc = addcarry_u64(cc, sp_1,
 					(nv_1 << s) | (nv_0 >> rs), &sp_1);
-				cc = _addcarry_u64(cc, sp_2,
+				cc = addcarry_u64(cc, sp_2,
 					(nv_2 << s) | (nv_1 >> rs), &sp_2);
-				cc = _addcarry_u64(cc, sp_3,
+				cc = addcarry_u64(cc, sp_3,
 					(nv_3 << s) | (nv_2 >> rs), &sp_3);
-				cc = _addcarry_u64(cc, sp_4,
+				cc = addcarry_u64(cc, sp_4,
 					(nv_4 << s) | (nv_3 >> rs), &sp_4);
-				cc = _addcarry_u64(cc, sp_5,
+				cc = addcarry_u64(cc, sp_5,
 					(nv_5 << s) | (nv_4 >> rs), &sp_5);
-				cc = _addcarry_u64(cc, sp_6,
+				cc = addcarry_u64(cc, sp_6,
 					(nv_6 << s) | (nv_5 >> rs), &sp_6);
-				(void)_addcarry_u64(cc, sp_7,
+				(void)addcarry_u64(cc, sp_7,
 					(nv_7 << s) | (nv_6 >> rs), &sp_7);
 			}
 		}
@@ -704,12 +651,12 @@ curve25519_reduce_basis_vartime(
 		/*
 		 * If nu < nv, then swap(u,v) and swap(nu,nv).
 		 */
-		cc = _subborrow_u64(0, nu_0, nv_0, &w);
-		cc = _subborrow_u64(cc, nu_1, nv_1, &w);
-		cc = _subborrow_u64(cc, nu_2, nv_2, &w);
-		cc = _subborrow_u64(cc, nu_3, nv_3, &w);
-		cc = _subborrow_u64(cc, nu_4, nv_4, &w);
-		cc = _subborrow_u64(cc, nu_5, nv_5, &w);
+		cc = subborrow_u64(0, nu_0, nv_0, &w);
+		cc = subborrow_u64(cc, nu_1, nv_1, &w);
+		cc = subborrow_u64(cc, nu_2, nv_2, &w);
+		cc = subborrow_u64(cc, nu_3, nv_3, &w);
+		cc = subborrow_u64(cc, nu_4, nv_4, &w);
+		cc = subborrow_u64(cc, nu_5, nv_5, &w);
 		m = -(unsigned long long)cc;
 
 		SWAPCOND(u0_0, v0_0, m);
@@ -757,7 +704,7 @@ curve25519_reduce_basis_vartime(
 		bitlength_top |= \
 			bitlength_word & -(unsigned long long)bitlength_flag; \
 		bitlength_acc -= bitlength_flag; \
-		(size) = (bitlength_acc << 6) - _lzcnt_u64(bitlength_top); \
+		(size) = (bitlength_acc << 6) - lzcnt_u64(bitlength_top); \
 	} while (0)
 
 		BITLENGTH_SHRUNK(bl_nv, nv_);
@@ -875,38 +822,38 @@ curve25519_reduce_basis_vartime(
 
 		if ((sp_5 >> 63) == 0) {
 			if (s == 0) {
-				cc = _subborrow_u64(0, u0_0, v0_0, &u0_0);
-				(void)_subborrow_u64(cc, u0_1, v0_1, &u0_1);
+				cc = subborrow_u64(0, u0_0, v0_0, &u0_0);
+				(void)subborrow_u64(cc, u0_1, v0_1, &u0_1);
 
-				cc = _subborrow_u64(0, u1_0, v1_0, &u1_0);
-				(void)_subborrow_u64(cc, u1_1, v1_1, &u1_1);
+				cc = subborrow_u64(0, u1_0, v1_0, &u1_0);
+				(void)subborrow_u64(cc, u1_1, v1_1, &u1_1);
 
-				cc = _addcarry_u64(0, nu_0, nv_0, &nu_0);
-				cc = _addcarry_u64(cc, nu_1, nv_1, &nu_1);
-				cc = _addcarry_u64(cc, nu_2, nv_2, &nu_2);
-				cc = _addcarry_u64(cc, nu_3, nv_3, &nu_3);
-				cc = _addcarry_u64(cc, nu_4, nv_4, &nu_4);
-				(void)_addcarry_u64(cc, nu_5, nv_5, &nu_5);
+				cc = addcarry_u64(0, nu_0, nv_0, &nu_0);
+				cc = addcarry_u64(cc, nu_1, nv_1, &nu_1);
+				cc = addcarry_u64(cc, nu_2, nv_2, &nu_2);
+				cc = addcarry_u64(cc, nu_3, nv_3, &nu_3);
+				cc = addcarry_u64(cc, nu_4, nv_4, &nu_4);
+				(void)addcarry_u64(cc, nu_5, nv_5, &nu_5);
 
-				cc = _subborrow_u64(0, nu_0,
+				cc = subborrow_u64(0, nu_0,
 					(sp_0 << 1), &nu_0);
-				cc = _subborrow_u64(cc, nu_1,
+				cc = subborrow_u64(cc, nu_1,
 					(sp_1 << 1) | (sp_0 >> 63), &nu_1);
-				cc = _subborrow_u64(cc, nu_2,
+				cc = subborrow_u64(cc, nu_2,
 					(sp_2 << 1) | (sp_1 >> 63), &nu_2);
-				cc = _subborrow_u64(cc, nu_3,
+				cc = subborrow_u64(cc, nu_3,
 					(sp_3 << 1) | (sp_2 >> 63), &nu_3);
-				cc = _subborrow_u64(cc, nu_4,
+				cc = subborrow_u64(cc, nu_4,
 					(sp_4 << 1) | (sp_3 >> 63), &nu_4);
-				(void)_subborrow_u64(cc, nu_5,
+				(void)subborrow_u64(cc, nu_5,
 					(sp_5 << 1) | (sp_4 >> 63), &nu_5);
 
-				cc = _subborrow_u64(0, sp_0, nv_0, &sp_0);
-				cc = _subborrow_u64(cc, sp_1, nv_1, &sp_1);
-				cc = _subborrow_u64(cc, sp_2, nv_2, &sp_2);
-				cc = _subborrow_u64(cc, sp_3, nv_3, &sp_3);
-				cc = _subborrow_u64(cc, sp_4, nv_4, &sp_4);
-				(void)_subborrow_u64(cc, sp_5, nv_5, &sp_5);
+				cc = subborrow_u64(0, sp_0, nv_0, &sp_0);
+				cc = subborrow_u64(cc, sp_1, nv_1, &sp_1);
+				cc = subborrow_u64(cc, sp_2, nv_2, &sp_2);
+				cc = subborrow_u64(cc, sp_3, nv_3, &sp_3);
+				cc = subborrow_u64(cc, sp_4, nv_4, &sp_4);
+				(void)subborrow_u64(cc, sp_5, nv_5, &sp_5);
 			} else {
 				unsigned rs, s1, rs1, s2, rs2;
 
@@ -916,89 +863,89 @@ curve25519_reduce_basis_vartime(
 				s2 = s << 1;
 				rs2 = 64 - s2;
 
-				cc = _subborrow_u64(0, u0_0,
+				cc = subborrow_u64(0, u0_0,
 					(v0_0 << s), &u0_0);
-				(void)_subborrow_u64(cc, u0_1,
+				(void)subborrow_u64(cc, u0_1,
 					(v0_1 << s) | (v0_0 >> rs), &u0_1);
 
-				cc = _subborrow_u64(0, u1_0,
+				cc = subborrow_u64(0, u1_0,
 					(v1_0 << s), &u1_0);
-				(void)_subborrow_u64(cc, u1_1,
+				(void)subborrow_u64(cc, u1_1,
 					(v1_1 << s) | (v1_0 >> rs), &u1_1);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(nv_0 << s2), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(nv_1 << s2) | (nv_0 >> rs2), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(nv_2 << s2) | (nv_1 >> rs2), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(nv_3 << s2) | (nv_2 >> rs2), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(nv_4 << s2) | (nv_3 >> rs2), &nu_4);
-				(void)_addcarry_u64(cc, nu_5,
+				(void)addcarry_u64(cc, nu_5,
 					(nv_5 << s2) | (nv_4 >> rs2), &nu_5);
 
-				cc = _subborrow_u64(0, nu_0,
+				cc = subborrow_u64(0, nu_0,
 					(sp_0 << s1), &nu_0);
-				cc = _subborrow_u64(cc, nu_1,
+				cc = subborrow_u64(cc, nu_1,
 					(sp_1 << s1) | (sp_0 >> rs1), &nu_1);
-				cc = _subborrow_u64(cc, nu_2,
+				cc = subborrow_u64(cc, nu_2,
 					(sp_2 << s1) | (sp_1 >> rs1), &nu_2);
-				cc = _subborrow_u64(cc, nu_3,
+				cc = subborrow_u64(cc, nu_3,
 					(sp_3 << s1) | (sp_2 >> rs1), &nu_3);
-				cc = _subborrow_u64(cc, nu_4,
+				cc = subborrow_u64(cc, nu_4,
 					(sp_4 << s1) | (sp_3 >> rs1), &nu_4);
-				(void)_subborrow_u64(cc, nu_5,
+				(void)subborrow_u64(cc, nu_5,
 					(sp_5 << s1) | (sp_4 >> rs1), &nu_5);
 
-				cc = _subborrow_u64(0, sp_0,
+				cc = subborrow_u64(0, sp_0,
 					(nv_0 << s), &sp_0);
-				cc = _subborrow_u64(cc, sp_1,
+				cc = subborrow_u64(cc, sp_1,
 					(nv_1 << s) | (nv_0 >> rs), &sp_1);
-				cc = _subborrow_u64(cc, sp_2,
+				cc = subborrow_u64(cc, sp_2,
 					(nv_2 << s) | (nv_1 >> rs), &sp_2);
-				cc = _subborrow_u64(cc, sp_3,
+				cc = subborrow_u64(cc, sp_3,
 					(nv_3 << s) | (nv_2 >> rs), &sp_3);
-				cc = _subborrow_u64(cc, sp_4,
+				cc = subborrow_u64(cc, sp_4,
 					(nv_4 << s) | (nv_3 >> rs), &sp_4);
-				(void)_subborrow_u64(cc, sp_5,
+				(void)subborrow_u64(cc, sp_5,
 					(nv_5 << s) | (nv_4 >> rs), &sp_5);
 			}
 		} else {
 			if (s == 0) {
-				cc = _addcarry_u64(0, u0_0, v0_0, &u0_0);
-				(void)_addcarry_u64(cc, u0_1, v0_1, &u0_1);
+				cc = addcarry_u64(0, u0_0, v0_0, &u0_0);
+				(void)addcarry_u64(cc, u0_1, v0_1, &u0_1);
 
-				cc = _addcarry_u64(0, u1_0, v1_0, &u1_0);
-				(void)_addcarry_u64(cc, u1_1, v1_1, &u1_1);
+				cc = addcarry_u64(0, u1_0, v1_0, &u1_0);
+				(void)addcarry_u64(cc, u1_1, v1_1, &u1_1);
 
-				cc = _addcarry_u64(0, nu_0, nv_0, &nu_0);
-				cc = _addcarry_u64(cc, nu_1, nv_1, &nu_1);
-				cc = _addcarry_u64(cc, nu_2, nv_2, &nu_2);
-				cc = _addcarry_u64(cc, nu_3, nv_3, &nu_3);
-				cc = _addcarry_u64(cc, nu_4, nv_4, &nu_4);
-				(void)_addcarry_u64(cc, nu_5, nv_5, &nu_5);
+				cc = addcarry_u64(0, nu_0, nv_0, &nu_0);
+				cc = addcarry_u64(cc, nu_1, nv_1, &nu_1);
+				cc = addcarry_u64(cc, nu_2, nv_2, &nu_2);
+				cc = addcarry_u64(cc, nu_3, nv_3, &nu_3);
+				cc = addcarry_u64(cc, nu_4, nv_4, &nu_4);
+				(void)addcarry_u64(cc, nu_5, nv_5, &nu_5);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(sp_0 << 1), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(sp_1 << 1) | (sp_0 >> 63), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(sp_2 << 1) | (sp_1 >> 63), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(sp_3 << 1) | (sp_2 >> 63), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(sp_4 << 1) | (sp_3 >> 63), &nu_4);
-				(void)_addcarry_u64(cc, nu_5,
+				(void)addcarry_u64(cc, nu_5,
 					(sp_5 << 1) | (sp_4 >> 63), &nu_5);
 
-				cc = _addcarry_u64(0, sp_0, nv_0, &sp_0);
-				cc = _addcarry_u64(cc, sp_1, nv_1, &sp_1);
-				cc = _addcarry_u64(cc, sp_2, nv_2, &sp_2);
-				cc = _addcarry_u64(cc, sp_3, nv_3, &sp_3);
-				cc = _addcarry_u64(cc, sp_4, nv_4, &sp_4);
-				(void)_addcarry_u64(cc, sp_5, nv_5, &sp_5);
+				cc = addcarry_u64(0, sp_0, nv_0, &sp_0);
+				cc = addcarry_u64(cc, sp_1, nv_1, &sp_1);
+				cc = addcarry_u64(cc, sp_2, nv_2, &sp_2);
+				cc = addcarry_u64(cc, sp_3, nv_3, &sp_3);
+				cc = addcarry_u64(cc, sp_4, nv_4, &sp_4);
+				(void)addcarry_u64(cc, sp_5, nv_5, &sp_5);
 			} else {
 				unsigned rs, s1, rs1, s2, rs2;
 
@@ -1008,53 +955,53 @@ curve25519_reduce_basis_vartime(
 				s2 = s << 1;
 				rs2 = 64 - s2;
 
-				cc = _addcarry_u64(0, u0_0,
+				cc = addcarry_u64(0, u0_0,
 					(v0_0 << s), &u0_0);
-				(void)_addcarry_u64(cc, u0_1,
+				(void)addcarry_u64(cc, u0_1,
 					(v0_1 << s) | (v0_0 >> rs), &u0_1);
 
-				cc = _addcarry_u64(0, u1_0,
+				cc = addcarry_u64(0, u1_0,
 					(v1_0 << s), &u1_0);
-				(void)_addcarry_u64(cc, u1_1,
+				(void)addcarry_u64(cc, u1_1,
 					(v1_1 << s) | (v1_0 >> rs), &u1_1);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(nv_0 << s2), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(nv_1 << s2) | (nv_0 >> rs2), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(nv_2 << s2) | (nv_1 >> rs2), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(nv_3 << s2) | (nv_2 >> rs2), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(nv_4 << s2) | (nv_3 >> rs2), &nu_4);
-				(void)_addcarry_u64(cc, nu_5,
+				(void)addcarry_u64(cc, nu_5,
 					(nv_5 << s2) | (nv_4 >> rs2), &nu_5);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(sp_0 << s1), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(sp_1 << s1) | (sp_0 >> rs1), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(sp_2 << s1) | (sp_1 >> rs1), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(sp_3 << s1) | (sp_2 >> rs1), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(sp_4 << s1) | (sp_3 >> rs1), &nu_4);
-				(void)_addcarry_u64(cc, nu_5,
+				(void)addcarry_u64(cc, nu_5,
 					(sp_5 << s1) | (sp_4 >> rs1), &nu_5);
 
-				cc = _addcarry_u64(0, sp_0,
+				cc = addcarry_u64(0, sp_0,
 					(nv_0 << s), &sp_0);
-				cc = _addcarry_u64(cc, sp_1,
+				cc = addcarry_u64(cc, sp_1,
 					(nv_1 << s) | (nv_0 >> rs), &sp_1);
-				cc = _addcarry_u64(cc, sp_2,
+				cc = addcarry_u64(cc, sp_2,
 					(nv_2 << s) | (nv_1 >> rs), &sp_2);
-				cc = _addcarry_u64(cc, sp_3,
+				cc = addcarry_u64(cc, sp_3,
 					(nv_3 << s) | (nv_2 >> rs), &sp_3);
-				cc = _addcarry_u64(cc, sp_4,
+				cc = addcarry_u64(cc, sp_4,
 					(nv_4 << s) | (nv_3 >> rs), &sp_4);
-				(void)_addcarry_u64(cc, sp_5,
+				(void)addcarry_u64(cc, sp_5,
 					(nv_5 << s) | (nv_4 >> rs), &sp_5);
 			}
 		}
@@ -1063,4 +1010,26 @@ curve25519_reduce_basis_vartime(
 #undef SWAPCOND
 #undef BITLENGTH
 #undef BITLENGTH_SHRUNK
-}
\ No newline at end of file
+}
+
+/*
+ * Same, with explicit bit-length targets: returns 0 if |c0| < 2^bl_c0 and
+ * |c1| < 2^bl_c1, -1 otherwise. Lagrange reduction returns a shortest
+ * vector of the lattice, i.e. a balanced split, so only targets with
+ * bl_c0, bl_c1 >= 127 are met; unbalanced splits need hEEA or hgcd.
+ */
+int
+curve25519_reduce_basis_target_vartime(
+	uint64_t *c0, uint64_t *c1, const uint64_t *b, unsigned bl_c0, unsigned bl_c1)
+{
+	unsigned long long m0, m1;
+	unsigned bl0, bl1;
+
+	curve25519_reduce_basis_vartime(c0, c1, b);
+
+	m0 = -(c0[1] >> 63);
+	m1 = -(c1[1] >> 63);
+	bl0 = (c0[1] ^ m0) ? 128 - lzcnt_u64(c0[1] ^ m0) : 64 - lzcnt_u64(c0[0] ^ m0);
+	bl1 = (c1[1] ^ m1) ? 128 - lzcnt_u64(c1[1] ^ m1) : 64 - lzcnt_u64(c1[0] ^ m1);
+	return (bl0 <= bl_c0 && bl1 <= bl_c1) ? 0 : -1;
+}
@@ -2,4 +2,7 @@
 #include <string.h>
 
 void curve25519_reduce_basis_vartime(
-	uint64_t *c0, uint64_t *c1, const uint64_t *b);
\ No newline at end of file
+	uint64_t *c0, uint64_t *c1, const uint64_t *b);
+
+int curve25519_reduce_basis_target_vartime(
+	uint64_t *c0, uint64_t *c1, const uint64_t *b, unsigned bl_c0, unsigned bl_c1);
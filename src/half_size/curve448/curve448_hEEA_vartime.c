@@ -35,69 +35,22 @@
 #include "curve448_hEEA_vartime.h"
 
 /*
- * We use the intrinsic functions:
- *   _lzcnt_u32(), _lzcnt_u64(), _addcarry_u64(), _subborrow_u64().
+ * We use the intrinsic functions (see portable_intrinsics.h):
+ *   lzcnt_u64(), addcarry_u64(), subborrow_u64().
  */
-#include <immintrin.h>
+#include "../../portable_intrinsics.h"
 // #include <stdio.h>
 
 
 
-/*
- * This macro defines a function with prototype:
- *  static inline void name(uint64_t *a, const uint64_t *b, unsigned s)
- * It adds lshift(b,s) to a (if intrinsic_op is _addcarry_u64), or
- * subtracts lshift(b,s) from a (if intrinsic_op is _subborrow_u64).
- * Both values consist of 'size' limbs. Truncation happens if the result
- * does not fit in the output.
- */
-#define DEF_OP_LSHIFT(name, intrinsic_op, size) \
-static void \
-name(uint64_t *a, const uint64_t *b, unsigned s) \
-{ \
-	uint64_t b2[(size)]; \
-	unsigned char cc; \
-	unsigned long long w, w2, e; \
-	size_t i; \
- \
- 	if (s >= 64) { \
-		unsigned k; \
- \
-		k = s >> 6; \
-		s &= 63; \
-		if (k >= (size)) { \
-			return; \
-		} \
-		memset(b2, 0, k * sizeof b2[0]); \
-		memcpy(b2 + k, b, ((size) - k) * sizeof b2[0]); \
-		b = b2; \
-	} \
-	if (s == 0) { \
-		cc = 0; \
-		for (i = 0; i < (size); i ++) { \
-			cc = intrinsic_op(cc, a[i], b[i], &w); \
-			a[i] = w; \
-		} \
-	} else { \
-		cc = 0; \
-		e = 0; \
-		for (i = 0; i < (size); i ++) { \
-			w = b[i]; \
-			cc = intrinsic_op(cc, a[i], (w << s) | e, &w2); \
-			e = w >> (64 - s); \
-			a[i] = w2; \
-		} \
-	} \
-}
-
-DEF_OP_LSHIFT(add_lshift_7, _addcarry_u64, 7)
-DEF_OP_LSHIFT(sub_lshift_7, _subborrow_u64, 7)
-DEF_OP_LSHIFT(add_lshift_6, _addcarry_u64, 6)
-DEF_OP_LSHIFT(sub_lshift_6, _subborrow_u64, 6)
-DEF_OP_LSHIFT(add_lshift_5, _addcarry_u64, 5)
-DEF_OP_LSHIFT(sub_lshift_5, _subborrow_u64, 5)
-DEF_OP_LSHIFT(add_lshift_4, _addcarry_u64, 4)
-DEF_OP_LSHIFT(sub_lshift_4, _subborrow_u64, 4)
+DEF_OP_LSHIFT(add_lshift_7, addcarry_u64, 7)
+DEF_OP_LSHIFT(sub_lshift_7, subborrow_u64, 7)
+DEF_OP_LSHIFT(add_lshift_6, addcarry_u64, 6)
+DEF_OP_LSHIFT(sub_lshift_6, subborrow_u64, 6)
+DEF_OP_LSHIFT(add_lshift_5, addcarry_u64, 5)
+DEF_OP_LSHIFT(sub_lshift_5, subborrow_u64, 5)
+DEF_OP_LSHIFT(add_lshift_4, addcarry_u64, 4)
+DEF_OP_LSHIFT(sub_lshift_4, subborrow_u64, 4)
 
 
 
@@ -224,7 +177,7 @@ curve448_hEEA_vartime(
 		bitlength_top |= \
 			bitlength_word & -(unsigned long long)bitlength_flag; \
 		bitlength_acc -= bitlength_flag; \
-		(size) = (bitlength_acc << 6) - _lzcnt_u64(bitlength_top); \
+		(size) = (bitlength_acc << 6) - lzcnt_u64(bitlength_top); \
 	} while (0)
 
 	BITLENGTH(bl_r1, r1_);
@@ -341,88 +294,88 @@ curve448_hEEA_vartime(
 	unsigned long long r_0, r_1, r_2, r_3, r_4, r_5, r_6, t_0, t_1, t_2, t_3;
 		if ((r2_6 >> 63) == (r1_6 >> 63)){
 			if (s == 0) {
-				cc = _subborrow_u64(0, r2_0, r1_0, &r_0);
-				cc = _subborrow_u64(cc, r2_1, r1_1, &r_1);
-				cc = _subborrow_u64(cc, r2_2, r1_2, &r_2);
-				cc = _subborrow_u64(cc, r2_3, r1_3, &r_3);
-				cc = _subborrow_u64(cc, r2_4, r1_4, &r_4);
-				cc = _subborrow_u64(cc, r2_5, r1_5, &r_5);
-				(void)_subborrow_u64(cc, r2_6, r1_6, &r_6);
-
-				cc = _subborrow_u64(0, t2_0, t1_0, &t_0);
-				cc = _subborrow_u64(cc, t2_1, t1_1, &t_1);
-				cc = _subborrow_u64(cc, t2_2, t1_2, &t_2);
-				(void)_subborrow_u64(cc, t2_3, t1_3, &t_3);
+				cc = subborrow_u64(0, r2_0, r1_0, &r_0);
+				cc = subborrow_u64(cc, r2_1, r1_1, &r_1);
+				cc = subborrow_u64(cc, r2_2, r1_2, &r_2);
+				cc = subborrow_u64(cc, r2_3, r1_3, &r_3);
+				cc = subborrow_u64(cc, r2_4, r1_4, &r_4);
+				cc = subborrow_u64(cc, r2_5, r1_5, &r_5);
+				(void)subborrow_u64(cc, r2_6, r1_6, &r_6);
+
+				cc = subborrow_u64(0, t2_0, t1_0, &t_0);
+				cc = subborrow_u64(cc, t2_1, t1_1, &t_1);
+				cc = subborrow_u64(cc, t2_2, t1_2, &t_2);
+				(void)subborrow_u64(cc, t2_3, t1_3, &t_3);
 
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				cc = _subborrow_u64(0, r2_0,
+				cc = subborrow_u64(0, r2_0,
 					(r1_0 << s), &r_0);
-				cc = _subborrow_u64(cc, r2_1,
+				cc = subborrow_u64(cc, r2_1,
 					(r1_1 << s) | (r1_0 >> rs), &r_1);
-				cc = _subborrow_u64(cc, r2_2,
+				cc = subborrow_u64(cc, r2_2,
 					(r1_2 << s) | (r1_1 >> rs), &r_2);
-				cc = _subborrow_u64(cc, r2_3,
+				cc = subborrow_u64(cc, r2_3,
 					(r1_3 << s) | (r1_2 >> rs), &r_3);
-				cc = _subborrow_u64(cc, r2_4,
+				cc = subborrow_u64(cc, r2_4,
 					(r1_4 << s) | (r1_3 >> rs), &r_4);
-				cc = _subborrow_u64(cc, r2_5,
+				cc = subborrow_u64(cc, r2_5,
 					(r1_5 << s) | (r1_4 >> rs), &r_5);
-				(void)_subborrow_u64(cc, r2_6,
+				(void)subborrow_u64(cc, r2_6,
 					(r1_6 << s) | (r1_5 >> rs), &r_6);
 
-				cc = _subborrow_u64(0, t2_0,
+				cc = subborrow_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				cc = _subborrow_u64(cc, t2_1,
+				cc = subborrow_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
-				cc = _subborrow_u64(cc, t2_2,
+				cc = subborrow_u64(cc, t2_2,
 					(t1_2 << s) | (t1_1 >> rs), &t_2);
-				(void)_subborrow_u64(cc, t2_3,
+				(void)subborrow_u64(cc, t2_3,
 					(t1_3 << s) | (t1_2 >> rs), &t_3);
 			}
 		} else {
 			if (s == 0) {
-				cc = _addcarry_u64(0, r2_0, r1_0, &r_0);
-				cc = _addcarry_u64(cc, r2_1, r1_1, &r_1);
-				cc = _addcarry_u64(cc, r2_2, r1_2, &r_2);
-				cc = _addcarry_u64(cc, r2_3, r1_3, &r_3);
-				cc = _addcarry_u64(cc, r2_4, r1_4, &r_4);
-				cc = _addcarry_u64(cc, r2_5, r1_5, &r_5);
-				(void)_addcarry_u64(cc, r2_6, r1_6, &r_6);
-
-				cc = _addcarry_u64(0, t2_0, t1_0, &t_0);
-				cc = _addcarry_u64(cc, t2_1, t1_1, &t_1);
-				cc = _addcarry_u64(cc, t2_2, t1_2, &t_2);
-				(void)_addcarry_u64(cc, t2_3, t1_3, &t_3);
+				cc = addcarry_u64(0, r2_0, r1_0, &r_0);
+				cc = addcarry_u64(cc, r2_1, r1_1, &r_1);
+				cc = addcarry_u64(cc, r2_2, r1_2, &r_2);
+				cc = addcarry_u64(cc, r2_3, r1_3, &r_3);
+				cc = addcarry_u64(cc, r2_4, r1_4, &r_4);
+				cc = addcarry_u64(cc, r2_5, r1_5, &r_5);
+				(void)addcarry_u64(cc, r2_6, r1_6, &r_6);
+
+				cc = addcarry_u64(0, t2_0, t1_0, &t_0);
+				cc = addcarry_u64(cc, t2_1, t1_1, &t_1);
+				cc = addcarry_u64(cc, t2_2, t1_2, &t_2);
+				(void)addcarry_u64(cc, t2_3, t1_3, &t_3);
 
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				cc = _addcarry_u64(0, r2_0,
+				cc = addcarry_u64(0, r2_0,
 					(r1_0 << s), &r_0);
-				cc = _addcarry_u64(cc, r2_1,
+				cc = addcarry_u64(cc, r2_1,
 					(r1_1 << s) | (r1_0 >> rs), &r_1);
-				cc = _addcarry_u64(cc, r2_2,
+				cc = addcarry_u64(cc, r2_2,
 					(r1_2 << s) | (r1_1 >> rs), &r_2);
-				cc = _addcarry_u64(cc, r2_3,
+				cc = addcarry_u64(cc, r2_3,
 					(r1_3 << s) | (r1_2 >> rs), &r_3);
-				cc = _addcarry_u64(cc, r2_4,
+				cc = addcarry_u64(cc, r2_4,
 					(r1_4 << s) | (r1_3 >> rs), &r_4);
-				cc = _addcarry_u64(cc, r2_5,
+				cc = addcarry_u64(cc, r2_5,
 					(r1_5 << s) | (r1_4 >> rs), &r_5);
-				(void)_addcarry_u64(cc, r2_6,
+				(void)addcarry_u64(cc, r2_6,
 					(r1_6 << s) | (r1_5 >> rs), &r_6);
 
-				cc = _addcarry_u64(0, t2_0,
+				cc = addcarry_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				cc = _addcarry_u64(cc, t2_1,
+				cc = addcarry_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
-				cc = _addcarry_u64(cc, t2_2,
+				cc = addcarry_u64(cc, t2_2,
 					(t1_2 << s) | (t1_1 >> rs), &t_2);
-				(void)_addcarry_u64(cc, t2_3,
+				(void)addcarry_u64(cc, t2_3,
 					(t1_3 << s) | (t1_2 >> rs), &t_3);
 			}
 		}
@@ -510,7 +463,7 @@ curve448_hEEA_vartime(
 		bitlength_top |= \
 			bitlength_word & -(unsigned long long)bitlength_flag; \
 		bitlength_acc -= bitlength_flag; \
-		(size) = (bitlength_acc << 6) - _lzcnt_u64(bitlength_top); \
+		(size) = (bitlength_acc << 6) - lzcnt_u64(bitlength_top); \
 	} while (0)
 
 		/*
@@ -623,82 +576,82 @@ curve448_hEEA_vartime(
 	unsigned long long r_0, r_1, r_2, r_3, r_4, r_5, t_0, t_1, t_2, t_3;
 		if ((r2_5 >> 63) == (r1_5 >> 63)){
 			if (s == 0) {
-				cc = _subborrow_u64(0, r2_0, r1_0, &r_0);
-				cc = _subborrow_u64(cc, r2_1, r1_1, &r_1);
-				cc = _subborrow_u64(cc, r2_2, r1_2, &r_2);
-				cc = _subborrow_u64(cc, r2_3, r1_3, &r_3);
-				cc = _subborrow_u64(cc, r2_4, r1_4, &r_4);
-				(void)_subborrow_u64(cc, r2_5, r1_5, &r_5);
-
-				cc = _subborrow_u64(0, t2_0, t1_0, &t_0);
-				cc = _subborrow_u64(cc, t2_1, t1_1, &t_1);
-				cc = _subborrow_u64(cc, t2_2, t1_2, &t_2);
-				(void)_subborrow_u64(cc, t2_3, t1_3, &t_3);
+				cc = subborrow_u64(0, r2_0, r1_0, &r_0);
+				cc = subborrow_u64(cc, r2_1, r1_1, &r_1);
+				cc = subborrow_u64(cc, r2_2, r1_2, &r_2);
+				cc = subborrow_u64(cc, r2_3, r1_3, &r_3);
+				cc = subborrow_u64(cc, r2_4, r1_4, &r_4);
+				(void)subborrow_u64(cc, r2_5, r1_5, &r_5);
+
+				cc = subborrow_u64(0, t2_0, t1_0, &t_0);
+				cc = subborrow_u64(cc, t2_1, t1_1, &t_1);
+				cc = subborrow_u64(cc, t2_2, t1_2, &t_2);
+				(void)subborrow_u64(cc, t2_3, t1_3, &t_3);
 
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				cc = _subborrow_u64(0, r2_0,
+				cc = subborrow_u64(0, r2_0,
 					(r1_0 << s), &r_0);
-				cc = _subborrow_u64(cc, r2_1,
+				cc = subborrow_u64(cc, r2_1,
 					(r1_1 << s) | (r1_0 >> rs), &r_1);
-				cc = _subborrow_u64(cc, r2_2,
+				cc = subborrow_u64(cc, r2_2,
 					(r1_2 << s) | (r1_1 >> rs), &r_2);
-				cc = _subborrow_u64(cc, r2_3,
+				cc = subborrow_u64(cc, r2_3,
 					(r1_3 << s) | (r1_2 >> rs), &r_3);
-				cc = _subborrow_u64(cc, r2_4,
+				cc = subborrow_u64(cc, r2_4,
 					(r1_4 << s) | (r1_3 >> rs), &r_4);
-				(void)_subborrow_u64(cc, r2_5,
+				(void)subborrow_u64(cc, r2_5,
 					(r1_5 << s) | (r1_4 >> rs), &r_5);
 
-				cc = _subborrow_u64(0, t2_0,
+				cc = subborrow_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				cc = _subborrow_u64(cc, t2_1,
+				cc = subborrow_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
-				cc = _subborrow_u64(cc, t2_2,
+				cc = subborrow_u64(cc, t2_2,
 					(t1_2 << s) | (t1_1 >> rs), &t_2);
-				(void)_subborrow_u64(cc, t2_3,
+				(void)subborrow_u64(cc, t2_3,
 					(t1_3 << s) | (t1_2 >> rs), &t_3);
 			}
 		} else {
 			if (s == 0) {
-				cc = _addcarry_u64(0, r2_0, r1_0, &r_0);
-				cc = _addcarry_u64(cc, r2_1, r1_1, &r_1);
-				cc = _addcarry_u64(cc, r2_2, r1_2, &r_2);
-				cc = _addcarry_u64(cc, r2_3, r1_3, &r_3);
-				cc = _addcarry_u64(cc, r2_4, r1_4, &r_4);
-				(void)_addcarry_u64(cc, r2_5, r1_5, &r_5);
-
-				cc = _addcarry_u64(0, t2_0, t1_0, &t_0);
-				cc = _addcarry_u64(cc, t2_1, t1_1, &t_1);
-				cc = _addcarry_u64(cc, t2_2, t1_2, &t_2);
-				(void)_addcarry_u64(cc, t2_3, t1_3, &t_3);
+				cc = addcarry_u64(0, r2_0, r1_0, &r_0);
+				cc = addcarry_u64(cc, r2_1, r1_1, &r_1);
+				cc = addcarry_u64(cc, r2_2, r1_2, &r_2);
+				cc = addcarry_u64(cc, r2_3, r1_3, &r_3);
+				cc = addcarry_u64(cc, r2_4, r1_4, &r_4);
+				(void)addcarry_u64(cc, r2_5, r1_5, &r_5);
+
+				cc = addcarry_u64(0, t2_0, t1_0, &t_0);
+				cc = addcarry_u64(cc, t2_1, t1_1, &t_1);
+				cc = addcarry_u64(cc, t2_2, t1_2, &t_2);
+				(void)addcarry_u64(cc, t2_3, t1_3, &t_3);
 
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				cc = _addcarry_u64(0, r2_0,
+				cc = addcarry_u64(0, r2_0,
 					(r1_0 << s), &r_0);
-				cc = _addcarry_u64(cc, r2_1,
+				cc = addcarry_u64(cc, r2_1,
 					(r1_1 << s) | (r1_0 >> rs), &r_1);
-				cc = _addcarry_u64(cc, r2_2,
+				cc = addcarry_u64(cc, r2_2,
 					(r1_2 << s) | (r1_1 >> rs), &r_2);
-				cc = _addcarry_u64(cc, r2_3,
+				cc = addcarry_u64(cc, r2_3,
 					(r1_3 << s) | (r1_2 >> rs), &r_3);
-				cc = _addcarry_u64(cc, r2_4,
+				cc = addcarry_u64(cc, r2_4,
 					(r1_4 << s) | (r1_3 >> rs), &r_4);
-				(void)_addcarry_u64(cc, r2_5,
+				(void)addcarry_u64(cc, r2_5,
 					(r1_5 << s) | (r1_4 >> rs), &r_5);
 
-				cc = _addcarry_u64(0, t2_0,
+				cc = addcarry_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				cc = _addcarry_u64(cc, t2_1,
+				cc = addcarry_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
-				cc = _addcarry_u64(cc, t2_2,
+				cc = addcarry_u64(cc, t2_2,
 					(t1_2 << s) | (t1_1 >> rs), &t_2);
-				(void)_addcarry_u64(cc, t2_3,
+				(void)addcarry_u64(cc, t2_3,
 					(t1_3 << s) | (t1_2 >> rs), &t_3);
 			}
 		}
@@ -781,7 +734,7 @@ curve448_hEEA_vartime(
 		bitlength_top |= \
 			bitlength_word & -(unsigned long long)bitlength_flag; \
 		bitlength_acc -= bitlength_flag; \
-		(size) = (bitlength_acc << 6) - _lzcnt_u64(bitlength_top); \
+		(size) = (bitlength_acc << 6) - lzcnt_u64(bitlength_top); \
 	} while (0)
 		
 		/*
@@ -895,76 +848,76 @@ curve448_hEEA_vartime(
 	unsigned long long r_0, r_1, r_2, r_3, r_4, t_0, t_1, t_2, t_3;
 		if ((r2_4 >> 63) == (r1_4 >> 63)){
 			if (s == 0) {
-				cc = _subborrow_u64(0, r2_0, r1_0, &r_0);
-				cc = _subborrow_u64(cc, r2_1, r1_1, &r_1);
-				cc = _subborrow_u64(cc, r2_2, r1_2, &r_2);
-				cc = _subborrow_u64(cc, r2_3, r1_3, &r_3);
-				(void)_subborrow_u64(cc, r2_4, r1_4, &r_4);
+				cc = subborrow_u64(0, r2_0, r1_0, &r_0);
+				cc = subborrow_u64(cc, r2_1, r1_1, &r_1);
+				cc = subborrow_u64(cc, r2_2, r1_2, &r_2);
+				cc = subborrow_u64(cc, r2_3, r1_3, &r_3);
+				(void)subborrow_u64(cc, r2_4, r1_4, &r_4);
 
-				cc = _subborrow_u64(0, t2_0, t1_0, &t_0);
-				cc = _subborrow_u64(cc, t2_1, t1_1, &t_1);
-				cc = _subborrow_u64(cc, t2_2, t1_2, &t_2);
-				(void)_subborrow_u64(cc, t2_3, t1_3, &t_3);
+				cc = subborrow_u64(0, t2_0, t1_0, &t_0);
+				cc = subborrow_u64(cc, t2_1, t1_1, &t_1);
+				cc = subborrow_u64(cc, t2_2, t1_2, &t_2);
+				(void)subborrow_u64(cc, t2_3, t1_3, &t_3);
 
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				cc = _subborrow_u64(0, r2_0,
+				cc = subborrow_u64(0, r2_0,
 					(r1_0 << s), &r_0);
-				cc = _subborrow_u64(cc, r2_1,
+				cc = subborrow_u64(cc, r2_1,
 					(r1_1 << s) | (r1_0 >> rs), &r_1);
-				cc = _subborrow_u64(cc, r2_2,
+				cc = subborrow_u64(cc, r2_2,
 					(r1_2 << s) | (r1_1 >> rs), &r_2);
-				cc = _subborrow_u64(cc, r2_3,
+				cc = subborrow_u64(cc, r2_3,
 					(r1_3 << s) | (r1_2 >> rs), &r_3);
-				(void)_subborrow_u64(cc, r2_4,
+				(void)subborrow_u64(cc, r2_4,
 					(r1_4 << s) | (r1_3 >> rs), &r_4);
 
-				cc = _subborrow_u64(0, t2_0,
+				cc = subborrow_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				cc = _subborrow_u64(cc, t2_1,
+				cc = subborrow_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
-				cc = _subborrow_u64(cc, t2_2,
+				cc = subborrow_u64(cc, t2_2,
 					(t1_2 << s) | (t1_1 >> rs), &t_2);
-				(void)_subborrow_u64(cc, t2_3,
+				(void)subborrow_u64(cc, t2_3,
 					(t1_3 << s) | (t1_2 >> rs), &t_3);
 			}
 		} else {
 			if (s == 0) {
-				cc = _addcarry_u64(0, r2_0, r1_0, &r_0);
-				cc = _addcarry_u64(cc, r2_1, r1_1, &r_1);
-				cc = _addcarry_u64(cc, r2_2, r1_2, &r_2);
-				cc = _addcarry_u64(cc, r2_3, r1_3, &r_3);
-				(void)_addcarry_u64(cc, r2_4, r1_4, &r_4);
+				cc = addcarry_u64(0, r2_0, r1_0, &r_0);
+				cc = addcarry_u64(cc, r2_1, r1_1, &r_1);
+				cc = addcarry_u64(cc, r2_2, r1_2, &r_2);
+				cc = addcarry_u64(cc, r2_3, r1_3, &r_3);
+				(void)addcarry_u64(cc, r2_4, r1_4, &r_4);
 
-				cc = _addcarry_u64(0, t2_0, t1_0, &t_0);
-				cc = _addcarry_u64(cc, t2_1, t1_1, &t_1);
-				cc = _addcarry_u64(cc, t2_2, t1_2, &t_2);
-				(void)_addcarry_u64(cc, t2_3, t1_3, &t_3);
+				cc = addcarry_u64(0, t2_0, t1_0, &t_0);
+				cc = addcarry_u64(cc, t2_1, t1_1, &t_1);
+				cc = addcarry_u64(cc, t2_2, t1_2, &t_2);
+				(void)addcarry_u64(cc, t2_3, t1_3, &t_3);
 
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				cc = _addcarry_u64(0, r2_0,
+				cc = addcarry_u64(0, r2_0,
 					(r1_0 << s), &r_0);
-				cc = _addcarry_u64(cc, r2_1,
+				cc = addcarry_u64(cc, r2_1,
 					(r1_1 << s) | (r1_0 >> rs), &r_1);
-				cc = _addcarry_u64(cc, r2_2,
+				cc = addcarry_u64(cc, r2_2,
 					(r1_2 << s) | (r1_1 >> rs), &r_2);
-				cc = _addcarry_u64(cc, r2_3,
+				cc = addcarry_u64(cc, r2_3,
 					(r1_3 << s) | (r1_2 >> rs), &r_3);
-				(void)_addcarry_u64(cc, r2_4,
+				(void)addcarry_u64(cc, r2_4,
 					(r1_4 << s) | (r1_3 >> rs), &r_4);
 
-				cc = _addcarry_u64(0, t2_0,
+				cc = addcarry_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				cc = _addcarry_u64(cc, t2_1,
+				cc = addcarry_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
-				cc = _addcarry_u64(cc, t2_2,
+				cc = addcarry_u64(cc, t2_2,
 					(t1_2 << s) | (t1_1 >> rs), &t_2);
-				(void)_addcarry_u64(cc, t2_3,
+				(void)addcarry_u64(cc, t2_3,
 					(t1_3 << s) | (t1_2 >> rs), &t_3);
 			}
 		}
@@ -1043,7 +996,7 @@ curve448_hEEA_vartime(
 		bitlength_top |= \
 			bitlength_word & -(unsigned long long)bitlength_flag; \
 		bitlength_acc -= bitlength_flag; \
-		(size) = (bitlength_acc << 6) - _lzcnt_u64(bitlength_top); \
+		(size) = (bitlength_acc << 6) - lzcnt_u64(bitlength_top); \
 	} while (0)
 
 		/*
@@ -1166,70 +1119,70 @@ curve448_hEEA_vartime(
 	unsigned long long r_0, r_1, r_2, r_3, t_0, t_1, t_2, t_3;
 		if ((r2_3 >> 63) == (r1_3 >> 63)){
 			if (s == 0) {
-				cc = _subborrow_u64(0, r2_0, r1_0, &r_0);
-				cc = _subborrow_u64(cc, r2_1, r1_1, &r_1);
-				cc = _subborrow_u64(cc, r2_2, r1_2, &r_2);
-				(void)_subborrow_u64(cc, r2_3, r1_3, &r_3);
+				cc = subborrow_u64(0, r2_0, r1_0, &r_0);
+				cc = subborrow_u64(cc, r2_1, r1_1, &r_1);
+				cc = subborrow_u64(cc, r2_2, r1_2, &r_2);
+				(void)subborrow_u64(cc, r2_3, r1_3, &r_3);
 
-				cc = _subborrow_u64(0, t2_0, t1_0, &t_0);
-				cc = _subborrow_u64(cc, t2_1, t1_1, &t_1);
-				cc = _subborrow_u64(cc, t2_2, t1_2, &t_2);
-				(void)_subborrow_u64(cc, t2_3, t1_3, &t_3);
+				cc = subborrow_u64(0, t2_0, t1_0, &t_0);
+				cc = subborrow_u64(cc, t2_1, t1_1, &t_1);
+				cc = subborrow_u64(cc, t2_2, t1_2, &t_2);
+				(void)subborrow_u64(cc, t2_3, t1_3, &t_3);
 
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				cc = _subborrow_u64(0, r2_0,
+				cc = subborrow_u64(0, r2_0,
 					(r1_0 << s), &r_0);
-				cc = _subborrow_u64(cc, r2_1,
+				cc = subborrow_u64(cc, r2_1,
 					(r1_1 << s) | (r1_0 >> rs), &r_1);
-				cc = _subborrow_u64(cc, r2_2,
+				cc = subborrow_u64(cc, r2_2,
 					(r1_2 << s) | (r1_1 >> rs), &r_2);
-				(void)_subborrow_u64(cc, r2_3,
+				(void)subborrow_u64(cc, r2_3,
 					(r1_3 << s) | (r1_2 >> rs), &r_3);
 
-				cc = _subborrow_u64(0, t2_0,
+				cc = subborrow_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				cc = _subborrow_u64(cc, t2_1,
+				cc = subborrow_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
-				cc = _subborrow_u64(cc, t2_2,
+				cc = subborrow_u64(cc, t2_2,
 					(t1_2 << s) | (t1_1 >> rs), &t_2);
-				(void)_subborrow_u64(cc, t2_3,
+				(void)subborrow_u64(cc, t2_3,
 					(t1_3 << s) | (t1_2 >> rs), &t_3);
 			}
 		} else {
 			if (s == 0) {
-				cc = _addcarry_u64(0, r2_0, r1_0, &r_0);
-				cc = _addcarry_u64(cc, r2_1, r1_1, &r_1);
-				cc = _addcarry_u64(cc, r2_2, r1_2, &r_2);
-				(void)_addcarry_u64(cc, r2_3, r1_3, &r_3);
+				cc = addcarry_u64(0, r2_0, r1_0, &r_0);
+				cc = addcarry_u64(cc, r2_1, r1_1, &r_1);
+				cc = addcarry_u64(cc, r2_2, r1_2, &r_2);
+				(void)addcarry_u64(cc, r2_3, r1_3, &r_3);
 
-				cc = _addcarry_u64(0, t2_0, t1_0, &t_0);
-				cc = _addcarry_u64(cc, t2_1, t1_1, &t_1);
-				cc = _addcarry_u64(cc, t2_2, t1_2, &t_2);
-				(void)_addcarry_u64(cc, t2_3, t1_3, &t_3);
+				cc = addcarry_u64(0, t2_0, t1_0, &t_0);
+				cc = addcarry_u64(cc, t2_1, t1_1, &t_1);
+				cc = addcarry_u64(cc, t2_2, t1_2, &t_2);
+				(void)addcarry_u64(cc, t2_3, t1_3, &t_3);
 
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				cc = _addcarry_u64(0, r2_0,
+				cc = addcarry_u64(0, r2_0,
 					(r1_0 << s), &r_0);
-				cc = _addcarry_u64(cc, r2_1,
+				cc = addcarry_u64(cc, r2_1,
 					(r1_1 << s) | (r1_0 >> rs), &r_1);
-				cc = _addcarry_u64(cc, r2_2,
+				cc = addcarry_u64(cc, r2_2,
 					(r1_2 << s) | (r1_1 >> rs), &r_2);
-				(void)_addcarry_u64(cc, r2_3,
+				(void)addcarry_u64(cc, r2_3,
 					(r1_3 << s) | (r1_2 >> rs), &r_3);
 
-				cc = _addcarry_u64(0, t2_0,
+				cc = addcarry_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				cc = _addcarry_u64(cc, t2_1,
+				cc = addcarry_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
-				cc = _addcarry_u64(cc, t2_2,
+				cc = addcarry_u64(cc, t2_2,
 					(t1_2 << s) | (t1_1 >> rs), &t_2);
-				(void)_addcarry_u64(cc, t2_3,
+				(void)addcarry_u64(cc, t2_3,
 					(t1_3 << s) | (t1_2 >> rs), &t_3);
 			}
 		}
@@ -36,10 +36,10 @@
 #include "curve448_reduce_basis_vartime.h"
 
 /*
- * We use the intrinsic functions:
- *   _lzcnt_u32(), _lzcnt_u64(), _addcarry_u64(), _subborrow_u64().
+ * We use the intrinsic functions (see portable_intrinsics.h):
+ *   lzcnt_u64(), addcarry_u64(), subborrow_u64(), muladd_u64().
  */
-#include <immintrin.h>
+#include "../../portable_intrinsics.h"
 
 /*
  * For lattice basis reduction, we use an other representation with
@@ -63,70 +63,17 @@ mul(uint64_t *d, const uint64_t *a, const uint64_t *b)
 		uint64_t cc;
 
 		cc = 0;
-		for (j = 0; j < 7; j ++) {
-			unsigned __int128 z;
-
-			z = (unsigned __int128)a[i] * (unsigned __int128)b[j]
-				+ (unsigned __int128)t[i + j] + cc;
-			t[i + j] = (uint64_t)z;
-			cc = (uint64_t)(z >> 64);
-		}
+		for (j = 0; j < 7; j ++)
+			t[i + j] = muladd_u64(a[i], b[j], t[i + j], cc, &cc);
 		t[i + 7] = cc;
 	}
 	memcpy(d, t, sizeof t);
 }
 
-/*
- * This macro defines a function with prototype:
- *  static inline void name(uint64_t *a, const uint64_t *b, unsigned s)
- * It adds lshift(b,s) to a (if intrinsic_op is _addcarry_u64), or
- * subtracts lshift(b,s) from a (if intrinsic_op is _subborrow_u64).
- * Both values consist of 'size' limbs. Truncation happens if the result
- * does not fit in the output.
- */
-#define DEF_OP_LSHIFT(name, intrinsic_op, size) \
-static void \
-name(uint64_t *a, const uint64_t *b, unsigned s) \
-{ \
-	uint64_t b2[(size)]; \
-	unsigned char cc; \
-	unsigned long long w, w2, e; \
-	size_t i; \
- \
- 	if (s >= 64) { \
-		unsigned k; \
- \
-		k = s >> 6; \
-		s &= 63; \
-		if (k >= (size)) { \
-			return; \
-		} \
-		memset(b2, 0, k * sizeof b2[0]); \
-		memcpy(b2 + k, b, ((size) - k) * sizeof b2[0]); \
-		b = b2; \
-	} \
-	if (s == 0) { \
-		cc = 0; \
-		for (i = 0; i < (size); i ++) { \
-			cc = intrinsic_op(cc, a[i], b[i], &w); \
-			a[i] = w; \
-		} \
-	} else { \
-		cc = 0; \
-		e = 0; \
-		for (i = 0; i < (size); i ++) { \
-			w = b[i]; \
-			cc = intrinsic_op(cc, a[i], (w << s) | e, &w2); \
-			e = w >> (64 - s); \
-			a[i] = w2; \
-		} \
-	} \
-}
-
-DEF_OP_LSHIFT(add_lshift_small, _addcarry_u64, 4)
-DEF_OP_LSHIFT(sub_lshift_small, _subborrow_u64, 4)
-DEF_OP_LSHIFT(add_lshift_large, _addcarry_u64, 14)
-DEF_OP_LSHIFT(sub_lshift_large, _subborrow_u64, 14)
+DEF_OP_LSHIFT(add_lshift_small, addcarry_u64, 4)
+DEF_OP_LSHIFT(sub_lshift_small, subborrow_u64, 4)
+DEF_OP_LSHIFT(add_lshift_large, addcarry_u64, 14)
+DEF_OP_LSHIFT(sub_lshift_large, subborrow_u64, 14)
 
 
 
@@ -228,20 +175,20 @@ curve448_reduce_basis_vartime(
 
 	mul(tmp_l, tmp_b, tmp_b);
 	
-	cc = _addcarry_u64(0, tmp_l[0], 1, &nv_0);
-	cc = _addcarry_u64(cc, tmp_l[1], 0, &nv_1);
-	cc = _addcarry_u64(cc, tmp_l[2], 0, &nv_2);
-	cc = _addcarry_u64(cc, tmp_l[3], 0, &nv_3);
-	cc = _addcarry_u64(cc, tmp_l[4], 0, &nv_4);
-	cc = _addcarry_u64(cc, tmp_l[5], 0, &nv_5);
-	cc = _addcarry_u64(cc, tmp_l[6], 0, &nv_6);
-	cc = _addcarry_u64(cc, tmp_l[7], 0, &nv_7);
-	cc = _addcarry_u64(cc, tmp_l[8], 0, &nv_8);
-	cc = _addcarry_u64(cc, tmp_l[9], 0, &nv_9);
-	cc = _addcarry_u64(cc, tmp_l[10], 0, &nv_10);
-	cc = _addcarry_u64(cc, tmp_l[11], 0, &nv_11);
-	cc = _addcarry_u64(cc, tmp_l[12], 0, &nv_12);
-	(void)_addcarry_u64(cc, tmp_l[13], 0, &nv_13);
+	cc = addcarry_u64(0, tmp_l[0], 1, &nv_0);
+	cc = addcarry_u64(cc, tmp_l[1], 0, &nv_1);
+	cc = addcarry_u64(cc, tmp_l[2], 0, &nv_2);
+	cc = addcarry_u64(cc, tmp_l[3], 0, &nv_3);
+	cc = addcarry_u64(cc, tmp_l[4], 0, &nv_4);
+	cc = addcarry_u64(cc, tmp_l[5], 0, &nv_5);
+	cc = addcarry_u64(cc, tmp_l[6], 0, &nv_6);
+	cc = addcarry_u64(cc, tmp_l[7], 0, &nv_7);
+	cc = addcarry_u64(cc, tmp_l[8], 0, &nv_8);
+	cc = addcarry_u64(cc, tmp_l[9], 0, &nv_9);
+	cc = addcarry_u64(cc, tmp_l[10], 0, &nv_10);
+	cc = addcarry_u64(cc, tmp_l[11], 0, &nv_11);
+	cc = addcarry_u64(cc, tmp_l[12], 0, &nv_12);
+	(void)addcarry_u64(cc, tmp_l[13], 0, &nv_13);
 		
 
 	mul(tmp_l, order_u64, tmp_b);
@@ -288,20 +235,20 @@ curve448_reduce_basis_vartime(
 		/*
 		 * If nu < nv, then swap(u,v) and swap(nu,nv).
 		 */
-		cc = _subborrow_u64(0, nu_0, nv_0, &w);
-		cc = _subborrow_u64(cc, nu_1, nv_1, &w);
-		cc = _subborrow_u64(cc, nu_2, nv_2, &w);
-		cc = _subborrow_u64(cc, nu_3, nv_3, &w);
-		cc = _subborrow_u64(cc, nu_4, nv_4, &w);
-		cc = _subborrow_u64(cc, nu_5, nv_5, &w);
-		cc = _subborrow_u64(cc, nu_6, nv_6, &w);
-		cc = _subborrow_u64(cc, nu_7, nv_7, &w);
-		cc = _subborrow_u64(cc, nu_8, nv_8, &w);
-		cc = _subborrow_u64(cc, nu_9, nv_9, &w);
-		cc = _subborrow_u64(cc, nu_10, nv_10, &w);
-		cc = _subborrow_u64(cc, nu_11, nv_11, &w);
-		cc = _subborrow_u64(cc, nu_12, nv_12, &w);
-		cc = _subborrow_u64(cc, nu_13, nv_13, &w);
+		cc = subborrow_u64(0, nu_0, nv_0, &w);
+		cc = subborrow_u64(cc, nu_1, nv_1, &w);
+		cc = subborrow_u64(cc, nu_2, nv_2, &w);
+		cc = subborrow_u64(cc, nu_3, nv_3, &w);
+		cc = subborrow_u64(cc, nu_4, nv_4, &w);
+		cc = subborrow_u64(cc, nu_5, nv_5, &w);
+		cc = subborrow_u64(cc, nu_6, nv_6, &w);
+		cc = subborrow_u64(cc, nu_7, nv_7, &w);
+		cc = subborrow_u64(cc, nu_8, nv_8, &w);
+		cc = subborrow_u64(cc, nu_9, nv_9, &w);
+		cc = subborrow_u64(cc, nu_10, nv_10, &w);
+		cc = subborrow_u64(cc, nu_11, nv_11, &w);
+		cc = subborrow_u64(cc, nu_12, nv_12, &w);
+		cc = subborrow_u64(cc, nu_13, nv_13, &w);
 		m = -(unsigned long long)cc;
 
 
@@ -425,7 +372,7 @@ curve448_reduce_basis_vartime(
 		bitlength_top |= \
 			bitlength_word & -(unsigned long long)bitlength_flag; \
 		bitlength_acc -= bitlength_flag; \
-		(size) = (bitlength_acc << 6) - _lzcnt_u64(bitlength_top); \
+		(size) = (bitlength_acc << 6) - lzcnt_u64(bitlength_top); \
 	} while (0)
 
 		BITLENGTH(bl_nv, nv_);
@@ -614,74 +561,74 @@ curve448_reduce_basis_vartime(
 
 		if ((sp_13 >> 63) == 0) {
 			if (s == 0) {
-				cc = _subborrow_u64(0, u0_0, v0_0, &u0_0);
-				cc = _subborrow_u64(cc, u0_1, v0_1, &u0_1);
-				cc = _subborrow_u64(cc, u0_2, v0_2, &u0_2);
-				(void)_subborrow_u64(cc, u0_3, v0_3, &u0_3);
-
-				cc = _subborrow_u64(0, u1_0, v1_0, &u1_0);
-				cc = _subborrow_u64(cc, u1_1, v1_1, &u1_1);
-				cc = _subborrow_u64(cc, u1_2, v1_2, &u1_2);
-				(void)_subborrow_u64(cc, u1_3, v1_3, &u1_3);
-
-				cc = _addcarry_u64(0, nu_0, nv_0, &nu_0);
-				cc = _addcarry_u64(cc, nu_1, nv_1, &nu_1);
-				cc = _addcarry_u64(cc, nu_2, nv_2, &nu_2);
-				cc = _addcarry_u64(cc, nu_3, nv_3, &nu_3);
-				cc = _addcarry_u64(cc, nu_4, nv_4, &nu_4);
-				cc = _addcarry_u64(cc, nu_5, nv_5, &nu_5);
-				cc = _addcarry_u64(cc, nu_6, nv_6, &nu_6);
-				cc = _addcarry_u64(cc, nu_7, nv_7, &nu_7);
-				cc = _addcarry_u64(cc, nu_8, nv_8, &nu_8);
-				cc = _addcarry_u64(cc, nu_9, nv_9, &nu_9);
-				cc = _addcarry_u64(cc, nu_10, nv_10, &nu_10);
-				cc = _addcarry_u64(cc, nu_11, nv_11, &nu_11);
-				cc = _addcarry_u64(cc, nu_12, nv_12, &nu_12);
-				(void)_addcarry_u64(cc, nu_13, nv_13, &nu_13);
-
-				cc = _subborrow_u64(0, nu_0,
+				cc = subborrow_u64(0, u0_0, v0_0, &u0_0);
+				cc = subborrow_u64(cc, u0_1, v0_1, &u0_1);
+				cc = subborrow_u64(cc, u0_2, v0_2, &u0_2);
+				(void)subborrow_u64(cc, u0_3, v0_3, &u0_3);
+
+				cc = subborrow_u64(0, u1_0, v1_0, &u1_0);
+				cc = subborrow_u64(cc, u1_1, v1_1, &u1_1);
+				cc = subborrow_u64(cc, u1_2, v1_2, &u1_2);
+				(void)subborrow_u64(cc, u1_3, v1_3, &u1_3);
+
+				cc = addcarry_u64(0, nu_0, nv_0, &nu_0);
+				cc = addcarry_u64(cc, nu_1, nv_1, &nu_1);
+				cc = addcarry_u64(cc, nu_2, nv_2, &nu_2);
+				cc = addcarry_u64(cc, nu_3, nv_3, &nu_3);
+				cc = addcarry_u64(cc, nu_4, nv_4, &nu_4);
+				cc = addcarry_u64(cc, nu_5, nv_5, &nu_5);
+				cc = addcarry_u64(cc, nu_6, nv_6, &nu_6);
+				cc = addcarry_u64(cc, nu_7, nv_7, &nu_7);
+				cc = addcarry_u64(cc, nu_8, nv_8, &nu_8);
+				cc = addcarry_u64(cc, nu_9, nv_9, &nu_9);
+				cc = addcarry_u64(cc, nu_10, nv_10, &nu_10);
+				cc = addcarry_u64(cc, nu_11, nv_11, &nu_11);
+				cc = addcarry_u64(cc, nu_12, nv_12, &nu_12);
+				(void)addcarry_u64(cc, nu_13, nv_13, &nu_13);
+
+				cc = subborrow_u64(0, nu_0,
 					(sp_0 << 1), &nu_0);
-				cc = _subborrow_u64(cc, nu_1,
+				cc = subborrow_u64(cc, nu_1,
 					(sp_1 << 1) | (sp_0 >> 63), &nu_1);
-				cc = _subborrow_u64(cc, nu_2,
+				cc = subborrow_u64(cc, nu_2,
 					(sp_2 << 1) | (sp_1 >> 63), &nu_2);
-				cc = _subborrow_u64(cc, nu_3,
+				cc = subborrow_u64(cc, nu_3,
 					(sp_3 << 1) | (sp_2 >> 63), &nu_3);
-				cc = _subborrow_u64(cc, nu_4,
+				cc = subborrow_u64(cc, nu_4,
 					(sp_4 << 1) | (sp_3 >> 63), &nu_4);
-				cc = _subborrow_u64(cc, nu_5,
+				cc = subborrow_u64(cc, nu_5,
 					(sp_5 << 1) | (sp_4 >> 63), &nu_5);
-				cc = _subborrow_u64(cc, nu_6,
+				cc = subborrow_u64(cc, nu_6,
 					(sp_6 << 1) | (sp_5 >> 63), &nu_6);
-				cc = _subborrow_u64(cc, nu_7,
+				cc = subborrow_u64(cc, nu_7,
 					(sp_7 << 1) | (sp_6 >> 63), &nu_7);
-				cc = _subborrow_u64(cc, nu_8,
+				cc = subborrow_u64(cc, nu_8,
 					(sp_8 << 1) | (sp_7 >> 63), &nu_8);
-				cc = _subborrow_u64(cc, nu_9,
+				cc = subborrow_u64(cc, nu_9,
 					(sp_9 << 1) | (sp_8 >> 63), &nu_9);
-				cc = _subborrow_u64(cc, nu_10,
+				cc = subborrow_u64(cc, nu_10,
 					(sp_10 << 1) | (sp_9 >> 63), &nu_10);
-				cc = _subborrow_u64(cc, nu_11,
+				cc = subborrow_u64(cc, nu_11,
 					(sp_11 << 1) | (sp_10 >> 63), &nu_11);
-				cc = _subborrow_u64(cc, nu_12,
+				cc = subborrow_u64(cc, nu_12,
 					(sp_12 << 1) | (sp_11 >> 63), &nu_12);
-				(void)_subborrow_u64(cc, nu_13,
+				(void)subborrow_u64(cc, nu_13,
 					(sp_13 << 1) | (sp_12 >> 63), &nu_13);
 
-				cc = _subborrow_u64(0, sp_0, nv_0, &sp_0);
-				cc = _subborrow_u64(cc, sp_1, nv_1, &sp_1);
-				cc = _subborrow_u64(cc, sp_2, nv_2, &sp_2);
-				cc = _subborrow_u64(cc, sp_3, nv_3, &sp_3);
-				cc = _subborrow_u64(cc, sp_4, nv_4, &sp_4);
-				cc = _subborrow_u64(cc, sp_5, nv_5, &sp_5);
-				cc = _subborrow_u64(cc, sp_6, nv_6, &sp_6);
-				cc = _subborrow_u64(cc, sp_7, nv_7, &sp_7);
-				cc = _subborrow_u64(cc, sp_8, nv_8, &sp_8);
-				cc = _subborrow_u64(cc, sp_9, nv_9, &sp_9);
-				cc = _subborrow_u64(cc, sp_10, nv_10, &sp_10);
-				cc = _subborrow_u64(cc, sp_11, nv_11, &sp_11);
-				cc = _subborrow_u64(cc, sp_12, nv_12, &sp_12);
-				(void)_subborrow_u64(cc, sp_13, nv_13, &sp_13);
+				cc = subborrow_u64(0, sp_0, nv_0, &sp_0);
+				cc = subborrow_u64(cc, sp_1, nv_1, &sp_1);
+				cc = subborrow_u64(cc, sp_2, nv_2, &sp_2);
+				cc = subborrow_u64(cc, sp_3, nv_3, &sp_3);
+				cc = subborrow_u64(cc, sp_4, nv_4, &sp_4);
+				cc = subborrow_u64(cc, sp_5, nv_5, &sp_5);
+				cc = subborrow_u64(cc, sp_6, nv_6, &sp_6);
+				cc = subborrow_u64(cc, sp_7, nv_7, &sp_7);
+				cc = subborrow_u64(cc, sp_8, nv_8, &sp_8);
+				cc = subborrow_u64(cc, sp_9, nv_9, &sp_9);
+				cc = subborrow_u64(cc, sp_10, nv_10, &sp_10);
+				cc = subborrow_u64(cc, sp_11, nv_11, &sp_11);
+				cc = subborrow_u64(cc, sp_12, nv_12, &sp_12);
+				(void)subborrow_u64(cc, sp_13, nv_13, &sp_13);
 
 			} else {
 				unsigned rs, s1, rs1, s2, rs2;
@@ -692,184 +639,184 @@ curve448_reduce_basis_vartime(
 				s2 = s << 1;
 				rs2 = 64 - s2;
 
-				cc = _subborrow_u64(0, u0_0,
+				cc = subborrow_u64(0, u0_0,
 					(v0_0 << s), &u0_0);
-				cc = _subborrow_u64(cc, u0_1,
+				cc = subborrow_u64(cc, u0_1,
 					(v0_1 << s) | (v0_0 >> rs), &u0_1);
-				cc = _subborrow_u64(cc, u0_2,
+				cc = subborrow_u64(cc, u0_2,
 					(v0_2 << s) | (v0_1 >> rs), &u0_2);
-				(void)_subborrow_u64(cc, u0_3,
+				(void)subborrow_u64(cc, u0_3,
 					(v0_3 << s) | (v0_2 >> rs), &u0_3);
 
 
-				cc = _subborrow_u64(0, u1_0,
+				cc = subborrow_u64(0, u1_0,
 					(v1_0 << s), &u1_0);
-				cc = _subborrow_u64(cc, u1_1,
+				cc = subborrow_u64(cc, u1_1,
 					(v1_1 << s) | (v1_0 >> rs), &u1_1);
-				cc = _subborrow_u64(cc, u1_2,
+				cc = subborrow_u64(cc, u1_2,
 					(v1_2 << s) | (v1_1 >> rs), &u1_2);
-				(void)_subborrow_u64(cc, u1_3,
+				(void)subborrow_u64(cc, u1_3,
 					(v1_3 << s) | (v1_2 >> rs), &u1_3);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(nv_0 << s2), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(nv_1 << s2) | (nv_0 >> rs2), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(nv_2 << s2) | (nv_1 >> rs2), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(nv_3 << s2) | (nv_2 >> rs2), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(nv_4 << s2) | (nv_3 >> rs2), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(nv_5 << s2) | (nv_4 >> rs2), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(nv_6 << s2) | (nv_5 >> rs2), &nu_6);
-				cc = _addcarry_u64(cc, nu_7,
+				cc = addcarry_u64(cc, nu_7,
 					(nv_7 << s2) | (nv_6 >> rs2), &nu_7);
-				cc = _addcarry_u64(cc, nu_8,
+				cc = addcarry_u64(cc, nu_8,
 					(nv_8 << s2) | (nv_7 >> rs2), &nu_8);
-				cc = _addcarry_u64(cc, nu_9,
+				cc = addcarry_u64(cc, nu_9,
 					(nv_9 << s2) | (nv_8 >> rs2), &nu_9);
-				cc = _addcarry_u64(cc, nu_10,
+				cc = addcarry_u64(cc, nu_10,
 					(nv_10 << s2) | (nv_9 >> rs2), &nu_10);
-				cc = _addcarry_u64(cc, nu_11,
+				cc = addcarry_u64(cc, nu_11,
 					(nv_11 << s2) | (nv_10 >> rs2), &nu_11);
-				cc = _addcarry_u64(cc, nu_12,
+				cc = addcarry_u64(cc, nu_12,
 					(nv_12 << s2) | (nv_11 >> rs2), &nu_12);
-				(void)_addcarry_u64(cc, nu_13,
+				(void)addcarry_u64(cc, nu_13,
 					(nv_13 << s2) | (nv_12 >> rs2), &nu_13);
 
-				cc = _subborrow_u64(0, nu_0,
+				cc = subborrow_u64(0, nu_0,
 					(sp_0 << s1), &nu_0);
-				cc = _subborrow_u64(cc, nu_1,
+				cc = subborrow_u64(cc, nu_1,
 					(sp_1 << s1) | (sp_0 >> rs1), &nu_1);
-				cc = _subborrow_u64(cc, nu_2,
+				cc = subborrow_u64(cc, nu_2,
 					(sp_2 << s1) | (sp_1 >> rs1), &nu_2);
-				cc = _subborrow_u64(cc, nu_3,
+				cc = subborrow_u64(cc, nu_3,
 					(sp_3 << s1) | (sp_2 >> rs1), &nu_3);
-				cc = _subborrow_u64(cc, nu_4,
+				cc = subborrow_u64(cc, nu_4,
 					(sp_4 << s1) | (sp_3 >> rs1), &nu_4);
-				cc = _subborrow_u64(cc, nu_5,
+				cc = subborrow_u64(cc, nu_5,
 					(sp_5 << s1) | (sp_4 >> rs1), &nu_5);
-				cc = _subborrow_u64(cc, nu_6,
+				cc = subborrow_u64(cc, nu_6,
 					(sp_6 << s1) | (sp_5 >> rs1), &nu_6);
-				cc = _subborrow_u64(cc, nu_7,
+				cc = subborrow_u64(cc, nu_7,
 					(sp_7 << s1) | (sp_6 >> rs1), &nu_7);
-				cc = _subborrow_u64(cc, nu_8,
+				cc = subborrow_u64(cc, nu_8,
 					(sp_8 << s1) | (sp_7 >> rs1), &nu_8);
-				cc = _subborrow_u64(cc, nu_9,
+				cc = subborrow_u64(cc, nu_9,
 					(sp_9 << s1) | (sp_8 >> rs1), &nu_9);
-				cc = _subborrow_u64(cc, nu_10,
+				cc = subborrow_u64(cc, nu_10,
 					(sp_10 << s1) | (sp_9 >> rs1), &nu_10);
-				cc = _subborrow_u64(cc, nu_11,
+				cc = subborrow_u64(cc, nu_11,
 					(sp_11 << s1) | (sp_10 >> rs1), &nu_11);
-				cc = _subborrow_u64(cc, nu_12,
+				cc = subborrow_u64(cc, nu_12,
 					(sp_12 << s1) | (sp_11 >> rs1), &nu_12);
-				(void)_subborrow_u64(cc, nu_13,
+				(void)subborrow_u64(cc, nu_13,
 					(sp_13 << s1) | (sp_12 >> rs1), &nu_13);
 
-				cc = _subborrow_u64(0, sp_0,
+				cc = subborrow_u64(0, sp_0,
 					(nv_0 << s), &sp_0);
-				cc = _subborrow_u64(cc, sp_1,
+				cc = subborrow_u64(cc, sp_1,
 					(nv_1 << s) | (nv_0 >> rs), &sp_1);
-				cc = _subborrow_u64(cc, sp_2,
+				cc = subborrow_u64(cc, sp_2,
 					(nv_2 << s) | (nv_1 >> rs), &sp_2);
-				cc = _subborrow_u64(cc, sp_3,
+				cc = subborrow_u64(cc, sp_3,
 					(nv_3 << s) | (nv_2 >> rs), &sp_3);
-				cc = _subborrow_u64(cc, sp_4,
+				cc = subborrow_u64(cc, sp_4,
 					(nv_4 << s) | (nv_3 >> rs), &sp_4);
-				cc = _subborrow_u64(cc, sp_5,
+				cc = subborrow_u64(cc, sp_5,
 					(nv_5 << s) | (nv_4 >> rs), &sp_5);
-				cc = _subborrow_u64(cc, sp_6,
+				cc = subborrow_u64(cc, sp_6,
 					(nv_6 << s) | (nv_5 >> rs), &sp_6);
-				cc = _subborrow_u64(cc, sp_7,
+				cc = subborrow_u64(cc, sp_7,
 					(nv_7 << s) | (nv_6 >> rs), &sp_7);
-				cc = _subborrow_u64(cc, sp_8,
+				cc = subborrow_u64(cc, sp_8,
 					(nv_8 << s) | (nv_7 >> rs), &sp_8);
-				cc = _subborrow_u64(cc, sp_9,
+				cc = subborrow_u64(cc, sp_9,
 					(nv_9 << s) | (nv_8 >> rs), &sp_9);
-				cc = _subborrow_u64(cc, sp_10,
+				cc = subborrow_u64(cc, sp_10,
 					(nv_10 << s) | (nv_9 >> rs), &sp_10);
-				cc = _subborrow_u64(cc, sp_11,
+				cc = subborrow_u64(cc, sp_11,
 					(nv_11 << s) | (nv_10 >> rs), &sp_11);
-				cc = _subborrow_u64(cc, sp_12,
+				cc = subborrow_u64(cc, sp_12,
 					(nv_12 << s) | (nv_11 >> rs), &sp_12);
-				(void)_subborrow_u64(cc, sp_13,
+				(void)subborrow_u64(cc, sp_13,
 					(nv_13 << s) | (nv_12 >> rs), &sp_13);
 			}
 		} else {
 			if (s == 0) {
-				cc = _addcarry_u64(0, u0_0, v0_0, &u0_0);
-				cc = _addcarry_u64(cc, u0_1, v0_1, &u0_1);
-				cc = _addcarry_u64(cc, u0_2, v0_2, &u0_2);
-				(void)_addcarry_u64(cc, u0_3, v0_3, &u0_3);
-
-				cc = _addcarry_u64(0, u1_0, v1_0, &u1_0);
-				cc = _addcarry_u64(cc, u1_1, v1_1, &u1_1);
-				cc = _addcarry_u64(cc, u1_2, v1_2, &u1_2);
-				(void)_addcarry_u64(cc, u1_3, v1_3, &u1_3);
-
-				cc = _addcarry_u64(0, nu_0, nv_0, &nu_0);
-				cc = _addcarry_u64(cc, nu_1, nv_1, &nu_1);
-				cc = _addcarry_u64(cc, nu_2, nv_2, &nu_2);
-				cc = _addcarry_u64(cc, nu_3, nv_3, &nu_3);
-				cc = _addcarry_u64(cc, nu_4, nv_4, &nu_4);
-				cc = _addcarry_u64(cc, nu_5, nv_5, &nu_5);
-				cc = _addcarry_u64(cc, nu_6, nv_6, &nu_6);
-				cc = _addcarry_u64(cc, nu_7, nv_7, &nu_7);
-				cc = _addcarry_u64(cc, nu_8, nv_8, &nu_8);
-				cc = _addcarry_u64(cc, nu_9, nv_9, &nu_9);
-				cc = _addcarry_u64(cc, nu_10, nv_10, &nu_10);
-				cc = _addcarry_u64(cc, nu_11, nv_11, &nu_11);
-				cc = _addcarry_u64(cc, nu_12, nv_12, &nu_12);
-				(void)_addcarry_u64(cc, nu_13, nv_13, &nu_13);
-
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, u0_0, v0_0, &u0_0);
+				cc = addcarry_u64(cc, u0_1, v0_1, &u0_1);
+				cc = addcarry_u64(cc, u0_2, v0_2, &u0_2);
+				(void)addcarry_u64(cc, u0_3, v0_3, &u0_3);
+
+				cc = addcarry_u64(0, u1_0, v1_0, &u1_0);
+				cc = addcarry_u64(cc, u1_1, v1_1, &u1_1);
+				cc = addcarry_u64(cc, u1_2, v1_2, &u1_2);
+				(void)addcarry_u64(cc, u1_3, v1_3, &u1_3);
+
+				cc = addcarry_u64(0, nu_0, nv_0, &nu_0);
+				cc = addcarry_u64(cc, nu_1, nv_1, &nu_1);
+				cc = addcarry_u64(cc, nu_2, nv_2, &nu_2);
+				cc = addcarry_u64(cc, nu_3, nv_3, &nu_3);
+				cc = addcarry_u64(cc, nu_4, nv_4, &nu_4);
+				cc = addcarry_u64(cc, nu_5, nv_5, &nu_5);
+				cc = addcarry_u64(cc, nu_6, nv_6, &nu_6);
+				cc = addcarry_u64(cc, nu_7, nv_7, &nu_7);
+				cc = addcarry_u64(cc, nu_8, nv_8, &nu_8);
+				cc = addcarry_u64(cc, nu_9, nv_9, &nu_9);
+				cc = addcarry_u64(cc, nu_10, nv_10, &nu_10);
+				cc = addcarry_u64(cc, nu_11, nv_11, &nu_11);
+				cc = addcarry_u64(cc, nu_12, nv_12, &nu_12);
+				(void)addcarry_u64(cc, nu_13, nv_13, &nu_13);
+
+				cc = addcarry_u64(0, nu_0,
 					(sp_0 << 1), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(sp_1 << 1) | (sp_0 >> 63), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(sp_2 << 1) | (sp_1 >> 63), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(sp_3 << 1) | (sp_2 >> 63), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(sp_4 << 1) | (sp_3 >> 63), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(sp_5 << 1) | (sp_4 >> 63), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(sp_6 << 1) | (sp_5 >> 63), &nu_6);
-				cc = _addcarry_u64(cc, nu_7,
+				cc = addcarry_u64(cc, nu_7,
 					(sp_7 << 1) | (sp_6 >> 63), &nu_7);
-				cc = _addcarry_u64(cc, nu_8,
+				cc = addcarry_u64(cc, nu_8,
 					(sp_8 << 1) | (sp_7 >> 63), &nu_8);
-				cc = _addcarry_u64(cc, nu_9,
+				cc = addcarry_u64(cc, nu_9,
 					(sp_9 << 1) | (sp_8 >> 63), &nu_9);
-				cc = _addcarry_u64(cc, nu_10,
+				cc = addcarry_u64(cc, nu_10,
 					(sp_10 << 1) | (sp_9 >> 63), &nu_10);
-				cc = _addcarry_u64(cc, nu_11,
+				cc = addcarry_u64(cc, nu_11,
 					(sp_11 << 1) | (sp_10 >> 63), &nu_11);
-				cc = _addcarry_u64(cc, nu_12,
+				cc = addcarry_u64(cc, nu_12,
 					(sp_12 << 1) | (sp_11 >> 63), &nu_12);
-				(void)_addcarry_u64(cc, nu_13,
+				(void)addcarry_u64(cc, nu_13,
 					(sp_13 << 1) | (sp_12 >> 63), &nu_13);
 
 
 
-				cc = _addcarry_u64(0, sp_0, nv_0, &sp_0);
-				cc = _addcarry_u64(cc, sp_1, nv_1, &sp_1);
-				cc = _addcarry_u64(cc, sp_2, nv_2, &sp_2);
-				cc = _addcarry_u64(cc, sp_3, nv_3, &sp_3);
-				cc = _addcarry_u64(cc, sp_4, nv_4, &sp_4);
-				cc = _addcarry_u64(cc, sp_5, nv_5, &sp_5);
-				cc = _addcarry_u64(cc, sp_6, nv_6, &sp_6);
-				cc = _addcarry_u64(cc, sp_7, nv_7, &sp_7);
-				cc = _addcarry_u64(cc, sp_8, nv_8, &sp_8);
-				cc = _addcarry_u64(cc, sp_9, nv_9, &sp_9);
-				cc = _addcarry_u64(cc, sp_10, nv_10, &sp_10);
-				cc = _addcarry_u64(cc, sp_11, nv_11, &sp_11);
-				cc = _addcarry_u64(cc, sp_12, nv_12, &sp_12);
-				(void)_addcarry_u64(cc, sp_13, nv_13, &sp_13);
+				cc = addcarry_u64(0, sp_0, nv_0, &sp_0);
+				cc = addcarry_u64(cc, sp_1, nv_1, &sp_1);
+				cc = addcarry_u64(cc, sp_2, nv_2, &sp_2);
+				cc = addcarry_u64(cc, sp_3, nv_3, &sp_3);
+				cc = addcarry_u64(cc, sp_4, nv_4, &sp_4);
+				cc = addcarry_u64(cc, sp_5, nv_5, &sp_5);
+				cc = addcarry_u64(cc, sp_6, nv_6, &sp_6);
+				cc = addcarry_u64(cc, sp_7, nv_7, &sp_7);
+				cc = addcarry_u64(cc, sp_8, nv_8, &sp_8);
+				cc = addcarry_u64(cc, sp_9, nv_9, &sp_9);
+				cc = addcarry_u64(cc, sp_10, nv_10, &sp_10);
+				cc = addcarry_u64(cc, sp_11, nv_11, &sp_11);
+				cc = addcarry_u64(cc, sp_12, nv_12, &sp_12);
+				(void)addcarry_u64(cc, sp_13, nv_13, &sp_13);
 
 			} else {
 				unsigned rs, s1, rs1, s2, rs2;
@@ -880,110 +827,110 @@ curve448_reduce_basis_vartime(
 				s2 = s << 1;
 				rs2 = 64 - s2;
 
-				cc = _addcarry_u64(0, u0_0,
+				cc = addcarry_u64(0, u0_0,
 					(v0_0 << s), &u0_0);
-				cc = _addcarry_u64(cc, u0_1,
+				cc = addcarry_u64(cc, u0_1,
 					(v0_1 << s) | (v0_0 >> rs), &u0_1);
-				cc = _addcarry_u64(cc, u0_2,
+				cc = addcarry_u64(cc, u0_2,
 					(v0_2 << s) | (v0_1 >> rs), &u0_2);
-				(void)_addcarry_u64(cc, u0_3,
+				(void)addcarry_u64(cc, u0_3,
 					(v0_3 << s) | (v0_2 >> rs), &u0_3);
 
 
-				cc = _addcarry_u64(0, u1_0,
+				cc = addcarry_u64(0, u1_0,
 					(v1_0 << s), &u1_0);
-				cc = _addcarry_u64(cc, u1_1,
+				cc = addcarry_u64(cc, u1_1,
 					(v1_1 << s) | (v1_0 >> rs), &u1_1);
-				cc = _addcarry_u64(cc, u1_2,
+				cc = addcarry_u64(cc, u1_2,
 					(v1_2 << s) | (v1_1 >> rs), &u1_2);
-				(void)_addcarry_u64(cc, u1_3,
+				(void)addcarry_u64(cc, u1_3,
 					(v1_3 << s) | (v1_2 >> rs), &u1_3);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(nv_0 << s2), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(nv_1 << s2) | (nv_0 >> rs2), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(nv_2 << s2) | (nv_1 >> rs2), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(nv_3 << s2) | (nv_2 >> rs2), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(nv_4 << s2) | (nv_3 >> rs2), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(nv_5 << s2) | (nv_4 >> rs2), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(nv_6 << s2) | (nv_5 >> rs2), &nu_6);
-				cc = _addcarry_u64(cc, nu_7,
+				cc = addcarry_u64(cc, nu_7,
 					(nv_7 << s2) | (nv_6 >> rs2), &nu_7);
-				cc = _addcarry_u64(cc, nu_8,
+				cc = addcarry_u64(cc, nu_8,
 					(nv_8 << s2) | (nv_7 >> rs2), &nu_8);
-				cc = _addcarry_u64(cc, nu_9,
+				cc = addcarry_u64(cc, nu_9,
 					(nv_9 << s2) | (nv_8 >> rs2), &nu_9);
-				cc = _addcarry_u64(cc, nu_10,
+				cc = addcarry_u64(cc, nu_10,
 					(nv_10 << s2) | (nv_9 >> rs2), &nu_10);
-				cc = _addcarry_u64(cc, nu_11,
+				cc = addcarry_u64(cc, nu_11,
 					(nv_11 << s2) | (nv_10 >> rs2), &nu_11);
-				cc = _addcarry_u64(cc, nu_12,
+				cc = addcarry_u64(cc, nu_12,
 					(nv_12 << s2) | (nv_11 >> rs2), &nu_12);
-				(void)_addcarry_u64(cc, nu_13,
+				(void)addcarry_u64(cc, nu_13,
 					(nv_13 << s2) | (nv_12 >> rs2), &nu_13);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(sp_0 << s1), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(sp_1 << s1) | (sp_0 >> rs1), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(sp_2 << s1) | (sp_1 >> rs1), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(sp_3 << s1) | (sp_2 >> rs1), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(sp_4 << s1) | (sp_3 >> rs1), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(sp_5 << s1) | (sp_4 >> rs1), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(sp_6 << s1) | (sp_5 >> rs1), &nu_6);
-				cc = _addcarry_u64(cc, nu_7,
+				cc = addcarry_u64(cc, nu_7,
 					(sp_7 << s1) | (sp_6 >> rs1), &nu_7);
-				cc = _addcarry_u64(cc, nu_8,
+				cc = addcarry_u64(cc, nu_8,
 					(sp_8 << s1) | (sp_7 >> rs1), &nu_8);
-				cc = _addcarry_u64(cc, nu_9,
+				cc = addcarry_u64(cc, nu_9,
 					(sp_9 << s1) | (sp_8 >> rs1), &nu_9);
-				cc = _addcarry_u64(cc, nu_10,
+				cc = addcarry_u64(cc, nu_10,
 					(sp_10 << s1) | (sp_9 >> rs1), &nu_10);
-				cc = _addcarry_u64(cc, nu_11,
+				cc = addcarry_u64(cc, nu_11,
 					(sp_11 << s1) | (sp_10 >> rs1), &nu_11);
-				cc = _addcarry_u64(cc, nu_12,
+				cc = addcarry_u64(cc, nu_12,
 					(sp_12 << s1) | (sp_11 >> rs1), &nu_12);
-				(void)_addcarry_u64(cc, nu_13,
+				(void)addcarry_u64(cc, nu_13,
 					(sp_13 << s1) | (sp_12 >> rs1), &nu_13);
 
-				cc = _addcarry_u64(0, sp_0,
+				cc = addcarry_u64(0, sp_0,
 					(nv_0 << s), &sp_0);
-				cc = _addcarry_u64(cc, sp_1,
+				cc = addcarry_u64(cc, sp_1,
 					(nv_1 << s) | (nv_0 >> rs), &sp_1);
-				cc = _addcarry_u64(cc, sp_2,
+				cc = addcarry_u64(cc, sp_2,
 					(nv_2 << s) | (nv_1 >> rs), &sp_2);
-				cc = _addcarry_u64(cc, sp_3,
+				cc = addcarry_u64(cc, sp_3,
 					(nv_3 << s) | (nv_2 >> rs), &sp_3);
-				cc = _addcarry_u64(cc, sp_4,
+				cc = addcarry_u64(cc, sp_4,
 					(nv_4 << s) | (nv_3 >> rs), &sp_4);
-				cc = _addcarry_u64(cc, sp_5,
+				cc = addcarry_u64(cc, sp_5,
 					(nv_5 << s) | (nv_4 >> rs), &sp_5);
-				cc = _addcarry_u64(cc, sp_6,
+				cc = addcarry_u64(cc, sp_6,
 					(nv_6 << s) | (nv_5 >> rs), &sp_6);
-				cc = _addcarry_u64(cc, sp_7,
+				cc = addcarry_u64(cc, sp_7,
 					(nv_7 << s) | (nv_6 >> rs), &sp_7);
-				cc = _addcarry_u64(cc, sp_8,
+				cc = addcarry_u64(cc, sp_8,
 					(nv_8 << s) | (nv_7 >> rs), &sp_8);
-				cc = _addcarry_u64(cc, sp_9,
+				cc = addcarry_u64(cc, sp_9,
 					(nv_9 << s) | (nv_8 >> rs), &sp_9);
-				cc = _addcarry_u64(cc, sp_10,
+				cc = addcarry_u64(cc, sp_10,
 					(nv_10 << s) | (nv_9 >> rs), &sp_10);
-				cc = _addcarry_u64(cc, sp_11,
+				cc = addcarry_u64(cc, sp_11,
 					(nv_11 << s) | (nv_10 >> rs), &sp_11);
-				cc = _addcarry_u64(cc, sp_12,
+				cc = addcarry_u64(cc, sp_12,
 					(nv_12 << s) | (nv_11 >> rs), &sp_12);
-				(void)_addcarry_u64(cc, sp_13,
+				(void)addcarry_u64(cc, sp_13,
 					(nv_13 << s) | (nv_12 >> rs), &sp_13);
 			}
 		}
@@ -1002,20 +949,20 @@ curve448_reduce_basis_vartime(
 		/*
 		 * If nu < nv, then swap(u,v) and swap(nu,nv).
 		 */
-		cc = _subborrow_u64(0, nu_0, nv_0, &w);
-		cc = _subborrow_u64(cc, nu_1, nv_1, &w);
-		cc = _subborrow_u64(cc, nu_2, nv_2, &w);
-		cc = _subborrow_u64(cc, nu_3, nv_3, &w);
-		cc = _subborrow_u64(cc, nu_4, nv_4, &w);
-		cc = _subborrow_u64(cc, nu_5, nv_5, &w);
-		cc = _subborrow_u64(cc, nu_6, nv_6, &w);
-		cc = _subborrow_u64(cc, nu_7, nv_7, &w);
-		cc = _subborrow_u64(cc, nu_8, nv_8, &w);
-		cc = _subborrow_u64(cc, nu_9, nv_9, &w);
-		cc = _subborrow_u64(cc, nu_10, nv_10, &w);
-		cc = _subborrow_u64(cc, nu_11, nv_11, &w);
-		// cc = _subborrow_u64(cc, nu_12, nv_12, &w);
-		// cc = _subborrow_u64(cc, nu_13, nv_13, &w);
+		cc = subborrow_u64(0, nu_0, nv_0, &w);
+		cc = subborrow_u64(cc, nu_1, nv_1, &w);
+		cc = subborrow_u64(cc, nu_2, nv_2, &w);
+		cc = subborrow_u64(cc, nu_3, nv_3, &w);
+		cc = subborrow_u64(cc, nu_4, nv_4, &w);
+		cc = subborrow_u64(cc, nu_5, nv_5, &w);
+		cc = subborrow_u64(cc, nu_6, nv_6, &w);
+		cc = subborrow_u64(cc, nu_7, nv_7, &w);
+		cc = subborrow_u64(cc, nu_8, nv_8, &w);
+		cc = subborrow_u64(cc, nu_9, nv_9, &w);
+		cc = subborrow_u64(cc, nu_10, nv_10, &w);
+		cc = subborrow_u64(cc, nu_11, nv_11, &w);
+		// cc = subborrow_u64(cc, nu_12, nv_12, &w);
+		// cc = subborrow_u64(cc, nu_13, nv_13, &w);
 		m = -(unsigned long long)cc;
 
 
@@ -1118,7 +1065,7 @@ curve448_reduce_basis_vartime(
 		bitlength_top |= \
 			bitlength_word & -(unsigned long long)bitlength_flag; \
 		bitlength_acc -= bitlength_flag; \
-		(size) = (bitlength_acc << 6) - _lzcnt_u64(bitlength_top); \
+		(size) = (bitlength_acc << 6) - lzcnt_u64(bitlength_top); \
 	} while (0)
 
 		BITLENGTH12(bl_nv, nv_);
@@ -1307,74 +1254,74 @@ curve448_reduce_basis_vartime(
 
 		if ((sp_11 >> 63) == 0) {
 			if (s == 0) {
-				cc = _subborrow_u64(0, u0_0, v0_0, &u0_0);
-				cc = _subborrow_u64(cc, u0_1, v0_1, &u0_1);
-				cc = _subborrow_u64(cc, u0_2, v0_2, &u0_2);
-				(void)_subborrow_u64(cc, u0_3, v0_3, &u0_3);
-
-				cc = _subborrow_u64(0, u1_0, v1_0, &u1_0);
-				cc = _subborrow_u64(cc, u1_1, v1_1, &u1_1);
-				cc = _subborrow_u64(cc, u1_2, v1_2, &u1_2);
-				(void)_subborrow_u64(cc, u1_3, v1_3, &u1_3);
-
-				cc = _addcarry_u64(0, nu_0, nv_0, &nu_0);
-				cc = _addcarry_u64(cc, nu_1, nv_1, &nu_1);
-				cc = _addcarry_u64(cc, nu_2, nv_2, &nu_2);
-				cc = _addcarry_u64(cc, nu_3, nv_3, &nu_3);
-				cc = _addcarry_u64(cc, nu_4, nv_4, &nu_4);
-				cc = _addcarry_u64(cc, nu_5, nv_5, &nu_5);
-				cc = _addcarry_u64(cc, nu_6, nv_6, &nu_6);
-				cc = _addcarry_u64(cc, nu_7, nv_7, &nu_7);
-				cc = _addcarry_u64(cc, nu_8, nv_8, &nu_8);
-				cc = _addcarry_u64(cc, nu_9, nv_9, &nu_9);
-				cc = _addcarry_u64(cc, nu_10, nv_10, &nu_10);
-				(void)_addcarry_u64(cc, nu_11, nv_11, &nu_11);
-				// cc = _addcarry_u64(cc, nu_12, nv_12, &nu_12);
-				// (void)_addcarry_u64(cc, nu_13, nv_13, &nu_13);
-
-				cc = _subborrow_u64(0, nu_0,
+				cc = subborrow_u64(0, u0_0, v0_0, &u0_0);
+				cc = subborrow_u64(cc, u0_1, v0_1, &u0_1);
+				cc = subborrow_u64(cc, u0_2, v0_2, &u0_2);
+				(void)subborrow_u64(cc, u0_3, v0_3, &u0_3);
+
+				cc = subborrow_u64(0, u1_0, v1_0, &u1_0);
+				cc = subborrow_u64(cc, u1_1, v1_1, &u1_1);
+				cc = subborrow_u64(cc, u1_2, v1_2, &u1_2);
+				(void)subborrow_u64(cc, u1_3, v1_3, &u1_3);
+
+				cc = addcarry_u64(0, nu_0, nv_0, &nu_0);
+				cc = addcarry_u64(cc, nu_1, nv_1, &nu_1);
+				cc = addcarry_u64(cc, nu_2, nv_2, &nu_2);
+				cc = addcarry_u64(cc, nu_3, nv_3, &nu_3);
+				cc = addcarry_u64(cc, nu_4, nv_4, &nu_4);
+				cc = addcarry_u64(cc, nu_5, nv_5, &nu_5);
+				cc = addcarry_u64(cc, nu_6, nv_6, &nu_6);
+				cc = addcarry_u64(cc, nu_7, nv_7, &nu_7);
+				cc = addcarry_u64(cc, nu_8, nv_8, &nu_8);
+				cc = addcarry_u64(cc, nu_9, nv_9, &nu_9);
+				cc = addcarry_u64(cc, nu_10, nv_10, &nu_10);
+				(void)addcarry_u64(cc, nu_11, nv_11, &nu_11);
+				// cc = addcarry_u64(cc, nu_12, nv_12, &nu_12);
+				// (void)addcarry_u64(cc, nu_13, nv_13, &nu_13);
+
+				cc = subborrow_u64(0, nu_0,
 					(sp_0 << 1), &nu_0);
-				cc = _subborrow_u64(cc, nu_1,
+				cc = subborrow_u64(cc, nu_1,
 					(sp_1 << 1) | (sp_0 >> 63), &nu_1);
-				cc = _subborrow_u64(cc, nu_2,
+				cc = subborrow_u64(cc, nu_2,
 					(sp_2 << 1) | (sp_1 >> 63), &nu_2);
-				cc = _subborrow_u64(cc, nu_3,
+				cc = subborrow_u64(cc, nu_3,
 					(sp_3 << 1) | (sp_2 >> 63), &nu_3);
-				cc = _subborrow_u64(cc, nu_4,
+				cc = subborrow_u64(cc, nu_4,
 					(sp_4 << 1) | (sp_3 >> 63), &nu_4);
-				cc = _subborrow_u64(cc, nu_5,
+				cc = subborrow_u64(cc, nu_5,
 					(sp_5 << 1) | (sp_4 >> 63), &nu_5);
-				cc = _subborrow_u64(cc, nu_6,
+				cc = subborrow_u64(cc, nu_6,
 					(sp_6 << 1) | (sp_5 >> 63), &nu_6);
-				cc = _subborrow_u64(cc, nu_7,
+				cc = subborrow_u64(cc, nu_7,
 					(sp_7 << 1) | (sp_6 >> 63), &nu_7);
-				cc = _subborrow_u64(cc, nu_8,
+				cc = subborrow_u64(cc, nu_8,
 					(sp_8 << 1) | (sp_7 >> 63), &nu_8);
-				cc = _subborrow_u64(cc, nu_9,
+				cc = subborrow_u64(cc, nu_9,
 					(sp_9 << 1) | (sp_8 >> 63), &nu_9);
-				cc = _subborrow_u64(cc, nu_10,
+				cc = subborrow_u64(cc, nu_10,
 					(sp_10 << 1) | (sp_9 >> 63), &nu_10);
-				(void)_subborrow_u64(cc, nu_11,
+				(void)subborrow_u64(cc, nu_11,
 					(sp_11 << 1) | (sp_10 >> 63), &nu_11);
-				// cc = _subborrow_u64(cc, nu_12,
+				// cc = subborrow_u64(cc, nu_12,
 				// 	(sp_12 << 1) | (sp_11 >> 63), &nu_12);
-				// (void)_subborrow_u64(cc, nu_13,
+				// (void)subborrow_u64(cc, nu_13,
 				// 	(sp_13 << 1) | (sp_12 >> 63), &nu_13);
 
-				cc = _subborrow_u64(0, sp_0, nv_0, &sp_0);
-				cc = _subborrow_u64(cc, sp_1, nv_1, &sp_1);
-				cc = _subborrow_u64(cc, sp_2, nv_2, &sp_2);
-				cc = _subborrow_u64(cc, sp_3, nv_3, &sp_3);
-				cc = _subborrow_u64(cc, sp_4, nv_4, &sp_4);
-				cc = _subborrow_u64(cc, sp_5, nv_5, &sp_5);
-				cc = _subborrow_u64(cc, sp_6, nv_6, &sp_6);
-				cc = _subborrow_u64(cc, sp_7, nv_7, &sp_7);
-				cc = _subborrow_u64(cc, sp_8, nv_8, &sp_8);
-				cc = _subborrow_u64(cc, sp_9, nv_9, &sp_9);
-				cc = _subborrow_u64(cc, sp_10, nv_10, &sp_10);
-				(void)_subborrow_u64(cc, sp_11, nv_11, &sp_11);
-				// cc = _subborrow_u64(cc, sp_12, nv_12, &sp_12);
-				// (void)_subborrow_u64(cc, sp_13, nv_13, &sp_13);
+				cc = subborrow_u64(0, sp_0, nv_0, &sp_0);
+				cc = subborrow_u64(cc, sp_1, nv_1, &sp_1);
+				cc = subborrow_u64(cc, sp_2, nv_2, &sp_2);
+				cc = subborrow_u64(cc, sp_3, nv_3, &sp_3);
+				cc = subborrow_u64(cc, sp_4, nv_4, &sp_4);
+				cc = subborrow_u64(cc, sp_5, nv_5, &sp_5);
+				cc = subborrow_u64(cc, sp_6, nv_6, &sp_6);
+				cc = subborrow_u64(cc, sp_7, nv_7, &sp_7);
+				cc = subborrow_u64(cc, sp_8, nv_8, &sp_8);
+				cc = subborrow_u64(cc, sp_9, nv_9, &sp_9);
+				cc = subborrow_u64(cc, sp_10, nv_10, &sp_10);
+				(void)subborrow_u64(cc, sp_11, nv_11, &sp_11);
+				// cc = subborrow_u64(cc, sp_12, nv_12, &sp_12);
+				// (void)subborrow_u64(cc, sp_13, nv_13, &sp_13);
 
 			} else {
 				unsigned rs, s1, rs1, s2, rs2;
@@ -1385,183 +1332,183 @@ curve448_reduce_basis_vartime(
 				s2 = s << 1;
 				rs2 = 64 - s2;
 
-				cc = _subborrow_u64(0, u0_0,
+				cc = subborrow_u64(0, u0_0,
 					(v0_0 << s), &u0_0);
-				cc = _subborrow_u64(cc, u0_1,
+				cc = subborrow_u64(cc, u0_1,
 					(v0_1 << s) | (v0_0 >> rs), &u0_1);
-				cc = _subborrow_u64(cc, u0_2,
+				cc = subborrow_u64(cc, u0_2,
 					(v0_2 << s) | (v0_1 >> rs), &u0_2);
-				(void)_subborrow_u64(cc, u0_3,
+				(void)subborrow_u64(cc, u0_3,
 					(v0_3 << s) | (v0_2 >> rs), &u0_3);
 
 
-				cc = _subborrow_u64(0, u1_0,
+				cc = subborrow_u64(0, u1_0,
 					(v1_0 << s), &u1_0);
-				cc = _subborrow_u64(cc, u1_1,
+				cc = subborrow_u64(cc, u1_1,
 					(v1_1 << s) | (v1_0 >> rs), &u1_1);
-				cc = _subborrow_u64(cc, u1_2,
+				cc = subborrow_u64(cc, u1_2,
 					(v1_2 << s) | (v1_1 >> rs), &u1_2);
-				(void)_subborrow_u64(cc, u1_3,
+				(void)subborrow_u64(cc, u1_3,
 					(v1_3 << s) | (v1_2 >> rs), &u1_3);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(nv_0 << s2), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(nv_1 << s2) | (nv_0 >> rs2), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(nv_2 << s2) | (nv_1 >> rs2), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(nv_3 << s2) | (nv_2 >> rs2), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(nv_4 << s2) | (nv_3 >> rs2), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(nv_5 << s2) | (nv_4 >> rs2), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(nv_6 << s2) | (nv_5 >> rs2), &nu_6);
-				cc = _addcarry_u64(cc, nu_7,
+				cc = addcarry_u64(cc, nu_7,
 					(nv_7 << s2) | (nv_6 >> rs2), &nu_7);
-				cc = _addcarry_u64(cc, nu_8,
+				cc = addcarry_u64(cc, nu_8,
 					(nv_8 << s2) | (nv_7 >> rs2), &nu_8);
-				cc = _addcarry_u64(cc, nu_9,
+				cc = addcarry_u64(cc, nu_9,
 					(nv_9 << s2) | (nv_8 >> rs2), &nu_9);
-				cc = _addcarry_u64(cc, nu_10,
+				cc = addcarry_u64(cc, nu_10,
 					(nv_10 << s2) | (nv_9 >> rs2), &nu_10);
-				(void)_addcarry_u64(cc, nu_11,
+				(void)addcarry_u64(cc, nu_11,
 					(nv_11 << s2) | (nv_10 >> rs2), &nu_11);
-				// cc = _addcarry_u64(cc, nu_12,
+				// cc = addcarry_u64(cc, nu_12,
 				// 	(nv_12 << s2) | (nv_11 >> rs2), &nu_12);
-				// (void)_addcarry_u64(cc, nu_13,
+				// (void)addcarry_u64(cc, nu_13,
 				// 	(nv_13 << s2) | (nv_12 >> rs2), &nu_13);
 
-				cc = _subborrow_u64(0, nu_0,
+				cc = subborrow_u64(0, nu_0,
 					(sp_0 << s1), &nu_0);
-				cc = _subborrow_u64(cc, nu_1,
+				cc = subborrow_u64(cc, nu_1,
 					(sp_1 << s1) | (sp_0 >> rs1), &nu_1);
-				cc = _subborrow_u64(cc, nu_2,
+				cc = subborrow_u64(cc, nu_2,
 					(sp_2 << s1) | (sp_1 >> rs1), &nu_2);
-				cc = _subborrow_u64(cc, nu_3,
+				cc = subborrow_u64(cc, nu_3,
 					(sp_3 << s1) | (sp_2 >> rs1), &nu_3);
-				cc = _subborrow_u64(cc, nu_4,
+				cc = subborrow_u64(cc, nu_4,
 					(sp_4 << s1) | (sp_3 >> rs1), &nu_4);
-				cc = _subborrow_u64(cc, nu_5,
+				cc = subborrow_u64(cc, nu_5,
 					(sp_5 << s1) | (sp_4 >> rs1), &nu_5);
-				cc = _subborrow_u64(cc, nu_6,
+				cc = subborrow_u64(cc, nu_6,
 					(sp_6 << s1) | (sp_5 >> rs1), &nu_6);
-				cc = _subborrow_u64(cc, nu_7,
+				cc = subborrow_u64(cc, nu_7,
 					(sp_7 << s1) | (sp_6 >> rs1), &nu_7);
-				cc = _subborrow_u64(cc, nu_8,
+				cc = subborrow_u64(cc, nu_8,
 					(sp_8 << s1) | (sp_7 >> rs1), &nu_8);
-				cc = _subborrow_u64(cc, nu_9,
+				cc = subborrow_u64(cc, nu_9,
 					(sp_9 << s1) | (sp_8 >> rs1), &nu_9);
-				cc = _subborrow_u64(cc, nu_10,
+				cc = subborrow_u64(cc, nu_10,
 					(sp_10 << s1) | (sp_9 >> rs1), &nu_10);
-				(void)_subborrow_u64(cc, nu_11,
+				(void)subborrow_u64(cc, nu_11,
 					(sp_11 << s1) | (sp_10 >> rs1), &nu_11);
-				// cc = _subborrow_u64(cc, nu_12,
+				// cc = subborrow_u64(cc, nu_12,
 				// 	(sp_12 << s1) | (sp_11 >> rs1), &nu_12);
-				// (void)_subborrow_u64(cc, nu_13,
+				// (void)subborrow_u64(cc, nu_13,
 				// 	(sp_13 << s1) | (sp_12 >> rs1), &nu_13);
 
-				cc = _subborrow_u64(0, sp_0,
+				cc = subborrow_u64(0, sp_0,
 					(nv_0 << s), &sp_0);
-				cc = _subborrow_u64(cc, sp_1,
+				cc = subborrow_u64(cc, sp_1,
 					(nv_1 << s) | (nv_0 >> rs), &sp_1);
-				cc = _subborrow_u64(cc, sp_2,
+				cc = subborrow_u64(cc, sp_2,
 					(nv_2 << s) | (nv_1 >> rs), &sp_2);
-				cc = _subborrow_u64(cc, sp_3,
+				cc = subborrow_u64(cc, sp_3,
 					(nv_3 << s) | (nv_2 >> rs), &sp_3);
-				cc = _subborrow_u64(cc, sp_4,
+				cc = subborrow_u64(cc, sp_4,
 					(nv_4 << s) | (nv_3 >> rs), &sp_4);
-				cc = _subborrow_u64(cc, sp_5,
+				cc = subborrow_u64(cc, sp_5,
 					(nv_5 << s) | (nv_4 >> rs), &sp_5);
-				cc = _subborrow_u64(cc, sp_6,
+				cc = subborrow_u64(cc, sp_6,
 					(nv_6 << s) | (nv_5 >> rs), &sp_6);
-				cc = _subborrow_u64(cc, sp_7,
+				cc = subborrow_u64(cc, sp_7,
 					(nv_7 << s) | (nv_6 >> rs), &sp_7);
-				cc = _subborrow_u64(cc, sp_8,
+				cc = subborrow_u64(cc, sp_8,
 					(nv_8 << s) | (nv_7 >> rs), &sp_8);
-				cc = _subborrow_u64(cc, sp_9,
+				cc = subborrow_u64(cc, sp_9,
 					(nv_9 << s) | (nv_8 >> rs), &sp_9);
-				cc = _subborrow_u64(cc, sp_10,
+				cc = subborrow_u64(cc, sp_10,
 					(nv_10 << s) | (nv_9 >> rs), &sp_10);
-				(void)_subborrow_u64(cc, sp_11,
+				(void)subborrow_u64(cc, sp_11,
 					(nv_11 << s) | (nv_10 >> rs), &sp_11);
-				// cc = _subborrow_u64(cc, sp_12,
+				// cc = subborrow_u64(cc, sp_12,
 				// 	(nv_12 << s) | (nv_11 >> rs), &sp_12);
-				// (void)_subborrow_u64(cc, sp_13,
+				// (void)subborrow_u64(cc, sp_13,
 				// 	(nv_13 << s) | (nv_12 >> rs), &sp_13);
 			}
 		} else {
 			if (s == 0) {
-				cc = _addcarry_u64(0, u0_0, v0_0, &u0_0);
-				cc = _addcarry_u64(cc, u0_1, v0_1, &u0_1);
-				cc = _addcarry_u64(cc, u0_2, v0_2, &u0_2);
-				(void)_addcarry_u64(cc, u0_3, v0_3, &u0_3);
-
-				cc = _addcarry_u64(0, u1_0, v1_0, &u1_0);
-				cc = _addcarry_u64(cc, u1_1, v1_1, &u1_1);
-				cc = _addcarry_u64(cc, u1_2, v1_2, &u1_2);
-				(void)_addcarry_u64(cc, u1_3, v1_3, &u1_3);
-
-				cc = _addcarry_u64(0, nu_0, nv_0, &nu_0);
-				cc = _addcarry_u64(cc, nu_1, nv_1, &nu_1);
-				cc = _addcarry_u64(cc, nu_2, nv_2, &nu_2);
-				cc = _addcarry_u64(cc, nu_3, nv_3, &nu_3);
-				cc = _addcarry_u64(cc, nu_4, nv_4, &nu_4);
-				cc = _addcarry_u64(cc, nu_5, nv_5, &nu_5);
-				cc = _addcarry_u64(cc, nu_6, nv_6, &nu_6);
-				cc = _addcarry_u64(cc, nu_7, nv_7, &nu_7);
-				cc = _addcarry_u64(cc, nu_8, nv_8, &nu_8);
-				cc = _addcarry_u64(cc, nu_9, nv_9, &nu_9);
-				cc = _addcarry_u64(cc, nu_10, nv_10, &nu_10);
-				(void)_addcarry_u64(cc, nu_11, nv_11, &nu_11);
-				// cc = _addcarry_u64(cc, nu_12, nv_12, &nu_12);
-				// (void)_addcarry_u64(cc, nu_13, nv_13, &nu_13);
-
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, u0_0, v0_0, &u0_0);
+				cc = addcarry_u64(cc, u0_1, v0_1, &u0_1);
+				cc = addcarry_u64(cc, u0_2, v0_2, &u0_2);
+				(void)addcarry_u64(cc, u0_3, v0_3, &u0_3);
+
+				cc = addcarry_u64(0, u1_0, v1_0, &u1_0);
+				cc = addcarry_u64(cc, u1_1, v1_1, &u1_1);
+				cc = addcarry_u64(cc, u1_2, v1_2, &u1_2);
+				(void)addcarry_u64(cc, u1_3, v1_3, &u1_3);
+
+				cc = addcarry_u64(0, nu_0, nv_0, &nu_0);
+				cc = addcarry_u64(cc, nu_1, nv_1, &nu_1);
+				cc = addcarry_u64(cc, nu_2, nv_2, &nu_2);
+				cc = addcarry_u64(cc, nu_3, nv_3, &nu_3);
+				cc = addcarry_u64(cc, nu_4, nv_4, &nu_4);
+				cc = addcarry_u64(cc, nu_5, nv_5, &nu_5);
+				cc = addcarry_u64(cc, nu_6, nv_6, &nu_6);
+				cc = addcarry_u64(cc, nu_7, nv_7, &nu_7);
+				cc = addcarry_u64(cc, nu_8, nv_8, &nu_8);
+				cc = addcarry_u64(cc, nu_9, nv_9, &nu_9);
+				cc = addcarry_u64(cc, nu_10, nv_10, &nu_10);
+				(void)addcarry_u64(cc, nu_11, nv_11, &nu_11);
+				// cc = addcarry_u64(cc, nu_12, nv_12, &nu_12);
+				// (void)addcarry_u64(cc, nu_13, nv_13, &nu_13);
+
+				cc = addcarry_u64(0, nu_0,
 					(sp_0 << 1), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(sp_1 << 1) | (sp_0 >> 63), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(sp_2 << 1) | (sp_1 >> 63), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(sp_3 << 1) | (sp_2 >> 63), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(sp_4 << 1) | (sp_3 >> 63), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(sp_5 << 1) | (sp_4 >> 63), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(sp_6 << 1) | (sp_5 >> 63), &nu_6);
-				cc = _addcarry_u64(cc, nu_7,
+				cc = addcarry_u64(cc, nu_7,
 					(sp_7 << 1) | (sp_6 >> 63), &nu_7);
-				cc = _addcarry_u64(cc, nu_8,
+				cc = addcarry_u64(cc, nu_8,
 					(sp_8 << 1) | (sp_7 >> 63), &nu_8);
-				cc = _addcarry_u64(cc, nu_9,
+				cc = addcarry_u64(cc, nu_9,
 					(sp_9 << 1) | (sp_8 >> 63), &nu_9);
-				cc = _addcarry_u64(cc, nu_10,
+				cc = addcarry_u64(cc, nu_10,
 					(sp_10 << 1) | (sp_9 >> 63), &nu_10);
-				(void)_addcarry_u64(cc, nu_11,
+				(void)addcarry_u64(cc, nu_11,
 					(sp_11 << 1) | (sp_10 >> 63), &nu_11);
-				// cc = _addcarry_u64(cc, nu_12,
+				// cc = addcarry_u64(cc, nu_12,
 				// 	(sp_12 << 1) | (sp_11 >> 63), &nu_12);
-				// (void)_addcarry_u64(cc, nu_13,
+				// (void)addcarry_u64(cc, nu_13,
 				// 	(sp_13 << 1) | (sp_12 >> 63), &nu_13);
 
 
-				cc = _addcarry_u64(0, sp_0, nv_0, &sp_0);
-				cc = _addcarry_u64(cc, sp_1, nv_1, &sp_1);
-				cc = _addcarry_u64(cc, sp_2, nv_2, &sp_2);
-				cc = _addcarry_u64(cc, sp_3, nv_3, &sp_3);
-				cc = _addcarry_u64(cc, sp_4, nv_4, &sp_4);
-				cc = _addcarry_u64(cc, sp_5, nv_5, &sp_5);
-				cc = _addcarry_u64(cc, sp_6, nv_6, &sp_6);
-				cc = _addcarry_u64(cc, sp_7, nv_7, &sp_7);
-				cc = _addcarry_u64(cc, sp_8, nv_8, &sp_8);
-				cc = _addcarry_u64(cc, sp_9, nv_9, &sp_9);
-				cc = _addcarry_u64(cc, sp_10, nv_10, &sp_10);
-				(void)_addcarry_u64(cc, sp_11, nv_11, &sp_11);
-				// cc = _addcarry_u64(cc, sp_12, nv_12, &sp_12);
-				// (void)_addcarry_u64(cc, sp_13, nv_13, &sp_13);
+				cc = addcarry_u64(0, sp_0, nv_0, &sp_0);
+				cc = addcarry_u64(cc, sp_1, nv_1, &sp_1);
+				cc = addcarry_u64(cc, sp_2, nv_2, &sp_2);
+				cc = addcarry_u64(cc, sp_3, nv_3, &sp_3);
+				cc = addcarry_u64(cc, sp_4, nv_4, &sp_4);
+				cc = addcarry_u64(cc, sp_5, nv_5, &sp_5);
+				cc = addcarry_u64(cc, sp_6, nv_6, &sp_6);
+				cc = addcarry_u64(cc, sp_7, nv_7, &sp_7);
+				cc = addcarry_u64(cc, sp_8, nv_8, &sp_8);
+				cc = addcarry_u64(cc, sp_9, nv_9, &sp_9);
+				cc = addcarry_u64(cc, sp_10, nv_10, &sp_10);
+				(void)addcarry_u64(cc, sp_11, nv_11, &sp_11);
+				// cc = addcarry_u64(cc, sp_12, nv_12, &sp_12);
+				// (void)addcarry_u64(cc, sp_13, nv_13, &sp_13);
 
 			} else {
 				unsigned rs, s1, rs1, s2, rs2;
@@ -1572,110 +1519,110 @@ curve448_reduce_basis_vartime(
 				s2 = s << 1;
 				rs2 = 64 - s2;
 
-				cc = _addcarry_u64(0, u0_0,
+				cc = addcarry_u64(0, u0_0,
 					(v0_0 << s), &u0_0);
-				cc = _addcarry_u64(cc, u0_1,
+				cc = addcarry_u64(cc, u0_1,
 					(v0_1 << s) | (v0_0 >> rs), &u0_1);
-				cc = _addcarry_u64(cc, u0_2,
+				cc = addcarry_u64(cc, u0_2,
 					(v0_2 << s) | (v0_1 >> rs), &u0_2);
-				(void)_addcarry_u64(cc, u0_3,
+				(void)addcarry_u64(cc, u0_3,
 					(v0_3 << s) | (v0_2 >> rs), &u0_3);
 
 
-				cc = _addcarry_u64(0, u1_0,
+				cc = addcarry_u64(0, u1_0,
 					(v1_0 << s), &u1_0);
-				cc = _addcarry_u64(cc, u1_1,
+				cc = addcarry_u64(cc, u1_1,
 					(v1_1 << s) | (v1_0 >> rs), &u1_1);
-				cc = _addcarry_u64(cc, u1_2,
+				cc = addcarry_u64(cc, u1_2,
 					(v1_2 << s) | (v1_1 >> rs), &u1_2);
-				(void)_addcarry_u64(cc, u1_3,
+				(void)addcarry_u64(cc, u1_3,
 					(v1_3 << s) | (v1_2 >> rs), &u1_3);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(nv_0 << s2), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(nv_1 << s2) | (nv_0 >> rs2), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(nv_2 << s2) | (nv_1 >> rs2), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(nv_3 << s2) | (nv_2 >> rs2), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(nv_4 << s2) | (nv_3 >> rs2), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(nv_5 << s2) | (nv_4 >> rs2), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(nv_6 << s2) | (nv_5 >> rs2), &nu_6);
-				cc = _addcarry_u64(cc, nu_7,
+				cc = addcarry_u64(cc, nu_7,
 					(nv_7 << s2) | (nv_6 >> rs2), &nu_7);
-				cc = _addcarry_u64(cc, nu_8,
+				cc = addcarry_u64(cc, nu_8,
 					(nv_8 << s2) | (nv_7 >> rs2), &nu_8);
-				cc = _addcarry_u64(cc, nu_9,
+				cc = addcarry_u64(cc, nu_9,
 					(nv_9 << s2) | (nv_8 >> rs2), &nu_9);
-				cc = _addcarry_u64(cc, nu_10,
+				cc = addcarry_u64(cc, nu_10,
 					(nv_10 << s2) | (nv_9 >> rs2), &nu_10);
-				(void)_addcarry_u64(cc, nu_11,
+				(void)addcarry_u64(cc, nu_11,
 					(nv_11 << s2) | (nv_10 >> rs2), &nu_11);
-				// cc = _addcarry_u64(cc, nu_12,
+				// cc = addcarry_u64(cc, nu_12,
 				// 	(nv_12 << s2) | (nv_11 >> rs2), &nu_12);
-				// (void)_addcarry_u64(cc, nu_13,
+				// (void)addcarry_u64(cc, nu_13,
 				// 	(nv_13 << s2) | (nv_12 >> rs2), &nu_13);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(sp_0 << s1), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(sp_1 << s1) | (sp_0 >> rs1), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(sp_2 << s1) | (sp_1 >> rs1), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(sp_3 << s1) | (sp_2 >> rs1), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(sp_4 << s1) | (sp_3 >> rs1), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(sp_5 << s1) | (sp_4 >> rs1), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(sp_6 << s1) | (sp_5 >> rs1), &nu_6);
-				cc = _addcarry_u64(cc, nu_7,
+				cc = addcarry_u64(cc, nu_7,
 					(sp_7 << s1) | (sp_6 >> rs1), &nu_7);
-				cc = _addcarry_u64(cc, nu_8,
+				cc = addcarry_u64(cc, nu_8,
 					(sp_8 << s1) | (sp_7 >> rs1), &nu_8);
-				cc = _addcarry_u64(cc, nu_9,
+				cc = addcarry_u64(cc, nu_9,
 					(sp_9 << s1) | (sp_8 >> rs1), &nu_9);
-				cc = _addcarry_u64(cc, nu_10,
+				cc = addcarry_u64(cc, nu_10,
 					(sp_10 << s1) | (sp_9 >> rs1), &nu_10);
-				(void)_addcarry_u64(cc, nu_11,
+				(void)addcarry_u64(cc, nu_11,
 					(sp_11 << s1) | (sp_10 >> rs1), &nu_11);
-				// cc = _addcarry_u64(cc, nu_12,
+				// cc = addcarry_u64(cc, nu_12,
 				// 	(sp_12 << s1) | (sp_11 >> rs1), &nu_12);
-				// (void)_addcarry_u64(cc, nu_13,
+				// (void)addcarry_u64(cc, nu_13,
 				// 	(sp_13 << s1) | (sp_12 >> rs1), &nu_13);
 
-				cc = _addcarry_u64(0, sp_0,
+				cc = addcarry_u64(0, sp_0,
 					(nv_0 << s), &sp_0);
-				cc = _addcarry_u64(cc, sp_1,
+				cc = addcarry_u64(cc, sp_1,
 					(nv_1 << s) | (nv_0 >> rs), &sp_1);
-				cc = _addcarry_u64(cc, sp_2,
+				cc = addcarry_u64(cc, sp_2,
 					(nv_2 << s) | (nv_1 >> rs), &sp_2);
-				cc = _addcarry_u64(cc, sp_3,
+				cc = addcarry_u64(cc, sp_3,
 					(nv_3 << s) | (nv_2 >> rs), &sp_3);
-				cc = _addcarry_u64(cc, sp_4,
+				cc = addcarry_u64(cc, sp_4,
 					(nv_4 << s) | (nv_3 >> rs), &sp_4);
-				cc = _addcarry_u64(cc, sp_5,
+				cc = addcarry_u64(cc, sp_5,
 					(nv_5 << s) | (nv_4 >> rs), &sp_5);
-				cc = _addcarry_u64(cc, sp_6,
+				cc = addcarry_u64(cc, sp_6,
 					(nv_6 << s) | (nv_5 >> rs), &sp_6);
-				cc = _addcarry_u64(cc, sp_7,
+				cc = addcarry_u64(cc, sp_7,
 					(nv_7 << s) | (nv_6 >> rs), &sp_7);
-				cc = _addcarry_u64(cc, sp_8,
+				cc = addcarry_u64(cc, sp_8,
 					(nv_8 << s) | (nv_7 >> rs), &sp_8);
-				cc = _addcarry_u64(cc, sp_9,
+				cc = addcarry_u64(cc, sp_9,
 					(nv_9 << s) | (nv_8 >> rs), &sp_9);
-				cc = _addcarry_u64(cc, sp_10,
+				cc = addcarry_u64(cc, sp_10,
 					(nv_10 << s) | (nv_9 >> rs), &sp_10);
-				(void)_addcarry_u64(cc, sp_11,
+				(void)addcarry_u64(cc, sp_11,
 					(nv_11 << s) | (nv_10 >> rs), &sp_11);
-				// cc = _addcarry_u64(cc, sp_12,
+				// cc = addcarry_u64(cc, sp_12,
 				// 	(nv_12 << s) | (nv_11 >> rs), &sp_12);
-				// (void)_addcarry_u64(cc, sp_13,
+				// (void)addcarry_u64(cc, sp_13,
 				// 	(nv_13 << s) | (nv_12 >> rs), &sp_13);
 			}
 		}
@@ -1696,20 +1643,20 @@ curve448_reduce_basis_vartime(
 		/*
 		 * If nu < nv, then swap(u,v) and swap(nu,nv).
 		 */
-		cc = _subborrow_u64(0, nu_0, nv_0, &w);
-		cc = _subborrow_u64(cc, nu_1, nv_1, &w);
-		cc = _subborrow_u64(cc, nu_2, nv_2, &w);
-		cc = _subborrow_u64(cc, nu_3, nv_3, &w);
-		cc = _subborrow_u64(cc, nu_4, nv_4, &w);
-		cc = _subborrow_u64(cc, nu_5, nv_5, &w);
-		cc = _subborrow_u64(cc, nu_6, nv_6, &w);
-		cc = _subborrow_u64(cc, nu_7, nv_7, &w);
-		cc = _subborrow_u64(cc, nu_8, nv_8, &w);
-		cc = _subborrow_u64(cc, nu_9, nv_9, &w);
-		// cc = _subborrow_u64(cc, nu_10, nv_10, &w);
-		// cc = _subborrow_u64(cc, nu_11, nv_11, &w);
-		// cc = _subborrow_u64(cc, nu_12, nv_12, &w);
-		// cc = _subborrow_u64(cc, nu_13, nv_13, &w);
+		cc = subborrow_u64(0, nu_0, nv_0, &w);
+		cc = subborrow_u64(cc, nu_1, nv_1, &w);
+		cc = subborrow_u64(cc, nu_2, nv_2, &w);
+		cc = subborrow_u64(cc, nu_3, nv_3, &w);
+		cc = subborrow_u64(cc, nu_4, nv_4, &w);
+		cc = subborrow_u64(cc, nu_5, nv_5, &w);
+		cc = subborrow_u64(cc, nu_6, nv_6, &w);
+		cc = subborrow_u64(cc, nu_7, nv_7, &w);
+		cc = subborrow_u64(cc, nu_8, nv_8, &w);
+		cc = subborrow_u64(cc, nu_9, nv_9, &w);
+		// cc = subborrow_u64(cc, nu_10, nv_10, &w);
+		// cc = subborrow_u64(cc, nu_11, nv_11, &w);
+		// cc = subborrow_u64(cc, nu_12, nv_12, &w);
+		// cc = subborrow_u64(cc, nu_13, nv_13, &w);
 		m = -(unsigned long long)cc;
 
 
@@ -1807,7 +1754,7 @@ curve448_reduce_basis_vartime(
 		bitlength_top |= \
 			bitlength_word & -(unsigned long long)bitlength_flag; \
 		bitlength_acc -= bitlength_flag; \
-		(size) = (bitlength_acc << 6) - _lzcnt_u64(bitlength_top); \
+		(size) = (bitlength_acc << 6) - lzcnt_u64(bitlength_top); \
 	} while (0)
 
 		BITLENGTH10(bl_nv, nv_);
@@ -1996,74 +1943,74 @@ curve448_reduce_basis_vartime(
 
 		if ((sp_9 >> 63) == 0) {
 			if (s == 0) {
-				cc = _subborrow_u64(0, u0_0, v0_0, &u0_0);
-				cc = _subborrow_u64(cc, u0_1, v0_1, &u0_1);
-				cc = _subborrow_u64(cc, u0_2, v0_2, &u0_2);
-				(void)_subborrow_u64(cc, u0_3, v0_3, &u0_3);
-
-				cc = _subborrow_u64(0, u1_0, v1_0, &u1_0);
-				cc = _subborrow_u64(cc, u1_1, v1_1, &u1_1);
-				cc = _subborrow_u64(cc, u1_2, v1_2, &u1_2);
-				(void)_subborrow_u64(cc, u1_3, v1_3, &u1_3);
-
-				cc = _addcarry_u64(0, nu_0, nv_0, &nu_0);
-				cc = _addcarry_u64(cc, nu_1, nv_1, &nu_1);
-				cc = _addcarry_u64(cc, nu_2, nv_2, &nu_2);
-				cc = _addcarry_u64(cc, nu_3, nv_3, &nu_3);
-				cc = _addcarry_u64(cc, nu_4, nv_4, &nu_4);
-				cc = _addcarry_u64(cc, nu_5, nv_5, &nu_5);
-				cc = _addcarry_u64(cc, nu_6, nv_6, &nu_6);
-				cc = _addcarry_u64(cc, nu_7, nv_7, &nu_7);
-				cc = _addcarry_u64(cc, nu_8, nv_8, &nu_8);
-				(void)_addcarry_u64(cc, nu_9, nv_9, &nu_9);
-				// cc = _addcarry_u64(cc, nu_10, nv_10, &nu_10);
-				// (void)_addcarry_u64(cc, nu_11, nv_11, &nu_11);
-				// cc = _addcarry_u64(cc, nu_12, nv_12, &nu_12);
-				// (void)_addcarry_u64(cc, nu_13, nv_13, &nu_13);
-
-				cc = _subborrow_u64(0, nu_0,
+				cc = subborrow_u64(0, u0_0, v0_0, &u0_0);
+				cc = subborrow_u64(cc, u0_1, v0_1, &u0_1);
+				cc = subborrow_u64(cc, u0_2, v0_2, &u0_2);
+				(void)subborrow_u64(cc, u0_3, v0_3, &u0_3);
+
+				cc = subborrow_u64(0, u1_0, v1_0, &u1_0);
+				cc = subborrow_u64(cc, u1_1, v1_1, &u1_1);
+				cc = subborrow_u64(cc, u1_2, v1_2, &u1_2);
+				(void)subborrow_u64(cc, u1_3, v1_3, &u1_3);
+
+				cc = addcarry_u64(0, nu_0, nv_0, &nu_0);
+				cc = addcarry_u64(cc, nu_1, nv_1, &nu_1);
+				cc = addcarry_u64(cc, nu_2, nv_2, &nu_2);
+				cc = addcarry_u64(cc, nu_3, nv_3, &nu_3);
+				cc = addcarry_u64(cc, nu_4, nv_4, &nu_4);
+				cc = addcarry_u64(cc, nu_5, nv_5, &nu_5);
+				cc = addcarry_u64(cc, nu_6, nv_6, &nu_6);
+				cc = addcarry_u64(cc, nu_7, nv_7, &nu_7);
+				cc = addcarry_u64(cc, nu_8, nv_8, &nu_8);
+				(void)addcarry_u64(cc, nu_9, nv_9, &nu_9);
+				// cc = addcarry_u64(cc, nu_10, nv_10, &nu_10);
+				// (void)addcarry_u64(cc, nu_11, nv_11, &nu_11);
+				// cc = addcarry_u64(cc, nu_12, nv_12, &nu_12);
+				// (void)addcarry_u64(cc, nu_13, nv_13, &nu_13);
+
+				cc = subborrow_u64(0, nu_0,
 					(sp_0 << 1), &nu_0);
-				cc = _subborrow_u64(cc, nu_1,
+				cc = subborrow_u64(cc, nu_1,
 					(sp_1 << 1) | (sp_0 >> 63), &nu_1);
-				cc = _subborrow_u64(cc, nu_2,
+				cc = subborrow_u64(cc, nu_2,
 					(sp_2 << 1) | (sp_1 >> 63), &nu_2);
-				cc = _subborrow_u64(cc, nu_3,
+				cc = subborrow_u64(cc, nu_3,
 					(sp_3 << 1) | (sp_2 >> 63), &nu_3);
-				cc = _subborrow_u64(cc, nu_4,
+				cc = subborrow_u64(cc, nu_4,
 					(sp_4 << 1) | (sp_3 >> 63), &nu_4);
-				cc = _subborrow_u64(cc, nu_5,
+				cc = subborrow_u64(cc, nu_5,
 					(sp_5 << 1) | (sp_4 >> 63), &nu_5);
-				cc = _subborrow_u64(cc, nu_6,
+				cc = subborrow_u64(cc, nu_6,
 					(sp_6 << 1) | (sp_5 >> 63), &nu_6);
-				cc = _subborrow_u64(cc, nu_7,
+				cc = subborrow_u64(cc, nu_7,
 					(sp_7 << 1) | (sp_6 >> 63), &nu_7);
-				cc = _subborrow_u64(cc, nu_8,
+				cc = subborrow_u64(cc, nu_8,
 					(sp_8 << 1) | (sp_7 >> 63), &nu_8);
-				(void)_subborrow_u64(cc, nu_9,
+				(void)subborrow_u64(cc, nu_9,
 					(sp_9 << 1) | (sp_8 >> 63), &nu_9);
-				// cc = _subborrow_u64(cc, nu_10,
+				// cc = subborrow_u64(cc, nu_10,
 				// 	(sp_10 << 1) | (sp_9 >> 63), &nu_10);
-				// (void)_subborrow_u64(cc, nu_11,
+				// (void)subborrow_u64(cc, nu_11,
 				// 	(sp_11 << 1) | (sp_10 >> 63), &nu_11);
-				// cc = _subborrow_u64(cc, nu_12,
+				// cc = subborrow_u64(cc, nu_12,
 				// 	(sp_12 << 1) | (sp_11 >> 63), &nu_12);
-				// (void)_subborrow_u64(cc, nu_13,
+				// (void)subborrow_u64(cc, nu_13,
 				// 	(sp_13 << 1) | (sp_12 >> 63), &nu_13);
 
-				cc = _subborrow_u64(0, sp_0, nv_0, &sp_0);
-				cc = _subborrow_u64(cc, sp_1, nv_1, &sp_1);
-				cc = _subborrow_u64(cc, sp_2, nv_2, &sp_2);
-				cc = _subborrow_u64(cc, sp_3, nv_3, &sp_3);
-				cc = _subborrow_u64(cc, sp_4, nv_4, &sp_4);
-				cc = _subborrow_u64(cc, sp_5, nv_5, &sp_5);
-				cc = _subborrow_u64(cc, sp_6, nv_6, &sp_6);
-				cc = _subborrow_u64(cc, sp_7, nv_7, &sp_7);
-				cc = _subborrow_u64(cc, sp_8, nv_8, &sp_8);
-				(void)_subborrow_u64(cc, sp_9, nv_9, &sp_9);
-				// cc = _subborrow_u64(cc, sp_10, nv_10, &sp_10);
-				// (void)_subborrow_u64(cc, sp_11, nv_11, &sp_11);
-				// cc = _subborrow_u64(cc, sp_12, nv_12, &sp_12);
-				// (void)_subborrow_u64(cc, sp_13, nv_13, &sp_13);
+				cc = subborrow_u64(0, sp_0, nv_0, &sp_0);
+				cc = subborrow_u64(cc, sp_1, nv_1, &sp_1);
+				cc = subborrow_u64(cc, sp_2, nv_2, &sp_2);
+				cc = subborrow_u64(cc, sp_3, nv_3, &sp_3);
+				cc = subborrow_u64(cc, sp_4, nv_4, &sp_4);
+				cc = subborrow_u64(cc, sp_5, nv_5, &sp_5);
+				cc = subborrow_u64(cc, sp_6, nv_6, &sp_6);
+				cc = subborrow_u64(cc, sp_7, nv_7, &sp_7);
+				cc = subborrow_u64(cc, sp_8, nv_8, &sp_8);
+				(void)subborrow_u64(cc, sp_9, nv_9, &sp_9);
+				// cc = subborrow_u64(cc, sp_10, nv_10, &sp_10);
+				// (void)subborrow_u64(cc, sp_11, nv_11, &sp_11);
+				// cc = subborrow_u64(cc, sp_12, nv_12, &sp_12);
+				// (void)subborrow_u64(cc, sp_13, nv_13, &sp_13);
 
 			} else {
 				unsigned rs, s1, rs1, s2, rs2;
@@ -2074,183 +2021,183 @@ curve448_reduce_basis_vartime(
 				s2 = s << 1;
 				rs2 = 64 - s2;
 
-				cc = _subborrow_u64(0, u0_0,
+				cc = subborrow_u64(0, u0_0,
 					(v0_0 << s), &u0_0);
-				cc = _subborrow_u64(cc, u0_1,
+				cc = subborrow_u64(cc, u0_1,
 					(v0_1 << s) | (v0_0 >> rs), &u0_1);
-				cc = _subborrow_u64(cc, u0_2,
+				cc = subborrow_u64(cc, u0_2,
 					(v0_2 << s) | (v0_1 >> rs), &u0_2);
-				(void)_subborrow_u64(cc, u0_3,
+				(void)subborrow_u64(cc, u0_3,
 					(v0_3 << s) | (v0_2 >> rs), &u0_3);
 
 
-				cc = _subborrow_u64(0, u1_0,
+				cc = subborrow_u64(0, u1_0,
 					(v1_0 << s), &u1_0);
-				cc = _subborrow_u64(cc, u1_1,
+				cc = subborrow_u64(cc, u1_1,
 					(v1_1 << s) | (v1_0 >> rs), &u1_1);
-				cc = _subborrow_u64(cc, u1_2,
+				cc = subborrow_u64(cc, u1_2,
 					(v1_2 << s) | (v1_1 >> rs), &u1_2);
-				(void)_subborrow_u64(cc, u1_3,
+				(void)subborrow_u64(cc, u1_3,
 					(v1_3 << s) | (v1_2 >> rs), &u1_3);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(nv_0 << s2), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(nv_1 << s2) | (nv_0 >> rs2), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(nv_2 << s2) | (nv_1 >> rs2), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(nv_3 << s2) | (nv_2 >> rs2), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(nv_4 << s2) | (nv_3 >> rs2), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(nv_5 << s2) | (nv_4 >> rs2), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(nv_6 << s2) | (nv_5 >> rs2), &nu_6);
-				cc = _addcarry_u64(cc, nu_7,
+				cc = addcarry_u64(cc, nu_7,
 					(nv_7 << s2) | (nv_6 >> rs2), &nu_7);
-				cc = _addcarry_u64(cc, nu_8,
+				cc = addcarry_u64(cc, nu_8,
 					(nv_8 << s2) | (nv_7 >> rs2), &nu_8);
-				(void)_addcarry_u64(cc, nu_9,
+				(void)addcarry_u64(cc, nu_9,
 					(nv_9 << s2) | (nv_8 >> rs2), &nu_9);
-				// cc = _addcarry_u64(cc, nu_10,
+				// cc = addcarry_u64(cc, nu_10,
 				// 	(nv_10 << s2) | (nv_9 >> rs2), &nu_10);
-				// (void)_addcarry_u64(cc, nu_11,
+				// (void)addcarry_u64(cc, nu_11,
 				// 	(nv_11 << s2) | (nv_10 >> rs2), &nu_11);
-				// cc = _addcarry_u64(cc, nu_12,
+				// cc = addcarry_u64(cc, nu_12,
 				// 	(nv_12 << s2) | (nv_11 >> rs2), &nu_12);
-				// (void)_addcarry_u64(cc, nu_13,
+				// (void)addcarry_u64(cc, nu_13,
 				// 	(nv_13 << s2) | (nv_12 >> rs2), &nu_13);
 
-				cc = _subborrow_u64(0, nu_0,
+				cc = subborrow_u64(0, nu_0,
 					(sp_0 << s1), &nu_0);
-				cc = _subborrow_u64(cc, nu_1,
+				cc = subborrow_u64(cc, nu_1,
 					(sp_1 << s1) | (sp_0 >> rs1), &nu_1);
-				cc = _subborrow_u64(cc, nu_2,
+				cc = subborrow_u64(cc, nu_2,
 					(sp_2 << s1) | (sp_1 >> rs1), &nu_2);
-				cc = _subborrow_u64(cc, nu_3,
+				cc = subborrow_u64(cc, nu_3,
 					(sp_3 << s1) | (sp_2 >> rs1), &nu_3);
-				cc = _subborrow_u64(cc, nu_4,
+				cc = subborrow_u64(cc, nu_4,
 					(sp_4 << s1) | (sp_3 >> rs1), &nu_4);
-				cc = _subborrow_u64(cc, nu_5,
+				cc = subborrow_u64(cc, nu_5,
 					(sp_5 << s1) | (sp_4 >> rs1), &nu_5);
-				cc = _subborrow_u64(cc, nu_6,
+				cc = subborrow_u64(cc, nu_6,
 					(sp_6 << s1) | (sp_5 >> rs1), &nu_6);
-				cc = _subborrow_u64(cc, nu_7,
+				cc = subborrow_u64(cc, nu_7,
 					(sp_7 << s1) | (sp_6 >> rs1), &nu_7);
-				cc = _subborrow_u64(cc, nu_8,
+				cc = subborrow_u64(cc, nu_8,
 					(sp_8 << s1) | (sp_7 >> rs1), &nu_8);
-				(void)_subborrow_u64(cc, nu_9,
+				(void)subborrow_u64(cc, nu_9,
 					(sp_9 << s1) | (sp_8 >> rs1), &nu_9);
-				// cc = _subborrow_u64(cc, nu_10,
+				// cc = subborrow_u64(cc, nu_10,
 				// 	(sp_10 << s1) | (sp_9 >> rs1), &nu_10);
-				// (void)_subborrow_u64(cc, nu_11,
+				// (void)subborrow_u64(cc, nu_11,
 				// 	(sp_11 << s1) | (sp_10 >> rs1), &nu_11);
-				// cc = _subborrow_u64(cc, nu_12,
+				// cc = subborrow_u64(cc, nu_12,
 				// 	(sp_12 << s1) | (sp_11 >> rs1), &nu_12);
-				// (void)_subborrow_u64(cc, nu_13,
+				// (void)subborrow_u64(cc, nu_13,
 				// 	(sp_13 << s1) | (sp_12 >> rs1), &nu_13);
 
-				cc = _subborrow_u64(0, sp_0,
+				cc = subborrow_u64(0, sp_0,
 					(nv_0 << s), &sp_0);
-				cc = _subborrow_u64(cc, sp_1,
+				cc = subborrow_u64(cc, sp_1,
 					(nv_1 << s) | (nv_0 >> rs), &sp_1);
-				cc = _subborrow_u64(cc, sp_2,
+				cc = subborrow_u64(cc, sp_2,
 					(nv_2 << s) | (nv_1 >> rs), &sp_2);
-				cc = _subborrow_u64(cc, sp_3,
+				cc = subborrow_u64(cc, sp_3,
 					(nv_3 << s) | (nv_2 >> rs), &sp_3);
-				cc = _subborrow_u64(cc, sp_4,
+				cc = subborrow_u64(cc, sp_4,
 					(nv_4 << s) | (nv_3 >> rs), &sp_4);
-				cc = _subborrow_u64(cc, sp_5,
+				cc = subborrow_u64(cc, sp_5,
 					(nv_5 << s) | (nv_4 >> rs), &sp_5);
-				cc = _subborrow_u64(cc, sp_6,
+				cc = subborrow_u64(cc, sp_6,
 					(nv_6 << s) | (nv_5 >> rs), &sp_6);
-				cc = _subborrow_u64(cc, sp_7,
+				cc = subborrow_u64(cc, sp_7,
 					(nv_7 << s) | (nv_6 >> rs), &sp_7);
-				cc = _subborrow_u64(cc, sp_8,
+				cc = subborrow_u64(cc, sp_8,
 					(nv_8 << s) | (nv_7 >> rs), &sp_8);
-				(void)_subborrow_u64(cc, sp_9,
+				(void)subborrow_u64(cc, sp_9,
 					(nv_9 << s) | (nv_8 >> rs), &sp_9);
-				// cc = _subborrow_u64(cc, sp_10,
+				// cc = subborrow_u64(cc, sp_10,
 				// 	(nv_10 << s) | (nv_9 >> rs), &sp_10);
-				// (void)_subborrow_u64(cc, sp_11,
+				// (void)subborrow_u64(cc, sp_11,
 				// 	(nv_11 << s) | (nv_10 >> rs), &sp_11);
-				// cc = _subborrow_u64(cc, sp_12,
+				// cc = subborrow_u64(cc, sp_12,
 				// 	(nv_12 << s) | (nv_11 >> rs), &sp_12);
-				// (void)_subborrow_u64(cc, sp_13,
+				// (void)subborrow_u64(cc, sp_13,
 				// 	(nv_13 << s) | (nv_12 >> rs), &sp_13);
 			}
 		} else {
 			if (s == 0) {
-				cc = _addcarry_u64(0, u0_0, v0_0, &u0_0);
-				cc = _addcarry_u64(cc, u0_1, v0_1, &u0_1);
-				cc = _addcarry_u64(cc, u0_2, v0_2, &u0_2);
-				(void)_addcarry_u64(cc, u0_3, v0_3, &u0_3);
-
-				cc = _addcarry_u64(0, u1_0, v1_0, &u1_0);
-				cc = _addcarry_u64(cc, u1_1, v1_1, &u1_1);
-				cc = _addcarry_u64(cc, u1_2, v1_2, &u1_2);
-				(void)_addcarry_u64(cc, u1_3, v1_3, &u1_3);
-
-				cc = _addcarry_u64(0, nu_0, nv_0, &nu_0);
-				cc = _addcarry_u64(cc, nu_1, nv_1, &nu_1);
-				cc = _addcarry_u64(cc, nu_2, nv_2, &nu_2);
-				cc = _addcarry_u64(cc, nu_3, nv_3, &nu_3);
-				cc = _addcarry_u64(cc, nu_4, nv_4, &nu_4);
-				cc = _addcarry_u64(cc, nu_5, nv_5, &nu_5);
-				cc = _addcarry_u64(cc, nu_6, nv_6, &nu_6);
-				cc = _addcarry_u64(cc, nu_7, nv_7, &nu_7);
-				cc = _addcarry_u64(cc, nu_8, nv_8, &nu_8);
-				(void)_addcarry_u64(cc, nu_9, nv_9, &nu_9);
-				// cc = _addcarry_u64(cc, nu_10, nv_10, &nu_10);
-				// (void)_addcarry_u64(cc, nu_11, nv_11, &nu_11);
-				// cc = _addcarry_u64(cc, nu_12, nv_12, &nu_12);
-				// (void)_addcarry_u64(cc, nu_13, nv_13, &nu_13);
-
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, u0_0, v0_0, &u0_0);
+				cc = addcarry_u64(cc, u0_1, v0_1, &u0_1);
+				cc = addcarry_u64(cc, u0_2, v0_2, &u0_2);
+				(void)addcarry_u64(cc, u0_3, v0_3, &u0_3);
+
+				cc = addcarry_u64(0, u1_0, v1_0, &u1_0);
+				cc = addcarry_u64(cc, u1_1, v1_1, &u1_1);
+				cc = addcarry_u64(cc, u1_2, v1_2, &u1_2);
+				(void)addcarry_u64(cc, u1_3, v1_3, &u1_3);
+
+				cc = addcarry_u64(0, nu_0, nv_0, &nu_0);
+				cc = addcarry_u64(cc, nu_1, nv_1, &nu_1);
+				cc = addcarry_u64(cc, nu_2, nv_2, &nu_2);
+				cc = addcarry_u64(cc, nu_3, nv_3, &nu_3);
+				cc = addcarry_u64(cc, nu_4, nv_4, &nu_4);
+				cc = addcarry_u64(cc, nu_5, nv_5, &nu_5);
+				cc = addcarry_u64(cc, nu_6, nv_6, &nu_6);
+				cc = addcarry_u64(cc, nu_7, nv_7, &nu_7);
+				cc = addcarry_u64(cc, nu_8, nv_8, &nu_8);
+				(void)addcarry_u64(cc, nu_9, nv_9, &nu_9);
+				// cc = addcarry_u64(cc, nu_10, nv_10, &nu_10);
+				// (void)addcarry_u64(cc, nu_11, nv_11, &nu_11);
+				// cc = addcarry_u64(cc, nu_12, nv_12, &nu_12);
+				// (void)addcarry_u64(cc, nu_13, nv_13, &nu_13);
+
+				cc = addcarry_u64(0, nu_0,
 					(sp_0 << 1), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(sp_1 << 1) | (sp_0 >> 63), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(sp_2 << 1) | (sp_1 >> 63), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(sp_3 << 1) | (sp_2 >> 63), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(sp_4 << 1) | (sp_3 >> 63), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(sp_5 << 1) | (sp_4 >> 63), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(sp_6 << 1) | (sp_5 >> 63), &nu_6);
-				cc = _addcarry_u64(cc, nu_7,
+				cc = addcarry_u64(cc, nu_7,
 					(sp_7 << 1) | (sp_6 >> 63), &nu_7);
-				cc = _addcarry_u64(cc, nu_8,
+				cc = addcarry_u64(cc, nu_8,
 					(sp_8 << 1) | (sp_7 >> 63), &nu_8);
-				(void)_addcarry_u64(cc, nu_9,
+				(void)addcarry_u64(cc, nu_9,
 					(sp_9 << 1) | (sp_8 >> 63), &nu_9);
-				// cc = _addcarry_u64(cc, nu_10,
+				// cc = addcarry_u64(cc, nu_10,
 				// 	(sp_10 << 1) | (sp_9 >> 63), &nu_10);
-				// (void)_addcarry_u64(cc, nu_11,
+				// (void)addcarry_u64(cc, nu_11,
 				// 	(sp_11 << 1) | (sp_10 >> 63), &nu_11);
-				// cc = _addcarry_u64(cc, nu_12,
+				// cc = addcarry_u64(cc, nu_12,
 				// 	(sp_12 << 1) | (sp_11 >> 63), &nu_12);
-				// (void)_addcarry_u64(cc, nu_13,
+				// (void)addcarry_u64(cc, nu_13,
 				// 	(sp_13 << 1) | (sp_12 >> 63), &nu_13);
 
 
-				cc = _addcarry_u64(0, sp_0, nv_0, &sp_0);
-				cc = _addcarry_u64(cc, sp_1, nv_1, &sp_1);
-				cc = _addcarry_u64(cc, sp_2, nv_2, &sp_2);
-				cc = _addcarry_u64(cc, sp_3, nv_3, &sp_3);
-				cc = _addcarry_u64(cc, sp_4, nv_4, &sp_4);
-				cc = _addcarry_u64(cc, sp_5, nv_5, &sp_5);
-				cc = _addcarry_u64(cc, sp_6, nv_6, &sp_6);
-				cc = _addcarry_u64(cc, sp_7, nv_7, &sp_7);
-				cc = _addcarry_u64(cc, sp_8, nv_8, &sp_8);
-				(void)_addcarry_u64(cc, sp_9, nv_9, &sp_9);
-				// cc = _addcarry_u64(cc, sp_10, nv_10, &sp_10);
-				// (void)_addcarry_u64(cc, sp_11, nv_11, &sp_11);
-				// cc = _addcarry_u64(cc, sp_12, nv_12, &sp_12);
-				// (void)_addcarry_u64(cc, sp_13, nv_13, &sp_13);
+				cc = addcarry_u64(0, sp_0, nv_0, &sp_0);
+				cc = addcarry_u64(cc, sp_1, nv_1, &sp_1);
+				cc = addcarry_u64(cc, sp_2, nv_2, &sp_2);
+				cc = addcarry_u64(cc, sp_3, nv_3, &sp_3);
+				cc = addcarry_u64(cc, sp_4, nv_4, &sp_4);
+				cc = addcarry_u64(cc, sp_5, nv_5, &sp_5);
+				cc = addcarry_u64(cc, sp_6, nv_6, &sp_6);
+				cc = addcarry_u64(cc, sp_7, nv_7, &sp_7);
+				cc = addcarry_u64(cc, sp_8, nv_8, &sp_8);
+				(void)addcarry_u64(cc, sp_9, nv_9, &sp_9);
+				// cc = addcarry_u64(cc, sp_10, nv_10, &sp_10);
+				// (void)addcarry_u64(cc, sp_11, nv_11, &sp_11);
+				// cc = addcarry_u64(cc, sp_12, nv_12, &sp_12);
+				// (void)addcarry_u64(cc, sp_13, nv_13, &sp_13);
 
 			} else {
 				unsigned rs, s1, rs1, s2, rs2;
@@ -2261,110 +2208,110 @@ curve448_reduce_basis_vartime(
 				s2 = s << 1;
 				rs2 = 64 - s2;
 
-				cc = _addcarry_u64(0, u0_0,
+				cc = addcarry_u64(0, u0_0,
 					(v0_0 << s), &u0_0);
-				cc = _addcarry_u64(cc, u0_1,
+				cc = addcarry_u64(cc, u0_1,
 					(v0_1 << s) | (v0_0 >> rs), &u0_1);
-				cc = _addcarry_u64(cc, u0_2,
+				cc = addcarry_u64(cc, u0_2,
 					(v0_2 << s) | (v0_1 >> rs), &u0_2);
-				(void)_addcarry_u64(cc, u0_3,
+				(void)addcarry_u64(cc, u0_3,
 					(v0_3 << s) | (v0_2 >> rs), &u0_3);
 
 
-				cc = _addcarry_u64(0, u1_0,
+				cc = addcarry_u64(0, u1_0,
 					(v1_0 << s), &u1_0);
-				cc = _addcarry_u64(cc, u1_1,
+				cc = addcarry_u64(cc, u1_1,
 					(v1_1 << s) | (v1_0 >> rs), &u1_1);
-				cc = _addcarry_u64(cc, u1_2,
+				cc = addcarry_u64(cc, u1_2,
 					(v1_2 << s) | (v1_1 >> rs), &u1_2);
-				(void)_addcarry_u64(cc, u1_3,
+				(void)addcarry_u64(cc, u1_3,
 					(v1_3 << s) | (v1_2 >> rs), &u1_3);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(nv_0 << s2), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(nv_1 << s2) | (nv_0 >> rs2), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(nv_2 << s2) | (nv_1 >> rs2), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(nv_3 << s2) | (nv_2 >> rs2), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(nv_4 << s2) | (nv_3 >> rs2), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(nv_5 << s2) | (nv_4 >> rs2), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(nv_6 << s2) | (nv_5 >> rs2), &nu_6);
-				cc = _addcarry_u64(cc, nu_7,
+				cc = addcarry_u64(cc, nu_7,
 					(nv_7 << s2) | (nv_6 >> rs2), &nu_7);
-				cc = _addcarry_u64(cc, nu_8,
+				cc = addcarry_u64(cc, nu_8,
 					(nv_8 << s2) | (nv_7 >> rs2), &nu_8);
-				(void)_addcarry_u64(cc, nu_9,
+				(void)addcarry_u64(cc, nu_9,
 					(nv_9 << s2) | (nv_8 >> rs2), &nu_9);
-				// cc = _addcarry_u64(cc, nu_10,
+				// cc = addcarry_u64(cc, nu_10,
 				// 	(nv_10 << s2) | (nv_9 >> rs2), &nu_10);
-				// (void)_addcarry_u64(cc, nu_11,
+				// (void)addcarry_u64(cc, nu_11,
 				// 	(nv_11 << s2) | (nv_10 >> rs2), &nu_11);
-				// cc = _addcarry_u64(cc, nu_12,
+				// cc = addcarry_u64(cc, nu_12,
 				// 	(nv_12 << s2) | (nv_11 >> rs2), &nu_12);
-				// (void)_addcarry_u64(cc, nu_13,
+				// (void)addcarry_u64(cc, nu_13,
 				// 	(nv_13 << s2) | (nv_12 >> rs2), &nu_13);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(sp_0 << s1), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(sp_1 << s1) | (sp_0 >> rs1), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(sp_2 << s1) | (sp_1 >> rs1), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(sp_3 << s1) | (sp_2 >> rs1), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(sp_4 << s1) | (sp_3 >> rs1), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(sp_5 << s1) | (sp_4 >> rs1), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(sp_6 << s1) | (sp_5 >> rs1), &nu_6);
-				cc = _addcarry_u64(cc, nu_7,
+				cc = addcarry_u64(cc, nu_7,
 					(sp_7 << s1) | (sp_6 >> rs1), &nu_7);
-				cc = _addcarry_u64(cc, nu_8,
+				cc = addcarry_u64(cc, nu_8,
 					(sp_8 << s1) | (sp_7 >> rs1), &nu_8);
-				(void)_addcarry_u64(cc, nu_9,
+				(void)addcarry_u64(cc, nu_9,
 					(sp_9 << s1) | (sp_8 >> rs1), &nu_9);
-				// cc = _addcarry_u64(cc, nu_10,
+				// cc = addcarry_u64(cc, nu_10,
 				// 	(sp_10 << s1) | (sp_9 >> rs1), &nu_10);
-				// (void)_addcarry_u64(cc, nu_11,
+				// (void)addcarry_u64(cc, nu_11,
 				// 	(sp_11 << s1) | (sp_10 >> rs1), &nu_11);
-				// cc = _addcarry_u64(cc, nu_12,
+				// cc = addcarry_u64(cc, nu_12,
 				// 	(sp_12 << s1) | (sp_11 >> rs1), &nu_12);
-				// (void)_addcarry_u64(cc, nu_13,
+				// (void)addcarry_u64(cc, nu_13,
 				// 	(sp_13 << s1) | (sp_12 >> rs1), &nu_13);
 
-				cc = _addcarry_u64(0, sp_0,
+				cc = addcarry_u64(0, sp_0,
 					(nv_0 << s), &sp_0);
-				cc = _addcarry_u64(cc, sp_1,
+				cc = addcarry_u64(cc, sp_1,
 					(nv_1 << s) | (nv_0 >> rs), &sp_1);
-				cc = _addcarry_u64(cc, sp_2,
+				cc = addcarry_u64(cc, sp_2,
 					(nv_2 << s) | (nv_1 >> rs), &sp_2);
-				cc = _addcarry_u64(cc, sp_3,
+				cc = addcarry_u64(cc, sp_3,
 					(nv_3 << s) | (nv_2 >> rs), &sp_3);
-				cc = _addcarry_u64(cc, sp_4,
+				cc = addcarry_u64(cc, sp_4,
 					(nv_4 << s) | (nv_3 >> rs), &sp_4);
-				cc = _addcarry_u64(cc, sp_5,
+				cc = addcarry_u64(cc, sp_5,
 					(nv_5 << s) | (nv_4 >> rs), &sp_5);
-				cc = _addcarry_u64(cc, sp_6,
+				cc = addcarry_u64(cc, sp_6,
 					(nv_6 << s) | (nv_5 >> rs), &sp_6);
-				cc = _addcarry_u64(cc, sp_7,
+				cc = addcarry_u64(cc, sp_7,
 					(nv_7 << s) | (nv_6 >> rs), &sp_7);
-				cc = _addcarry_u64(cc, sp_8,
+				cc = addcarry_u64(cc, sp_8,
 					(nv_8 << s) | (nv_7 >> rs), &sp_8);
-				(void)_addcarry_u64(cc, sp_9,
+				(void)addcarry_u64(cc, sp_9,
 					(nv_9 << s) | (nv_8 >> rs), &sp_9);
-				// cc = _addcarry_u64(cc, sp_10,
+				// cc = addcarry_u64(cc, sp_10,
 				// 	(nv_10 << s) | (nv_9 >> rs), &sp_10);
-				// (void)_addcarry_u64(cc, sp_11,
+				// (void)addcarry_u64(cc, sp_11,
 				// 	(nv_11 << s) | (nv_10 >> rs), &sp_11);
-				// cc = _addcarry_u64(cc, sp_12,
+				// cc = addcarry_u64(cc, sp_12,
 				// 	(nv_12 << s) | (nv_11 >> rs), &sp_12);
-				// (void)_addcarry_u64(cc, sp_13,
+				// (void)addcarry_u64(cc, sp_13,
 				// 	(nv_13 << s) | (nv_12 >> rs), &sp_13);
 			}
 		}
@@ -2384,20 +2331,20 @@ curve448_reduce_basis_vartime(
 		/*
 		 * If nu < nv, then swap(u,v) and swap(nu,nv).
 		 */
-		cc = _subborrow_u64(0, nu_0, nv_0, &w);
-		cc = _subborrow_u64(cc, nu_1, nv_1, &w);
-		cc = _subborrow_u64(cc, nu_2, nv_2, &w);
-		cc = _subborrow_u64(cc, nu_3, nv_3, &w);
-		cc = _subborrow_u64(cc, nu_4, nv_4, &w);
-		cc = _subborrow_u64(cc, nu_5, nv_5, &w);
-		cc = _subborrow_u64(cc, nu_6, nv_6, &w);
-		cc = _subborrow_u64(cc, nu_7, nv_7, &w);
-		// cc = _subborrow_u64(cc, nu_8, nv_8, &w);
-		// cc = _subborrow_u64(cc, nu_9, nv_9, &w);
-		// cc = _subborrow_u64(cc, nu_10, nv_10, &w);
-		// cc = _subborrow_u64(cc, nu_11, nv_11, &w);
-		// cc = _subborrow_u64(cc, nu_12, nv_12, &w);
-		// cc = _subborrow_u64(cc, nu_13, nv_13, &w);
+		cc = subborrow_u64(0, nu_0, nv_0, &w);
+		cc = subborrow_u64(cc, nu_1, nv_1, &w);
+		cc = subborrow_u64(cc, nu_2, nv_2, &w);
+		cc = subborrow_u64(cc, nu_3, nv_3, &w);
+		cc = subborrow_u64(cc, nu_4, nv_4, &w);
+		cc = subborrow_u64(cc, nu_5, nv_5, &w);
+		cc = subborrow_u64(cc, nu_6, nv_6, &w);
+		cc = subborrow_u64(cc, nu_7, nv_7, &w);
+		// cc = subborrow_u64(cc, nu_8, nv_8, &w);
+		// cc = subborrow_u64(cc, nu_9, nv_9, &w);
+		// cc = subborrow_u64(cc, nu_10, nv_10, &w);
+		// cc = subborrow_u64(cc, nu_11, nv_11, &w);
+		// cc = subborrow_u64(cc, nu_12, nv_12, &w);
+		// cc = subborrow_u64(cc, nu_13, nv_13, &w);
 		m = -(unsigned long long)cc;
 
 
@@ -2471,7 +2418,7 @@ curve448_reduce_basis_vartime(
 		bitlength_top |= \
 			bitlength_word & -(unsigned long long)bitlength_flag; \
 		bitlength_acc -= bitlength_flag; \
-		(size) = (bitlength_acc << 6) - _lzcnt_u64(bitlength_top); \
+		(size) = (bitlength_acc << 6) - lzcnt_u64(bitlength_top); \
 	} while (0)
 
 
@@ -2661,74 +2608,74 @@ curve448_reduce_basis_vartime(
 
 		if ((sp_7 >> 63) == 0) {
 			if (s == 0) {
-				cc = _subborrow_u64(0, u0_0, v0_0, &u0_0);
-				cc = _subborrow_u64(cc, u0_1, v0_1, &u0_1);
-				cc = _subborrow_u64(cc, u0_2, v0_2, &u0_2);
-				(void)_subborrow_u64(cc, u0_3, v0_3, &u0_3);
-
-				cc = _subborrow_u64(0, u1_0, v1_0, &u1_0);
-				cc = _subborrow_u64(cc, u1_1, v1_1, &u1_1);
-				cc = _subborrow_u64(cc, u1_2, v1_2, &u1_2);
-				(void)_subborrow_u64(cc, u1_3, v1_3, &u1_3);
-
-				cc = _addcarry_u64(0, nu_0, nv_0, &nu_0);
-				cc = _addcarry_u64(cc, nu_1, nv_1, &nu_1);
-				cc = _addcarry_u64(cc, nu_2, nv_2, &nu_2);
-				cc = _addcarry_u64(cc, nu_3, nv_3, &nu_3);
-				cc = _addcarry_u64(cc, nu_4, nv_4, &nu_4);
-				cc = _addcarry_u64(cc, nu_5, nv_5, &nu_5);
-				cc = _addcarry_u64(cc, nu_6, nv_6, &nu_6);
-				(void)_addcarry_u64(cc, nu_7, nv_7, &nu_7);
-				// cc = _addcarry_u64(cc, nu_8, nv_8, &nu_8);
-				// (void)_addcarry_u64(cc, nu_9, nv_9, &nu_9);
-				// cc = _addcarry_u64(cc, nu_10, nv_10, &nu_10);
-				// (void)_addcarry_u64(cc, nu_11, nv_11, &nu_11);
-				// cc = _addcarry_u64(cc, nu_12, nv_12, &nu_12);
-				// (void)_addcarry_u64(cc, nu_13, nv_13, &nu_13);
-
-				cc = _subborrow_u64(0, nu_0,
+				cc = subborrow_u64(0, u0_0, v0_0, &u0_0);
+				cc = subborrow_u64(cc, u0_1, v0_1, &u0_1);
+				cc = subborrow_u64(cc, u0_2, v0_2, &u0_2);
+				(void)subborrow_u64(cc, u0_3, v0_3, &u0_3);
+
+				cc = subborrow_u64(0, u1_0, v1_0, &u1_0);
+				cc = subborrow_u64(cc, u1_1, v1_1, &u1_1);
+				cc = subborrow_u64(cc, u1_2, v1_2, &u1_2);
+				(void)subborrow_u64(cc, u1_3, v1_3, &u1_3);
+
+				cc = addcarry_u64(0, nu_0, nv_0, &nu_0);
+				cc = addcarry_u64(cc, nu_1, nv_1, &nu_1);
+				cc = addcarry_u64(cc, nu_2, nv_2, &nu_2);
+				cc = addcarry_u64(cc, nu_3, nv_3, &nu_3);
+				cc = addcarry_u64(cc, nu_4, nv_4, &nu_4);
+				cc = addcarry_u64(cc, nu_5, nv_5, &nu_5);
+				cc = addcarry_u64(cc, nu_6, nv_6, &nu_6);
+				(void)addcarry_u64(cc, nu_7, nv_7, &nu_7);
+				// cc = addcarry_u64(cc, nu_8, nv_8, &nu_8);
+				// (void)addcarry_u64(cc, nu_9, nv_9, &nu_9);
+				// cc = addcarry_u64(cc, nu_10, nv_10, &nu_10);
+				// (void)addcarry_u64(cc, nu_11, nv_11, &nu_11);
+				// cc = addcarry_u64(cc, nu_12, nv_12, &nu_12);
+				// (void)addcarry_u64(cc, nu_13, nv_13, &nu_13);
+
+				cc = subborrow_u64(0, nu_0,
 					(sp_0 << 1), &nu_0);
-				cc = _subborrow_u64(cc, nu_1,
+				cc = subborrow_u64(cc, nu_1,
 					(sp_1 << 1) | (sp_0 >> 63), &nu_1);
-				cc = _subborrow_u64(cc, nu_2,
+				cc = subborrow_u64(cc, nu_2,
 					(sp_2 << 1) | (sp_1 >> 63), &nu_2);
-				cc = _subborrow_u64(cc, nu_3,
+				cc = subborrow_u64(cc, nu_3,
 					(sp_3 << 1) | (sp_2 >> 63), &nu_3);
-				cc = _subborrow_u64(cc, nu_4,
+				cc = subborrow_u64(cc, nu_4,
 					(sp_4 << 1) | (sp_3 >> 63), &nu_4);
-				cc = _subborrow_u64(cc, nu_5,
+				cc = subborrow_u64(cc, nu_5,
 					(sp_5 << 1) | (sp_4 >> 63), &nu_5);
-				cc = _subborrow_u64(cc, nu_6,
+				cc = subborrow_u64(cc, nu_6,
 					(sp_6 << 1) | (sp_5 >> 63), &nu_6);
-				(void)_subborrow_u64(cc, nu_7,
+				(void)subborrow_u64(cc, nu_7,
 					(sp_7 << 1) | (sp_6 >> 63), &nu_7);
-				// cc = _subborrow_u64(cc, nu_8,
+				// cc = subborrow_u64(cc, nu_8,
 				// 	(sp_8 << 1) | (sp_7 >> 63), &nu_8);
-				// (void)_subborrow_u64(cc, nu_9,
+				// (void)subborrow_u64(cc, nu_9,
 				// 	(sp_9 << 1) | (sp_8 >> 63), &nu_9);
-				// cc = _subborrow_u64(cc, nu_10,
+				// cc = subborrow_u64(cc, nu_10,
 				// 	(sp_10 << 1) | (sp_9 >> 63), &nu_10);
-				// (void)_subborrow_u64(cc, nu_11,
+				// (void)subborrow_u64(cc, nu_11,
 				// 	(sp_11 << 1) | (sp_10 >> 63), &nu_11);
-				// cc = _subborrow_u64(cc, nu_12,
+				// cc = subborrow_u64(cc, nu_12,
 				// 	(sp_12 << 1) | (sp_11 >> 63), &nu_12);
-				// (void)_subborrow_u64(cc, nu_13,
+				// (void)subborrow_u64(cc, nu_13,
 				// 	(sp_13 << 1) | (sp_12 >> 63), &nu_13);
 
-				cc = _subborrow_u64(0, sp_0, nv_0, &sp_0);
-				cc = _subborrow_u64(cc, sp_1, nv_1, &sp_1);
-				cc = _subborrow_u64(cc, sp_2, nv_2, &sp_2);
-				cc = _subborrow_u64(cc, sp_3, nv_3, &sp_3);
-				cc = _subborrow_u64(cc, sp_4, nv_4, &sp_4);
-				cc = _subborrow_u64(cc, sp_5, nv_5, &sp_5);
-				cc = _subborrow_u64(cc, sp_6, nv_6, &sp_6);
-				(void)_subborrow_u64(cc, sp_7, nv_7, &sp_7);
-				// cc = _subborrow_u64(cc, sp_8, nv_8, &sp_8);
-				// (void)_subborrow_u64(cc, sp_9, nv_9, &sp_9);
-				// cc = _subborrow_u64(cc, sp_10, nv_10, &sp_10);
-				// (void)_subborrow_u64(cc, sp_11, nv_11, &sp_11);
-				// cc = _subborrow_u64(cc, sp_12, nv_12, &sp_12);
-				// (void)_subborrow_u64(cc, sp_13, nv_13, &sp_13);
+				cc = subborrow_u64(0, sp_0, nv_0, &sp_0);
+				cc = subborrow_u64(cc, sp_1, nv_1, &sp_1);
+				cc = subborrow_u64(cc, sp_2, nv_2, &sp_2);
+				cc = subborrow_u64(cc, sp_3, nv_3, &sp_3);
+				cc = subborrow_u64(cc, sp_4, nv_4, &sp_4);
+				cc = subborrow_u64(cc, sp_5, nv_5, &sp_5);
+				cc = subborrow_u64(cc, sp_6, nv_6, &sp_6);
+				(void)subborrow_u64(cc, sp_7, nv_7, &sp_7);
+				// cc = subborrow_u64(cc, sp_8, nv_8, &sp_8);
+				// (void)subborrow_u64(cc, sp_9, nv_9, &sp_9);
+				// cc = subborrow_u64(cc, sp_10, nv_10, &sp_10);
+				// (void)subborrow_u64(cc, sp_11, nv_11, &sp_11);
+				// cc = subborrow_u64(cc, sp_12, nv_12, &sp_12);
+				// (void)subborrow_u64(cc, sp_13, nv_13, &sp_13);
 
 			} else {
 				unsigned rs, s1, rs1, s2, rs2;
@@ -2739,183 +2686,183 @@ curve448_reduce_basis_vartime(
 				s2 = s << 1;
 				rs2 = 64 - s2;
 
-				cc = _subborrow_u64(0, u0_0,
+				cc = subborrow_u64(0, u0_0,
 					(v0_0 << s), &u0_0);
-				cc = _subborrow_u64(cc, u0_1,
+				cc = subborrow_u64(cc, u0_1,
 					(v0_1 << s) | (v0_0 >> rs), &u0_1);
-				cc = _subborrow_u64(cc, u0_2,
+				cc = subborrow_u64(cc, u0_2,
 					(v0_2 << s) | (v0_1 >> rs), &u0_2);
-				(void)_subborrow_u64(cc, u0_3,
+				(void)subborrow_u64(cc, u0_3,
 					(v0_3 << s) | (v0_2 >> rs), &u0_3);
 
 
-				cc = _subborrow_u64(0, u1_0,
+				cc = subborrow_u64(0, u1_0,
 					(v1_0 << s), &u1_0);
-				cc = _subborrow_u64(cc, u1_1,
+				cc = subborrow_u64(cc, u1_1,
 					(v1_1 << s) | (v1_0 >> rs), &u1_1);
-				cc = _subborrow_u64(cc, u1_2,
+				cc = subborrow_u64(cc, u1_2,
 					(v1_2 << s) | (v1_1 >> rs), &u1_2);
-				(void)_subborrow_u64(cc, u1_3,
+				(void)subborrow_u64(cc, u1_3,
 					(v1_3 << s) | (v1_2 >> rs), &u1_3);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(nv_0 << s2), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(nv_1 << s2) | (nv_0 >> rs2), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(nv_2 << s2) | (nv_1 >> rs2), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(nv_3 << s2) | (nv_2 >> rs2), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(nv_4 << s2) | (nv_3 >> rs2), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(nv_5 << s2) | (nv_4 >> rs2), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(nv_6 << s2) | (nv_5 >> rs2), &nu_6);
-				(void)_addcarry_u64(cc, nu_7,
+				(void)addcarry_u64(cc, nu_7,
 					(nv_7 << s2) | (nv_6 >> rs2), &nu_7);
-				// cc = _addcarry_u64(cc, nu_8,
+				// cc = addcarry_u64(cc, nu_8,
 				// 	(nv_8 << s2) | (nv_7 >> rs2), &nu_8);
-				// (void)_addcarry_u64(cc, nu_9,
+				// (void)addcarry_u64(cc, nu_9,
 				// 	(nv_9 << s2) | (nv_8 >> rs2), &nu_9);
-				// cc = _addcarry_u64(cc, nu_10,
+				// cc = addcarry_u64(cc, nu_10,
 				// 	(nv_10 << s2) | (nv_9 >> rs2), &nu_10);
-				// (void)_addcarry_u64(cc, nu_11,
+				// (void)addcarry_u64(cc, nu_11,
 				// 	(nv_11 << s2) | (nv_10 >> rs2), &nu_11);
-				// cc = _addcarry_u64(cc, nu_12,
+				// cc = addcarry_u64(cc, nu_12,
 				// 	(nv_12 << s2) | (nv_11 >> rs2), &nu_12);
-				// (void)_addcarry_u64(cc, nu_13,
+				// (void)addcarry_u64(cc, nu_13,
 				// 	(nv_13 << s2) | (nv_12 >> rs2), &nu_13);
 
-				cc = _subborrow_u64(0, nu_0,
+				cc = subborrow_u64(0, nu_0,
 					(sp_0 << s1), &nu_0);
-				cc = _subborrow_u64(cc, nu_1,
+				cc = subborrow_u64(cc, nu_1,
 					(sp_1 << s1) | (sp_0 >> rs1), &nu_1);
-				cc = _subborrow_u64(cc, nu_2,
+				cc = subborrow_u64(cc, nu_2,
 					(sp_2 << s1) | (sp_1 >> rs1), &nu_2);
-				cc = _subborrow_u64(cc, nu_3,
+				cc = subborrow_u64(cc, nu_3,
 					(sp_3 << s1) | (sp_2 >> rs1), &nu_3);
-				cc = _subborrow_u64(cc, nu_4,
+				cc = subborrow_u64(cc, nu_4,
 					(sp_4 << s1) | (sp_3 >> rs1), &nu_4);
-				cc = _subborrow_u64(cc, nu_5,
+				cc = subborrow_u64(cc, nu_5,
 					(sp_5 << s1) | (sp_4 >> rs1), &nu_5);
-				cc = _subborrow_u64(cc, nu_6,
+				cc = subborrow_u64(cc, nu_6,
 					(sp_6 << s1) | (sp_5 >> rs1), &nu_6);
-				(void)_subborrow_u64(cc, nu_7,
+				(void)subborrow_u64(cc, nu_7,
 					(sp_7 << s1) | (sp_6 >> rs1), &nu_7);
-				// cc = _subborrow_u64(cc, nu_8,
+				// cc = subborrow_u64(cc, nu_8,
 				// 	(sp_8 << s1) | (sp_7 >> rs1), &nu_8);
-				// (void)_subborrow_u64(cc, nu_9,
+				// (void)subborrow_u64(cc, nu_9,
 				// 	(sp_9 << s1) | (sp_8 >> rs1), &nu_9);
-				// cc = _subborrow_u64(cc, nu_10,
+				// cc = subborrow_u64(cc, nu_10,
 				// 	(sp_10 << s1) | (sp_9 >> rs1), &nu_10);
-				// (void)_subborrow_u64(cc, nu_11,
+				// (void)subborrow_u64(cc, nu_11,
 				// 	(sp_11 << s1) | (sp_10 >> rs1), &nu_11);
-				// cc = _subborrow_u64(cc, nu_12,
+				// cc = subborrow_u64(cc, nu_12,
 				// 	(sp_12 << s1) | (sp_11 >> rs1), &nu_12);
-				// (void)_subborrow_u64(cc, nu_13,
+				// (void)subborrow_u64(cc, nu_13,
 				// 	(sp_13 << s1) | (sp_12 >> rs1), &nu_13);
 
-				cc = _subborrow_u64(0, sp_0,
+				cc = subborrow_u64(0, sp_0,
 					(nv_0 << s), &sp_0);
-				cc = _subborrow_u64(cc, sp_1,
+				cc = subborrow_u64(cc, sp_1,
 					(nv_1 << s) | (nv_0 >> rs), &sp_1);
-				cc = _subborrow_u64(cc, sp_2,
+				cc = subborrow_u64(cc, sp_2,
 					(nv_2 << s) | (nv_1 >> rs), &sp_2);
-				cc = _subborrow_u64(cc, sp_3,
+				cc = subborrow_u64(cc, sp_3,
 					(nv_3 << s) | (nv_2 >> rs), &sp_3);
-				cc = _subborrow_u64(cc, sp_4,
+				cc = subborrow_u64(cc, sp_4,
 					(nv_4 << s) | (nv_3 >> rs), &sp_4);
-				cc = _subborrow_u64(cc, sp_5,
+				cc = subborrow_u64(cc, sp_5,
 					(nv_5 << s) | (nv_4 >> rs), &sp_5);
-				cc = _subborrow_u64(cc, sp_6,
+				cc = subborrow_u64(cc, sp_6,
 					(nv_6 << s) | (nv_5 >> rs), &sp_6);
-				(void)_subborrow_u64(cc, sp_7,
+				(void)subborrow_u64(cc, sp_7,
 					(nv_7 << s) | (nv_6 >> rs), &sp_7);
-				// cc = _subborrow_u64(cc, sp_8,
+				// cc = subborrow_u64(cc, sp_8,
 				// 	(nv_8 << s) | (nv_7 >> rs), &sp_8);
-				// (void)_subborrow_u64(cc, sp_9,
+				// (void)subborrow_u64(cc, sp_9,
 				// 	(nv_9 << s) | (nv_8 >> rs), &sp_9);
-				// cc = _subborrow_u64(cc, sp_10,
+				// cc = subborrow_u64(cc, sp_10,
 				// 	(nv_10 << s) | (nv_9 >> rs), &sp_10);
-				// (void)_subborrow_u64(cc, sp_11,
+				// (void)subborrow_u64(cc, sp_11,
 				// 	(nv_11 << s) | (nv_10 >> rs), &sp_11);
-				// cc = _subborrow_u64(cc, sp_12,
+				// cc = subborrow_u64(cc, sp_12,
 				// 	(nv_12 << s) | (nv_11 >> rs), &sp_12);
-				// (void)_subborrow_u64(cc, sp_13,
+				// (void)subborrow_u64(cc, sp_13,
 				// 	(nv_13 << s) | (nv_12 >> rs), &sp_13);
 			}
 		} else {
 			if (s == 0) {
-				cc = _addcarry_u64(0, u0_0, v0_0, &u0_0);
-				cc = _addcarry_u64(cc, u0_1, v0_1, &u0_1);
-				cc = _addcarry_u64(cc, u0_2, v0_2, &u0_2);
-				(void)_addcarry_u64(cc, u0_3, v0_3, &u0_3);
-
-				cc = _addcarry_u64(0, u1_0, v1_0, &u1_0);
-				cc = _addcarry_u64(cc, u1_1, v1_1, &u1_1);
-				cc = _addcarry_u64(cc, u1_2, v1_2, &u1_2);
-				(void)_addcarry_u64(cc, u1_3, v1_3, &u1_3);
-
-				cc = _addcarry_u64(0, nu_0, nv_0, &nu_0);
-				cc = _addcarry_u64(cc, nu_1, nv_1, &nu_1);
-				cc = _addcarry_u64(cc, nu_2, nv_2, &nu_2);
-				cc = _addcarry_u64(cc, nu_3, nv_3, &nu_3);
-				cc = _addcarry_u64(cc, nu_4, nv_4, &nu_4);
-				cc = _addcarry_u64(cc, nu_5, nv_5, &nu_5);
-				cc = _addcarry_u64(cc, nu_6, nv_6, &nu_6);
-				(void)_addcarry_u64(cc, nu_7, nv_7, &nu_7);
-				// cc = _addcarry_u64(cc, nu_8, nv_8, &nu_8);
-				// (void)_addcarry_u64(cc, nu_9, nv_9, &nu_9);
-				// cc = _addcarry_u64(cc, nu_10, nv_10, &nu_10);
-				// (void)_addcarry_u64(cc, nu_11, nv_11, &nu_11);
-				// cc = _addcarry_u64(cc, nu_12, nv_12, &nu_12);
-				// (void)_addcarry_u64(cc, nu_13, nv_13, &nu_13);
-
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, u0_0, v0_0, &u0_0);
+				cc = addcarry_u64(cc, u0_1, v0_1, &u0_1);
+				cc = addcarry_u64(cc, u0_2, v0_2, &u0_2);
+				(void)addcarry_u64(cc, u0_3, v0_3, &u0_3);
+
+				cc = addcarry_u64(0, u1_0, v1_0, &u1_0);
+				cc = addcarry_u64(cc, u1_1, v1_1, &u1_1);
+				cc = addcarry_u64(cc, u1_2, v1_2, &u1_2);
+				(void)addcarry_u64(cc, u1_3, v1_3, &u1_3);
+
+				cc = addcarry_u64(0, nu_0, nv_0, &nu_0);
+				cc = addcarry_u64(cc, nu_1, nv_1, &nu_1);
+				cc = addcarry_u64(cc, nu_2, nv_2, &nu_2);
+				cc = addcarry_u64(cc, nu_3, nv_3, &nu_3);
+				cc = addcarry_u64(cc, nu_4, nv_4, &nu_4);
+				cc = addcarry_u64(cc, nu_5, nv_5, &nu_5);
+				cc = addcarry_u64(cc, nu_6, nv_6, &nu_6);
+				(void)addcarry_u64(cc, nu_7, nv_7, &nu_7);
+				// cc = addcarry_u64(cc, nu_8, nv_8, &nu_8);
+				// (void)addcarry_u64(cc, nu_9, nv_9, &nu_9);
+				// cc = addcarry_u64(cc, nu_10, nv_10, &nu_10);
+				// (void)addcarry_u64(cc, nu_11, nv_11, &nu_11);
+				// cc = addcarry_u64(cc, nu_12, nv_12, &nu_12);
+				// (void)addcarry_u64(cc, nu_13, nv_13, &nu_13);
+
+				cc = addcarry_u64(0, nu_0,
 					(sp_0 << 1), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(sp_1 << 1) | (sp_0 >> 63), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(sp_2 << 1) | (sp_1 >> 63), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(sp_3 << 1) | (sp_2 >> 63), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(sp_4 << 1) | (sp_3 >> 63), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(sp_5 << 1) | (sp_4 >> 63), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(sp_6 << 1) | (sp_5 >> 63), &nu_6);
-				(void)_addcarry_u64(cc, nu_7,
+				(void)addcarry_u64(cc, nu_7,
 					(sp_7 << 1) | (sp_6 >> 63), &nu_7);
-				// cc = _addcarry_u64(cc, nu_8,
+				// cc = addcarry_u64(cc, nu_8,
 				// 	(sp_8 << 1) | (sp_7 >> 63), &nu_8);
-				// (void)_addcarry_u64(cc, nu_9,
+				// (void)addcarry_u64(cc, nu_9,
 				// 	(sp_9 << 1) | (sp_8 >> 63), &nu_9);
-				// cc = _addcarry_u64(cc, nu_10,
+				// cc = addcarry_u64(cc, nu_10,
 				// 	(sp_10 << 1) | (sp_9 >> 63), &nu_10);
-				// (void)_addcarry_u64(cc, nu_11,
+				// (void)addcarry_u64(cc, nu_11,
 				// 	(sp_11 << 1) | (sp_10 >> 63), &nu_11);
-				// cc = _addcarry_u64(cc, nu_12,
+				// cc = addcarry_u64(cc, nu_12,
 				// 	(sp_12 << 1) | (sp_11 >> 63), &nu_12);
-				// (void)_addcarry_u64(cc, nu_13,
+				// (void)addcarry_u64(cc, nu_13,
 				// 	(sp_13 << 1) | (sp_12 >> 63), &nu_13);
 
 
-				cc = _addcarry_u64(0, sp_0, nv_0, &sp_0);
-				cc = _addcarry_u64(cc, sp_1, nv_1, &sp_1);
-				cc = _addcarry_u64(cc, sp_2, nv_2, &sp_2);
-				cc = _addcarry_u64(cc, sp_3, nv_3, &sp_3);
-				cc = _addcarry_u64(cc, sp_4, nv_4, &sp_4);
-				cc = _addcarry_u64(cc, sp_5, nv_5, &sp_5);
-				cc = _addcarry_u64(cc, sp_6, nv_6, &sp_6);
-				(void)_addcarry_u64(cc, sp_7, nv_7, &sp_7);
-				// cc = _addcarry_u64(cc, sp_8, nv_8, &sp_8);
-				// (void)_addcarry_u64(cc, sp_9, nv_9, &sp_9);
-				// cc = _addcarry_u64(cc, sp_10, nv_10, &sp_10);
-				// (void)_addcarry_u64(cc, sp_11, nv_11, &sp_11);
-				// cc = _addcarry_u64(cc, sp_12, nv_12, &sp_12);
-				// (void)_addcarry_u64(cc, sp_13, nv_13, &sp_13);
+				cc = addcarry_u64(0, sp_0, nv_0, &sp_0);
+				cc = addcarry_u64(cc, sp_1, nv_1, &sp_1);
+				cc = addcarry_u64(cc, sp_2, nv_2, &sp_2);
+				cc = addcarry_u64(cc, sp_3, nv_3, &sp_3);
+				cc = addcarry_u64(cc, sp_4, nv_4, &sp_4);
+				cc = addcarry_u64(cc, sp_5, nv_5, &sp_5);
+				cc = addcarry_u64(cc, sp_6, nv_6, &sp_6);
+				(void)addcarry_u64(cc, sp_7, nv_7, &sp_7);
+				// cc = addcarry_u64(cc, sp_8, nv_8, &sp_8);
+				// (void)addcarry_u64(cc, sp_9, nv_9, &sp_9);
+				// cc = addcarry_u64(cc, sp_10, nv_10, &sp_10);
+				// (void)addcarry_u64(cc, sp_11, nv_11, &sp_11);
+				// cc = addcarry_u64(cc, sp_12, nv_12, &sp_12);
+				// (void)addcarry_u64(cc, sp_13, nv_13, &sp_13);
 
 			} else {
 				unsigned rs, s1, rs1, s2, rs2;
@@ -2926,110 +2873,110 @@ curve448_reduce_basis_vartime(
 				s2 = s << 1;
 				rs2 = 64 - s2;
 
-				cc = _addcarry_u64(0, u0_0,
+				cc = addcarry_u64(0, u0_0,
 					(v0_0 << s), &u0_0);
-				cc = _addcarry_u64(cc, u0_1,
+				cc = addcarry_u64(cc, u0_1,
 					(v0_1 << s) | (v0_0 >> rs), &u0_1);
-				cc = _addcarry_u64(cc, u0_2,
+				cc = addcarry_u64(cc, u0_2,
 					(v0_2 << s) | (v0_1 >> rs), &u0_2);
-				(void)_addcarry_u64(cc, u0_3,
+				(void)addcarry_u64(cc, u0_3,
 					(v0_3 << s) | (v0_2 >> rs), &u0_3);
 
 
-				cc = _addcarry_u64(0, u1_0,
+				cc = addcarry_u64(0, u1_0,
 					(v1_0 << s), &u1_0);
-				cc = _addcarry_u64(cc, u1_1,
+				cc = addcarry_u64(cc, u1_1,
 					(v1_1 << s) | (v1_0 >> rs), &u1_1);
-				cc = _addcarry_u64(cc, u1_2,
+				cc = addcarry_u64(cc, u1_2,
 					(v1_2 << s) | (v1_1 >> rs), &u1_2);
-				(void)_addcarry_u64(cc, u1_3,
+				(void)addcarry_u64(cc, u1_3,
 					(v1_3 << s) | (v1_2 >> rs), &u1_3);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(nv_0 << s2), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(nv_1 << s2) | (nv_0 >> rs2), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(nv_2 << s2) | (nv_1 >> rs2), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(nv_3 << s2) | (nv_2 >> rs2), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(nv_4 << s2) | (nv_3 >> rs2), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(nv_5 << s2) | (nv_4 >> rs2), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(nv_6 << s2) | (nv_5 >> rs2), &nu_6);
-				(void)_addcarry_u64(cc, nu_7,
+				(void)addcarry_u64(cc, nu_7,
 					(nv_7 << s2) | (nv_6 >> rs2), &nu_7);
-				// cc = _addcarry_u64(cc, nu_8,
+				// cc = addcarry_u64(cc, nu_8,
 				// 	(nv_8 << s2) | (nv_7 >> rs2), &nu_8);
-				// (void)_addcarry_u64(cc, nu_9,
+				// (void)addcarry_u64(cc, nu_9,
 				// 	(nv_9 << s2) | (nv_8 >> rs2), &nu_9);
-				// cc = _addcarry_u64(cc, nu_10,
+				// cc = addcarry_u64(cc, nu_10,
 				// 	(nv_10 << s2) | (nv_9 >> rs2), &nu_10);
-				// (void)_addcarry_u64(cc, nu_11,
+				// (void)addcarry_u64(cc, nu_11,
 				// 	(nv_11 << s2) | (nv_10 >> rs2), &nu_11);
-				// cc = _addcarry_u64(cc, nu_12,
+				// cc = addcarry_u64(cc, nu_12,
 				// 	(nv_12 << s2) | (nv_11 >> rs2), &nu_12);
-				// (void)_addcarry_u64(cc, nu_13,
+				// (void)addcarry_u64(cc, nu_13,
 				// 	(nv_13 << s2) | (nv_12 >> rs2), &nu_13);
 
-				cc = _addcarry_u64(0, nu_0,
+				cc = addcarry_u64(0, nu_0,
 					(sp_0 << s1), &nu_0);
-				cc = _addcarry_u64(cc, nu_1,
+				cc = addcarry_u64(cc, nu_1,
 					(sp_1 << s1) | (sp_0 >> rs1), &nu_1);
-				cc = _addcarry_u64(cc, nu_2,
+				cc = addcarry_u64(cc, nu_2,
 					(sp_2 << s1) | (sp_1 >> rs1), &nu_2);
-				cc = _addcarry_u64(cc, nu_3,
+				cc = addcarry_u64(cc, nu_3,
 					(sp_3 << s1) | (sp_2 >> rs1), &nu_3);
-				cc = _addcarry_u64(cc, nu_4,
+				cc = addcarry_u64(cc, nu_4,
 					(sp_4 << s1) | (sp_3 >> rs1), &nu_4);
-				cc = _addcarry_u64(cc, nu_5,
+				cc = addcarry_u64(cc, nu_5,
 					(sp_5 << s1) | (sp_4 >> rs1), &nu_5);
-				cc = _addcarry_u64(cc, nu_6,
+				cc = addcarry_u64(cc, nu_6,
 					(sp_6 << s1) | (sp_5 >> rs1), &nu_6);
-				(void)_addcarry_u64(cc, nu_7,
+				(void)addcarry_u64(cc, nu_7,
 					(sp_7 << s1) | (sp_6 >> rs1), &nu_7);
-				// cc = _addcarry_u64(cc, nu_8,
+				// cc = addcarry_u64(cc, nu_8,
 				// 	(sp_8 << s1) | (sp_7 >> rs1), &nu_8);
-				// (void)_addcarry_u64(cc, nu_9,
+				// (void)addcarry_u64(cc, nu_9,
 				// 	(sp_9 << s1) | (sp_8 >> rs1), &nu_9);
-				// cc = _addcarry_u64(cc, nu_10,
+				// cc = addcarry_u64(cc, nu_10,
 				// 	(sp_10 << s1) | (sp_9 >> rs1), &nu_10);
-				// (void)_addcarry_u64(cc, nu_11,
+				// (void)addcarry_u64(cc, nu_11,
 				// 	(sp_11 << s1) | (sp_10 >> rs1), &nu_11);
-				// cc = _addcarry_u64(cc, nu_12,
+				// cc = addcarry_u64(cc, nu_12,
 				// 	(sp_12 << s1) | (sp_11 >> rs1), &nu_12);
-				// (void)_addcarry_u64(cc, nu_13,
+				// (void)addcarry_u64(cc, nu_13,
 				// 	(sp_13 << s1) | (sp_12 >> rs1), &nu_13);
 
-				cc = _addcarry_u64(0, sp_0,
+				cc = addcarry_u64(0, sp_0,
 					(nv_0 << s), &sp_0);
-				cc = _addcarry_u64(cc, sp_1,
+				cc = addcarry_u64(cc, sp_1,
 					(nv_1 << s) | (nv_0 >> rs), &sp_1);
-				cc = _addcarry_u64(cc, sp_2,
+				cc = addcarry_u64(cc, sp_2,
 					(nv_2 << s) | (nv_1 >> rs), &sp_2);
-				cc = _addcarry_u64(cc, sp_3,
+				cc = addcarry_u64(cc, sp_3,
 					(nv_3 << s) | (nv_2 >> rs), &sp_3);
-				cc = _addcarry_u64(cc, sp_4,
+				cc = addcarry_u64(cc, sp_4,
 					(nv_4 << s) | (nv_3 >> rs), &sp_4);
-				cc = _addcarry_u64(cc, sp_5,
+				cc = addcarry_u64(cc, sp_5,
 					(nv_5 << s) | (nv_4 >> rs), &sp_5);
-				cc = _addcarry_u64(cc, sp_6,
+				cc = addcarry_u64(cc, sp_6,
 					(nv_6 << s) | (nv_5 >> rs), &sp_6);
-				(void)_addcarry_u64(cc, sp_7,
+				(void)addcarry_u64(cc, sp_7,
 					(nv_7 << s) | (nv_6 >> rs), &sp_7);
-				// cc = _addcarry_u64(cc, sp_8,
+				// cc = addcarry_u64(cc, sp_8,
 				// 	(nv_8 << s) | (nv_7 >> rs), &sp_8);
-				// (void)_addcarry_u64(cc, sp_9,
+				// (void)addcarry_u64(cc, sp_9,
 				// 	(nv_9 << s) | (nv_8 >> rs), &sp_9);
-				// cc = _addcarry_u64(cc, sp_10,
+				// cc = addcarry_u64(cc, sp_10,
 				// 	(nv_10 << s) | (nv_9 >> rs), &sp_10);
-				// (void)_addcarry_u64(cc, sp_11,
+				// (void)addcarry_u64(cc, sp_11,
 				// 	(nv_11 << s) | (nv_10 >> rs), &sp_11);
-				// cc = _addcarry_u64(cc, sp_12,
+				// cc = addcarry_u64(cc, sp_12,
 				// 	(nv_12 << s) | (nv_11 >> rs), &sp_12);
-				// (void)_addcarry_u64(cc, sp_13,
+				// (void)addcarry_u64(cc, sp_13,
 				// 	(nv_13 << s) | (nv_12 >> rs), &sp_13);
 			}
 		}
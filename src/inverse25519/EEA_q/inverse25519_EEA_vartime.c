@@ -35,68 +35,21 @@
 #include "inverse25519_EEA_vartime.h"
 
 /*
- * We use the intrinsic functions:
- *   _lzcnt_u32(), _lzcnt_u64(), _addcarry_u64(), _subborrow_u64().
+ * We use the intrinsic functions (see portable_intrinsics.h):
+ *   lzcnt_u64(), addcarry_u64(), subborrow_u64(), muladd_u64().
  */
-#include <immintrin.h>
+#include "../../portable_intrinsics.h"
 
 #define UNLIKELY(cond)  __builtin_expect ((cond) != 0, 0)
 
 
-/*
- * This macro defines a function with prototype:
- *  static inline void name(uint64_t *a, const uint64_t *b, unsigned s)
- * It adds lshift(b,s) to a (if intrinsic_op is _addcarry_u64), or
- * subtracts lshift(b,s) from a (if intrinsic_op is _subborrow_u64).
- * Both values consist of 'size' limbs. Truncation happens if the result
- * does not fit in the output.
- */
-#define DEF_OP_LSHIFT(name, intrinsic_op, size) \
-static void \
-name(uint64_t *a, const uint64_t *b, unsigned s) \
-{ \
-	uint64_t b2[(size)]; \
-	unsigned char cc; \
-	unsigned long long w, w2, e; \
-	size_t i; \
- \
- 	if (s >= 64) { \
-		unsigned k; \
- \
-		k = s >> 6; \
-		s &= 63; \
-		if (k >= (size)) { \
-			return; \
-		} \
-		memset(b2, 0, k * sizeof b2[0]); \
-		memcpy(b2 + k, b, ((size) - k) * sizeof b2[0]); \
-		b = b2; \
-	} \
-	if (s == 0) { \
-		cc = 0; \
-		for (i = 0; i < (size); i ++) { \
-			cc = intrinsic_op(cc, a[i], b[i], &w); \
-			a[i] = w; \
-		} \
-	} else { \
-		cc = 0; \
-		e = 0; \
-		for (i = 0; i < (size); i ++) { \
-			w = b[i]; \
-			cc = intrinsic_op(cc, a[i], (w << s) | e, &w2); \
-			e = w >> (64 - s); \
-			a[i] = w2; \
-		} \
-	} \
-}
-
 
-DEF_OP_LSHIFT(add_lshift_4, _addcarry_u64, 4)
-DEF_OP_LSHIFT(sub_lshift_4, _subborrow_u64, 4)
-DEF_OP_LSHIFT(add_lshift_3, _addcarry_u64, 3)
-DEF_OP_LSHIFT(sub_lshift_3, _subborrow_u64, 3)
-DEF_OP_LSHIFT(add_lshift_2, _addcarry_u64, 2)
-DEF_OP_LSHIFT(sub_lshift_2, _subborrow_u64, 2)
+DEF_OP_LSHIFT(add_lshift_4, addcarry_u64, 4)
+DEF_OP_LSHIFT(sub_lshift_4, subborrow_u64, 4)
+DEF_OP_LSHIFT(add_lshift_3, addcarry_u64, 3)
+DEF_OP_LSHIFT(sub_lshift_3, subborrow_u64, 3)
+DEF_OP_LSHIFT(add_lshift_2, addcarry_u64, 2)
+DEF_OP_LSHIFT(sub_lshift_2, subborrow_u64, 2)
 
 
 
@@ -209,7 +162,7 @@ inverse25519_EEA_vartime(
 		bitlength_top |= \
 			bitlength_word & -(unsigned long long)bitlength_flag; \
 		bitlength_acc -= bitlength_flag; \
-		(size) = (bitlength_acc << 6) - _lzcnt_u64(bitlength_top); \
+		(size) = (bitlength_acc << 6) - lzcnt_u64(bitlength_top); \
 	} while (0)	
 	
 
@@ -298,58 +251,58 @@ inverse25519_EEA_vartime(
 	unsigned long long r_0, r_1, r_2, r_3, t_0, t_1;
 		if ((r2_3 >> 63) == (r1_3 >> 63)){
 			if (s == 0) {
-				cc = _subborrow_u64(0, r2_0, r1_0, &r_0);
-				cc = _subborrow_u64(cc, r2_1, r1_1, &r_1);
-				cc = _subborrow_u64(cc, r2_2, r1_2, &r_2);
-				(void)_subborrow_u64(cc, r2_3, r1_3, &r_3);
+				cc = subborrow_u64(0, r2_0, r1_0, &r_0);
+				cc = subborrow_u64(cc, r2_1, r1_1, &r_1);
+				cc = subborrow_u64(cc, r2_2, r1_2, &r_2);
+				(void)subborrow_u64(cc, r2_3, r1_3, &r_3);
 
-				cc = _subborrow_u64(0, t2_0, t1_0, &t_0);
-				(void)_subborrow_u64(cc, t2_1, t1_1, &t_1);
+				cc = subborrow_u64(0, t2_0, t1_0, &t_0);
+				(void)subborrow_u64(cc, t2_1, t1_1, &t_1);
 
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				cc = _subborrow_u64(0, r2_0,
+				cc = subborrow_u64(0, r2_0,
 					(r1_0 << s), &r_0);
-				cc = _subborrow_u64(cc, r2_1,
+				cc = subborrow_u64(cc, r2_1,
 					(r1_1 << s) | (r1_0 >> rs), &r_1);
-				cc = _subborrow_u64(cc, r2_2,
+				cc = subborrow_u64(cc, r2_2,
 					(r1_2 << s) | (r1_1 >> rs), &r_2);
-				(void)_subborrow_u64(cc, r2_3,
+				(void)subborrow_u64(cc, r2_3,
 					(r1_3 << s) | (r1_2 >> rs), &r_3);
 
-				cc = _subborrow_u64(0, t2_0,
+				cc = subborrow_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				(void)_subborrow_u64(cc, t2_1,
+				(void)subborrow_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
 			}
 		} else {
 			if (s == 0) {
-				cc = _addcarry_u64(0, r2_0, r1_0, &r_0);
-				cc = _addcarry_u64(cc, r2_1, r1_1, &r_1);
-				cc = _addcarry_u64(cc, r2_2, r1_2, &r_2);
-				(void)_addcarry_u64(cc, r2_3, r1_3, &r_3);
+				cc = addcarry_u64(0, r2_0, r1_0, &r_0);
+				cc = addcarry_u64(cc, r2_1, r1_1, &r_1);
+				cc = addcarry_u64(cc, r2_2, r1_2, &r_2);
+				(void)addcarry_u64(cc, r2_3, r1_3, &r_3);
 
-				cc = _addcarry_u64(0, t2_0, t1_0, &t_0);
-				(void)_addcarry_u64(cc, t2_1, t1_1, &t_1);
+				cc = addcarry_u64(0, t2_0, t1_0, &t_0);
+				(void)addcarry_u64(cc, t2_1, t1_1, &t_1);
 
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				cc = _addcarry_u64(0, r2_0,
+				cc = addcarry_u64(0, r2_0,
 					(r1_0 << s), &r_0);
-				cc = _addcarry_u64(cc, r2_1,
+				cc = addcarry_u64(cc, r2_1,
 					(r1_1 << s) | (r1_0 >> rs), &r_1);
-				cc = _addcarry_u64(cc, r2_2,
+				cc = addcarry_u64(cc, r2_2,
 					(r1_2 << s) | (r1_1 >> rs), &r_2);
-				(void)_addcarry_u64(cc, r2_3,
+				(void)addcarry_u64(cc, r2_3,
 					(r1_3 << s) | (r1_2 >> rs), &r_3);
 
-				cc = _addcarry_u64(0, t2_0,
+				cc = addcarry_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				(void)_addcarry_u64(cc, t2_1,
+				(void)addcarry_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
 			}
 		}
@@ -413,7 +366,7 @@ inverse25519_EEA_vartime(
 			bitlength_word & -(unsigned long long)bitlength_flag; \
 		bitlength_acc -= bitlength_flag; \
 		bitlength_flag &= (bitlength_word == 0); \
-		(size) = (bitlength_acc << 6) - _lzcnt_u64(bitlength_top); \
+		(size) = (bitlength_acc << 6) - lzcnt_u64(bitlength_top); \
 	} while (0)
 
 		/*
@@ -493,58 +446,58 @@ inverse25519_EEA_vartime(
 	unsigned long long r_0, r_1, r_2, t_0, t_1, t_2;
 		if ((r2_2 >> 63) == (r1_2 >> 63)){
 			if (s == 0) {
-				cc = _subborrow_u64(0, r2_0, r1_0, &r_0);
-				cc = _subborrow_u64(cc, r2_1, r1_1, &r_1);
-				(void)_subborrow_u64(cc, r2_2, r1_2, &r_2);
+				cc = subborrow_u64(0, r2_0, r1_0, &r_0);
+				cc = subborrow_u64(cc, r2_1, r1_1, &r_1);
+				(void)subborrow_u64(cc, r2_2, r1_2, &r_2);
 
-				cc = _subborrow_u64(0, t2_0, t1_0, &t_0);
-				cc = _subborrow_u64(cc, t2_1, t1_1, &t_1);
-				(void)_subborrow_u64(cc, t2_2, t1_2, &t_2);
+				cc = subborrow_u64(0, t2_0, t1_0, &t_0);
+				cc = subborrow_u64(cc, t2_1, t1_1, &t_1);
+				(void)subborrow_u64(cc, t2_2, t1_2, &t_2);
 
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				cc = _subborrow_u64(0, r2_0,
+				cc = subborrow_u64(0, r2_0,
 					(r1_0 << s), &r_0);
-				cc = _subborrow_u64(cc, r2_1,
+				cc = subborrow_u64(cc, r2_1,
 					(r1_1 << s) | (r1_0 >> rs), &r_1);
-				(void)_subborrow_u64(cc, r2_2,
+				(void)subborrow_u64(cc, r2_2,
 					(r1_2 << s) | (r1_1 >> rs), &r_2);
 
-				cc = _subborrow_u64(0, t2_0,
+				cc = subborrow_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				cc = _subborrow_u64(cc, t2_1,
+				cc = subborrow_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
-				(void)_subborrow_u64(cc, t2_2,
+				(void)subborrow_u64(cc, t2_2,
 					(t1_2 << s) | (t1_1 >> rs), &t_2);
 			}
 		} else {
 			if (s == 0) {
-				cc = _addcarry_u64(0, r2_0, r1_0, &r_0);
-				cc = _addcarry_u64(cc, r2_1, r1_1, &r_1);
-				(void)_addcarry_u64(cc, r2_2, r1_2, &r_2);
+				cc = addcarry_u64(0, r2_0, r1_0, &r_0);
+				cc = addcarry_u64(cc, r2_1, r1_1, &r_1);
+				(void)addcarry_u64(cc, r2_2, r1_2, &r_2);
 
-				cc = _addcarry_u64(0, t2_0, t1_0, &t_0);
-				cc = _addcarry_u64(cc, t2_1, t1_1, &t_1);
-				(void)_addcarry_u64(cc, t2_2, t1_2, &t_2);
+				cc = addcarry_u64(0, t2_0, t1_0, &t_0);
+				cc = addcarry_u64(cc, t2_1, t1_1, &t_1);
+				(void)addcarry_u64(cc, t2_2, t1_2, &t_2);
 
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				cc = _addcarry_u64(0, r2_0,
+				cc = addcarry_u64(0, r2_0,
 					(r1_0 << s), &r_0);
-				cc = _addcarry_u64(cc, r2_1,
+				cc = addcarry_u64(cc, r2_1,
 					(r1_1 << s) | (r1_0 >> rs), &r_1);
-				(void)_addcarry_u64(cc, r2_2,
+				(void)addcarry_u64(cc, r2_2,
 					(r1_2 << s) | (r1_1 >> rs), &r_2);
 				
-				cc = _addcarry_u64(0, t2_0,
+				cc = addcarry_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				cc = _addcarry_u64(cc, t2_1,
+				cc = addcarry_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
-				(void)_addcarry_u64(cc, t2_2,
+				(void)addcarry_u64(cc, t2_2,
 					(t1_2 << s) | (t1_1 >> rs), &t_2);
 			}
 		}
@@ -601,7 +554,7 @@ inverse25519_EEA_vartime(
 		bitlength_top |= \
 			bitlength_word & -(unsigned long long)bitlength_flag; \
 		bitlength_acc -= bitlength_flag; \
-		(size) = (bitlength_acc << 6) - _lzcnt_u64(bitlength_top); \
+		(size) = (bitlength_acc << 6) - lzcnt_u64(bitlength_top); \
 	} while (0)
 		
 		/*
@@ -679,58 +632,58 @@ inverse25519_EEA_vartime(
 	unsigned long long r_0, r_1, t_0, t_1, t_2, t_3;
 		if ((r2_1 >> 63) == (r1_1 >> 63)){
 			if (s == 0) {
-				cc = _subborrow_u64(0, r2_0, r1_0, &r_0);
-				(void)_subborrow_u64(cc, r2_1, r1_1, &r_1);
+				cc = subborrow_u64(0, r2_0, r1_0, &r_0);
+				(void)subborrow_u64(cc, r2_1, r1_1, &r_1);
 				
-				cc = _subborrow_u64(0, t2_0, t1_0, &t_0);
-				cc = _subborrow_u64(cc, t2_1, t1_1, &t_1);
-				cc = _subborrow_u64(cc, t2_2, t1_2, &t_2);
-				(void)_subborrow_u64(cc, t2_3, t1_3, &t_3);
+				cc = subborrow_u64(0, t2_0, t1_0, &t_0);
+				cc = subborrow_u64(cc, t2_1, t1_1, &t_1);
+				cc = subborrow_u64(cc, t2_2, t1_2, &t_2);
+				(void)subborrow_u64(cc, t2_3, t1_3, &t_3);
 
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				cc = _subborrow_u64(0, r2_0,
+				cc = subborrow_u64(0, r2_0,
 					(r1_0 << s), &r_0);
-				(void)_subborrow_u64(cc, r2_1,
+				(void)subborrow_u64(cc, r2_1,
 					(r1_1 << s) | (r1_0 >> rs), &r_1);
 				
-				cc = _subborrow_u64(0, t2_0,
+				cc = subborrow_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				cc = _subborrow_u64(cc, t2_1,
+				cc = subborrow_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
-				cc = _subborrow_u64(cc, t2_2,
+				cc = subborrow_u64(cc, t2_2,
 					(t1_2 << s) | (t1_1 >> rs), &t_2);
-				(void)_subborrow_u64(cc, t2_3,
+				(void)subborrow_u64(cc, t2_3,
 					(t1_3 << s) | (t1_2 >> rs), &t_3);
 			}
 		} else {
 			if (s == 0) {
-				cc = _addcarry_u64(0, r2_0, r1_0, &r_0);
-				(void)_addcarry_u64(cc, r2_1, r1_1, &r_1);
+				cc = addcarry_u64(0, r2_0, r1_0, &r_0);
+				(void)addcarry_u64(cc, r2_1, r1_1, &r_1);
 				
-				cc = _addcarry_u64(0, t2_0, t1_0, &t_0);
-				cc = _addcarry_u64(cc, t2_1, t1_1, &t_1);
-				cc = _addcarry_u64(cc, t2_2, t1_2, &t_2);
-				(void)_addcarry_u64(cc, t2_3, t1_3, &t_3);
+				cc = addcarry_u64(0, t2_0, t1_0, &t_0);
+				cc = addcarry_u64(cc, t2_1, t1_1, &t_1);
+				cc = addcarry_u64(cc, t2_2, t1_2, &t_2);
+				(void)addcarry_u64(cc, t2_3, t1_3, &t_3);
 
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				cc = _addcarry_u64(0, r2_0,
+				cc = addcarry_u64(0, r2_0,
 					(r1_0 << s), &r_0);
-				(void)_addcarry_u64(cc, r2_1,
+				(void)addcarry_u64(cc, r2_1,
 					(r1_1 << s) | (r1_0 >> rs), &r_1);
 				
-				cc = _addcarry_u64(0, t2_0,
+				cc = addcarry_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				cc = _addcarry_u64(cc, t2_1,
+				cc = addcarry_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
-				cc = _addcarry_u64(cc, t2_2,
+				cc = addcarry_u64(cc, t2_2,
 					(t1_2 << s) | (t1_1 >> rs), &t_2);
-				(void)_addcarry_u64(cc, t2_3,
+				(void)addcarry_u64(cc, t2_3,
 					(t1_3 << s) | (t1_2 >> rs), &t_3);
 			}
 		}
@@ -774,8 +727,8 @@ inverse25519_EEA_vartime(
 #define BITLENGTH_1(size, bb)   do { \
 		unsigned long long bitlength_mask = -(bb ## 0 >> 63); \
 		unsigned long long bitlength_word = bb ## 0 ^ bitlength_mask; \
-		(void)_addcarry_u64((bb ## 0 >> 63), bitlength_word, (0L), &bitlength_word);\
-		(size) = (64) - _lzcnt_u64(bitlength_word); \
+		(void)addcarry_u64((bb ## 0 >> 63), bitlength_word, (0L), &bitlength_word);\
+		(size) = (64) - lzcnt_u64(bitlength_word); \
 	} while (0)
 		/*
 		 * If r1 = 0, return.
@@ -790,22 +743,22 @@ inverse25519_EEA_vartime(
 				t2_1 = ~t2_1;
 				t2_2 = ~t2_2;
 				t2_3 = ~t2_3;
-				cc = _addcarry_u64(1, t2_0, 0L, &t2_0);
-				cc = _addcarry_u64(cc, t2_1, 0L, &t2_1);
-				cc = _addcarry_u64(cc, t2_2, 0L, &t2_2);
-				(void)_addcarry_u64(cc, t2_3, 0L, &t2_3);
+				cc = addcarry_u64(1, t2_0, 0L, &t2_0);
+				cc = addcarry_u64(cc, t2_1, 0L, &t2_1);
+				cc = addcarry_u64(cc, t2_2, 0L, &t2_2);
+				(void)addcarry_u64(cc, t2_3, 0L, &t2_3);
 			}else if ((r2_0>>63) && ~(t2_3>>63)){
 				/* sign(r2) = -1 & t2 is positive ==> return -t2 % p = p - t2 */
-				cc = _subborrow_u64(0, p[0], t2_0, &t2_0);
-				cc = _subborrow_u64(cc, p[1], t2_1, &t2_1);
-				cc = _subborrow_u64(cc, p[2], t2_2, &t2_2);
-				(void)_subborrow_u64(cc, p[3], t2_3, &t2_3);
+				cc = subborrow_u64(0, p[0], t2_0, &t2_0);
+				cc = subborrow_u64(cc, p[1], t2_1, &t2_1);
+				cc = subborrow_u64(cc, p[2], t2_2, &t2_2);
+				(void)subborrow_u64(cc, p[3], t2_3, &t2_3);
 			}else if (t2_3>>63){
 				/* sign(r2) = 1 & t2 is negative ==> return t2 % p = p + t2 */
-				cc = _addcarry_u64(0, t2_0, p[0], &t2_0);
-				cc = _addcarry_u64(cc, t2_1, p[1], &t2_1);
-				cc = _addcarry_u64(cc, t2_2, p[2], &t2_2);
-				(void)_addcarry_u64(cc, t2_3, p[3], &t2_3);
+				cc = addcarry_u64(0, t2_0, p[0], &t2_0);
+				cc = addcarry_u64(cc, t2_1, p[1], &t2_1);
+				cc = addcarry_u64(cc, t2_2, p[2], &t2_2);
+				(void)addcarry_u64(cc, t2_3, p[3], &t2_3);
 			}
 			// else if (~(out[3]>>63))
 			/* sign(r2) = 1 & t2 is positive ==> return t2 */
@@ -825,52 +778,52 @@ inverse25519_EEA_vartime(
 	unsigned long long r_0 , t_0, t_1, t_2, t_3;
 		if ((r2_0 >> 63) == (r1_0 >> 63)){
 			if (s == 0) {
-				(void)_subborrow_u64(0, r2_0, r1_0, &r_0);
+				(void)subborrow_u64(0, r2_0, r1_0, &r_0);
 				
-				cc = _subborrow_u64(0, t2_0, t1_0, &t_0);
-				cc = _subborrow_u64(cc, t2_1, t1_1, &t_1);
-				cc = _subborrow_u64(cc, t2_2, t1_2, &t_2);
-				(void)_subborrow_u64(cc, t2_3, t1_3, &t_3);
+				cc = subborrow_u64(0, t2_0, t1_0, &t_0);
+				cc = subborrow_u64(cc, t2_1, t1_1, &t_1);
+				cc = subborrow_u64(cc, t2_2, t1_2, &t_2);
+				(void)subborrow_u64(cc, t2_3, t1_3, &t_3);
 
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				(void)_subborrow_u64(0, r2_0,
+				(void)subborrow_u64(0, r2_0,
 					(r1_0 << s), &r_0);
 				
-				cc = _subborrow_u64(0, t2_0,
+				cc = subborrow_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				cc = _subborrow_u64(cc, t2_1,
+				cc = subborrow_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
-				cc = _subborrow_u64(cc, t2_2,
+				cc = subborrow_u64(cc, t2_2,
 					(t1_2 << s) | (t1_1 >> rs), &t_2);
-				(void)_subborrow_u64(cc, t2_3,
+				(void)subborrow_u64(cc, t2_3,
 					(t1_3 << s) | (t1_2 >> rs), &t_3);
 			}
 		} else {
 			if (s == 0) {
-				(void)_addcarry_u64(0, r2_0, r1_0, &r_0);
+				(void)addcarry_u64(0, r2_0, r1_0, &r_0);
 				
-				cc = _addcarry_u64(0, t2_0, t1_0, &t_0);
-				cc = _addcarry_u64(cc, t2_1, t1_1, &t_1);
-				cc = _addcarry_u64(cc, t2_2, t1_2, &t_2);
-				(void)_addcarry_u64(cc, t2_3, t1_3, &t_3);
+				cc = addcarry_u64(0, t2_0, t1_0, &t_0);
+				cc = addcarry_u64(cc, t2_1, t1_1, &t_1);
+				cc = addcarry_u64(cc, t2_2, t1_2, &t_2);
+				(void)addcarry_u64(cc, t2_3, t1_3, &t_3);
 
 			} else {
 				unsigned rs;
 				rs = 64 - s;
 
-				(void)_addcarry_u64(0, r2_0,
+				(void)addcarry_u64(0, r2_0,
 					(r1_0 << s), &r_0);
 				
-				cc = _addcarry_u64(0, t2_0,
+				cc = addcarry_u64(0, t2_0,
 					(t1_0 << s), &t_0);
-				cc = _addcarry_u64(cc, t2_1,
+				cc = addcarry_u64(cc, t2_1,
 					(t1_1 << s) | (t1_0 >> rs), &t_1);
-				cc = _addcarry_u64(cc, t2_2,
+				cc = addcarry_u64(cc, t2_2,
 					(t1_2 << s) | (t1_1 >> rs), &t_2);
-				(void)_addcarry_u64(cc, t2_3,
+				(void)addcarry_u64(cc, t2_3,
 					(t1_3 << s) | (t1_2 >> rs), &t_3);
 			}
 		}
@@ -901,4 +854,93 @@ inverse25519_EEA_vartime(
 		
 	}
 
-}
\ No newline at end of file
+}
+
+/*
+ * d = a * b mod p, with a, b < 2^256. The result is < 2^256 but is not
+ * necessarily reduced below p.
+ */
+static inline void
+mul25519(uint64_t *d, const uint64_t *a, const uint64_t *b)
+{
+	uint64_t t[8], c;
+	unsigned char cc;
+	int i, j;
+
+	for (i = 0; i < 8; i++)
+		t[i] = 0;
+	for (i = 0; i < 4; i++) {
+		c = 0;
+		for (j = 0; j < 4; j++)
+			t[i + j] = muladd_u64(a[i], b[j], t[i + j], c, &c);
+		t[i + 4] = c;
+	}
+
+	/* 2^256 = 38 mod p */
+	c = 0;
+	for (i = 0; i < 4; i++)
+		d[i] = muladd_u64(t[i + 4], 38, t[i], c, &c);
+	cc = addcarry_u64(0, d[0], c * 38, (unsigned long long *)&d[0]);
+	cc = addcarry_u64(cc, d[1], 0, (unsigned long long *)&d[1]);
+	cc = addcarry_u64(cc, d[2], 0, (unsigned long long *)&d[2]);
+	cc = addcarry_u64(cc, d[3], 0, (unsigned long long *)&d[3]);
+	d[0] += 38 * (uint64_t)cc;
+}
+
+/* reduce a < 2^256 to the range 0..p-1 */
+static inline void
+reduce25519(uint64_t *d)
+{
+	unsigned long long t[4];
+	unsigned char cc;
+
+	cc = addcarry_u64(0, d[0], 19 * (d[3] >> 63), (unsigned long long *)&d[0]);
+	d[3] &= 0x7fffffffffffffff;
+	cc = addcarry_u64(cc, d[1], 0, (unsigned long long *)&d[1]);
+	cc = addcarry_u64(cc, d[2], 0, (unsigned long long *)&d[2]);
+	(void)addcarry_u64(cc, d[3], 0, (unsigned long long *)&d[3]);
+
+	/* d >= p iff d + 19 >= 2^255 */
+	cc = addcarry_u64(0, d[0], 19, &t[0]);
+	cc = addcarry_u64(cc, d[1], 0, &t[1]);
+	cc = addcarry_u64(cc, d[2], 0, &t[2]);
+	(void)addcarry_u64(cc, d[3], 0, &t[3]);
+	if (t[3] >> 63) {
+		d[0] = t[0];
+		d[1] = t[1];
+		d[2] = t[2];
+		d[3] = t[3] & 0x7fffffffffffffff;
+	}
+}
+
+/*
+ * out[i] * in[i] = 1 mod p for the n non-zero inputs in 0..p-1, 4 limbs
+ * each. One inversion and 3(n - 1) multiplications (Montgomery's trick);
+ * the prefix products are kept in out, so out and in must not overlap.
+ */
+void
+inverse25519_batch_vartime(
+	uint64_t *out, const uint64_t *in, size_t n)
+{
+	uint64_t inv[4], t[4];
+	size_t i;
+
+	if (n == 0)
+		return;
+
+	memcpy(out, in, 4 * sizeof(uint64_t));
+	for (i = 1; i < n; i++)
+		mul25519(out + 4 * i, out + 4 * (i - 1), in + 4 * i);
+
+	memcpy(t, out + 4 * (n - 1), sizeof(t));
+	reduce25519(t);
+	inverse25519_EEA_vartime(inv, t);
+
+	for (i = n - 1; i > 0; i--) {
+		mul25519(out + 4 * i, inv, out + 4 * (i - 1));
+		reduce25519(out + 4 * i);
+		mul25519(inv, inv, in + 4 * i);
+	}
+	reduce25519(inv);
+	memcpy(out, inv, sizeof(inv));
+}
@@ -2,4 +2,7 @@
 #include <string.h>
 
 void inverse25519_EEA_vartime(
-	uint64_t *, const uint64_t *);
\ No newline at end of file
+	uint64_t *, const uint64_t *);
+
+void inverse25519_batch_vartime(
+	uint64_t *, const uint64_t *, size_t);
\ No newline at end of file
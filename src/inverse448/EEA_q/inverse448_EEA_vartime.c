@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2024 xxxxxxxxxx (xxxxx@xxxxx). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following disclaimer
+ *    in the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Google Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Inspired by https://github.com/pornin/curve9767/blob/master/src/scalar_amd64.c
+*/
+
+#include "inverse448_EEA_vartime.h"
+
+/*
+ * We use the intrinsic functions (see portable_intrinsics.h):
+ *   lzcnt_u64(), addcarry_u64(), subborrow_u64(), muladd_u64().
+ */
+#include "../../portable_intrinsics.h"
+
+
+/*
+ * p = 2**448 - 2**224 - 1
+ *   = 0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffeffffffffffffffffffffffffffffffffffffffffffffffffffffffff
+ */
+static const uint64_t p448[] = {
+	0xffffffffffffffff,
+	0xffffffffffffffff,
+	0xffffffffffffffff,
+	0xfffffffeffffffff,
+	0xffffffffffffffff,
+	0xffffffffffffffff,
+	0xffffffffffffffff
+};
+
+
+DEF_OP_LSHIFT(add_lshift_8, addcarry_u64, 8)
+DEF_OP_LSHIFT(sub_lshift_8, subborrow_u64, 8)
+DEF_OP_LSHIFT(add_lshift_7, addcarry_u64, 7)
+DEF_OP_LSHIFT(sub_lshift_7, subborrow_u64, 7)
+DEF_OP_LSHIFT(add_lshift_6, addcarry_u64, 6)
+DEF_OP_LSHIFT(sub_lshift_6, subborrow_u64, 6)
+DEF_OP_LSHIFT(add_lshift_5, addcarry_u64, 5)
+DEF_OP_LSHIFT(sub_lshift_5, subborrow_u64, 5)
+DEF_OP_LSHIFT(add_lshift_4, addcarry_u64, 4)
+DEF_OP_LSHIFT(sub_lshift_4, subborrow_u64, 4)
+DEF_OP_LSHIFT(add_lshift_3, addcarry_u64, 3)
+DEF_OP_LSHIFT(sub_lshift_3, subborrow_u64, 3)
+DEF_OP_LSHIFT(add_lshift_2, addcarry_u64, 2)
+DEF_OP_LSHIFT(sub_lshift_2, subborrow_u64, 2)
+DEF_OP_LSHIFT(add_lshift_1, addcarry_u64, 1)
+DEF_OP_LSHIFT(sub_lshift_1, subborrow_u64, 1)
+
+
+/*
+ * Bit length of a signed value of 'size' limbs, as in the Curve25519 code:
+ * for a negative r it is the bit length of the one's complement of r, which
+ * is the bit length of abs(r) except for r = -2**n.
+ */
+#define DEF_BITLENGTH(name, size) \
+static inline unsigned \
+name(const uint64_t *a) \
+{ \
+	unsigned long long mask = -(a[(size) - 1] >> 63); \
+	unsigned long long w; \
+	int i; \
+ \
+	for (i = (size) - 1; i >= 0; i --) { \
+		w = a[i] ^ mask; \
+		if (w) { \
+			return 64 * i + 64 - (unsigned)lzcnt_u64(w); \
+		} \
+	} \
+	return 0; \
+}
+
+DEF_BITLENGTH(bitlength_8, 8)
+DEF_BITLENGTH(bitlength_7, 7)
+DEF_BITLENGTH(bitlength_6, 6)
+DEF_BITLENGTH(bitlength_5, 5)
+DEF_BITLENGTH(bitlength_4, 4)
+DEF_BITLENGTH(bitlength_3, 3)
+DEF_BITLENGTH(bitlength_2, 2)
+DEF_BITLENGTH(bitlength_1, 1)
+
+
+/* end of a stage: r2 fits in size - 1 limbs, or, for the last stage, r1 = 0 */
+#define EEA_STAGE_FITS(size, bl_r2, r1) ((bl_r2) < 64 * ((size) - 1))
+#define EEA_STAGE_LAST(size, bl_r2, r1) ((r1)[0] == 0)
+
+/*
+ * This macro defines the stage of the algorithm where r2 and r1 fit in
+ * 'size' signed limbs, i.e. bl(r2) < 64 * size. It runs until done, which
+ * is EEA_STAGE_FITS, then the next stage goes on with the low limbs.
+ * The last stage (size = 1) takes EEA_STAGE_LAST, since bl(r2) >= 0 always
+ * holds there. The cofactors t2 and t1 always use 8 limbs, since abs(t)
+ * may exceed p (449 bits).
+ * The state lives in three r and three t buffers, rotated through
+ * pointers; r and t are scratch.
+ */
+#define DEF_EEA_STAGE(name, size, add_lshift, sub_lshift, bitlength, done) \
+static inline void \
+name(uint64_t **r2, uint64_t **r1, uint64_t **r, \
+	uint64_t **t2, uint64_t **t1, uint64_t **t, \
+	unsigned *pbl_r2, unsigned *pbl_r1) \
+{ \
+	uint64_t *tmp; \
+	unsigned bl_r2 = *pbl_r2, bl_r1 = *pbl_r1, bl_r, s; \
+ \
+	while (!done(size, bl_r2, *r1)) { \
+		s = bl_r2 - bl_r1; \
+		memcpy(*r, *r2, (size) * sizeof (*r)[0]); \
+		memcpy(*t, *t2, 8 * sizeof (*t)[0]); \
+		if (((*r2)[(size) - 1] >> 63) == ((*r1)[(size) - 1] >> 63)) { \
+			sub_lshift(*r, *r1, s); \
+			sub_lshift_8(*t, *t1, s); \
+		} else { \
+			add_lshift(*r, *r1, s); \
+			add_lshift_8(*t, *t1, s); \
+		} \
+ \
+		bl_r = bitlength(*r); \
+		if (bl_r > bl_r1) { \
+			tmp = *r2; *r2 = *r; *r = tmp; \
+			tmp = *t2; *t2 = *t; *t = tmp; \
+			bl_r2 = bl_r; \
+		} else { \
+			tmp = *r2; *r2 = *r1; *r1 = *r; *r = tmp; \
+			tmp = *t2; *t2 = *t1; *t1 = *t; *t = tmp; \
+			bl_r2 = bl_r1; \
+			bl_r1 = bl_r; \
+		} \
+	} \
+ \
+	*pbl_r2 = bl_r2; \
+	*pbl_r1 = bl_r1; \
+}
+
+DEF_EEA_STAGE(eea_stage_8, 8, add_lshift_8, sub_lshift_8, bitlength_8, EEA_STAGE_FITS)
+DEF_EEA_STAGE(eea_stage_7, 7, add_lshift_7, sub_lshift_7, bitlength_7, EEA_STAGE_FITS)
+DEF_EEA_STAGE(eea_stage_6, 6, add_lshift_6, sub_lshift_6, bitlength_6, EEA_STAGE_FITS)
+DEF_EEA_STAGE(eea_stage_5, 5, add_lshift_5, sub_lshift_5, bitlength_5, EEA_STAGE_FITS)
+DEF_EEA_STAGE(eea_stage_4, 4, add_lshift_4, sub_lshift_4, bitlength_4, EEA_STAGE_FITS)
+DEF_EEA_STAGE(eea_stage_3, 3, add_lshift_3, sub_lshift_3, bitlength_3, EEA_STAGE_FITS)
+DEF_EEA_STAGE(eea_stage_2, 2, add_lshift_2, sub_lshift_2, bitlength_2, EEA_STAGE_FITS)
+DEF_EEA_STAGE(eea_stage_1, 1, add_lshift_1, sub_lshift_1, bitlength_1, EEA_STAGE_LAST)
+
+
+/* a <- a - p while a >= p, for 0 <= a < 2^512 (8 limbs) */
+static inline void
+sub_p448(uint64_t *a)
+{
+	unsigned long long d[8];
+	unsigned char cc;
+	int i;
+
+	for (;;) {
+		cc = 0;
+		for (i = 0; i < 8; i ++) {
+			cc = subborrow_u64(cc, a[i], i < 7 ? p448[i] : 0, &d[i]);
+		}
+		if (cc) {
+			return;
+		}
+		memcpy(a, d, sizeof d);
+	}
+}
+
+/* a <- a + p while a < 0, for a signed value of 8 limbs */
+static inline void
+add_p448(uint64_t *a)
+{
+	unsigned char cc;
+	int i;
+
+	while (a[7] >> 63) {
+		cc = 0;
+		for (i = 0; i < 8; i ++) {
+			cc = addcarry_u64(cc, a[i], i < 7 ? p448[i] : 0,
+				(unsigned long long *)&a[i]);
+		}
+	}
+}
+
+/* return out s.t out * x = 1 mod p, for 0 < x < p */
+void
+inverse448_EEA_vartime(
+	uint64_t *out, const uint64_t *x)
+{
+	uint64_t rb[3][8], tb[3][8];
+	uint64_t *r2 = rb[0], *r1 = rb[1], *r = rb[2];
+	uint64_t *t2 = tb[0], *t1 = tb[1], *t = tb[2];
+	unsigned bl_r2, bl_r1;
+	unsigned char cc;
+	int i;
+
+	/*
+	 * Algorithm:
+	 * r2 = p, r1 = x, t2 = 0, t1 = 1
+	 * while r1 != 0
+	 * 	s = len(r2) - len(r1)
+	 * 	if (sign(r2) = sign(r1))
+	 *		r = r2 - (r1 << s)
+	 *		t = t2 - (t1 << s)
+	 * 	else
+	 * 		r = r2 + (r1 << s)
+	 *		t = t2 + (t1 << s)
+	 * 	if len(r) > len(r1)
+	 * 		r2 = r, t2 = t
+	 * 	else
+	 * 		r2 = r1, r1 = r, t2 = t1, t1 = t
+	 * return sign(r2) * t2 mod p
+	 *
+	 * p needs 448 bits, so the first stage uses 8 signed limbs; each
+	 * stage drops one limb of r2 and r1, down to a single limb.
+	 */
+	memcpy(r2, p448, 7 * sizeof r2[0]);
+	r2[7] = 0;
+	memcpy(r1, x, 7 * sizeof r1[0]);
+	r1[7] = 0;
+	memset(t2, 0, 8 * sizeof t2[0]);
+	memset(t1, 0, 8 * sizeof t1[0]);
+	t1[0] = 1;
+
+	bl_r2 = 448;
+	bl_r1 = bitlength_8(r1);
+
+	eea_stage_8(&r2, &r1, &r, &t2, &t1, &t, &bl_r2, &bl_r1);
+	eea_stage_7(&r2, &r1, &r, &t2, &t1, &t, &bl_r2, &bl_r1);
+	eea_stage_6(&r2, &r1, &r, &t2, &t1, &t, &bl_r2, &bl_r1);
+	eea_stage_5(&r2, &r1, &r, &t2, &t1, &t, &bl_r2, &bl_r1);
+	eea_stage_4(&r2, &r1, &r, &t2, &t1, &t, &bl_r2, &bl_r1);
+	eea_stage_3(&r2, &r1, &r, &t2, &t1, &t, &bl_r2, &bl_r1);
+	eea_stage_2(&r2, &r1, &r, &t2, &t1, &t, &bl_r2, &bl_r1);
+	eea_stage_1(&r2, &r1, &r, &t2, &t1, &t, &bl_r2, &bl_r1);
+
+	/* r2 = sign(r2) * gcd = -1 or 1 ==> return sign(r2) * t2 */
+	if (r2[0] >> 63) {
+		cc = 0;
+		for (i = 0; i < 8; i ++) {
+			cc = subborrow_u64(cc, 0, t2[i], (unsigned long long *)&t2[i]);
+		}
+	}
+
+	/*
+	 * Unlike the exact EEA, abs(t2) can exceed p here (r1 is subtracted
+	 * with a shift that may overshoot by one bit), so we reduce in loops.
+	 */
+	add_p448(t2);
+	sub_p448(t2);
+	memcpy(out, t2, 7 * sizeof out[0]);
+}
+
+
+/*
+ * Multiplication modulo p, for the Fermat baseline. The inputs are below
+ * 2^448, and so is the output, which is not necessarily below p.
+ * With 2^448 = 2^224 + 1 mod p, the high half h of a 896-bit product
+ * folds as h + h * 2^224.
+ */
+static void
+mul448(uint64_t *d, const uint64_t *a, const uint64_t *b)
+{
+	uint64_t t[14], h[7], c;
+	int i, j, k;
+
+	memset(t, 0, sizeof t);
+	for (i = 0; i < 7; i ++) {
+		c = 0;
+		for (j = 0; j < 7; j ++)
+			t[i + j] = muladd_u64(a[i], b[j], t[i + j], c, &c);
+		t[i + 7] = c;
+	}
+
+	/* fold the high half twice: 896 -> ~673 -> ~449 bits */
+	for (k = 0; k < 2; k ++) {
+		uint64_t s[11];
+
+		memcpy(h, t + 7, sizeof h);
+		memset(t + 7, 0, 7 * sizeof t[0]);
+
+		/* s = h << 224 */
+		s[0] = s[1] = s[2] = 0;
+		s[3] = h[0] << 32;
+		for (i = 1; i < 7; i ++) {
+			s[3 + i] = (h[i] << 32) | (h[i - 1] >> 32);
+		}
+		s[10] = h[6] >> 32;
+
+		c = 0;
+		for (i = 0; i < 11; i ++) {
+			unsigned char cc;
+
+			t[i] = muladd_u64(i < 7 ? h[i] : 0, 1, t[i], c, &c);
+			cc = addcarry_u64(0, t[i], s[i], (unsigned long long *)&t[i]);
+			c += cc;
+		}
+	}
+
+	/* what is left above 2^448 is at most a few bits */
+	c = t[7];
+	memcpy(d, t, 7 * sizeof d[0]);
+	while (c) {
+		unsigned char cc;
+
+		cc = addcarry_u64(0, d[0], c, (unsigned long long *)&d[0]);
+		for (i = 1; i < 7; i ++) {
+			cc = addcarry_u64(cc, d[i], (i == 3) ? (c << 32) : 0,
+				(unsigned long long *)&d[i]);
+		}
+		c = cc;
+	}
+}
+
+/* d = a^(2^n) */
+static void
+sqr448_n(uint64_t *d, const uint64_t *a, int n)
+{
+	memcpy(d, a, 7 * sizeof d[0]);
+	while (n -- > 0) {
+		mul448(d, d, d);
+	}
+}
+
+/*
+ * For comparisons only: out = x^(p - 2) with Fermat's little theorem.
+ * p - 2 = 2^448 - 2^224 - 3, i.e. 223 ones, a zero, 222 ones, then 01, so
+ * x^(p-2) = ((x^(2^223 - 1))^(2^223) * x^(2^222 - 1))^4 * x, with an
+ * addition chain on the exponents 2^k - 1.
+ */
+void
+inverse448_FLT(
+	uint64_t *out, const uint64_t *x)
+{
+	uint64_t e1[8], e2[8], e3[8], e6[8], e12[8], e24[8], e30[8];
+	uint64_t e48[8], e96[8], e192[8], e222[8], e223[8], t[8];
+
+	memcpy(e1, x, 7 * sizeof e1[0]);
+	sqr448_n(t, e1, 1);   mul448(e2, t, e1);
+	sqr448_n(t, e2, 1);   mul448(e3, t, e1);
+	sqr448_n(t, e3, 3);   mul448(e6, t, e3);
+	sqr448_n(t, e6, 6);   mul448(e12, t, e6);
+	sqr448_n(t, e12, 12); mul448(e24, t, e12);
+	sqr448_n(t, e24, 6);  mul448(e30, t, e6);
+	sqr448_n(t, e24, 24); mul448(e48, t, e24);
+	sqr448_n(t, e48, 48); mul448(e96, t, e48);
+	sqr448_n(t, e96, 96); mul448(e192, t, e96);
+	sqr448_n(t, e192, 30); mul448(e222, t, e30);
+	sqr448_n(t, e222, 1); mul448(e223, t, e1);
+	sqr448_n(t, e223, 223); mul448(t, t, e222);
+	sqr448_n(t, t, 2);    mul448(t, t, e1);
+
+	t[7] = 0;
+	sub_p448(t);
+	memcpy(out, t, 7 * sizeof out[0]);
+}
@@ -0,0 +1,8 @@
+#include <stdint.h>
+#include <string.h>
+
+void inverse448_EEA_vartime(
+	uint64_t *, const uint64_t *);
+
+void inverse448_FLT(
+	uint64_t *, const uint64_t *);
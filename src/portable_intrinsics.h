@@ -0,0 +1,160 @@
+#ifndef PORTABLE_INTRINSICS_H
+#define PORTABLE_INTRINSICS_H
+
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * The half-size reducers and the EEA_q inversions use three x86 intrinsics:
+ *   _lzcnt_u64(), _addcarry_u64(), _subborrow_u64().
+ * They are called through lzcnt_u64(), addcarry_u64() and subborrow_u64(),
+ * which map to the intrinsics on x86-64 and to __builtin_clzll() and
+ * __builtin_add_overflow()/__builtin_sub_overflow() everywhere else; the
+ * compilers usually turn the overflow chains back into add-with-carry.
+ * Compile with -DPORTABLE_INTRINSICS to use the portable versions on
+ * x86-64 as well.
+ *
+ * _lzcnt_u64() needs -mlzcnt; without it (or with PORTABLE_INTRINSICS)
+ * lzcnt_u64() is __builtin_clzll(), which already compiles to a single
+ * lzcnt/clz on targets that have one.
+ *
+ * Callers pass uint64_t limbs cast to unsigned long long *, as the
+ * intrinsics require; the portable versions store through memcpy() so
+ * that this stays well-defined under strict aliasing.
+ *
+ * The 64 x 64 -> 128 products go through muladd_u64(), which is a plain
+ * unsigned __int128 expression where the compiler has the type (all 64-bit
+ * targets) and is built from 32 x 32 -> 64 products on 32-bit targets.
+ */
+#if defined(__x86_64__) && !defined(PORTABLE_INTRINSICS)
+#include <immintrin.h>
+#endif
+
+#if defined(__x86_64__) && defined(__LZCNT__) && !defined(PORTABLE_INTRINSICS)
+
+#define lzcnt_u64 _lzcnt_u64
+
+#else
+
+static inline unsigned long long
+lzcnt_u64(unsigned long long x)
+{
+	return x ? (unsigned long long)__builtin_clzll(x) : 64;
+}
+
+#endif
+
+#if defined(__x86_64__) && !defined(PORTABLE_INTRINSICS)
+
+#define addcarry_u64 _addcarry_u64
+#define subborrow_u64 _subborrow_u64
+
+#else
+
+static inline unsigned char
+addcarry_u64(unsigned char c, unsigned long long a, unsigned long long b,
+	unsigned long long *d)
+{
+	unsigned long long w;
+	unsigned char c1, c2;
+
+	c1 = __builtin_add_overflow(a, b, &w);
+	c2 = __builtin_add_overflow(w, (unsigned long long)c, &w);
+	memcpy(d, &w, sizeof w);
+	return c1 | c2;
+}
+
+static inline unsigned char
+subborrow_u64(unsigned char c, unsigned long long a, unsigned long long b,
+	unsigned long long *d)
+{
+	unsigned long long w;
+	unsigned char c1, c2;
+
+	c1 = __builtin_sub_overflow(a, b, &w);
+	c2 = __builtin_sub_overflow(w, (unsigned long long)c, &w);
+	memcpy(d, &w, sizeof w);
+	return c1 | c2;
+}
+
+#endif
+
+/* a * b + c + d, which always fits in 128 bits: returns the low word, *hi gets the high one */
+static inline uint64_t
+muladd_u64(uint64_t a, uint64_t b, uint64_t c, uint64_t d, uint64_t *hi)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 z;
+
+	z = (unsigned __int128)a * b + c + d;
+	*hi = (uint64_t)(z >> 64);
+	return (uint64_t)z;
+#else
+	uint64_t a0 = (uint32_t)a, a1 = a >> 32, b0 = (uint32_t)b, b1 = b >> 32;
+	uint64_t p00, p01, p10, p11, mid, lo;
+
+	p00 = a0 * b0;
+	p01 = a0 * b1;
+	p10 = a1 * b0;
+	p11 = a1 * b1;
+	mid = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+	p11 += (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+	lo = (mid << 32) | (uint32_t)p00;
+	lo += c;
+	p11 += (lo < c);
+	lo += d;
+	p11 += (lo < d);
+	*hi = p11;
+	return lo;
+#endif
+}
+
+/*
+ * The multi-limb shift-and-add of the EEA_q loops, shared by the reducers
+ * and the inversions. This macro defines a function with prototype:
+ *  static void name(uint64_t *a, const uint64_t *b, unsigned s)
+ * It adds lshift(b,s) to a (if intrinsic_op is addcarry_u64), or
+ * subtracts lshift(b,s) from a (if intrinsic_op is subborrow_u64).
+ * Both values consist of 'size' limbs. Truncation happens if the result
+ * does not fit in the output.
+ */
+#define DEF_OP_LSHIFT(name, intrinsic_op, size) \
+static void \
+name(uint64_t *a, const uint64_t *b, unsigned s) \
+{ \
+	uint64_t b2[(size)]; \
+	unsigned char cc; \
+	unsigned long long w, w2, e; \
+	size_t i; \
+ \
+ 	if (s >= 64) { \
+		unsigned k; \
+ \
+		k = s >> 6; \
+		s &= 63; \
+		if (k >= (size)) { \
+			return; \
+		} \
+		memset(b2, 0, k * sizeof b2[0]); \
+		memcpy(b2 + k, b, ((size) - k) * sizeof b2[0]); \
+		b = b2; \
+	} \
+	if (s == 0) { \
+		cc = 0; \
+		for (i = 0; i < (size); i ++) { \
+			cc = intrinsic_op(cc, a[i], b[i], &w); \
+			a[i] = w; \
+		} \
+	} else { \
+		cc = 0; \
+		e = 0; \
+		for (i = 0; i < (size); i ++) { \
+			w = b[i]; \
+			cc = intrinsic_op(cc, a[i], (w << s) | e, &w2); \
+			e = w >> (64 - s); \
+			a[i] = w2; \
+		} \
+	} \
+}
+
+#endif
@@ -0,0 +1,748 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <math.h>
+#include <time.h>
+#include <gmp.h>
+#include <openssl/sha.h>
+#include "test-bench.h"
+#include "../src/half_size/curve25519/curve25519_hEEA_vartime.h"
+#include "../src/half_size/curve25519/curve25519_hEEA32_vartime.h"
+#include "../src/half_size/curve25519/curve25519_hEEA_lehmer_vartime.h"
+#include "../src/half_size/curve25519/curve25519_hEEA_div_vartime.h"
+#include "../src/half_size/curve25519/curve25519_hgcd_vartime.h"
+#include "../src/half_size/curve25519/curve25519_reduce_basis_vartime.h"
+#include "../src/half_size/curve448/curve448_hEEA_vartime.h"
+#include "../src/half_size/curve448/curve448_hEEA_div_vartime.h"
+#include "../src/half_size/curve448/curve448_hgcd_vartime.h"
+#include "../src/half_size/curve448/curve448_reduce_basis_vartime.h"
+#include "../src/inverse25519/EEA_q/inverse25519_EEA_vartime.h"
+#include "../src/inverse25519/inverse25519skylake-20210110/inverse25519.h"
+#include "../src/inverse25519/bingcd/src/gf25519.h"
+#include "../src/inverse448/EEA_q/inverse448_EEA_vartime.h"
+#include "../src/ed25519-donna/ed25519.h"
+
+/*
+ * One driver for the half-size reducers, the inverses and the single and
+ * batch verifiers. Every variant registers in bench_variants below with the
+ * kind of input it needs; the driver prepares the inputs, runs the selected
+ * variants with the same warmup, sampling and statistics, checks their
+ * results after timing, and prints a table or JSON:
+ *
+ *	./bench [--list] [--json] [--filter s] [--curve c] [--kind k]
+ *		[--samples n] [--rounds n] [--warmup n] [--batch n,n,...]
+ *
+ * --filter keeps the variants whose name contains s, --curve and --kind
+ * those of a curve (ed25519, ed448) and kind (reducer, inverse, single,
+ * batch, batch_inverse). A sample is the time of --rounds calls on one
+ * input, divided by the rounds and, for the batch kinds, by the batch size.
+ * The donna variants are the unmodified verifier; donna_vartime_pack is
+ * donna with the variable-time inversion in the final pack, the fallback of
+ * ed25519_sign_open_batch. halfagg verifies one aggregate per batch size,
+ * made by its first call (in the warmup), and joint2/joint3 verify a batch
+ * two or three signatures at a time, the rest singly. With
+ * BENCH_PERF set (test-perf.h), the hardware counters of every variant are
+ * printed after the table, or added to its JSON entry.
+ */
+
+#define default_samples 1000
+#define default_rounds 10
+#define default_warmup 100
+#define max_batch_sizes 16
+#define signature_pool 4096
+#define message_size 64
+
+typedef enum bench_kind_t {
+	BENCH_REDUCER,
+	BENCH_INVERSE,
+	BENCH_SINGLE,
+	BENCH_BATCH,
+	BENCH_BATCH_INVERSE,
+	BENCH_KINDS
+} bench_kind;
+
+static const char *bench_kind_names[BENCH_KINDS] = {"reducer", "inverse", "single", "batch", "batch_inverse"};
+
+typedef enum bench_curve_t {
+	BENCH_ED25519,
+	BENCH_ED448
+} bench_curve;
+
+static const char *bench_curve_names[] = {"ed25519", "ed448"};
+
+/* the inputs of every variant and the output of the last call */
+typedef struct bench_data_t {
+	size_t count;
+	mpz_t modulus, value, product;
+
+	/* reducers and inverses: count random values below the modulus, as 64-bit words */
+	uint64_t (*x)[7];
+	uint64_t c0[7], c1[7];
+	int c0_size, c1_size;
+	unsigned char bytes[32];
+	gf g;
+
+	/* batch inverses: signature_pool of the values, 4 words each, and their inverses */
+	uint64_t *xs, *ys;
+
+	/* verifiers: signature_pool signatures on message_size-byte messages */
+	ed25519_public_key *pk;
+	ed25519_signature *sig;
+	unsigned char (*msg)[message_size];
+	const unsigned char **pm, **ppk, **pRS;
+	size_t *mlen;
+	int *valid, ret;
+
+	/* their H(R,A,M), and the half-aggregate of the first agg_batch of them */
+	unsigned char (*hram)[64];
+	const unsigned char **phram;
+	unsigned char *agg;
+	size_t agg_batch;
+} bench_data;
+
+typedef struct bench_variant_t {
+	const char *name;
+	bench_curve curve;
+	bench_kind kind;
+	void (*run)(bench_data *d, size_t i, size_t batch);
+	int (*check)(bench_data *d, size_t i, size_t batch); /* 1 if the last call on input i was right */
+} bench_variant;
+
+typedef struct bench_options_t {
+	size_t samples, rounds, warmup;
+	size_t batch[max_batch_sizes], batches;
+	const char *filter;
+	int curve, kind; /* -1 for all */
+	int json, list;
+} bench_options;
+
+typedef struct bench_result_t {
+	uint64_t min, median, median_lo, median_hi;
+	double mean, mean_lo, mean_hi, stddev;
+} bench_result;
+
+/* signed little-endian words to mpz */
+static void words_2_mpz(mpz_t out, const uint64_t *in, size_t l)
+{
+	uint64_t w[7];
+	size_t i;
+	int isneg = (int)(in[l - 1] >> 63), carry = 1;
+
+	for (i = 0; i < l; i++) {
+		w[i] = isneg ? ~in[i] + (uint64_t)carry : in[i];
+		carry &= isneg && w[i] == 0;
+	}
+	mpz_import(out, l, -1, sizeof(uint64_t), 0, 0, w);
+	if (isneg)
+		mpz_neg(out, out);
+}
+
+/* reducers */
+
+/* c0 = c1 * b mod modulus, c0 and c1 of c0_size and c1_size signed words */
+static int check_reduction(bench_data *d, size_t i, size_t words)
+{
+	mpz_t c0;
+
+	mpz_init(c0);
+	words_2_mpz(c0, d->c0, (size_t)d->c0_size);
+	words_2_mpz(d->product, d->c1, (size_t)d->c1_size);
+	mpz_import(d->value, words, -1, sizeof(uint64_t), 0, 0, d->x[i]);
+	mpz_mul(d->product, d->product, d->value);
+	mpz_sub(d->product, d->product, c0);
+	mpz_clear(c0);
+	return mpz_divisible_p(d->product, d->modulus);
+}
+
+static int check_reduction25519(bench_data *d, size_t i, size_t batch) { (void)batch; return check_reduction(d, i, 4); }
+static int check_reduction448(bench_data *d, size_t i, size_t batch) { (void)batch; return check_reduction(d, i, 7); }
+
+#define REDUCER(fn, size) \
+	static void run_##fn(bench_data *d, size_t i, size_t batch) { \
+		(void)batch; fn(d->c0, d->c1, d->x[i]); d->c0_size = d->c1_size = size; \
+	}
+#define REDUCER_SIZED(fn) \
+	static void run_##fn(bench_data *d, size_t i, size_t batch) { \
+		(void)batch; fn(d->c0, d->c1, d->x[i], &d->c0_size, &d->c1_size); \
+	}
+
+REDUCER(curve25519_hEEA_vartime, 2)
+REDUCER(curve25519_hEEA_lehmer_vartime, 2)
+REDUCER(curve25519_hEEA_div_vartime, 2)
+REDUCER(curve25519_reduce_basis_vartime, 2)
+REDUCER_SIZED(curve25519_hgcd_vartime)
+
+/* the 32-bit word hEEA_q of the 32-bit builds, on the same 64-bit words */
+static void run_curve25519_hEEA32_vartime(bench_data *d, size_t i, size_t batch) {
+	uint32_t v[8], c0[4], c1[4];
+	size_t k;
+
+	(void)batch;
+	for (k = 0; k < 4; k++) {
+		v[2 * k] = (uint32_t)d->x[i][k];
+		v[2 * k + 1] = (uint32_t)(d->x[i][k] >> 32);
+	}
+	curve25519_hEEA32_vartime(c0, c1, v);
+	for (k = 0; k < 2; k++) {
+		d->c0[k] = c0[2 * k] | ((uint64_t)c0[2 * k + 1] << 32);
+		d->c1[k] = c1[2 * k] | ((uint64_t)c1[2 * k + 1] << 32);
+	}
+	d->c0_size = d->c1_size = 2;
+}
+
+/* the balanced split of the single verifier; a target miss still returns c1 * b = c0 */
+static void run_curve25519_hEEA_target_vartime(bench_data *d, size_t i, size_t batch) {
+	(void)batch;
+	d->ret = curve25519_hEEA_target_vartime(d->c0, d->c1, d->x[i], 127, 126);
+	d->c0_size = d->c1_size = 3;
+}
+
+REDUCER_SIZED(curve25519_hgcd_vartime_enhance1)
+REDUCER_SIZED(curve25519_hgcd_vartime_enhance2)
+REDUCER(curve448_hEEA_vartime, 4)
+REDUCER(curve448_hEEA_div_vartime, 4)
+REDUCER(curve448_reduce_basis_vartime, 4)
+
+static void run_curve448_hgcd_vartime(bench_data *d, size_t i, size_t batch) {
+	(void)batch;
+	curve448_hgcd_vartime(d->c0, d->c1, d->x[i], &d->c0_size, &d->c1_size);
+	d->c0_size = d->c1_size = 4;
+}
+
+/* inverses */
+
+/* y * x = 1 mod modulus, y of words words */
+static int check_inverse(bench_data *d, size_t i, const uint64_t *y, size_t words)
+{
+	mpz_import(d->product, words, -1, sizeof(uint64_t), 0, 0, y);
+	mpz_import(d->value, words, -1, sizeof(uint64_t), 0, 0, d->x[i]);
+	mpz_mul(d->product, d->product, d->value);
+	mpz_mod(d->product, d->product, d->modulus);
+	return !mpz_cmp_ui(d->product, 1);
+}
+
+static void run_inverse25519_EEA_vartime(bench_data *d, size_t i, size_t batch) { (void)batch; inverse25519_EEA_vartime(d->c0, d->x[i]); }
+static int check_inverse25519_EEA_vartime(bench_data *d, size_t i, size_t batch) { (void)batch; return check_inverse(d, i, d->c0, 4); }
+
+static void run_inverse25519_skylake(bench_data *d, size_t i, size_t batch) {
+	(void)batch;
+	inverse25519_skylake(d->bytes, (const unsigned char *)d->x[i]);
+}
+static int check_inverse25519_skylake(bench_data *d, size_t i, size_t batch) {
+	(void)batch;
+	mpz_import(d->product, 32, -1, 1, 0, 0, d->bytes);
+	mpz_mod(d->product, d->product, d->modulus);
+	memset(d->c1, 0, sizeof(d->c1));
+	mpz_export(d->c1, NULL, -1, sizeof(uint64_t), 0, 0, d->product);
+	return check_inverse(d, i, d->c1, 4);
+}
+
+static void run_gf_inv(bench_data *d, size_t i, size_t batch) {
+	gf x;
+
+	(void)batch;
+	x.v0 = d->x[i][0]; x.v1 = d->x[i][1]; x.v2 = d->x[i][2]; x.v3 = d->x[i][3];
+	gf_inv(&d->g, &x);
+}
+static int check_gf_inv(bench_data *d, size_t i, size_t batch) {
+	(void)batch;
+	gf_encode(d->bytes, &d->g);
+	memset(d->c1, 0, sizeof(d->c1));
+	mpz_import(d->product, 32, -1, 1, 0, 0, d->bytes);
+	mpz_export(d->c1, NULL, -1, sizeof(uint64_t), 0, 0, d->product);
+	return check_inverse(d, i, d->c1, 4);
+}
+
+static void run_inverse448_EEA_vartime(bench_data *d, size_t i, size_t batch) { (void)batch; inverse448_EEA_vartime(d->c0, d->x[i]); }
+static void run_inverse448_FLT(bench_data *d, size_t i, size_t batch) { (void)batch; inverse448_FLT(d->c0, d->x[i]); }
+static int check_inverse448(bench_data *d, size_t i, size_t batch) { (void)batch; return check_inverse(d, i, d->c0, 7); }
+
+/* batch inverses, on the values from i * batch on, wrapping around the pool */
+
+static size_t pool_offset(size_t i, size_t batch)
+{
+	return (i * batch) % (signature_pool - batch + 1);
+}
+
+static void run_inverse25519_batch_vartime(bench_data *d, size_t i, size_t batch) {
+	inverse25519_batch_vartime(d->ys, d->xs + 4 * pool_offset(i, batch), batch);
+}
+static int check_inverse25519_batch_vartime(bench_data *d, size_t i, size_t batch) {
+	const uint64_t *x = d->xs + 4 * pool_offset(i, batch);
+	size_t j;
+
+	for (j = 0; j < batch; j++) {
+		mpz_import(d->product, 4, -1, sizeof(uint64_t), 0, 0, d->ys + 4 * j);
+		mpz_import(d->value, 4, -1, sizeof(uint64_t), 0, 0, x + 4 * j);
+		mpz_mul(d->product, d->product, d->value);
+		mpz_mod(d->product, d->product, d->modulus);
+		if (mpz_cmp_ui(d->product, 1))
+			return 0;
+	}
+	return 1;
+}
+
+/* verifiers, on the signatures from i * batch on, wrapping around the pool */
+
+#define SINGLE(fn) \
+	static void run_##fn(bench_data *d, size_t i, size_t batch) { \
+		size_t j = pool_offset(i, 1); (void)batch; d->ret = fn(d->pm[j], d->mlen[j], d->ppk[j], d->pRS[j]); \
+	}
+#define BATCH(fn) \
+	static void run_##fn(bench_data *d, size_t i, size_t batch) { \
+		size_t j = pool_offset(i, batch); d->ret = fn(d->pm + j, d->mlen + j, d->ppk + j, d->pRS + j, batch, d->valid); \
+	}
+
+#define JOINT(fn, n) \
+	static void run_##fn(bench_data *d, size_t i, size_t batch) { \
+		size_t j = pool_offset(i, batch), k = 0; \
+		d->ret = 0; \
+		for (; k + n <= batch; k += n) \
+			d->ret |= fn(d->pm + j + k, d->mlen + j + k, d->ppk + j + k, d->pRS + j + k, d->valid + k); \
+		for (; k < batch; k++) \
+			d->ret |= (d->valid[k] = !ed25519_sign_open_hEEA(d->pm[j + k], d->mlen[j + k], d->ppk[j + k], d->pRS[j + k])) ^ 1; \
+	}
+
+SINGLE(ed25519_sign_open_donna)
+SINGLE(ed25519_sign_open)
+SINGLE(ed25519_sign_open_hEEA)
+SINGLE(ed25519_sign_open_hgcd)
+BATCH(ed25519_sign_open_batch)
+BATCH(ed25519_sign_open_batch_hEEA)
+BATCH(ed25519_sign_open_batch_hgcd)
+BATCH(ed25519_sign_open_batch_auto)
+JOINT(ed25519_sign_open_joint2_hEEA, 2)
+JOINT(ed25519_sign_open_joint3_hEEA, 3)
+
+static void run_ed25519_sign_open_hEEA_split(bench_data *d, size_t i, size_t batch) {
+	size_t j = pool_offset(i, 1);
+
+	(void)batch;
+	d->ret = ed25519_sign_open_hEEA_split(d->pm[j], d->mlen[j], d->ppk[j], d->pRS[j], ed25519_hEEA_split());
+}
+
+static void run_ed25519_verify_prehashed_hram(bench_data *d, size_t i, size_t batch) {
+	size_t j = pool_offset(i, 1);
+
+	(void)batch;
+	d->ret = ed25519_verify_prehashed_hram(d->hram[j], d->ppk[j], d->pRS[j]);
+}
+
+static void run_ed25519_verify_prehashed_hram_batch(bench_data *d, size_t i, size_t batch) {
+	size_t j = pool_offset(i, batch);
+
+	d->ret = ed25519_verify_prehashed_hram_batch(d->phram + j, d->ppk + j, d->pRS + j, batch, d->valid);
+}
+
+static void run_ed25519_halfagg_verify(bench_data *d, size_t i, size_t batch) {
+	(void)i;
+	if (d->agg_batch != batch) {
+		ed25519_halfagg_aggregate(d->pm, d->mlen, d->ppk, d->pRS, batch, d->agg);
+		d->agg_batch = batch;
+	}
+	d->ret = ed25519_halfagg_verify(d->pm, d->mlen, d->ppk, d->agg, batch);
+}
+
+static int check_single(bench_data *d, size_t i, size_t batch) { (void)i; (void)batch; return d->ret == 0; }
+static int check_batch(bench_data *d, size_t i, size_t batch) {
+	size_t j;
+
+	(void)i;
+	for (j = 0; j < batch; j++)
+		if (d->valid[j] != 1)
+			return 0;
+	return d->ret == 0;
+}
+static int check_halfagg(bench_data *d, size_t i, size_t batch) { (void)i; (void)batch; return d->ret == 0; }
+
+static const bench_variant bench_variants[] = {
+	{"hEEA_q", BENCH_ED25519, BENCH_REDUCER, run_curve25519_hEEA_vartime, check_reduction25519},
+	{"hEEA_q32", BENCH_ED25519, BENCH_REDUCER, run_curve25519_hEEA32_vartime, check_reduction25519},
+	{"hEEA_lehmer", BENCH_ED25519, BENCH_REDUCER, run_curve25519_hEEA_lehmer_vartime, check_reduction25519},
+	{"hEEA_div", BENCH_ED25519, BENCH_REDUCER, run_curve25519_hEEA_div_vartime, check_reduction25519},
+	{"reduce_basis", BENCH_ED25519, BENCH_REDUCER, run_curve25519_reduce_basis_vartime, check_reduction25519},
+	{"hgcd", BENCH_ED25519, BENCH_REDUCER, run_curve25519_hgcd_vartime, check_reduction25519},
+	{"hgcd_enhance1", BENCH_ED25519, BENCH_REDUCER, run_curve25519_hgcd_vartime_enhance1, check_reduction25519},
+	{"hgcd_enhance2", BENCH_ED25519, BENCH_REDUCER, run_curve25519_hgcd_vartime_enhance2, check_reduction25519},
+	{"hEEA_target", BENCH_ED25519, BENCH_REDUCER, run_curve25519_hEEA_target_vartime, check_reduction25519},
+	{"hEEA_q", BENCH_ED448, BENCH_REDUCER, run_curve448_hEEA_vartime, check_reduction448},
+	{"hEEA_div", BENCH_ED448, BENCH_REDUCER, run_curve448_hEEA_div_vartime, check_reduction448},
+	{"reduce_basis", BENCH_ED448, BENCH_REDUCER, run_curve448_reduce_basis_vartime, check_reduction448},
+	{"hgcd", BENCH_ED448, BENCH_REDUCER, run_curve448_hgcd_vartime, check_reduction448},
+	{"EEA_q", BENCH_ED25519, BENCH_INVERSE, run_inverse25519_EEA_vartime, check_inverse25519_EEA_vartime},
+	{"safegcd", BENCH_ED25519, BENCH_INVERSE, run_inverse25519_skylake, check_inverse25519_skylake},
+	{"bingcd", BENCH_ED25519, BENCH_INVERSE, run_gf_inv, check_gf_inv},
+	{"EEA_q", BENCH_ED448, BENCH_INVERSE, run_inverse448_EEA_vartime, check_inverse448},
+	{"FLT", BENCH_ED448, BENCH_INVERSE, run_inverse448_FLT, check_inverse448},
+	{"EEA_q", BENCH_ED25519, BENCH_BATCH_INVERSE, run_inverse25519_batch_vartime, check_inverse25519_batch_vartime},
+	{"donna", BENCH_ED25519, BENCH_SINGLE, run_ed25519_sign_open_donna, check_single},
+	{"donna_vartime_pack", BENCH_ED25519, BENCH_SINGLE, run_ed25519_sign_open, check_single},
+	{"hEEA_q", BENCH_ED25519, BENCH_SINGLE, run_ed25519_sign_open_hEEA, check_single},
+	{"hEEA_split", BENCH_ED25519, BENCH_SINGLE, run_ed25519_sign_open_hEEA_split, check_single},
+	{"hgcd", BENCH_ED25519, BENCH_SINGLE, run_ed25519_sign_open_hgcd, check_single},
+	{"prehashed_hram", BENCH_ED25519, BENCH_SINGLE, run_ed25519_verify_prehashed_hram, check_single},
+	{"donna_vartime_pack", BENCH_ED25519, BENCH_BATCH, run_ed25519_sign_open_batch, check_batch},
+	{"hEEA_q", BENCH_ED25519, BENCH_BATCH, run_ed25519_sign_open_batch_hEEA, check_batch},
+	{"hgcd", BENCH_ED25519, BENCH_BATCH, run_ed25519_sign_open_batch_hgcd, check_batch},
+	{"auto", BENCH_ED25519, BENCH_BATCH, run_ed25519_sign_open_batch_auto, check_batch},
+	{"joint2_hEEA", BENCH_ED25519, BENCH_BATCH, run_ed25519_sign_open_joint2_hEEA, check_batch},
+	{"joint3_hEEA", BENCH_ED25519, BENCH_BATCH, run_ed25519_sign_open_joint3_hEEA, check_batch},
+	{"prehashed_hram", BENCH_ED25519, BENCH_BATCH, run_ed25519_verify_prehashed_hram_batch, check_batch},
+	{"halfagg", BENCH_ED25519, BENCH_BATCH, run_ed25519_halfagg_verify, check_halfagg}
+};
+
+#define number_of_variants (sizeof(bench_variants) / sizeof(bench_variants[0]))
+
+/* count random values in [1, modulus) */
+static void prepare_values(bench_data *d, gmp_randstate_t state, const char *modulus)
+{
+	size_t i;
+
+	mpz_set_str(d->modulus, modulus, 10);
+	for (i = 0; i < d->count; i++) {
+		do {
+			mpz_urandomm(d->value, state, d->modulus);
+		} while (!mpz_sgn(d->value));
+		memset(d->x[i], 0, sizeof(d->x[i]));
+		mpz_export(d->x[i], NULL, -1, sizeof(uint64_t), 0, 0, d->value);
+	}
+}
+
+/* the values again, 4 words each, in a pool for the batch inverses */
+static void prepare_batch_values(bench_data *d)
+{
+	size_t i;
+
+	if (!d->xs) {
+		d->xs = malloc(signature_pool * 4 * sizeof(uint64_t));
+		d->ys = malloc(signature_pool * 4 * sizeof(uint64_t));
+		if (!d->xs || !d->ys) {
+			fprintf(stderr, "ERR: out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	for (i = 0; i < signature_pool; i++)
+		memcpy(d->xs + 4 * i, d->x[i % d->count], 4 * sizeof(uint64_t));
+}
+
+static void prepare_signatures(bench_data *d)
+{
+	ed25519_secret_key sk;
+	unsigned char buf[64 + message_size];
+	size_t i;
+
+	if (d->pk)
+		return;
+	d->pk = malloc(signature_pool * sizeof(*d->pk));
+	d->sig = malloc(signature_pool * sizeof(*d->sig));
+	d->msg = malloc(signature_pool * sizeof(*d->msg));
+	d->pm = malloc(signature_pool * sizeof(*d->pm));
+	d->ppk = malloc(signature_pool * sizeof(*d->ppk));
+	d->pRS = malloc(signature_pool * sizeof(*d->pRS));
+	d->mlen = malloc(signature_pool * sizeof(*d->mlen));
+	d->valid = malloc(signature_pool * sizeof(*d->valid));
+	d->hram = malloc(signature_pool * sizeof(*d->hram));
+	d->phram = malloc(signature_pool * sizeof(*d->phram));
+	d->agg = malloc(ed25519_halfagg_size(signature_pool));
+	if (!d->pk || !d->sig || !d->msg || !d->pm || !d->ppk || !d->pRS || !d->mlen || !d->valid || !d->hram || !d->phram || !d->agg) {
+		fprintf(stderr, "ERR: out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	ed25519_randombytes_unsafe(d->msg, signature_pool * sizeof(*d->msg));
+	for (i = 0; i < signature_pool; i++) {
+		ed25519_randombytes_unsafe(sk, sizeof(sk));
+		ed25519_publickey(sk, d->pk[i]);
+		ed25519_sign(d->msg[i], message_size, sk, d->pk[i], d->sig[i]);
+		d->pm[i] = d->msg[i];
+		d->mlen[i] = message_size;
+		d->ppk[i] = d->pk[i];
+		d->pRS[i] = d->sig[i];
+		memcpy(buf, d->sig[i], 32);
+		memcpy(buf + 32, d->pk[i], 32);
+		memcpy(buf + 64, d->msg[i], message_size);
+		SHA512(buf, sizeof(buf), d->hram[i]);
+		d->phram[i] = d->hram[i];
+	}
+}
+
+/* the inputs of v, unless the previous variant had the same */
+static void prepare(bench_data *d, gmp_randstate_t state, const bench_variant *v, const bench_variant *previous)
+{
+	if (previous && previous->kind == v->kind && previous->curve == v->curve)
+		return;
+	if (v->kind == BENCH_REDUCER && v->curve == BENCH_ED25519)
+		prepare_values(d, state, "7237005577332262213973186563042994240857116359379907606001950938285454250989");
+	else if (v->kind == BENCH_REDUCER)
+		prepare_values(d, state, "181709681073901722637330951972001133588410340171829515070372549795146003961539585716195755291692375963310293709091662304773755859649779");
+	else if ((v->kind == BENCH_INVERSE || v->kind == BENCH_BATCH_INVERSE) && v->curve == BENCH_ED25519)
+		prepare_values(d, state, "57896044618658097711785492504343953926634992332820282019728792003956564819949");
+	else if (v->kind == BENCH_INVERSE)
+		prepare_values(d, state, "726838724295606890549323807888004534353641360687318060281490199180612328166730772686396383698676545930088884461843637361053498018365439");
+	else
+		prepare_signatures(d);
+	if (v->kind == BENCH_BATCH_INVERSE)
+		prepare_batch_values(d);
+}
+
+/* the kinds timed per element over every --batch size */
+static int batched(const bench_variant *v)
+{
+	return v->kind == BENCH_BATCH || v->kind == BENCH_BATCH_INVERSE;
+}
+
+/* median and mean of the samples, with 95% confidence intervals */
+static bench_result statistics(uint64_t *t, size_t n)
+{
+	bench_result res;
+	double sum = 0, sq = 0, half, dev;
+	size_t i, lo, hi;
+
+	qsort(t, n, sizeof(uint64_t), cmp_int64);
+	for (i = 0; i < n; i++)
+		sum += (double)t[i];
+	res.mean = sum / (double)n;
+	for (i = 0; i < n; i++) {
+		dev = (double)t[i] - res.mean;
+		sq += dev * dev;
+	}
+	res.stddev = (n > 1) ? sqrt(sq / (double)(n - 1)) : 0;
+	half = 1.96 * res.stddev / sqrt((double)n);
+	res.mean_lo = res.mean - half;
+	res.mean_hi = res.mean + half;
+
+	/* order statistics around n/2: the median is below t[k] with probability Binomial(n, 1/2) <= k */
+	half = 0.98 * sqrt((double)n);
+	lo = ((double)n / 2 > half) ? (size_t)((double)n / 2 - half) : 0;
+	hi = (size_t)((double)n / 2 + half + 1);
+	if (hi >= n)
+		hi = n - 1;
+	res.min = t[0];
+	res.median = t[n / 2];
+	res.median_lo = t[lo];
+	res.median_hi = t[hi];
+	return res;
+}
+
+static bench_result run_variant(bench_data *d, const bench_variant *v, const bench_options *o, size_t batch, uint64_t *t)
+{
+	uint64_t t_begin;
+	size_t i, j;
+
+	for (i = 0; i < o->warmup; i++)
+		v->run(d, i % d->count, batch);
+
+	for (i = 0; i < o->samples; i++) {
+		perf_begin();
+		t_begin = get_ticks();
+		for (j = 0; j < o->rounds; j++)
+			v->run(d, i % d->count, batch);
+		t[i] = (get_ticks() - t_begin) / (o->rounds * batch);
+		perf_end((uint64_t)o->rounds * batch, "%s %s %s, %zu", bench_curve_names[v->curve], bench_kind_names[v->kind], v->name, batch);
+
+		if (!v->check(d, i % d->count, batch)) {
+			fprintf(stderr, "ERR: wrong result of %s %s %s on input %zu\n",
+				bench_curve_names[v->curve], bench_kind_names[v->kind], v->name, i);
+			exit(EXIT_FAILURE);
+		}
+	}
+	return statistics(t, o->samples);
+}
+
+static int selected(const bench_variant *v, const bench_options *o)
+{
+	return (!o->filter || strstr(v->name, o->filter)) &&
+		(o->curve < 0 || o->curve == (int)v->curve) &&
+		(o->kind < 0 || o->kind == (int)v->kind);
+}
+
+static int lookup(const char **names, size_t n, const char *name)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		if (!strcmp(names[i], name))
+			return (int)i;
+	fprintf(stderr, "ERR: unknown name `%s`\n", name);
+	exit(EXIT_FAILURE);
+}
+
+static size_t parse_size(const char *s, size_t min, size_t max)
+{
+	char *end;
+	unsigned long long v = strtoull(s, &end, 10);
+
+	if (*s == '\0' || *end != '\0' || v < min || v > max) {
+		fprintf(stderr, "ERR: `%s` is not a number in [%zu, %zu]\n", s, min, max);
+		exit(EXIT_FAILURE);
+	}
+	return (size_t)v;
+}
+
+static void parse_batches(bench_options *o, char *s)
+{
+	char *p;
+
+	o->batches = 0;
+	for (p = strtok(s, ","); p; p = strtok(NULL, ",")) {
+		if (o->batches == max_batch_sizes) {
+			fprintf(stderr, "ERR: at most %i batch sizes\n", max_batch_sizes);
+			exit(EXIT_FAILURE);
+		}
+		o->batch[o->batches++] = parse_size(p, 1, signature_pool);
+	}
+}
+
+static void parse_options(bench_options *o, int argc, char **argv)
+{
+	int i;
+
+	o->samples = default_samples;
+	o->rounds = default_rounds;
+	o->warmup = default_warmup;
+	o->batch[0] = 16;
+	o->batch[1] = 64;
+	o->batch[2] = 128;
+	o->batches = 3;
+	o->filter = NULL;
+	o->curve = o->kind = -1;
+	o->json = o->list = 0;
+
+	for (i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--list")) {
+			o->list = 1;
+		} else if (!strcmp(argv[i], "--json")) {
+			o->json = 1;
+		} else if (i + 1 < argc && !strcmp(argv[i], "--filter")) {
+			o->filter = argv[++i];
+		} else if (i + 1 < argc && !strcmp(argv[i], "--curve")) {
+			o->curve = lookup(bench_curve_names, 2, argv[++i]);
+		} else if (i + 1 < argc && !strcmp(argv[i], "--kind")) {
+			o->kind = lookup(bench_kind_names, BENCH_KINDS, argv[++i]);
+		} else if (i + 1 < argc && !strcmp(argv[i], "--samples")) {
+			o->samples = parse_size(argv[++i], 1, 1000000);
+		} else if (i + 1 < argc && !strcmp(argv[i], "--rounds")) {
+			o->rounds = parse_size(argv[++i], 1, 1000000);
+		} else if (i + 1 < argc && !strcmp(argv[i], "--warmup")) {
+			o->warmup = parse_size(argv[++i], 0, 1000000);
+		} else if (i + 1 < argc && !strcmp(argv[i], "--batch")) {
+			parse_batches(o, argv[++i]);
+		} else {
+			fprintf(stderr, "usage: %s [--list] [--json] [--filter s] [--curve ed25519|ed448] [--kind reducer|inverse|single|batch|batch_inverse]\n"
+				"\t[--samples n] [--rounds n] [--warmup n] [--batch n,n,...]\n", argv[0]);
+			exit(EXIT_FAILURE);
+		}
+	}
+}
+
+/* the hardware counters of v per call, as JSON members, if they are on */
+static void print_counters_json(const bench_variant *v, size_t batch)
+{
+	static const char *names[PERF_EVENTS] = {"cycles", "instructions", "branches", "branch_misses", "l1d_misses", "uops"};
+	char name[PERF_NAME_SIZE];
+	const perf_totals *totals;
+	int i;
+
+	snprintf(name, sizeof(name), "%s %s %s, %zu", bench_curve_names[v->curve], bench_kind_names[v->kind], v->name, batch);
+	if (!(totals = perf_lookup(name)))
+		return;
+	if (perf_ipc(totals) >= 0)
+		printf(", \"ipc\": %.3f", perf_ipc(totals));
+	for (i = 0; i < PERF_EVENTS; i++)
+		if (perf_per_call(totals, i) >= 0)
+			printf(", \"%s\": %.2f", names[i], perf_per_call(totals, i));
+	if (totals->scaled)
+		printf(", \"counters_scaled\": true");
+}
+
+static void print_result(const bench_options *o, const bench_variant *v, size_t batch, bench_result res, int first)
+{
+	char ci[48];
+
+	if (o->json) {
+		printf("%s\n    {\"name\": \"%s\", \"curve\": \"%s\", \"kind\": \"%s\", \"batch\": %zu, \"min\": %" PRIu64 ", "
+			"\"median\": %" PRIu64 ", \"median_ci95\": [%" PRIu64 ", %" PRIu64 "], "
+			"\"mean\": %.2f, \"mean_ci95\": [%.2f, %.2f], \"stddev\": %.2f",
+			first ? "" : ",", v->name, bench_curve_names[v->curve], bench_kind_names[v->kind], batch, res.min,
+			res.median, res.median_lo, res.median_hi, res.mean, res.mean_lo, res.mean_hi, res.stddev);
+		print_counters_json(v, batch);
+		printf("}");
+	} else {
+		snprintf(ci, sizeof(ci), "[%" PRIu64 ", %" PRIu64 "]", res.median_lo, res.median_hi);
+		printf("%-8s | %-13s | %-18s | %-6zu | %-10" PRIu64 " | %-10" PRIu64 " | %-21s | %.2f ± %.2f\n",
+			bench_curve_names[v->curve], bench_kind_names[v->kind], v->name, batch, res.min, res.median, ci, res.mean, res.mean_hi - res.mean);
+	}
+}
+
+int main(int argc, char **argv){
+	bench_options o;
+	bench_data d;
+	bench_result res;
+	gmp_randstate_t state;
+	const bench_variant *v, *previous = NULL;
+	uint64_t *t;
+	size_t i, b, batch, batches;
+	int first = 1;
+
+	parse_options(&o, argc, argv);
+	if (o.list) {
+		for (i = 0; i < number_of_variants; i++)
+			if (selected(&bench_variants[i], &o))
+				printf("%-8s %-13s %s\n", bench_curve_names[bench_variants[i].curve], bench_kind_names[bench_variants[i].kind], bench_variants[i].name);
+		return 0;
+	}
+
+	perf_open();
+	memset(&d, 0, sizeof(d));
+	d.count = o.samples;
+	d.x = malloc(d.count * sizeof(*d.x));
+	t = malloc(o.samples * sizeof(*t));
+	if (!d.x || !t) {
+		fprintf(stderr, "ERR: out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	mpz_inits(d.modulus, d.value, d.product, NULL);
+	gmp_randinit_mt(state);
+	gmp_randseed_ui(state, time(NULL));
+
+	if (o.json) {
+		printf("{\n  \"samples\": %zu, \"rounds\": %zu, \"warmup\": %zu, \"unit\": \"ticks\",\n  \"results\": [", o.samples, o.rounds, o.warmup);
+	} else {
+		printf("Samples = %zu, rounds = %zu, warmup = %zu (ticks per call, per signature for batches)\n", o.samples, o.rounds, o.warmup);
+		printf("───────────────────────────────────────────────────────────────────────────────────────────────────────────────────\n");
+		printf("Curve    | Kind          | Variant            | Batch  | Best       | Median     | Median 95%% CI         | Mean ± 95%% CI\n");
+		printf("───────────────────────────────────────────────────────────────────────────────────────────────────────────────────\n");
+	}
+
+	for (i = 0; i < number_of_variants; i++) {
+		v = &bench_variants[i];
+		if (!selected(v, &o))
+			continue;
+		prepare(&d, state, v, previous);
+		previous = v;
+
+		batches = batched(v) ? o.batches : 1;
+		for (b = 0; b < batches; b++) {
+			batch = batched(v) ? o.batch[b] : 1;
+			res = run_variant(&d, v, &o, batch, t);
+			print_result(&o, v, batch, res, first);
+			first = 0;
+		}
+	}
+
+	if (o.json)
+		printf("\n  ]\n}\n");
+	else {
+		printf("───────────────────────────────────────────────────────────────────────────────────────────────────────────────────\n");
+		perf_report();
+	}
+
+	gmp_randclear(state);
+	mpz_clears(d.modulus, d.value, d.product, NULL);
+	free(d.x);
+	free(t);
+	free(d.pk); free(d.sig); free(d.msg); free(d.pm); free(d.ppk); free(d.pRS); free(d.mlen); free(d.valid);
+	free(d.hram); free(d.phram); free(d.agg); free(d.xs); free(d.ys);
+	return 0;
+}
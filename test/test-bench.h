@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include "test-ticks.h"
+#include "test-perf.h"
+/*
+ * The timing scaffolding of the test programs. A sample is taken with
+ *
+ *	BENCH_TICKS(t[j], loops, calls, "name", fn(...));
+ *
+ * which runs the statement loops times between two get_ticks() reads,
+ * inside perf_begin/perf_end so that BENCH_PERF charges calls calls to
+ * "name", and stores the ticks in t[j]. benchmark_summary sorts the
+ * samples into the best, median and average ticks per call, and
+ * print_comparison prints two such results with the speed up and the
+ * improvement of the second over the first.
+ */
+
+#define BENCH_TICKS(ticks, loops, calls, name, ...) do {			\
+	uint64_t bench_begin_;							\
+	size_t bench_loop_;							\
+										\
+	perf_begin();								\
+	bench_begin_ = get_ticks();						\
+	for (bench_loop_ = 0; bench_loop_ < (size_t)(loops); bench_loop_++) {	\
+		__VA_ARGS__;							\
+	}									\
+	(ticks) = get_ticks() - bench_begin_;					\
+	perf_end((calls), "%s", (name));					\
+} while (0)
+
+struct benchmark_result{
+	uint64_t best;
+	uint64_t median;
+	double average;
+};
+
+static int cmp_int64(const void *v1, const void *v2)
+{
+	int64_t x1, x2;
+
+	x1 = *(const int64_t *)v1;
+	x2 = *(const int64_t *)v2;
+	if (x1 < x2) {
+		return -1;
+	} else if (x1 == x2) {
+		return 0;
+	} else {
+		return 1;
+	}
+}
+
+/* sorts the count samples of t, each of calls calls, into ticks per call */
+static inline struct benchmark_result benchmark_summary(uint64_t *t, size_t count, uint64_t calls)
+{
+	struct benchmark_result res;
+	uint64_t total_t = 0;
+	size_t i;
+
+	for (i = 0; i < count; i++)
+		total_t += t[i];
+	qsort(t, count, sizeof(uint64_t), cmp_int64);
+	res.best = t[0]/calls;
+	res.median = t[count/2]/calls;
+	res.average = total_t/(calls*(double)count);
+	return res;
+}
+
+/* the median ticks per call of the count samples of t, which it sorts */
+static inline uint64_t benchmark_median(uint64_t *t, size_t count, uint64_t calls)
+{
+	qsort(t, count, sizeof(uint64_t), cmp_int64);
+	return t[count/2]/calls;
+}
+
+/* name centred in a 14 wide table column */
+static inline void print_column(const char *name)
+{
+	int pad = 14 - (int)strlen(name);
+
+	if (pad < 0)
+		pad = 0;
+	printf("%*s%s%*s|", pad/2, "", name, pad - pad/2, "");
+}
+
+static inline void print_comparison(const char *name_a, const char *name_b, struct benchmark_result a, struct benchmark_result b)
+{
+	printf("───────────────────────────────────────────────────────────────────────\n");
+	printf("Time (ticks)|");
+	print_column(name_a);
+	print_column(name_b);
+	printf(" Speed up     | Improvement\n");
+	printf("───────────────────────────────────────────────────────────────────────\n");
+	printf("Best        | %-12" PRIu64 " | %-12" PRIu64 " | %-12.4f | %.2f %%\n", a.best, b.best, (double)a.best/(double)b.best, ((double)a.best - (double)b.best)/((double)a.best) * 100);
+	printf("Median      | %-12" PRIu64 " | %-12" PRIu64 " | %-12.4f | %.2f %%\n", a.median, b.median, (double)a.median/(double)b.median, ((double)a.median - (double)b.median)/((double)a.median) * 100);
+	printf("Average     | %-12.2f | %-12.2f | %-12.4f | %.2f %%\n", a.average, b.average, a.average/b.average, (a.average - b.average)/a.average * 100);
+	printf("───────────────────────────────────────────────────────────────────────\n");
+}
@@ -0,0 +1,247 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdarg.h>
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+/*
+ * Optional hardware counters around the measured calls, through Linux
+ * perf_event_open. They are off unless BENCH_PERF is set in the
+ * environment, and then cost one read() before and after each measured
+ * block, outside the rdtsc window:
+ *
+ *	perf_begin();
+ *	t_begin = get_ticks();
+ *	for (...) fn(...);
+ *	t[j] = get_ticks() - t_begin;
+ *	perf_end(number of calls, "name %zu", batch_size);
+ *
+ * perf_end adds the counts of the block to the totals of the name, given
+ * as a printf format, and perf_report prints, per name, the IPC and the
+ * counts per call. If the kernel multiplexed the group with other counters,
+ * so that it ran for only part of a block, the counts of that block are
+ * scaled by the time the group was enabled over the time it ran, and the
+ * name is marked in the report. The counters are cycles, instructions, branches,
+ * branch misses and L1D read misses. Micro-ops have no generic event:
+ * BENCH_PERF_UOPS gives the raw event of the CPU (0x10e, UOPS_ISSUED.ANY,
+ * on recent Intel cores; 0xc1, retired ops, on AMD Zen). A counter the CPU
+ * or the kernel does not offer is reported as n/a; on other systems the
+ * functions do nothing.
+ */
+
+#define PERF_CYCLES 0
+#define PERF_INSTRUCTIONS 1
+#define PERF_BRANCHES 2
+#define PERF_BRANCH_MISSES 3
+#define PERF_L1D_MISSES 4
+#define PERF_UOPS 5
+#define PERF_EVENTS 6
+#define PERF_MAX_NAMES 128
+#define PERF_NAME_SIZE 48
+/* a group read is nr, time enabled, time running, then the counts in slot order */
+#define PERF_READ_HEADER 3
+#define PERF_READ_SIZE (PERF_READ_HEADER + PERF_EVENTS)
+
+typedef struct perf_totals_t {
+	char name[PERF_NAME_SIZE];
+	uint64_t calls;
+	uint64_t count[PERF_EVENTS];
+	int scaled; /* some block ran for less than its enabled time */
+} perf_totals;
+
+static struct {
+	int enabled;
+	int leader;
+	int slot[PERF_EVENTS]; /* position of the counter in a group read, -1 if not opened */
+	int opened;
+	uint64_t begin[PERF_READ_SIZE];
+	perf_totals totals[PERF_MAX_NAMES];
+	size_t names;
+} perf_state = {0, -1, {-1, -1, -1, -1, -1, -1}, 0, {0}, {{0}}, 0};
+
+#if defined(__linux__)
+static int perf_open_event(uint32_t type, uint64_t config, int group)
+{
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = type;
+	attr.config = config;
+	attr.disabled = (group == -1);
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	return (int)syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+/* the group read into values, see PERF_READ_HEADER; 0 on failure */
+static int perf_read(uint64_t values[PERF_READ_SIZE])
+{
+	ssize_t size = (ssize_t)((perf_state.opened + PERF_READ_HEADER) * sizeof(uint64_t));
+
+	return read(perf_state.leader, values, (size_t)size) == size;
+}
+#endif
+
+/* opens the counters if BENCH_PERF is set */
+static void perf_open(void)
+{
+#if defined(__linux__)
+	static const uint64_t config[PERF_UOPS] = {
+		PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES,
+		PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+	};
+	const char *uops = getenv("BENCH_PERF_UOPS");
+	int fd, i;
+
+	if (!getenv("BENCH_PERF"))
+		return;
+	perf_state.leader = perf_open_event(PERF_TYPE_HARDWARE, config[PERF_CYCLES], -1);
+	if (perf_state.leader < 0) {
+		fprintf(stderr, "BENCH_PERF: perf_event_open failed, hardware counters are off (see /proc/sys/kernel/perf_event_paranoid)\n");
+		return;
+	}
+	perf_state.slot[PERF_CYCLES] = 0;
+	perf_state.opened = 1;
+	for (i = PERF_INSTRUCTIONS; i < PERF_EVENTS; i++) {
+		if (i == PERF_UOPS && !uops)
+			break;
+		if (i == PERF_UOPS)
+			fd = perf_open_event(PERF_TYPE_RAW, strtoull(uops, NULL, 0), perf_state.leader);
+		else
+			fd = perf_open_event((i == PERF_L1D_MISSES) ? PERF_TYPE_HW_CACHE : PERF_TYPE_HARDWARE, config[i], perf_state.leader);
+		if (fd >= 0)
+			perf_state.slot[i] = perf_state.opened++;
+	}
+	ioctl(perf_state.leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(perf_state.leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	perf_state.enabled = 1;
+#endif
+}
+
+static inline void perf_begin(void)
+{
+#if defined(__linux__)
+	if (perf_state.enabled && !perf_read(perf_state.begin))
+		perf_state.enabled = 0;
+#endif
+}
+
+/* the totals of name, NULL if the counters are off */
+static perf_totals *perf_lookup(const char *name)
+{
+	size_t i;
+
+	if (!perf_state.enabled)
+		return NULL;
+	for (i = 0; i < perf_state.names; i++)
+		if (!strcmp(perf_state.totals[i].name, name))
+			return &perf_state.totals[i];
+	if (perf_state.names == PERF_MAX_NAMES)
+		return NULL;
+	snprintf(perf_state.totals[perf_state.names].name, PERF_NAME_SIZE, "%s", name);
+	return &perf_state.totals[perf_state.names++];
+}
+
+/* adds the counts since perf_begin, over calls calls, to the totals of the name printed from format */
+static void perf_end(uint64_t calls, const char *format, ...)
+{
+#if defined(__linux__)
+	uint64_t end[PERF_READ_SIZE], enabled, running;
+	char name[PERF_NAME_SIZE];
+	perf_totals *totals;
+	va_list args;
+	double scale = 1;
+	int i;
+
+	if (!perf_state.enabled)
+		return;
+	if (!perf_read(end)) {
+		perf_state.enabled = 0;
+		return;
+	}
+	va_start(args, format);
+	vsnprintf(name, sizeof(name), format, args);
+	va_end(args);
+	if (!(totals = perf_lookup(name)))
+		return;
+	enabled = end[1] - perf_state.begin[1];
+	running = end[2] - perf_state.begin[2];
+	if (running < enabled) {
+		totals->scaled = 1;
+		/* the group never ran during the block: nothing to scale */
+		if (!running)
+			return;
+		scale = (double)enabled / (double)running;
+	}
+	totals->calls += calls;
+	for (i = 0; i < PERF_EVENTS; i++)
+		if (perf_state.slot[i] >= 0)
+			totals->count[i] += (uint64_t)((double)(end[PERF_READ_HEADER + perf_state.slot[i]] - perf_state.begin[PERF_READ_HEADER + perf_state.slot[i]]) * scale + 0.5);
+#else
+	(void)calls;
+	(void)format;
+#endif
+}
+
+/* count i per call of t, or -1 if the counter is not available */
+static double perf_per_call(const perf_totals *t, int i)
+{
+	if (perf_state.slot[i] < 0 || !t->calls)
+		return -1;
+	return (double)t->count[i] / (double)t->calls;
+}
+
+static double perf_ipc(const perf_totals *t)
+{
+	if (perf_state.slot[PERF_INSTRUCTIONS] < 0 || !t->count[PERF_CYCLES])
+		return -1;
+	return (double)t->count[PERF_INSTRUCTIONS] / (double)t->count[PERF_CYCLES];
+}
+
+static void perf_print_value(double v, const char *format)
+{
+	if (v < 0)
+		printf(format, "n/a");
+	else {
+		char s[32];
+
+		snprintf(s, sizeof(s), "%.2f", v);
+		printf(format, s);
+	}
+}
+
+/* prints the totals of every name, if the counters are on */
+static void perf_report(void)
+{
+	size_t i;
+	int scaled = 0;
+
+	if (!perf_state.enabled || !perf_state.names)
+		return;
+	printf("\nHardware counters per call:\n");
+	printf("──────────────────────────────────────────────────────────────────────────────────────────────────────────────────────\n");
+	printf("%-40s | IPC    | Instructions | Branches     | Branch misses | L1D misses   | Uops\n", "Algorithm");
+	printf("──────────────────────────────────────────────────────────────────────────────────────────────────────────────────────\n");
+	for (i = 0; i < perf_state.names; i++) {
+		const perf_totals *t = &perf_state.totals[i];
+
+		printf("%-40s%c| ", t->name, t->scaled ? '*' : ' ');
+		scaled |= t->scaled;
+		perf_print_value(perf_ipc(t), "%-6s | ");
+		perf_print_value(perf_per_call(t, PERF_INSTRUCTIONS), "%-12s | ");
+		perf_print_value(perf_per_call(t, PERF_BRANCHES), "%-12s | ");
+		perf_print_value(perf_per_call(t, PERF_BRANCH_MISSES), "%-13s | ");
+		perf_print_value(perf_per_call(t, PERF_L1D_MISSES), "%-12s | ");
+		perf_print_value(perf_per_call(t, PERF_UOPS), "%s\n");
+	}
+	printf("──────────────────────────────────────────────────────────────────────────────────────────────────────────────────────\n");
+	if (scaled)
+		printf("* the counters were multiplexed: counts scaled by time enabled / time running\n");
+}
@@ -1,13 +1,22 @@
 #include <stdint.h>
+#if defined(__x86_64__) || defined(__i386__)
 #include <immintrin.h>
+#else
+#include <time.h>
+#endif
 /*
  * Read the cycle counter. The 'lfence' call should guarantee enough
  * serialization without adding too much overhead (contrary to what,
  * say, 'cpuid' would do).
+ *
+ * Other targets read the generic timer (AArch64) or fall back to
+ * CLOCK_MONOTONIC, so their figures are in timer ticks or nanoseconds
+ * rather than cycles.
  */
 static inline uint64_t
 get_ticks(void)
 {
+#if defined(__x86_64__) || defined(__i386__)
 	/*
 	 * GCC seems not to have the __rdtsc() intrinsic.
 	 */
@@ -21,4 +30,15 @@ get_ticks(void)
 	_mm_lfence();
 	return __rdtsc();
 #endif
-}
\ No newline at end of file
+#elif defined(__aarch64__)
+	uint64_t t;
+
+	__asm__ __volatile__ ("isb; mrs %0, cntvct_el0" : "=r" (t) : : "memory");
+	return t;
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
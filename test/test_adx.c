@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test-bench.h"
+#include "../src/ed25519-donna/ed25519.h"
+
+
+#define number_of_samples 10000
+#define number_of_rounds 10
+
+/* ed25519.c built a second time with ED25519_ADX (see `OBJADX` in the Makefile) */
+void ed25519_publickey_adx(const ed25519_secret_key sk, ed25519_public_key pk);
+void ed25519_sign_adx(const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_public_key pk, ed25519_signature RS);
+int ed25519_sign_open_donna_adx(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
+int ed25519_sign_open_hEEA_adx(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
+int ed25519_sign_open_hEEA_samePre_adx(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
+
+typedef int (*open_fn)(const unsigned char *, size_t, const ed25519_public_key, const ed25519_signature);
+
+
+struct adx_result{
+	uint64_t base;
+	uint64_t adx;
+};
+
+/*
+ * Runs both builds of a verifier on the same signatures, checks that they
+ * accept the valid ones and reject a corrupted copy, and keeps the median
+ * time of each.
+ */
+struct adx_result bench_open(const char *name, open_fn base, open_fn adx,
+	const unsigned char (*messages)[128], const size_t *message_lengths,
+	const ed25519_public_key *pks, const ed25519_signature *sigs, size_t test_count){
+	struct adx_result res;
+	ed25519_signature bad;
+	char name_base[PERF_NAME_SIZE], name_adx[PERF_NAME_SIZE];
+	uint64_t t[test_count], u[test_count];
+	int ret_base = 0, ret_adx = 0;
+	size_t i;
+
+	snprintf(name_base, sizeof(name_base), "%s, 64-bit", name);
+	snprintf(name_adx, sizeof(name_adx), "%s, ADX", name);
+	for (i = 0; i < test_count; i++) {
+		BENCH_TICKS(t[i], number_of_rounds, number_of_rounds, name_base, ret_base |= base(messages[i], message_lengths[i], pks[i], sigs[i]));
+
+		BENCH_TICKS(u[i], number_of_rounds, number_of_rounds, name_adx, ret_adx |= adx(messages[i], message_lengths[i], pks[i], sigs[i]));
+
+		memcpy(bad, sigs[i], sizeof(bad));
+		bad[i & 31] ^= 1 << (i & 7);
+		if (ret_base || ret_adx || !base(messages[i], message_lengths[i], pks[i], bad) || !adx(messages[i], message_lengths[i], pks[i], bad)) {
+			fprintf(stderr, "ERR: `%s` failed on message %zu\n", name, i);
+			exit(EXIT_FAILURE);
+		}
+	}
+	res.base = benchmark_median(t, test_count, number_of_rounds);
+	res.adx = benchmark_median(u, test_count, number_of_rounds);
+	return res;
+}
+
+void print_result(const char *name, struct adx_result res){
+	printf("%-20s | %-12" PRIu64 " | %-12" PRIu64 " | %.4f\n", name, res.base, res.adx, (double)res.adx/(double)res.base);
+}
+
+int test_instance(size_t test_count){
+	static ed25519_secret_key sks[number_of_samples];
+	static ed25519_public_key pks[number_of_samples];
+	static ed25519_signature sigs[number_of_samples];
+	static unsigned char messages[number_of_samples][128];
+	static size_t message_lengths[number_of_samples];
+	size_t i;
+
+	ed25519_randombytes_unsafe(sks, sizeof(sks));
+	ed25519_randombytes_unsafe(messages, sizeof(messages));
+	for (i = 0; i < test_count; i++) {
+		ed25519_public_key pk;
+		ed25519_signature sig;
+
+		message_lengths[i] = (i & 127) + 1;
+		ed25519_publickey(sks[i], pks[i]);
+		ed25519_sign(messages[i], message_lengths[i], sks[i], pks[i], sigs[i]);
+
+		/* key generation and signing go through the same field code */
+		ed25519_publickey_adx(sks[i], pk);
+		ed25519_sign_adx(messages[i], message_lengths[i], sks[i], pks[i], sig);
+		if (memcmp(pk, pks[i], sizeof(pk)) || memcmp(sig, sigs[i], sizeof(sig))) {
+			fprintf(stderr, "ERR: the ADX build signs differently on message %zu\n", i);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	printf("───────────────────────────────────────────────────────────────────────\n");
+	printf("Median (ticks)       | 64-bit       | ADX          | Ratio\n");
+	printf("───────────────────────────────────────────────────────────────────────\n");
+	print_result("donna", bench_open("ed25519_sign_open_donna", ed25519_sign_open_donna, ed25519_sign_open_donna_adx, (const unsigned char (*)[128])messages, message_lengths, (const ed25519_public_key *)pks, (const ed25519_signature *)sigs, test_count));
+	print_result("hEEA_q", bench_open("ed25519_sign_open_hEEA", ed25519_sign_open_hEEA, ed25519_sign_open_hEEA_adx, (const unsigned char (*)[128])messages, message_lengths, (const ed25519_public_key *)pks, (const ed25519_signature *)sigs, test_count));
+	print_result("hEEA_q samePre", bench_open("ed25519_sign_open_hEEA_samePre", ed25519_sign_open_hEEA_samePre, ed25519_sign_open_hEEA_samePre_adx, (const unsigned char (*)[128])messages, message_lengths, (const ed25519_public_key *)pks, (const ed25519_signature *)sigs, test_count));
+	printf("───────────────────────────────────────────────────────────────────────\n");
+
+	return 0;
+}
+
+int main(){
+	if (!__builtin_cpu_supports("adx") || !__builtin_cpu_supports("bmi2")) {
+		printf("This CPU has no ADX/BMI2, skipping the ADX backend\n");
+		return 0;
+	}
+	perf_open();
+	printf("Benchmark of the ADX backend against the 64-bit one:\n");
+	printf("Number of samples = %i \n", number_of_samples);
+	printf("Number of rounds = %i \n", number_of_rounds);
+	test_instance(number_of_samples);
+	perf_report();
+	printf("Done!\n");
+}
@@ -1,29 +1,20 @@
 #include <stdio.h>
+#include <inttypes.h>
 #include <string.h>
+#include <openssl/rand.h>
+#include <openssl/sha.h>
 #include "../src/ed25519-donna/ed25519.h"
 
-#include "test-ticks.h"
+#include "test-bench.h"
 
 #define max_batch_size 128
 #define number_of_samples 100
 #define number_of_rounds 10
+#define max_workspace_size 2048
+#define number_of_workspace_samples 10
+#define max_halfagg_size 1024
 
 
-static int cmp_int64(const void *v1, const void *v2)
-{
-	int64_t x1, x2;
-
-	x1 = *(const int64_t *)v1;
-	x2 = *(const int64_t *)v2;
-	if (x1 < x2) {
-		return -1;
-	} else if (x1 == x2) {
-		return 0;
-	} else {
-		return 1;
-	}
-}
-
 
 int test_batch_instance(int test_count, int batch_size){
     ed25519_secret_key sks[batch_size];
@@ -63,33 +54,41 @@ int test_batch_instance(int test_count, int batch_size){
     	/* batch verify */
 
 		/* Old approach */
+		perf_begin();
 		t_begin = get_ticks();
 		for(i=0;i<number_of_rounds;i++)
 			ret = ed25519_sign_open_batch(message_pointers, message_lengths, pk_pointers, sig_pointers, batch_size, valid);
 		total_time_old += get_ticks() - t_begin;
+		perf_end((uint64_t)number_of_rounds * batch_size, "batch donna, %d", batch_size);
 		if (ret){
 			fprintf(stderr, "ERR: Old Batch verification failed\n");
 			exit(EXIT_FAILURE);
 		}
 
 		/* New approach */
+		perf_begin();
 		t_begin = get_ticks();
 		for(i=0;i<number_of_rounds;i++)
 			ret = ed25519_sign_open_batch_hEEA(message_pointers, message_lengths, pk_pointers, sig_pointers, batch_size, valid);
 		total_time_new += get_ticks() - t_begin;
+		perf_end((uint64_t)number_of_rounds * batch_size, "batch hEEA_q, %d", batch_size);
 		if (ret){
 			fprintf(stderr, "ERR: New Batch verification failed\n");
 			exit(EXIT_FAILURE);
 		}
+#if !defined(ED25519_NO_HGCD)
 		/* New approach */
+		perf_begin();
 		t_begin = get_ticks();
 		for(i=0;i<number_of_rounds;i++)
 			ret = ed25519_sign_open_batch_hgcd(message_pointers, message_lengths, pk_pointers, sig_pointers, batch_size, valid);
 		total_time_new_hgcd += get_ticks() - t_begin;
+		perf_end((uint64_t)number_of_rounds * batch_size, "batch hgcd, %d", batch_size);
 		if (ret){
 			fprintf(stderr, "ERR: New Batch verification failed\n");
 			exit(EXIT_FAILURE);
 		}
+#endif
 
 	}
 
@@ -105,27 +104,782 @@ int test_batch_instance(int test_count, int batch_size){
 	// printf("──────────────────────────────────────────────────────────────────────\n");
 	// printf("Best         | %-12lu | %-12lu | %-12.2f | %.2f %%\n", t_old[0], t_new[0], (double)t_old[0]/(double)t_new[0],(double)(t_old[0] - t_new[0])/((double)t_old[0]) * 100);
 	// printf("Median       | %-12lu | %-12lu | %-12.2f | %.2f %%\n", t_old[test_count/2], t_new[test_count/2], (double)t_old[test_count/2]/(double)t_new[test_count/2], (double)(t_old[test_count/2] - t_new[test_count/2])/((double)t_old[test_count/2]) * 100);
+#if !defined(ED25519_NO_HGCD)
 	printf("%-10i | %-12.2f | %-14.2f | %-8.4f | %-5.2f %%     || %-18.2f | %-12.4f | %.2f %%\n", batch_size, total_time_old, total_time_new ,total_time_old/total_time_new ,(total_time_old - total_time_new)/total_time_old * 100, total_time_new_hgcd, total_time_new/total_time_new_hgcd, (total_time_new-total_time_new_hgcd)/total_time_new_hgcd * 100);
+#else
+	(void)total_time_new_hgcd;
+	printf("%-10i | %-12.2f | %-14.2f | %-8.4f | %-5.2f %%\n", batch_size, total_time_old, total_time_new ,total_time_old/total_time_new ,(total_time_old - total_time_new)/total_time_old * 100);
+#endif
 	// printf("──────────────────────────────────────────────────────────────────────\n");
 
 	return 0;
 
 }
 
+/*
+ * Batches above max_batch_size: one workspace sized to the whole batch
+ * against the default entry point, which splits it into max_batch_size
+ * chunks on the stack.
+ */
+int test_workspace_instance(int test_count, size_t batch_size){
+	static ed25519_secret_key sks[max_workspace_size];
+	static ed25519_public_key pks[max_workspace_size];
+	static ed25519_signature sigs[max_workspace_size];
+	static unsigned char messages[max_workspace_size][128];
+	static size_t message_lengths[max_workspace_size];
+	static const unsigned char *message_pointers[max_workspace_size];
+	static const unsigned char *pk_pointers[max_workspace_size];
+	static const unsigned char *sig_pointers[max_workspace_size];
+	static int valid[max_workspace_size];
+	ed25519_batch_workspace *ws;
+	size_t i, j;
+	int ret = 0;
+	uint64_t t_begin;
+	double total_time_chunked = 0, total_time_ws = 0;
+
+	ws = ed25519_batch_workspace_create(batch_size);
+	if (!ws){
+		fprintf(stderr, "ERR: could not create a workspace for %zu signatures\n", batch_size);
+		exit(EXIT_FAILURE);
+	}
+
+	for (j = 0; j < test_count; j++){
+		ed25519_randombytes_unsafe(sks, batch_size * sizeof(sks[0]));
+		ed25519_randombytes_unsafe(messages, batch_size * sizeof(messages[0]));
+		for (i = 0; i < batch_size; i++) {
+			ed25519_publickey(sks[i], pks[i]);
+			message_lengths[i] = (i & 127) + 1;
+			ed25519_sign(messages[i], message_lengths[i], sks[i], pks[i], sigs[i]);
+			message_pointers[i] = messages[i];
+			pk_pointers[i] = pks[i];
+			sig_pointers[i] = sigs[i];
+		}
+
+		perf_begin();
+		t_begin = get_ticks();
+		for(i=0;i<number_of_rounds;i++)
+			ret |= ed25519_sign_open_batch_hEEA(message_pointers, message_lengths, pk_pointers, sig_pointers, batch_size, valid);
+		total_time_chunked += get_ticks() - t_begin;
+		perf_end((uint64_t)number_of_rounds * batch_size, "batch hEEA_q, %zu", batch_size);
+
+		perf_begin();
+		t_begin = get_ticks();
+		for(i=0;i<number_of_rounds;i++)
+			ret |= ed25519_sign_open_batch_hEEA_ws(ws, message_pointers, message_lengths, pk_pointers, sig_pointers, batch_size, valid);
+		total_time_ws += get_ticks() - t_begin;
+		perf_end((uint64_t)number_of_rounds * batch_size, "batch hEEA_q one workspace, %zu", batch_size);
+
+		if (ret){
+			fprintf(stderr, "ERR: Workspace batch verification failed\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	total_time_chunked = total_time_chunked/((double)(number_of_rounds*test_count*batch_size));
+	total_time_ws = total_time_ws/((double)(number_of_rounds*test_count*batch_size));
+	printf("%-10zu | %-13zu | %-14.2f | %-14.2f | %.4f\n", batch_size, ed25519_batch_workspace_size(batch_size), total_time_chunked, total_time_ws, total_time_chunked/total_time_ws);
+
+	ed25519_batch_workspace_free(ws);
+	return 0;
+}
+
+
+/* S <-- S + 1, or S - 1 when down, on the little-endian S of a signature */
+static void sig_S_step(unsigned char *S, int down){
+	size_t i;
+
+	for (i = 0; i < 32; i++) {
+		S[i] += down ? 0xff : 1;
+		if (S[i] != (down ? 0xff : 0))
+			break;
+	}
+}
+
+/*
+ * Joint verification of 2 and 3 signatures against single verification,
+ * and on invalid batches: one bad signature in each position, and a pair
+ * whose S are moved by +1 and -1 so that an unweighted sum still cancels.
+ */
+int test_joint_instance(int test_count, size_t batch_size){
+	ed25519_secret_key sks[3];
+	ed25519_public_key pks[3];
+	ed25519_signature sigs[3];
+	unsigned char messages[3][128];
+	size_t message_lengths[3];
+	const unsigned char *message_pointers[3];
+	const unsigned char *pk_pointers[3];
+	const unsigned char *sig_pointers[3];
+	int valid[3], ret = 0;
+	size_t i, j, k;
+	uint64_t t_begin;
+	double total_time_single = 0, total_time_joint = 0;
+	int (*joint)(const unsigned char **, size_t *, const unsigned char **, const unsigned char **, int *) =
+		(batch_size == 2) ? ed25519_sign_open_joint2_hEEA : ed25519_sign_open_joint3_hEEA;
+
+	for (j = 0; j < test_count; j++){
+		ed25519_randombytes_unsafe(sks, sizeof(sks));
+		ed25519_randombytes_unsafe(messages, sizeof(messages));
+		for (i = 0; i < batch_size; i++) {
+			ed25519_publickey(sks[i], pks[i]);
+			message_lengths[i] = (i & 127) + 1;
+			ed25519_sign(messages[i], message_lengths[i], sks[i], pks[i], sigs[i]);
+			message_pointers[i] = messages[i];
+			pk_pointers[i] = pks[i];
+			sig_pointers[i] = sigs[i];
+		}
+
+		perf_begin();
+		t_begin = get_ticks();
+		for(k=0;k<number_of_rounds;k++)
+			for (i = 0; i < batch_size; i++)
+				ret |= ed25519_sign_open_hEEA(message_pointers[i], message_lengths[i], pk_pointers[i], sig_pointers[i]);
+		total_time_single += get_ticks() - t_begin;
+		perf_end((uint64_t)number_of_rounds * batch_size, "single hEEA_q, %zu", batch_size);
+
+		perf_begin();
+		t_begin = get_ticks();
+		for(k=0;k<number_of_rounds;k++)
+			ret |= joint(message_pointers, message_lengths, pk_pointers, sig_pointers, valid);
+		total_time_joint += get_ticks() - t_begin;
+		perf_end((uint64_t)number_of_rounds * batch_size, "joint%zu hEEA_q", batch_size);
+
+		if (ret){
+			fprintf(stderr, "ERR: Joint verification of %zu valid signatures failed\n", batch_size);
+			exit(EXIT_FAILURE);
+		}
+
+		/* one bad message in each position */
+		for (k = 0; k < batch_size; k++) {
+			messages[k][0] ^= 1;
+			ret = joint(message_pointers, message_lengths, pk_pointers, sig_pointers, valid);
+			messages[k][0] ^= 1;
+			for (i = 0; i < batch_size; i++)
+				if (valid[i] != (i != k))
+					ret = 0;
+			if (!ret){
+				fprintf(stderr, "ERR: Joint verification of %zu signatures accepted a bad signature %zu\n", batch_size, k);
+				exit(EXIT_FAILURE);
+			}
+		}
+
+		/* S_0 + 1 and S_1 - 1: both are bad, the unweighted sum is not */
+		sig_S_step(sigs[0] + 32, 0);
+		sig_S_step(sigs[1] + 32, 1);
+		ret = joint(message_pointers, message_lengths, pk_pointers, sig_pointers, valid);
+		sig_S_step(sigs[0] + 32, 1);
+		sig_S_step(sigs[1] + 32, 0);
+		if (!ret || valid[0] || valid[1] || (batch_size == 3 && !valid[2])){
+			fprintf(stderr, "ERR: Joint verification of %zu signatures accepted two cancelling bad signatures\n", batch_size);
+			exit(EXIT_FAILURE);
+		}
+		ret = 0;
+	}
+
+	total_time_single = total_time_single/((double)(number_of_rounds*test_count*batch_size));
+	total_time_joint = total_time_joint/((double)(number_of_rounds*test_count*batch_size));
+	printf("%-10zu | %-14.2f | %-14.2f | %.4f\n", batch_size, total_time_single, total_time_joint, total_time_single/total_time_joint);
+	return 0;
+}
+
+/* median ticks of one 64-byte draw, the size of a batch chunk's U */
+static uint64_t bench_rng(void (*rng)(void *, size_t)){
+	unsigned char out[64];
+	uint64_t t[1000], t_begin;
+	size_t i, j;
+
+	for (i = 0; i < 1000; i++){
+		t_begin = get_ticks();
+		for (j = 0; j < number_of_rounds; j++)
+			rng(out, sizeof(out));
+		t[i] = get_ticks() - t_begin;
+	}
+	qsort(t, 1000, sizeof(uint64_t), cmp_int64);
+	return t[500]/number_of_rounds;
+}
+
+static void openssl_rand_bytes(void *p, size_t len){
+	RAND_bytes(p, (int) len);
+}
+
+/*
+ * Cost of the blinding randomness: the same batches verified with U drawn
+ * from ed25519_randombytes_unsafe, the per-thread ChaCha20 generator and the
+ * hash of the batch.
+ */
+int test_rng_instance(int test_count, size_t batch_size){
+	static ed25519_secret_key sks[max_batch_size];
+	static ed25519_public_key pks[max_batch_size];
+	static ed25519_signature sigs[max_batch_size];
+	static unsigned char messages[max_batch_size][128];
+	static size_t message_lengths[max_batch_size];
+	static const unsigned char *message_pointers[max_batch_size];
+	static const unsigned char *pk_pointers[max_batch_size];
+	static const unsigned char *sig_pointers[max_batch_size];
+	static int valid[max_batch_size];
+	static const ed25519_batch_rng modes[3] = {ED25519_BATCH_RNG_SYSTEM, ED25519_BATCH_RNG_DRBG, ED25519_BATCH_RNG_TRANSCRIPT};
+	double total_time[3] = {0, 0, 0};
+	size_t i, j, k;
+	int ret = 0;
+	uint64_t t_begin;
+
+	for (j = 0; j < test_count; j++){
+		ed25519_randombytes_unsafe(sks, batch_size * sizeof(sks[0]));
+		ed25519_randombytes_unsafe(messages, batch_size * sizeof(messages[0]));
+		for (i = 0; i < batch_size; i++) {
+			ed25519_publickey(sks[i], pks[i]);
+			message_lengths[i] = (i & 127) + 1;
+			ed25519_sign(messages[i], message_lengths[i], sks[i], pks[i], sigs[i]);
+			message_pointers[i] = messages[i];
+			pk_pointers[i] = pks[i];
+			sig_pointers[i] = sigs[i];
+		}
+
+		for (k = 0; k < 3; k++){
+			ed25519_batch_rng_use(modes[k]);
+			perf_begin();
+			t_begin = get_ticks();
+			for(i=0;i<number_of_rounds;i++)
+				ret |= ed25519_sign_open_batch_hEEA(message_pointers, message_lengths, pk_pointers, sig_pointers, batch_size, valid);
+			total_time[k] += get_ticks() - t_begin;
+			perf_end((uint64_t)number_of_rounds * batch_size, "batch hEEA_q, U from %s, %zu", (k == 0) ? "randombytes" : (k == 1) ? "DRBG" : "transcript", batch_size);
+		}
+		ed25519_batch_rng_use(ED25519_BATCH_RNG_DRBG);
+
+		if (ret){
+			fprintf(stderr, "ERR: Batch verification failed with a blinding generator\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	for (k = 0; k < 3; k++)
+		total_time[k] = total_time[k]/((double)(number_of_rounds*test_count*batch_size));
+	printf("%-10zu | %-14.2f | %-14.2f | %-14.2f | %.4f\n", batch_size, total_time[0], total_time[1], total_time[2], total_time[0]/total_time[1]);
+	return 0;
+}
+
+/*
+ * Incremental verification: ticks spent in ed25519_batch_ctx_add (the
+ * per-signature work) and in ed25519_batch_ctx_finalize, against the array
+ * entry point on the same batches.
+ */
+int test_ctx_instance(int test_count, size_t batch_size){
+	static ed25519_secret_key sks[max_batch_size];
+	static ed25519_public_key pks[max_batch_size];
+	static ed25519_signature sigs[max_batch_size];
+	static unsigned char messages[max_batch_size][128];
+	static size_t message_lengths[max_batch_size];
+	static const unsigned char *message_pointers[max_batch_size];
+	static const unsigned char *pk_pointers[max_batch_size];
+	static const unsigned char *sig_pointers[max_batch_size];
+	static int valid[max_batch_size];
+	ed25519_batch_ctx *ctx;
+	double total_time_array = 0, total_time_add = 0, total_time_finalize = 0;
+	size_t i, j, k;
+	int ret = 0;
+	uint64_t t_begin;
+
+	ctx = ed25519_batch_ctx_create(batch_size);
+	for (j = 0; j < test_count; j++){
+		ed25519_randombytes_unsafe(sks, batch_size * sizeof(sks[0]));
+		ed25519_randombytes_unsafe(messages, batch_size * sizeof(messages[0]));
+		for (i = 0; i < batch_size; i++) {
+			ed25519_publickey(sks[i], pks[i]);
+			message_lengths[i] = (i & 127) + 1;
+			ed25519_sign(messages[i], message_lengths[i], sks[i], pks[i], sigs[i]);
+		}
+
+		perf_begin();
+		t_begin = get_ticks();
+		for(k=0;k<number_of_rounds;k++){
+			for (i = 0; i < batch_size; i++) {
+				message_pointers[i] = messages[i];
+				pk_pointers[i] = pks[i];
+				sig_pointers[i] = sigs[i];
+			}
+			ret |= ed25519_sign_open_batch_hEEA(message_pointers, message_lengths, pk_pointers, sig_pointers, batch_size, valid);
+		}
+		total_time_array += get_ticks() - t_begin;
+		perf_end(batch_size, "ctx arrays, %zu", batch_size);
+
+		for(k=0;k<number_of_rounds;k++){
+			perf_begin();
+			t_begin = get_ticks();
+			for (i = 0; i < batch_size; i++)
+				ret |= ed25519_batch_ctx_add(ctx, messages[i], message_lengths[i], pks[i], sigs[i]);
+			total_time_add += get_ticks() - t_begin;
+			perf_begin();
+			perf_end(batch_size, "ctx add, %zu", batch_size);
+			t_begin = get_ticks();
+			ret |= ed25519_batch_ctx_finalize(ctx, valid);
+			total_time_finalize += get_ticks() - t_begin;
+			perf_end(batch_size, "ctx finalize, %zu", batch_size);
+		}
+
+		if (ret){
+			fprintf(stderr, "ERR: Incremental batch verification failed\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	ed25519_batch_ctx_free(ctx);
+
+	total_time_array = total_time_array/((double)(number_of_rounds*test_count*batch_size));
+	total_time_add = total_time_add/((double)(number_of_rounds*test_count*batch_size));
+	total_time_finalize = total_time_finalize/((double)(number_of_rounds*test_count*batch_size));
+	printf("%-10zu | %-14.2f | %-14.2f | %-14.2f | %.4f\n", batch_size, total_time_array, total_time_add, total_time_finalize, total_time_array/(total_time_add + total_time_finalize));
+	return 0;
+}
 
-int main(){
+/*
+ * Stages of batch verification: hashing every H(R_i,A_i,m_i) on the caller
+ * side, ed25519_verify_prehashed_hram_batch on those hashes, and
+ * ed25519_sign_open_batch_hEEA doing both.
+ */
+int test_prehashed_instance(int test_count, size_t batch_size){
+	static ed25519_secret_key sks[max_batch_size];
+	static ed25519_public_key pks[max_batch_size];
+	static ed25519_signature sigs[max_batch_size];
+	static unsigned char messages[max_batch_size][128];
+	static unsigned char hrams[max_batch_size][64];
+	static unsigned char buf[64 + 128];
+	static size_t message_lengths[max_batch_size];
+	static const unsigned char *message_pointers[max_batch_size];
+	static const unsigned char *hram_pointers[max_batch_size];
+	static const unsigned char *pk_pointers[max_batch_size];
+	static const unsigned char *sig_pointers[max_batch_size];
+	static int valid[max_batch_size];
+	double total_time_hash = 0, total_time_group = 0, total_time_full = 0;
+	size_t i, j, k;
+	int ret = 0;
+	uint64_t t_begin;
+
+	for (j = 0; j < test_count; j++){
+		ed25519_randombytes_unsafe(sks, batch_size * sizeof(sks[0]));
+		ed25519_randombytes_unsafe(messages, batch_size * sizeof(messages[0]));
+		for (i = 0; i < batch_size; i++) {
+			ed25519_publickey(sks[i], pks[i]);
+			message_lengths[i] = (i & 127) + 1;
+			ed25519_sign(messages[i], message_lengths[i], sks[i], pks[i], sigs[i]);
+			message_pointers[i] = messages[i];
+			hram_pointers[i] = hrams[i];
+			pk_pointers[i] = pks[i];
+			sig_pointers[i] = sigs[i];
+		}
+
+		perf_begin();
+		t_begin = get_ticks();
+		for(k=0;k<number_of_rounds;k++){
+			for (i = 0; i < batch_size; i++) {
+				memcpy(buf, sigs[i], 32);
+				memcpy(buf + 32, pks[i], 32);
+				memcpy(buf + 64, messages[i], message_lengths[i]);
+				SHA512(buf, 64 + message_lengths[i], hrams[i]);
+			}
+		}
+		total_time_hash += get_ticks() - t_begin;
+		perf_end((uint64_t)number_of_rounds * batch_size, "H(R,A,M), %zu", batch_size);
+
+		perf_begin();
+		t_begin = get_ticks();
+		for(k=0;k<number_of_rounds;k++)
+			ret |= ed25519_verify_prehashed_hram_batch(hram_pointers, pk_pointers, sig_pointers, batch_size, valid);
+		total_time_group += get_ticks() - t_begin;
+		perf_end((uint64_t)number_of_rounds * batch_size, "prehashed batch, %zu", batch_size);
+
+		perf_begin();
+		t_begin = get_ticks();
+		for(k=0;k<number_of_rounds;k++)
+			ret |= ed25519_sign_open_batch_hEEA(message_pointers, message_lengths, pk_pointers, sig_pointers, batch_size, valid);
+		total_time_full += get_ticks() - t_begin;
+		perf_end((uint64_t)number_of_rounds * batch_size, "batch hEEA_q, %zu", batch_size);
+
+		/* a wrong hash must be caught */
+		hrams[j % batch_size][j & 63] ^= 1;
+		if (ret || !ed25519_verify_prehashed_hram_batch(hram_pointers, pk_pointers, sig_pointers, batch_size, valid) || valid[j % batch_size]){
+			fprintf(stderr, "ERR: Prehashed batch verification failed\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	total_time_hash = total_time_hash/((double)(number_of_rounds*test_count*batch_size));
+	total_time_group = total_time_group/((double)(number_of_rounds*test_count*batch_size));
+	total_time_full = total_time_full/((double)(number_of_rounds*test_count*batch_size));
+	printf("%-10zu | %-14.2f | %-14.2f | %-14.2f | %.2f %%\n", batch_size, total_time_hash, total_time_group, total_time_full, total_time_hash/total_time_full * 100);
+	return 0;
+}
+
+/*
+ * Half-aggregation: ticks of ed25519_halfagg_aggregate and ed25519_halfagg_verify
+ * against ed25519_sign_open_batch_hEEA on the original signatures, and a
+ * check that a changed R, s or message is rejected.
+ */
+int test_halfagg_instance(int test_count, size_t batch_size){
+	static ed25519_secret_key sks[max_halfagg_size];
+	static ed25519_public_key pks[max_halfagg_size];
+	static ed25519_signature sigs[max_halfagg_size];
+	static unsigned char messages[max_halfagg_size][128];
+	static unsigned char agg[32 * (max_halfagg_size + 1)];
+	static size_t message_lengths[max_halfagg_size];
+	static const unsigned char *message_pointers[max_halfagg_size];
+	static const unsigned char *pk_pointers[max_halfagg_size];
+	static const unsigned char *sig_pointers[max_halfagg_size];
+	static int valid[max_halfagg_size];
+	double total_time_aggregate = 0, total_time_verify = 0, total_time_batch = 0;
+	size_t i, j, k, agg_size = ed25519_halfagg_size(batch_size);
+	int ret = 0, ret_bad = 1;
+	uint64_t t_begin;
+
+	for (j = 0; j < test_count; j++){
+		ed25519_randombytes_unsafe(sks, batch_size * sizeof(sks[0]));
+		ed25519_randombytes_unsafe(messages, batch_size * sizeof(messages[0]));
+		for (i = 0; i < batch_size; i++) {
+			ed25519_publickey(sks[i], pks[i]);
+			message_lengths[i] = (i & 127) + 1;
+			ed25519_sign(messages[i], message_lengths[i], sks[i], pks[i], sigs[i]);
+			message_pointers[i] = messages[i];
+			pk_pointers[i] = pks[i];
+			sig_pointers[i] = sigs[i];
+		}
+
+		perf_begin();
+		t_begin = get_ticks();
+		for(k=0;k<number_of_rounds;k++)
+			ret |= ed25519_halfagg_aggregate(message_pointers, message_lengths, pk_pointers, sig_pointers, batch_size, agg);
+		total_time_aggregate += get_ticks() - t_begin;
+		perf_end((uint64_t)number_of_rounds * batch_size, "halfagg aggregate, %zu", batch_size);
+
+		perf_begin();
+		t_begin = get_ticks();
+		for(k=0;k<number_of_rounds;k++)
+			ret |= ed25519_halfagg_verify(message_pointers, message_lengths, pk_pointers, agg, batch_size);
+		total_time_verify += get_ticks() - t_begin;
+		perf_end((uint64_t)number_of_rounds * batch_size, "halfagg verify, %zu", batch_size);
+
+		perf_begin();
+		t_begin = get_ticks();
+		for(k=0;k<number_of_rounds;k++)
+			ret |= ed25519_sign_open_batch_hEEA(message_pointers, message_lengths, pk_pointers, sig_pointers, batch_size, valid);
+		total_time_batch += get_ticks() - t_begin;
+		perf_end((uint64_t)number_of_rounds * batch_size, "batch hEEA_q, %zu", batch_size);
+
+		/* a changed R_i, s or message must be rejected */
+		i = j % batch_size;
+		agg[32 * i] ^= 1;
+		ret_bad &= ed25519_halfagg_verify(message_pointers, message_lengths, pk_pointers, agg, batch_size) ? 1 : 0;
+		agg[32 * i] ^= 1;
+		agg[32 * batch_size + (j & 15)] ^= 1;
+		ret_bad &= ed25519_halfagg_verify(message_pointers, message_lengths, pk_pointers, agg, batch_size) ? 1 : 0;
+		agg[32 * batch_size + (j & 15)] ^= 1;
+		messages[i][0] ^= 1;
+		ret_bad &= ed25519_halfagg_verify(message_pointers, message_lengths, pk_pointers, agg, batch_size) ? 1 : 0;
+
+		if (ret || !ret_bad){
+			fprintf(stderr, "ERR: Half-aggregate verification failed\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	total_time_aggregate = total_time_aggregate/((double)(number_of_rounds*test_count*batch_size));
+	total_time_verify = total_time_verify/((double)(number_of_rounds*test_count*batch_size));
+	total_time_batch = total_time_batch/((double)(number_of_rounds*test_count*batch_size));
+	printf("%-10zu | %-13zu | %-14.2f | %-14.2f | %-14.2f | %.4f\n", batch_size, agg_size, total_time_aggregate, total_time_verify, total_time_batch, total_time_batch/total_time_verify);
+	return 0;
+}
+
+/*
+ * Verification rules: ticks of single and batch verification of valid
+ * signatures, then trials that put one signature with a small-order R and A
+ * (and S = 0) into a batch of valid ones, counting how often the batch
+ * verdict on it differs from ed25519_sign_open_hEEA. Under ZIP-215 both must
+ * accept it, and reject the same signature with S = el.
+ */
+int test_rules_instance(int test_count, size_t batch_size, ed25519_verify_rules rules, const char *name){
+	/* points of order 8 */
+	static const unsigned char small_order[2][32] = {
+		{0x26, 0xe8, 0x95, 0x8f, 0xc2, 0xb2, 0x27, 0xb0, 0x45, 0xc3, 0xf4, 0x89, 0xf2, 0xef, 0x98, 0xf0,
+		 0xd5, 0xdf, 0xac, 0x05, 0xd3, 0xc6, 0x33, 0x39, 0xb1, 0x38, 0x02, 0x88, 0x6d, 0x53, 0xfc, 0x05},
+		{0xc7, 0x17, 0x6a, 0x70, 0x3d, 0x4d, 0xd8, 0x4f, 0xba, 0x3c, 0x0b, 0x76, 0x0d, 0x10, 0x67, 0x0f,
+		 0x2a, 0x20, 0x53, 0xfa, 0x2c, 0x39, 0xcc, 0xc6, 0x4e, 0xc7, 0xfd, 0x77, 0x92, 0xac, 0x03, 0x7a}
+	};
+	static const unsigned char el[32] = {
+		0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10
+	};
+	static ed25519_secret_key sks[max_batch_size];
+	static ed25519_public_key pks[max_batch_size];
+	static ed25519_signature sigs[max_batch_size];
+	static unsigned char messages[max_batch_size][128];
+	static size_t message_lengths[max_batch_size];
+	static const unsigned char *message_pointers[max_batch_size];
+	static const unsigned char *pk_pointers[max_batch_size];
+	static const unsigned char *sig_pointers[max_batch_size];
+	static int valid[max_batch_size];
+	double total_time_single = 0, total_time_batch = 0;
+	size_t i, j, k, small = batch_size / 2;
+	int ret = 0, accepted = 0, disagreements = 0, single, batch;
+	uint64_t t_begin;
+
+	ed25519_verify_rules_use(rules);
+	for (j = 0; j < test_count; j++){
+		ed25519_randombytes_unsafe(sks, batch_size * sizeof(sks[0]));
+		ed25519_randombytes_unsafe(messages, batch_size * sizeof(messages[0]));
+		for (i = 0; i < batch_size; i++) {
+			ed25519_publickey(sks[i], pks[i]);
+			message_lengths[i] = (i & 127) + 1;
+			ed25519_sign(messages[i], message_lengths[i], sks[i], pks[i], sigs[i]);
+			message_pointers[i] = messages[i];
+			pk_pointers[i] = pks[i];
+			sig_pointers[i] = sigs[i];
+		}
+
+		perf_begin();
+		t_begin = get_ticks();
+		for(k=0;k<number_of_rounds;k++)
+			for (i = 0; i < batch_size; i++)
+				ret |= ed25519_sign_open_hEEA(messages[i], message_lengths[i], pks[i], sigs[i]);
+		total_time_single += get_ticks() - t_begin;
+		perf_end((uint64_t)number_of_rounds * batch_size, "single hEEA_q, %s, %zu", name, batch_size);
+
+		perf_begin();
+		t_begin = get_ticks();
+		for(k=0;k<number_of_rounds;k++)
+			ret |= ed25519_sign_open_batch_hEEA(message_pointers, message_lengths, pk_pointers, sig_pointers, batch_size, valid);
+		total_time_batch += get_ticks() - t_begin;
+		perf_end((uint64_t)number_of_rounds * batch_size, "batch hEEA_q, %s, %zu", name, batch_size);
+
+		/* one signature with R and A of order 8 and S = 0, for every message */
+		memcpy(sigs[small], small_order[0], 32);
+		memset(sigs[small] + 32, 0, 32);
+		memcpy(pks[small], small_order[1], 32);
+		for (k = 0; k < 16; k++) {
+			messages[small][0] = (unsigned char)k;
+			single = ed25519_sign_open_hEEA(messages[small], message_lengths[small], pks[small], sigs[small]) ? 0 : 1;
+			batch = ed25519_sign_open_batch_hEEA(message_pointers, message_lengths, pk_pointers, sig_pointers, batch_size, valid);
+			accepted += single;
+			disagreements += (single != valid[small]);
+			if (rules == ED25519_VERIFY_ZIP215 && (!single || batch))
+				ret |= 4;
+		}
+
+		/* S = el passes the 2^253 bound, but not the ZIP-215 one */
+		memcpy(sigs[small] + 32, el, 32);
+		single = ed25519_sign_open_hEEA(messages[small], message_lengths[small], pks[small], sigs[small]) ? 0 : 1;
+		ed25519_sign_open_batch_hEEA(message_pointers, message_lengths, pk_pointers, sig_pointers, batch_size, valid);
+		if (rules == ED25519_VERIFY_ZIP215 && (single || valid[small]))
+			ret |= 8;
+
+		if (ret){
+			fprintf(stderr, "ERR: Verification under the %s rules failed (%d)\n", name, ret);
+			exit(EXIT_FAILURE);
+		}
+	}
+	ed25519_verify_rules_use(ED25519_VERIFY_COFACTORLESS);
+
+	total_time_single = total_time_single/((double)(number_of_rounds*test_count*batch_size));
+	total_time_batch = total_time_batch/((double)(number_of_rounds*test_count*batch_size));
+	printf("%-12s | %-10zu | %-14.2f | %-14.2f | %4d / %-7d | %d\n", name, batch_size, total_time_single, total_time_batch, accepted, 16 * test_count, disagreements);
+	return 0;
+}
+
+/*
+ * Pre-filter: batches of batch_size where every signature past the first
+ * (100 - junk_percent)% is replaced by junk that breaks one rule (S = el, a
+ * non-canonical y for R or A, or R or A of order 8), verified without and
+ * with ed25519_prefilter_use(ED25519_PREFILTER_ALL). Both must give the
+ * same verdicts; the counters show how often each rule fired.
+ */
+int test_prefilter_instance(int test_count, size_t batch_size, size_t junk_percent){
+	static const unsigned char el[32] = {
+		0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10
+	};
+	static const unsigned char order8[32] = {
+		0x26, 0xe8, 0x95, 0x8f, 0xc2, 0xb2, 0x27, 0xb0, 0x45, 0xc3, 0xf4, 0x89, 0xf2, 0xef, 0x98, 0xf0,
+		0xd5, 0xdf, 0xac, 0x05, 0xd3, 0xc6, 0x33, 0x39, 0xb1, 0x38, 0x02, 0x88, 0x6d, 0x53, 0xfc, 0x05
+	};
+	static unsigned char p_plus_3[32];
+	static ed25519_secret_key sks[max_batch_size];
+	static ed25519_public_key pks[max_batch_size];
+	static ed25519_signature sigs[max_batch_size];
+	static unsigned char messages[max_batch_size][128];
+	static size_t message_lengths[max_batch_size];
+	static const unsigned char *message_pointers[max_batch_size];
+	static const unsigned char *pk_pointers[max_batch_size];
+	static const unsigned char *sig_pointers[max_batch_size];
+	static int valid[max_batch_size], valid_filtered[max_batch_size];
+	uint64_t counts[ED25519_PREFILTER_RULES];
+	double total_time_off = 0, total_time_on = 0;
+	size_t i, j, k, good = batch_size - batch_size * junk_percent / 100;
+	uint64_t t_begin;
+
+	memset(p_plus_3, 0xff, 32);
+	p_plus_3[0] = 0xf0;
+	p_plus_3[31] = 0x7f;
+	ed25519_prefilter_counters(counts, 1);
+
+	for (j = 0; j < test_count; j++){
+		ed25519_randombytes_unsafe(sks, batch_size * sizeof(sks[0]));
+		ed25519_randombytes_unsafe(messages, batch_size * sizeof(messages[0]));
+		for (i = 0; i < batch_size; i++) {
+			ed25519_publickey(sks[i], pks[i]);
+			message_lengths[i] = (i & 127) + 1;
+			ed25519_sign(messages[i], message_lengths[i], sks[i], pks[i], sigs[i]);
+			message_pointers[i] = messages[i];
+			pk_pointers[i] = pks[i];
+			sig_pointers[i] = sigs[i];
+			if (i < good)
+				continue;
+			switch (i % 5) {
+				case 0: memcpy(sigs[i] + 32, el, 32); break;
+				case 1: memcpy(sigs[i], p_plus_3, 32); break;
+				case 2: memcpy(pks[i], p_plus_3, 32); break;
+				case 3: memcpy(sigs[i], order8, 32); break;
+				case 4: memcpy(pks[i], order8, 32); break;
+			}
+		}
+
+		ed25519_prefilter_use(0);
+		perf_begin();
+		t_begin = get_ticks();
+		for(k=0;k<number_of_rounds;k++)
+			ed25519_sign_open_batch_hEEA(message_pointers, message_lengths, pk_pointers, sig_pointers, batch_size, valid);
+		total_time_off += get_ticks() - t_begin;
+		perf_end((uint64_t)number_of_rounds * batch_size, "batch hEEA_q, %zu%% junk, no filter", junk_percent);
+
+		ed25519_prefilter_use(ED25519_PREFILTER_ALL);
+		perf_begin();
+		t_begin = get_ticks();
+		for(k=0;k<number_of_rounds;k++)
+			ed25519_sign_open_batch_hEEA(message_pointers, message_lengths, pk_pointers, sig_pointers, batch_size, valid_filtered);
+		total_time_on += get_ticks() - t_begin;
+		perf_end((uint64_t)number_of_rounds * batch_size, "batch hEEA_q, %zu%% junk, filter", junk_percent);
+		ed25519_prefilter_use(0);
+
+		for (i = 0; i < batch_size; i++) {
+			if (valid[i] != valid_filtered[i] || valid[i] != (i < good)){
+				fprintf(stderr, "ERR: Pre-filtered batch verification failed on signature %zu\n", i);
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+	ed25519_prefilter_counters(counts, 1);
+
+	total_time_off = total_time_off/((double)(number_of_rounds*test_count*batch_size));
+	total_time_on = total_time_on/((double)(number_of_rounds*test_count*batch_size));
+	printf("%-10zu | %3zu %%  | %-14.2f | %-14.2f | %-8.2f |", batch_size, junk_percent, total_time_off, total_time_on, total_time_off/total_time_on);
+	for (i = 0; i < ED25519_PREFILTER_RULES; i++)
+		printf(" %" PRIu64, counts[i]);
+	printf("\n");
+	return 0;
+}
+
+void calibrate(){
+	ed25519_batch_config config;
+
+	ed25519_batch_calibrate(get_ticks, &config);
+
+	printf("/*\n\tBatch verification profile, generated by `make calibrate`\n*/\n\n");
+	printf("#define ED25519_BATCH_CHUNK_SIZE %zu\n", config.chunk_size);
+	printf("#define ED25519_BATCH_MIN_SIZE %zu\n", config.min_batch_size);
+	printf("#define ED25519_BATCH_HALF_SIZE %s\n", (config.half_size == ED25519_BATCH_HGCD) ? "ED25519_BATCH_HGCD" : "ED25519_BATCH_HEEA");
+}
+
+int main(int argc, char **argv){
+	ed25519_batch_config config;
+
+	if (argc > 1 && !strcmp(argv[1], "--calibrate")) {
+		calibrate();
+		return 0;
+	}
+
+	perf_open();
 	printf("Benchmark of batch verification:\n");
 	printf("Number of samples = %i \n", number_of_samples);
 	printf("Number of rounds = %i \n", number_of_rounds);
+	ed25519_batch_config_get(&config);
+	printf("Batch profile: chunks of %zu, batches from %zu, %s for ed25519_sign_open_batch_auto\n", config.chunk_size, config.min_batch_size,
+		(config.half_size == ED25519_BATCH_HGCD) ? "hgcd" : "hEEA");
 	
 	printf("───────────────────────────────────────Average Time (ticks/verification)──────────────────────────────────────────────\n");
 	printf("──────────────────────────────────────────────────────────────────────────────────────────────────────────────────────\n");
+#if !defined(ED25519_NO_HGCD)
 	printf("Batch size | Old approach | New using hEEA | Speed up | Improvement || New using GMP_hgcd | Speed up     | Improvement\n");
+#else
+	printf("Batch size | Old approach | New using hEEA | Speed up | Improvement\n");
+#endif
 	printf("──────────────────────────────────────────────────────────────────────────────────────────────────────────────────────\n");
-	for(int batch_size=4;batch_size<=max_batch_size;batch_size++)
+	for(int batch_size=2;batch_size<=max_batch_size;batch_size++)
 		test_batch_instance(number_of_samples, batch_size);
 	
 	printf("──────────────────────────────────────────────────────────────────────────────────────────────────────────────────────\n");
 
+	printf("\nJoint verification against single verification, with invalid batches (%i samples, ticks/verification):\n", number_of_samples);
+	printf("──────────────────────────────────────────────────────────────────────\n");
+	printf("Batch size | Single         | Joint          | Speed up\n");
+	printf("──────────────────────────────────────────────────────────────────────\n");
+	for(size_t batch_size=2;batch_size<=3;batch_size++)
+		test_joint_instance(number_of_samples, batch_size);
+	printf("──────────────────────────────────────────────────────────────────────\n");
+
+	printf("\nBlinding randomness, median ticks per 64 bytes: RAND_bytes %" PRIu64 ", ed25519_randombytes_unsafe %" PRIu64 ", ChaCha20 DRBG %" PRIu64 "\n",
+		bench_rng(openssl_rand_bytes), bench_rng(ed25519_randombytes_unsafe), bench_rng(ed25519_randombytes_drbg));
+	printf("Batch verification with each source of U (%i samples, ticks/verification):\n", number_of_workspace_samples);
+	printf("──────────────────────────────────────────────────────────────────────\n");
+	printf("Batch size | randombytes    | ChaCha20 DRBG  | Transcript     | Speed up\n");
+	printf("──────────────────────────────────────────────────────────────────────\n");
+	for(size_t batch_size=4;batch_size<=max_batch_size;batch_size*=4)
+		test_rng_instance(number_of_workspace_samples, batch_size);
+	printf("──────────────────────────────────────────────────────────────────────\n");
+
+	printf("\nIncremental verification with ed25519_batch_ctx (%i samples, ticks/verification):\n", number_of_workspace_samples);
+	printf("──────────────────────────────────────────────────────────────────────\n");
+	printf("Batch size | Arrays         | add            | finalize       | Speed up\n");
+	printf("──────────────────────────────────────────────────────────────────────\n");
+	for(size_t batch_size=4;batch_size<=max_batch_size;batch_size*=4)
+		test_ctx_instance(number_of_workspace_samples, batch_size);
+	printf("──────────────────────────────────────────────────────────────────────\n");
+
+	printf("\nStages of batch verification (%i samples, ticks/verification):\n", number_of_workspace_samples);
+	printf("──────────────────────────────────────────────────────────────────────\n");
+	printf("Batch size | H(R,A,M)       | Prehashed      | Full           | Hash share\n");
+	printf("──────────────────────────────────────────────────────────────────────\n");
+	for(size_t batch_size=4;batch_size<=max_batch_size;batch_size*=4)
+		test_prehashed_instance(number_of_workspace_samples, batch_size);
+	printf("──────────────────────────────────────────────────────────────────────\n");
+
+	printf("\nHalf-aggregated signatures against batch verification of the originals (%i samples, ticks/verification):\n", number_of_workspace_samples);
+	printf("──────────────────────────────────────────────────────────────────────────────────────\n");
+	printf("Batch size | Aggregate (B) | Aggregate      | Verify         | Batch          | Speed up\n");
+	printf("──────────────────────────────────────────────────────────────────────────────────────\n");
+	for(size_t batch_size=1;batch_size<=max_halfagg_size;batch_size*=4)
+		test_halfagg_instance(number_of_workspace_samples, batch_size);
+	printf("──────────────────────────────────────────────────────────────────────────────────────\n");
+
+	printf("\nVerification rules (%i samples, ticks/verification; a small-order signature in each batch, 16 messages per sample):\n", number_of_workspace_samples);
+	printf("──────────────────────────────────────────────────────────────────────────────────────\n");
+	printf("Rules        | Batch size | Single         | Batch          | Accepted      | Batch != single\n");
+	printf("──────────────────────────────────────────────────────────────────────────────────────\n");
+	for(size_t batch_size=4;batch_size<=max_batch_size;batch_size*=4){
+		test_rules_instance(number_of_workspace_samples, batch_size, ED25519_VERIFY_COFACTORLESS, "cofactorless");
+		test_rules_instance(number_of_workspace_samples, batch_size, ED25519_VERIFY_ZIP215, "ZIP-215");
+	}
+	printf("──────────────────────────────────────────────────────────────────────────────────────\n");
+
+	printf("\nPre-filter on batches with junk signatures (%i samples, ticks/verification; rules hit: S, R y, A y, R small, A small):\n", number_of_workspace_samples);
+	printf("──────────────────────────────────────────────────────────────────────────────────────\n");
+	printf("Batch size | Junk   | No filter      | Filter         | Speed up | Rules hit\n");
+	printf("──────────────────────────────────────────────────────────────────────────────────────\n");
+	for(size_t junk_percent=0;junk_percent<=100;junk_percent+=25)
+		test_prefilter_instance(number_of_workspace_samples, 64, junk_percent);
+	printf("──────────────────────────────────────────────────────────────────────────────────────\n");
+
+	printf("\nBatches above %i signatures (%i samples, ticks/verification):\n", max_batch_size, number_of_workspace_samples);
+	printf("──────────────────────────────────────────────────────────────────────\n");
+	printf("Batch size | Workspace (B) | %i-chunks     | One workspace  | Speed up\n", max_batch_size);
+	printf("──────────────────────────────────────────────────────────────────────\n");
+	for(size_t batch_size=2*max_batch_size;batch_size<=max_workspace_size;batch_size*=2)
+		test_workspace_instance(number_of_workspace_samples, batch_size);
+	printf("──────────────────────────────────────────────────────────────────────\n");
+
+	perf_report();
 	printf("Done!\n");	
 }
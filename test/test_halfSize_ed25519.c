@@ -2,8 +2,9 @@
 #include <gmp.h>
 #include <time.h>
 #include <openssl/rand.h>
-#include "test-ticks.h"
+#include "test-bench.h"
 #include "../src/half_size/curve25519/curve25519_hEEA_vartime.h"
+#include "../src/half_size/curve25519/curve25519_hEEA_lehmer_vartime.h"
 #include "../src/half_size/curve25519/curve25519_hEEA_div_vartime.h"
 #include "../src/half_size/curve25519/curve25519_hgcd_vartime.h"
 #include "../src/half_size/curve25519/curve25519_reduce_basis_vartime.h"
@@ -13,11 +14,6 @@
 #define number_of_rounds 10
 
 
-struct benchmark_result{
-	uint64_t best;
-	uint64_t median;
-	double average;
-};
 
 /* u64 to mpz */
 void u64_2_mpz(mpz_t out, const uint64_t* in, size_t l) 
@@ -110,19 +106,58 @@ int check_correctness(uint64_t *c0, uint64_t *c1, const mpz_t b_mpz, const mpz_t
 
 }
 
-static int cmp_int64(const void *v1, const void *v2)
-{
-	int64_t x1, x2;
-
-	x1 = *(const int64_t *)v1;
-	x2 = *(const int64_t *)v2;
-	if (x1 < x2) {
-		return -1;
-	} else if (x1 == x2) {
-		return 0;
-	} else {
-		return 1;
+/*
+ * curve25519_hEEA_target_vartime on asymmetric splits: the result must be
+ * right, |c0| < 2^bl_c0, and |c1| < 2^bl_c1 unless it reports a miss
+ */
+int test_target_instance(size_t test_count){
+	static const unsigned splits[][2] = {{120, 133}, {133, 120}, {127, 126}, {100, 153}, {150, 103}};
+	gmp_randstate_t state;
+	mpz_t L, b_mpz, c_mpz;
+	uint64_t b[4], c0[4], c1[4];
+	size_t i, j, misses;
+	int ret;
+
+	gmp_randinit_mt(state);
+	gmp_randseed_ui(state, time(NULL));
+	mpz_inits(L, b_mpz, c_mpz, NULL);
+	mpz_set_str(L, "7237005577332262213973186563042994240857116359379907606001950938285454250989", 10);
+
+	printf("───────────────────────────────────────\n");
+	printf("hEEA_target | bl_c0 | bl_c1 | Misses\n");
+	printf("───────────────────────────────────────\n");
+	for (i = 0; i < sizeof(splits) / sizeof(splits[0]); i++) {
+		misses = 0;
+		for (j = 0; j < test_count; j++) {
+			rand_mpz(b_mpz, state, L);
+			mpz_2_u64(b, b_mpz, 4);
+			c0[0] = c0[1] = c0[2] = c0[3] = 0ul;
+			c1[0] = c1[1] = c1[2] = c1[3] = 0ul;
+			ret = curve25519_hEEA_target_vartime(c0, c1, b, splits[i][0], splits[i][1]);
+			/* check_correctness leaves |c0| and |c1| in c0 and c1 */
+			if (!check_correctness(c0, c1, b_mpz, L, 3, 3)){
+				fprintf(stderr, "ERR: wrong reduction result using `curve25519_hEEA_target_vartime`\n");
+				exit(EXIT_FAILURE);
+			}
+			u64_2_mpz(c_mpz, c0, 3);
+			if (mpz_sizeinbase(c_mpz, 2) > splits[i][0]){
+				fprintf(stderr, "ERR: |c0| above 2^%u using `curve25519_hEEA_target_vartime`\n", splits[i][0]);
+				exit(EXIT_FAILURE);
+			}
+			u64_2_mpz(c_mpz, c1, 3);
+			if ((mpz_sizeinbase(c_mpz, 2) > splits[i][1]) != (ret != 0)){
+				fprintf(stderr, "ERR: wrong miss report for |c1| < 2^%u using `curve25519_hEEA_target_vartime`\n", splits[i][1]);
+				exit(EXIT_FAILURE);
+			}
+			misses += (ret != 0);
+		}
+		printf("            | %-5u | %-5u | %zu / %zu\n", splits[i][0], splits[i][1], misses, test_count);
 	}
+	printf("───────────────────────────────────────\n");
+
+	mpz_clears(L, b_mpz, c_mpz, NULL);
+	gmp_randclear(state);
+	return 0;
 }
 
 int test_instance(size_t test_count){
@@ -142,11 +177,10 @@ int test_instance(size_t test_count){
 	uint64_t b[test_count][4], c0[4], c1[4];
 	int c0_size, c1_size;
 
-	uint64_t t_begin;
 	uint64_t t[test_count];
-	uint64_t total_t = 0;
 	struct benchmark_result benchmark_reduce_basis; 
 	struct benchmark_result benchmark_hEEA; 
+	struct benchmark_result benchmark_hEEA_lehmer; 
 	struct benchmark_result benchmark_hEEA_div; 
 	struct benchmark_result benchmark_gmp_hgcd; 
 	struct benchmark_result benchmark_gmp_hgcd1; 
@@ -160,193 +194,127 @@ int test_instance(size_t test_count){
 	}
 
 	/* Test hgcd2 */
-	total_t = 0;
 	for(size_t j=0; j<test_count; j++)
 	{
 		c0[0] = c0[1] = c0[2] = c0[3] = 0ul;
 		c1[0] = c1[1] = c1[2] = c1[3] = 0ul;
     	
-		t_begin = get_ticks();
-		for(int i=0; i<number_of_rounds;i++)
-    		curve25519_hgcd_vartime_enhance2(c0, c1, b[j], &c0_size, &c1_size);
-
-		t[j] = get_ticks() - t_begin;
-		total_t += t[j]; 
+		BENCH_TICKS(t[j], number_of_rounds, number_of_rounds, "hgcd_enhance2", curve25519_hgcd_vartime_enhance2(c0, c1, b[j], &c0_size, &c1_size));
 		u64_2_mpz(b_mpz, b[j], 4);
 		if (!check_correctness(c0, c1, b_mpz, L, c0_size, c1_size)){
 			fprintf(stderr, "ERR: wrong reduction result using `curve25519_hgcd_vartime_enhance2`\n");
 			exit(EXIT_FAILURE);
 		}
 	}
-	qsort(t, test_count, sizeof(uint64_t), cmp_int64);
-	benchmark_gmp_hgcd2.best =  t[0]/number_of_rounds;
-	benchmark_gmp_hgcd2.median = t[test_count/2]/number_of_rounds;
-	benchmark_gmp_hgcd2.average =  total_t/(number_of_rounds*(double)test_count);
+	benchmark_gmp_hgcd2 = benchmark_summary(t, test_count, number_of_rounds);
 
 	/* Test reduce_basis */
-	total_t = 0;
 	for(size_t j=0; j<test_count; j++)
 	{
 		c0[0] = c0[1] = c0[2] = c0[3] = 0ul;
 		c1[0] = c1[1] = c1[2] = c1[3] = 0ul;
     	
-		t_begin = get_ticks();
-		for(int i=0; i<number_of_rounds;i++)
-    		curve25519_reduce_basis_vartime(c0, c1, b[j]);
-
-		t[j] = get_ticks() - t_begin;
-		total_t += t[j]; 
+		BENCH_TICKS(t[j], number_of_rounds, number_of_rounds, "reduce_basis", curve25519_reduce_basis_vartime(c0, c1, b[j]));
 		u64_2_mpz(b_mpz, b[j], 4);
 		if (!check_correctness(c0, c1, b_mpz, L, 2, 2)){
 			fprintf(stderr, "ERR: wrong reduction result using `curve25519_reduce_basis_vartime`\n");
 			exit(EXIT_FAILURE);
 		}
 	}
-	qsort(t, test_count, sizeof(uint64_t), cmp_int64);
-	benchmark_reduce_basis.best =  t[0]/number_of_rounds;
-	benchmark_reduce_basis.median = t[test_count/2]/number_of_rounds;
-	benchmark_reduce_basis.average =  total_t/(number_of_rounds*(double)test_count);
+	benchmark_reduce_basis = benchmark_summary(t, test_count, number_of_rounds);
 
 
 	/* Test hgcd1 */
-	total_t = 0;
 	for(size_t j=0; j<test_count; j++)
 	{
 		c0[0] = c0[1] = c0[2] = c0[3] = 0ul;
 		c1[0] = c1[1] = c1[2] = c1[3] = 0ul;
     	
-		t_begin = get_ticks();
-		for(int i=0; i<number_of_rounds;i++)
-    		curve25519_hgcd_vartime_enhance1(c0, c1, b[j], &c0_size, &c1_size);
-
-		t[j] = get_ticks() - t_begin;
-		total_t += t[j]; 
+		BENCH_TICKS(t[j], number_of_rounds, number_of_rounds, "hgcd_enhance1", curve25519_hgcd_vartime_enhance1(c0, c1, b[j], &c0_size, &c1_size));
 		u64_2_mpz(b_mpz, b[j], 4);
 		if (!check_correctness(c0, c1, b_mpz, L, c0_size, c1_size)){
 			fprintf(stderr, "ERR: wrong reduction result using `curve25519_hgcd_vartime_enhance1`\n");
 			exit(EXIT_FAILURE);
 		}
 	}
-	qsort(t, test_count, sizeof(uint64_t), cmp_int64);
-	benchmark_gmp_hgcd1.best =  t[0]/number_of_rounds;
-	benchmark_gmp_hgcd1.median = t[test_count/2]/number_of_rounds;
-	benchmark_gmp_hgcd1.average =  total_t/(number_of_rounds*(double)test_count);
+	benchmark_gmp_hgcd1 = benchmark_summary(t, test_count, number_of_rounds);
 
 	/* Test hEEA */
-	total_t = 0;
 	for(size_t j=0; j<test_count; j++)
 	{
 		c0[0] = c0[1] = c0[2] = c0[3] = 0ul;
 		c1[0] = c1[1] = c1[2] = c1[3] = 0ul;
     	
-		t_begin = get_ticks();
-		for(int i=0; i<number_of_rounds;i++)
-    		curve25519_hEEA_vartime(c0, c1, b[j]);
-
-		t[j] = get_ticks() - t_begin;
-		total_t += t[j]; 
+		BENCH_TICKS(t[j], number_of_rounds, number_of_rounds, "hEEA_q", curve25519_hEEA_vartime(c0, c1, b[j]));
 		u64_2_mpz(b_mpz, b[j], 4);
 		if (!check_correctness(c0, c1, b_mpz, L, 2, 2)){
 			fprintf(stderr, "ERR: wrong reduction result using `curve25519_hEEA_vartime`\n");
 			exit(EXIT_FAILURE);
 		}
 	}
-	qsort(t, test_count, sizeof(uint64_t), cmp_int64);
-	benchmark_hEEA.best =  t[0]/number_of_rounds;
-	benchmark_hEEA.median = t[test_count/2]/number_of_rounds;
-	benchmark_hEEA.average =  total_t/(number_of_rounds*(double)test_count);
+	benchmark_hEEA = benchmark_summary(t, test_count, number_of_rounds);
 
 	
-	/* Test hEEA_div */
-	total_t = 0;
+	/* Test hEEA_lehmer */
 	for(size_t j=0; j<test_count; j++)
 	{
 		c0[0] = c0[1] = c0[2] = c0[3] = 0ul;
 		c1[0] = c1[1] = c1[2] = c1[3] = 0ul;
     	
-		t_begin = get_ticks();
-		for(int i=0; i<number_of_rounds;i++)
-    		curve25519_hEEA_div_vartime(c0, c1, b[j]);
+		BENCH_TICKS(t[j], number_of_rounds, number_of_rounds, "hEEA_lehmer", curve25519_hEEA_lehmer_vartime(c0, c1, b[j]));
+		u64_2_mpz(b_mpz, b[j], 4);
+		if (!check_correctness(c0, c1, b_mpz, L, 2, 2)){
+			fprintf(stderr, "ERR: wrong reduction result using `curve25519_hEEA_lehmer_vartime`\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	benchmark_hEEA_lehmer = benchmark_summary(t, test_count, number_of_rounds);
 
-		t[j] = get_ticks() - t_begin;
-		total_t += t[j]; 
+	
+	/* Test hEEA_div */
+	for(size_t j=0; j<test_count; j++)
+	{
+		c0[0] = c0[1] = c0[2] = c0[3] = 0ul;
+		c1[0] = c1[1] = c1[2] = c1[3] = 0ul;
+    	
+		BENCH_TICKS(t[j], number_of_rounds, number_of_rounds, "hEEA_div", curve25519_hEEA_div_vartime(c0, c1, b[j]));
 		u64_2_mpz(b_mpz, b[j], 4);
 		if (!check_correctness(c0, c1, b_mpz, L, 2, 2)){
 			fprintf(stderr, "ERR: wrong reduction result using `curve25519_hEEA_div_vartime`\n");
 			exit(EXIT_FAILURE);
 		}
 	}
-	qsort(t, test_count, sizeof(uint64_t), cmp_int64);
-	benchmark_hEEA_div.best =  t[0]/number_of_rounds;
-	benchmark_hEEA_div.median = t[test_count/2]/number_of_rounds;
-	benchmark_hEEA_div.average =  total_t/(number_of_rounds*(double)test_count);
+	benchmark_hEEA_div = benchmark_summary(t, test_count, number_of_rounds);
 
 
 	/* Test hgcd */
-	total_t = 0;
 	for(size_t j=0; j<test_count; j++)
 	{
 		c0[0] = c0[1] = c0[2] = c0[3] = 0ul;
 		c1[0] = c1[1] = c1[2] = c1[3] = 0ul;
     	
-		t_begin = get_ticks();
-		for(int i=0; i<number_of_rounds;i++)
-    	curve25519_hgcd_vartime(c0, c1, b[j], &c0_size, &c1_size);
-
-		t[j] = get_ticks() - t_begin;
-		total_t += t[j]; 
+		BENCH_TICKS(t[j], number_of_rounds, number_of_rounds, "hgcd", curve25519_hgcd_vartime(c0, c1, b[j], &c0_size, &c1_size));
 		u64_2_mpz(b_mpz, b[j], 4);
 		if (!check_correctness(c0, c1, b_mpz, L, c0_size, c1_size)){
 			fprintf(stderr, "ERR: wrong reduction result using `curve25519_hgcd_vartime`\n");
 			exit(EXIT_FAILURE);
 		}
 	}
-	qsort(t, test_count, sizeof(uint64_t), cmp_int64);
-	benchmark_gmp_hgcd.best =  t[0]/number_of_rounds;
-	benchmark_gmp_hgcd.median = t[test_count/2]/number_of_rounds;
-	benchmark_gmp_hgcd.average =  total_t/(number_of_rounds*(double)test_count);
-
-
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Time (ticks)|   hEEA_div   |    hEEA_q    | Speed up     | Improvement\n");
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Best        | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_hEEA_div.best, benchmark_hEEA.best, (double)benchmark_hEEA_div.best/(double)benchmark_hEEA.best,((double)benchmark_hEEA_div.best - (double)benchmark_hEEA.best)/((double)benchmark_hEEA_div.best) * 100);
-	printf("Median      | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_hEEA_div.median, benchmark_hEEA.median, (double)benchmark_hEEA_div.median/(double)benchmark_hEEA.median,((double)benchmark_hEEA_div.median - (double)benchmark_hEEA.median)/((double)benchmark_hEEA_div.median) * 100);
-	printf("Average     | %-12.2f | %-12.2f | %-12.4f | %.2f %%\n", benchmark_hEEA_div.average, benchmark_hEEA.average, (double)benchmark_hEEA_div.average/(double)benchmark_hEEA.average,((double)benchmark_hEEA_div.average - (double)benchmark_hEEA.average)/((double)benchmark_hEEA_div.average) * 100);
-	printf("───────────────────────────────────────────────────────────────────────\n");
-
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Time (ticks)| reduce_basis |    hEEA_q    | Speed up     | Improvement\n");
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Best        | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_reduce_basis.best, benchmark_hEEA.best, (double)benchmark_reduce_basis.best/(double)benchmark_hEEA.best,((double)benchmark_reduce_basis.best - (double)benchmark_hEEA.best)/((double)benchmark_reduce_basis.best) * 100);
-	printf("Median      | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_reduce_basis.median, benchmark_hEEA.median, (double)benchmark_reduce_basis.median/(double)benchmark_hEEA.median,((double)benchmark_reduce_basis.median - (double)benchmark_hEEA.median)/((double)benchmark_reduce_basis.median) * 100);
-	printf("Average     | %-12.2f | %-12.2f | %-12.4f | %.2f %%\n", benchmark_reduce_basis.average, benchmark_hEEA.average, (double)benchmark_reduce_basis.average/(double)benchmark_hEEA.average,((double)benchmark_reduce_basis.average - (double)benchmark_hEEA.average)/((double)benchmark_reduce_basis.average) * 100);
-	printf("───────────────────────────────────────────────────────────────────────\n");
-
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Time (ticks)|   GMP_hgcd   |    hEEA_q    | Speed up     | Improvement\n");
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Best        | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_gmp_hgcd.best, benchmark_hEEA.best, (double)benchmark_gmp_hgcd.best/(double)benchmark_hEEA.best,((double)benchmark_gmp_hgcd.best - (double)benchmark_hEEA.best)/((double)benchmark_gmp_hgcd.best) * 100);
-	printf("Median      | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_gmp_hgcd.median, benchmark_hEEA.median, (double)benchmark_gmp_hgcd.median/(double)benchmark_hEEA.median,((double)benchmark_gmp_hgcd.median - (double)benchmark_hEEA.median)/((double)benchmark_gmp_hgcd.median) * 100);
-	printf("Average     | %-12.2f | %-12.2f | %-12.4f | %.2f %%\n", benchmark_gmp_hgcd.average, benchmark_hEEA.average, (double)benchmark_gmp_hgcd.average/(double)benchmark_hEEA.average,((double)benchmark_gmp_hgcd.average - (double)benchmark_hEEA.average)/((double)benchmark_gmp_hgcd.average) * 100);
-	printf("───────────────────────────────────────────────────────────────────────\n");
-
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Time (ticks)|  GMP_hgcd1   |    hEEA_q    | Speed up     | Improvement\n");
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Best        | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_gmp_hgcd1.best, benchmark_hEEA.best, (double)benchmark_gmp_hgcd1.best/(double)benchmark_hEEA.best,((double)benchmark_gmp_hgcd1.best - (double)benchmark_hEEA.best)/((double)benchmark_gmp_hgcd1.best) * 100);
-	printf("Median      | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_gmp_hgcd1.median, benchmark_hEEA.median, (double)benchmark_gmp_hgcd1.median/(double)benchmark_hEEA.median,((double)benchmark_gmp_hgcd1.median - (double)benchmark_hEEA.median)/((double)benchmark_gmp_hgcd1.median) * 100);
-	printf("Average     | %-12.2f | %-12.2f | %-12.4f | %.2f %%\n", benchmark_gmp_hgcd1.average, benchmark_hEEA.average, (double)benchmark_gmp_hgcd1.average/(double)benchmark_hEEA.average,((double)benchmark_gmp_hgcd1.average - (double)benchmark_hEEA.average)/((double)benchmark_gmp_hgcd1.average) * 100);
-	printf("───────────────────────────────────────────────────────────────────────\n");
-
-
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Time (ticks)|  GMP_hgcd2   |    hEEA_q    | Speed up     | Improvement\n");
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Best        | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_gmp_hgcd2.best, benchmark_hEEA.best, (double)benchmark_gmp_hgcd2.best/(double)benchmark_hEEA.best,((double)benchmark_gmp_hgcd2.best - (double)benchmark_hEEA.best)/((double)benchmark_gmp_hgcd2.best) * 100);
-	printf("Median      | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_gmp_hgcd2.median, benchmark_hEEA.median, (double)benchmark_gmp_hgcd2.median/(double)benchmark_hEEA.median,((double)benchmark_gmp_hgcd2.median - (double)benchmark_hEEA.median)/((double)benchmark_gmp_hgcd2.median) * 100);
-	printf("Average     | %-12.2f | %-12.2f | %-12.4f | %.2f %%\n", benchmark_gmp_hgcd2.average, benchmark_hEEA.average, (double)benchmark_gmp_hgcd2.average/(double)benchmark_hEEA.average,((double)benchmark_gmp_hgcd2.average - (double)benchmark_hEEA.average)/((double)benchmark_gmp_hgcd2.average) * 100);
-	printf("───────────────────────────────────────────────────────────────────────\n");
+	benchmark_gmp_hgcd = benchmark_summary(t, test_count, number_of_rounds);
+
+
+	print_comparison("hEEA_div", "hEEA_q", benchmark_hEEA_div, benchmark_hEEA);
+
+	print_comparison("reduce_basis", "hEEA_q", benchmark_reduce_basis, benchmark_hEEA);
+
+	print_comparison("GMP_hgcd", "hEEA_q", benchmark_gmp_hgcd, benchmark_hEEA);
+
+	print_comparison("GMP_hgcd1", "hEEA_q", benchmark_gmp_hgcd1, benchmark_hEEA);
+
+
+	print_comparison("GMP_hgcd2", "hEEA_q", benchmark_gmp_hgcd2, benchmark_hEEA);
+
+	print_comparison("hEEA_q", "hEEA_lehmer", benchmark_hEEA, benchmark_hEEA_lehmer);
 		
     return 0;
 }
@@ -354,10 +322,13 @@ int test_instance(size_t test_count){
 
 int main(){
 	
+	perf_open();
 	printf("Benchmark of half-size-scalars for Ed25519:\n");
 	printf("Number of samples = %i \n", number_of_samples);
 	printf("Number of rounds = %i \n", number_of_rounds);
 	test_instance(number_of_samples);
+	test_target_instance(number_of_samples);
+	perf_report();
 	printf("Done!\n");
 		
 }
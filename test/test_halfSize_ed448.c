@@ -2,7 +2,7 @@
 #include <gmp.h>
 #include <time.h>
 #include <openssl/rand.h>
-#include "test-ticks.h"
+#include "test-bench.h"
 #include "../src/half_size/curve448/curve448_hEEA_vartime.h"
 #include "../src/half_size/curve448/curve448_hEEA_div_vartime.h"
 #include "../src/half_size/curve448/curve448_hgcd_vartime.h"
@@ -11,11 +11,6 @@
 #define number_of_samples 10000
 #define number_of_rounds 10
 
-struct benchmark_result{
-	uint64_t best;
-	uint64_t median;
-	double average;
-};
 
 /* u64 to mpz */
 void u64_2_mpz(mpz_t out, const uint64_t* in, size_t l) 
@@ -97,21 +92,6 @@ int check_correctness(uint64_t *c0, uint64_t *c1, const mpz_t b_mpz, const mpz_t
 
 }
 
-static int cmp_int64(const void *v1, const void *v2)
-{
-	int64_t x1, x2;
-
-	x1 = *(const int64_t *)v1;
-	x2 = *(const int64_t *)v2;
-	if (x1 < x2) {
-		return -1;
-	} else if (x1 == x2) {
-		return 0;
-	} else {
-		return 1;
-	}
-}
-
 int test_instance(int test_count){
 
 	gmp_randstate_t state;
@@ -127,10 +107,8 @@ int test_instance(int test_count){
 	uint64_t b[test_count][7], c0[4], c1[4];
 	int c0_size, c1_size;
 
-	uint64_t t_begin;
 	
 	uint64_t t[test_count];
-	uint64_t total_t = 0;
 	struct benchmark_result benchmark_reduce_basis; 
 	struct benchmark_result benchmark_hEEA; 
 	struct benchmark_result benchmark_hEEA_div; 
@@ -145,67 +123,43 @@ int test_instance(int test_count){
 	}
 
 	/* Test hEEA_div */
-	total_t = 0;
 	for(size_t j=0; j<test_count; j++)
 	{
 		c0[0] = c0[1] = c0[2] = c0[3] = 0ul;
 		c1[0] = c1[1] = c1[2] = c1[3] = 0ul;
     	
-		t_begin = get_ticks();
-		for(int i=0; i<number_of_rounds;i++)
-    		curve448_hEEA_div_vartime(c0, c1, b[j]);
-
-		t[j] = get_ticks() - t_begin;
-		total_t += t[j]; 
+		BENCH_TICKS(t[j], number_of_rounds, number_of_rounds, "hEEA_div", curve448_hEEA_div_vartime(c0, c1, b[j]));
 		u64_2_mpz(b_mpz, b[j], 7);
 		if (!check_correctness(c0, c1, b_mpz, L)){
 			fprintf(stderr, "ERR: wrong reduction result using `curve25519_hEEA_div_vartime`\n");
 			exit(EXIT_FAILURE);
 		}
 	}
-	qsort(t, test_count, sizeof(uint64_t), cmp_int64);
-	benchmark_hEEA_div.best =  t[0]/number_of_rounds;
-	benchmark_hEEA_div.median = t[test_count/2]/number_of_rounds;
-	benchmark_hEEA_div.average =  total_t/(number_of_rounds*(double)test_count);
+	benchmark_hEEA_div = benchmark_summary(t, test_count, number_of_rounds);
 
 
 	/* Test reduce_basis */
-	total_t = 0;
 	for(size_t j=0; j<test_count; j++)
 	{
 		c0[0] = c0[1] = c0[2] = c0[3] = 0ul;
 		c1[0] = c1[1] = c1[2] = c1[3] = 0ul;
 
-		t_begin = get_ticks();
-		for(int i=0; i<number_of_rounds;i++)
-    		curve448_reduce_basis_vartime(c0, c1, b[j]);
-
-		t[j] = get_ticks() - t_begin;
-		total_t += t[j]; 
+		BENCH_TICKS(t[j], number_of_rounds, number_of_rounds, "reduce_basis", curve448_reduce_basis_vartime(c0, c1, b[j]));
 		u64_2_mpz(b_mpz, b[j], 7);
 		if (!check_correctness(c0, c1, b_mpz, L)){
 			fprintf(stderr, "ERR: wrong reduction result using `curve25519_reduce_basis_vartime`\n");
 			exit(EXIT_FAILURE);
 		}
 	}
-	qsort(t, test_count, sizeof(uint64_t), cmp_int64);
-	benchmark_reduce_basis.best =  t[0]/number_of_rounds;
-	benchmark_reduce_basis.median = t[test_count/2]/number_of_rounds;
-	benchmark_reduce_basis.average =  total_t/(number_of_rounds*(double)test_count);
+	benchmark_reduce_basis = benchmark_summary(t, test_count, number_of_rounds);
 
 	/* Test hEEA */
-	total_t = 0;
 	for(size_t j=0; j<test_count; j++)
 	{
 		c0[0] = c0[1] = c0[2] = c0[3] = 0ul;
 		c1[0] = c1[1] = c1[2] = c1[3] = 0ul;
     	
-		t_begin = get_ticks();
-		for(int i=0; i<number_of_rounds;i++)
-    		curve448_hEEA_vartime(c0, c1, b[j]);
-
-		t[j] = get_ticks() - t_begin;
-		total_t += t[j]; 
+		BENCH_TICKS(t[j], number_of_rounds, number_of_rounds, "hEEA_q", curve448_hEEA_vartime(c0, c1, b[j]));
 		u64_2_mpz(b_mpz, b[j], 7);
 		if (!check_correctness(c0, c1, b_mpz, L)){
 			fprintf(stderr, "ERR: wrong reduction result using `curve25519_hEEA_vartime`\n");
@@ -213,59 +167,29 @@ int test_instance(int test_count){
 		}
 		
 	}
-	qsort(t, test_count, sizeof(uint64_t), cmp_int64);
-	benchmark_hEEA.best =  t[0]/number_of_rounds;
-	benchmark_hEEA.median = t[test_count/2]/number_of_rounds;
-	benchmark_hEEA.average =  total_t/(number_of_rounds*(double)test_count);
+	benchmark_hEEA = benchmark_summary(t, test_count, number_of_rounds);
 
 
 	/* Test hgcd */
-	total_t = 0;
 	for(size_t j=0; j<test_count; j++)
 	{
 		c0[0] = c0[1] = c0[2] = c0[3] = 0ul;
 		c1[0] = c1[1] = c1[2] = c1[3] = 0ul;
     	
-		t_begin = get_ticks();
-		for(int i=0; i<number_of_rounds;i++)
-    		curve448_hgcd_vartime(c0, c1, b[j], &c0_size, &c1_size);
-
-		t[j] = get_ticks() - t_begin;
-		total_t += t[j]; 
+		BENCH_TICKS(t[j], number_of_rounds, number_of_rounds, "hgcd", curve448_hgcd_vartime(c0, c1, b[j], &c0_size, &c1_size));
 		u64_2_mpz(b_mpz, b[j], 7);
 		if (!check_correctness(c0, c1, b_mpz, L)){
 			fprintf(stderr, "ERR: wrong reduction result using `curve25519_hgcd_vartime`\n");
 			exit(EXIT_FAILURE);
 		}
 	}
-	qsort(t, test_count, sizeof(uint64_t), cmp_int64);
-	benchmark_gmp_hgcd.best =  t[0]/number_of_rounds;
-	benchmark_gmp_hgcd.median = t[test_count/2]/number_of_rounds;
-	benchmark_gmp_hgcd.average =  total_t/(number_of_rounds*(double)test_count);
-
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Time (ticks)|   hEEA_div   |    hEEA_q    | Speed up     | Improvement\n");
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Best        | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_hEEA_div.best, benchmark_hEEA.best, (double)benchmark_hEEA_div.best/(double)benchmark_hEEA.best,((double)benchmark_hEEA_div.best - (double)benchmark_hEEA.best)/((double)benchmark_hEEA_div.best) * 100);
-	printf("Median      | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_hEEA_div.median, benchmark_hEEA.median, (double)benchmark_hEEA_div.median/(double)benchmark_hEEA.median,((double)benchmark_hEEA_div.median - (double)benchmark_hEEA.median)/((double)benchmark_hEEA_div.median) * 100);
-	printf("Average     | %-12.2f | %-12.2f | %-12.4f | %.2f %%\n", benchmark_hEEA_div.average, benchmark_hEEA.average, (double)benchmark_hEEA_div.average/(double)benchmark_hEEA.average,((double)benchmark_hEEA_div.average - (double)benchmark_hEEA.average)/((double)benchmark_hEEA_div.average) * 100);
-	printf("───────────────────────────────────────────────────────────────────────\n");
-
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Time (ticks)| reduce_basis |    hEEA_q    | Speed up     | Improvement\n");
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Best        | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_reduce_basis.best, benchmark_hEEA.best, (double)benchmark_reduce_basis.best/(double)benchmark_hEEA.best,((double)benchmark_reduce_basis.best - (double)benchmark_hEEA.best)/((double)benchmark_reduce_basis.best) * 100);
-	printf("Median      | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_reduce_basis.median, benchmark_hEEA.median, (double)benchmark_reduce_basis.median/(double)benchmark_hEEA.median,((double)benchmark_reduce_basis.median - (double)benchmark_hEEA.median)/((double)benchmark_reduce_basis.median) * 100);
-	printf("Average     | %-12.2f | %-12.2f | %-12.4f | %.2f %%\n", benchmark_reduce_basis.average, benchmark_hEEA.average, (double)benchmark_reduce_basis.average/(double)benchmark_hEEA.average,((double)benchmark_reduce_basis.average - (double)benchmark_hEEA.average)/((double)benchmark_reduce_basis.average) * 100);
-	printf("───────────────────────────────────────────────────────────────────────\n");
-
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Time (ticks)|   GMP_hgcd   |    hEEA_q    | Speed up     | Improvement\n");
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Best        | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_gmp_hgcd.best, benchmark_hEEA.best, (double)benchmark_gmp_hgcd.best/(double)benchmark_hEEA.best,((double)benchmark_gmp_hgcd.best - (double)benchmark_hEEA.best)/((double)benchmark_gmp_hgcd.best) * 100);
-	printf("Median      | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_gmp_hgcd.median, benchmark_hEEA.median, (double)benchmark_gmp_hgcd.median/(double)benchmark_hEEA.median,((double)benchmark_gmp_hgcd.median - (double)benchmark_hEEA.median)/((double)benchmark_gmp_hgcd.median) * 100);
-	printf("Average     | %-12.2f | %-12.2f | %-12.4f | %.2f %%\n", benchmark_gmp_hgcd.average, benchmark_hEEA.average, (double)benchmark_gmp_hgcd.average/(double)benchmark_hEEA.average,((double)benchmark_gmp_hgcd.average - (double)benchmark_hEEA.average)/((double)benchmark_gmp_hgcd.average) * 100);
-	printf("───────────────────────────────────────────────────────────────────────\n");
+	benchmark_gmp_hgcd = benchmark_summary(t, test_count, number_of_rounds);
+
+	print_comparison("hEEA_div", "hEEA_q", benchmark_hEEA_div, benchmark_hEEA);
+
+	print_comparison("reduce_basis", "hEEA_q", benchmark_reduce_basis, benchmark_hEEA);
+
+	print_comparison("GMP_hgcd", "hEEA_q", benchmark_gmp_hgcd, benchmark_hEEA);
 
     return 0;
 }
@@ -273,10 +197,12 @@ int test_instance(int test_count){
 
 int main(){
 	
+	perf_open();
 	printf("Benchmark of half-size-scalars for Ed448:\n");
 	printf("Number of samples = %i \n", number_of_samples);
 	printf("Number of rounds = %i \n", number_of_rounds);
 	test_instance(number_of_samples);
+	perf_report();
 	printf("Done!\n");
 		
 }
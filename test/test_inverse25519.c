@@ -2,18 +2,15 @@
 #include <gmp.h>
 #include <time.h>
 #include <openssl/rand.h>
-#include "test-ticks.h"
+#include "test-bench.h"
 #include "../src/inverse25519/EEA_q/inverse25519_EEA_vartime.h"
 #include "../src/inverse25519/inverse25519skylake-20210110/inverse25519.h"
 #include "../src/inverse25519/bingcd/src/gf25519.h"
 
 #define number_of_samples 10000
+#define throughput_size 100
+#define max_batch_size 128
 
-struct benchmark_result{
-	uint64_t best;
-	uint64_t median;
-	double average;
-};
 
 void gmp_import(mpz_t z,const unsigned char *s,unsigned long long slen)
 {
@@ -106,21 +103,6 @@ int check_correctness(const mpz_t x_inv_mpz, const mpz_t x_mpz, const mpz_t p_mp
 
 }
 
-static int cmp_int64(const void *v1, const void *v2)
-{
-	int64_t x1, x2;
-
-	x1 = *(const int64_t *)v1;
-	x2 = *(const int64_t *)v2;
-	if (x1 < x2) {
-		return -1;
-	} else if (x1 == x2) {
-		return 0;
-	} else {
-		return 1;
-	}
-}
-
 int test_instance(int test_count){
 
 	gmp_randstate_t state;
@@ -138,10 +120,8 @@ int test_instance(int test_count){
 	uint64_t x[4], x_inv[4];
 	mpz_init(x_inv_mpz);
 
-	uint64_t t_begin;
 
 	uint64_t t[test_count];
-	uint64_t total_t = 0;
 	struct benchmark_result benchmark_safegcd; 
 	struct benchmark_result benchmark_EEA; 
 	struct benchmark_result benchmark_bingcd; 
@@ -155,24 +135,18 @@ int test_instance(int test_count){
 
 
 	/* Test bingcd */
-	total_t = 0;
 	for(size_t j=0; j<test_count; j++)
 	{
 		
 		mpz_2_gf(&x_gf, x_mpz[j]);
     	
-		t_begin = get_ticks();
-
-		for(int i=0;i<20;i++){
-    	gf_inv(&x_inv_gf, &x_gf);
-    	gf_inv(&x_gf, &x_inv_gf);
-    	gf_inv(&x_inv_gf, &x_gf);
-		gf_inv(&x_gf, &x_inv_gf);
-    	gf_inv(&x_inv_gf, &x_gf);
-		}
-
-		t[j] = get_ticks() - t_begin;
-		total_t += t[j]; 
+		BENCH_TICKS(t[j], 20, 100, "bingcd", {
+			gf_inv(&x_inv_gf, &x_gf);
+			gf_inv(&x_gf, &x_inv_gf);
+			gf_inv(&x_inv_gf, &x_gf);
+			gf_inv(&x_gf, &x_inv_gf);
+			gf_inv(&x_inv_gf, &x_gf);
+		});
 
 		gf_to_mpz(x_inv_mpz, &x_inv_gf);
 		if (!check_correctness(x_inv_mpz, x_mpz[j], p_mpz)){
@@ -180,29 +154,22 @@ int test_instance(int test_count){
 			exit(EXIT_FAILURE);
 		}
 	}
-	qsort(t, test_count, sizeof(uint64_t), cmp_int64);
-	benchmark_bingcd.best =  t[0]/100;
-	benchmark_bingcd.median = t[test_count/2]/100;
-	benchmark_bingcd.average =  total_t/(100 * (double)test_count);
+	benchmark_bingcd = benchmark_summary(t, test_count, 100);
 
 	/* Test EEA */
-	total_t = 0;
 	for(size_t j=0; j<test_count; j++)
 	{
 		
 		x_inv[0] = x_inv[1] = x_inv[2] = x_inv[3] = 0ul;
 		mpz_2_u64(x, x_mpz[j], 4);
     	
-		t_begin = get_ticks();
-		for(int i=0;i<20;i++){
+		BENCH_TICKS(t[j], 20, 100, "EEA_q", {
 			inverse25519_EEA_vartime(x_inv, x);
 			inverse25519_EEA_vartime(x, x_inv);
 			inverse25519_EEA_vartime(x_inv, x);
 			inverse25519_EEA_vartime(x, x_inv);
 			inverse25519_EEA_vartime(x_inv, x);
-		}
-		t[j] = get_ticks() - t_begin;
-		total_t += t[j]; 
+		});
 
 		u64_2_mpz(x_inv_mpz, x_inv, 4);
 		if (!check_correctness(x_inv_mpz, x_mpz[j], p_mpz)){
@@ -210,59 +177,186 @@ int test_instance(int test_count){
 			exit(EXIT_FAILURE);
 		}
 	}
-	qsort(t, test_count, sizeof(uint64_t), cmp_int64);
-	benchmark_EEA.best =  t[0]/100;
-	benchmark_EEA.median = t[test_count/2]/100;
-	benchmark_EEA.average =  total_t/(100*(double)test_count);
+	benchmark_EEA = benchmark_summary(t, test_count, 100);
 
 
 	
 
 
 	/* Test safegcd */
-	total_t = 0;
 	for(size_t j=0; j<test_count; j++)
 	{
 		gmp_export(x_c, 32, x_mpz[j]);
     	
-		t_begin = get_ticks();
-		for(int i=0;i<20;i++){
+		BENCH_TICKS(t[j], 20, 100, "safegcd", {
 			inverse25519(x_inv_c, x_c);
 			inverse25519(x_c, x_inv_c);
 			inverse25519(x_inv_c, x_c);
 			inverse25519(x_c, x_inv_c);
 			inverse25519(x_inv_c, x_c);
-		}
-		t[j] = get_ticks() - t_begin;
-		total_t += t[j]; 
+		});
 		gmp_import(x_inv_mpz, x_inv_c, 32);
 		if (!check_correctness(x_inv_mpz, x_mpz[j], p_mpz)){
 			fprintf(stderr, "ERR: wrong reduction result using `inverse25519` in  safegcd\n");
 			exit(EXIT_FAILURE);
 		}
 	}
-	qsort(t, test_count, sizeof(uint64_t), cmp_int64);
-	benchmark_safegcd.best =  t[0]/100;
-	benchmark_safegcd.median = t[test_count/2]/100;
-	benchmark_safegcd.average =  total_t/(100*(double)test_count);
+	benchmark_safegcd = benchmark_summary(t, test_count, 100);
 
 	    
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Time (ticks)|   binGCD     |     EEA_q    | Speed up     | Improvement\n");
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Best        | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_bingcd.best, benchmark_EEA.best, (double)benchmark_bingcd.best/(double)benchmark_EEA.best,((double)benchmark_bingcd.best - (double)benchmark_EEA.best)/((double)benchmark_bingcd.best) * 100);
-	printf("Median      | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_bingcd.median, benchmark_EEA.median, (double)benchmark_bingcd.median/(double)benchmark_EEA.median,((double)benchmark_bingcd.median - (double)benchmark_EEA.median)/((double)benchmark_bingcd.median) * 100);
-	printf("Average     | %-12.2f | %-12.2f | %-12.4f | %.2f %%\n", benchmark_bingcd.average, benchmark_EEA.average, (double)benchmark_bingcd.average/(double)benchmark_EEA.average,((double)benchmark_bingcd.average - (double)benchmark_EEA.average)/((double)benchmark_bingcd.average) * 100);
-	printf("───────────────────────────────────────────────────────────────────────\n");
+	print_comparison("binGCD", "EEA_q", benchmark_bingcd, benchmark_EEA);
 
+	print_comparison("safeGCD", "EEA_q", benchmark_safegcd, benchmark_EEA);
+
+
+	return 0;
+}
+
+/*
+ * Throughput mode: throughput_size independent inversions per measurement,
+ * which may overlap in the out-of-order window. Then n independent EEA_q
+ * inversions against one inverse25519_batch_vartime call on n inputs.
+ */
+int test_throughput(int test_count){
+
+	gmp_randstate_t state;
+	gmp_randinit_mt(state);
+	gmp_randseed_ui(state, time(NULL) + 1);
+
+	mpz_t p_mpz, x_mpz, x_inv_mpz;
+	mpz_init(p_mpz);
+	mpz_init(x_mpz);
+	mpz_init(x_inv_mpz);
+	mpz_set_str(p_mpz, "57896044618658097711785492504343953926634992332820282019728792003956564819949", 10);
+
+	static uint64_t x[max_batch_size + throughput_size][4], x_inv[max_batch_size + throughput_size][4];
+	static unsigned char x_c[throughput_size][32], x_inv_c[throughput_size][32];
+	static gf x_gf[throughput_size], x_inv_gf[throughput_size];
+	size_t i, j, n, crossover = 0;
+
+	uint64_t t_begin;
+	uint64_t t[test_count];
+	struct benchmark_result benchmark_safegcd;
+	struct benchmark_result benchmark_EEA;
+	struct benchmark_result benchmark_bingcd;
+	struct benchmark_result benchmark_single;
+	struct benchmark_result benchmark_batch;
+
+	for (i = 0; i < max_batch_size + throughput_size; i++) {
+		rand_mpz(x_mpz, state, p_mpz);
+		mpz_2_u64(x[i], x_mpz, 4);
+		if (i < throughput_size) {
+			gmp_export(x_c[i], 32, x_mpz);
+			mpz_2_gf(&x_gf[i], x_mpz);
+		}
+	}
+
+	/* Test bingcd */
+	for (j = 0; j < test_count; j++)
+	{
+		perf_begin();
+		t_begin = get_ticks();
+		for (i = 0; i < throughput_size; i++)
+			gf_inv(&x_inv_gf[i], &x_gf[i]);
+		t[j] = get_ticks() - t_begin;
+		perf_end(throughput_size, "bingcd, throughput");
+	}
+	benchmark_bingcd = benchmark_summary(t, test_count, throughput_size);
+
+	/* Test EEA */
+	for (j = 0; j < test_count; j++)
+	{
+		perf_begin();
+		t_begin = get_ticks();
+		for (i = 0; i < throughput_size; i++)
+			inverse25519_EEA_vartime(x_inv[i], x[i]);
+		t[j] = get_ticks() - t_begin;
+		perf_end(throughput_size, "EEA_q, throughput");
+	}
+	benchmark_EEA = benchmark_summary(t, test_count, throughput_size);
+
+	/* Test safegcd */
+	for (j = 0; j < test_count; j++)
+	{
+		perf_begin();
+		t_begin = get_ticks();
+		for (i = 0; i < throughput_size; i++)
+			inverse25519(x_inv_c[i], x_c[i]);
+		t[j] = get_ticks() - t_begin;
+		perf_end(throughput_size, "safegcd, throughput");
+	}
+	benchmark_safegcd = benchmark_summary(t, test_count, throughput_size);
+
+	for (i = 0; i < throughput_size; i++) {
+		u64_2_mpz(x_mpz, x[i], 4);
+		u64_2_mpz(x_inv_mpz, x_inv[i], 4);
+		if (!check_correctness(x_inv_mpz, x_mpz, p_mpz)){
+			fprintf(stderr, "ERR: wrong reduction result using `inverse25519_EEA_vartime`\n");
+			exit(EXIT_FAILURE);
+		}
+		gf_to_mpz(x_mpz, &x_gf[i]);
+		gf_to_mpz(x_inv_mpz, &x_inv_gf[i]);
+		if (!check_correctness(x_inv_mpz, x_mpz, p_mpz)){
+			fprintf(stderr, "ERR: wrong reduction result using `gf_inv` of bingcd\n");
+			exit(EXIT_FAILURE);
+		}
+		gmp_import(x_mpz, x_c[i], 32);
+		gmp_import(x_inv_mpz, x_inv_c[i], 32);
+		if (!check_correctness(x_inv_mpz, x_mpz, p_mpz)){
+			fprintf(stderr, "ERR: wrong reduction result using `inverse25519` in  safegcd\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	printf("Throughput of %i independent inversions:\n", throughput_size);
+	print_comparison("binGCD", "EEA_q", benchmark_bingcd, benchmark_EEA);
+
+	print_comparison("safeGCD", "EEA_q", benchmark_safegcd, benchmark_EEA);
+
+	/* n individual EEA_q inversions vs one batch inversion, median per element */
+	printf("Batch inversion, median ticks per element:\n");
 	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Time (ticks)|   safeGCD    |     EEA_q    | Speed up     | Improvement\n");
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Best        | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_safegcd.best, benchmark_EEA.best, (double)benchmark_safegcd.best/(double)benchmark_EEA.best,((double)benchmark_safegcd.best - (double)benchmark_EEA.best)/((double)benchmark_safegcd.best) * 100);
-	printf("Median      | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_safegcd.median, benchmark_EEA.median, (double)benchmark_safegcd.median/(double)benchmark_EEA.median,((double)benchmark_safegcd.median - (double)benchmark_EEA.median)/((double)benchmark_safegcd.median) * 100);
-	printf("Average     | %-12.2f | %-12.2f | %-12.4f | %.2f %%\n", benchmark_safegcd.average, benchmark_EEA.average, (double)benchmark_safegcd.average/(double)benchmark_EEA.average,((double)benchmark_safegcd.average - (double)benchmark_EEA.average)/((double)benchmark_safegcd.average) * 100);
+	printf("Batch size  |   n x EEA_q  |    batch     | Speed up     | Improvement\n");
 	printf("───────────────────────────────────────────────────────────────────────\n");
+	for (n = 1; n <= max_batch_size; n <<= 1) {
+		for (j = 0; j < test_count; j++) {
+			perf_begin();
+			t_begin = get_ticks();
+			for (i = 0; i < n; i++)
+				inverse25519_EEA_vartime(x_inv[i], x[i]);
+			t[j] = get_ticks() - t_begin;
+			perf_end(n, "EEA_q, %zu separately", (size_t)n);
+		}
+		benchmark_single.median = benchmark_median(t, test_count, n);
+
+		for (j = 0; j < test_count; j++) {
+			perf_begin();
+			t_begin = get_ticks();
+			inverse25519_batch_vartime(x_inv[0], x[0], n);
+			t[j] = get_ticks() - t_begin;
+			perf_end(n, "inverse25519_batch_vartime, %zu", (size_t)n);
+		}
+		benchmark_batch.median = benchmark_median(t, test_count, n);
+
+		for (i = 0; i < n; i++) {
+			u64_2_mpz(x_mpz, x[i], 4);
+			u64_2_mpz(x_inv_mpz, x_inv[i], 4);
+			if (!check_correctness(x_inv_mpz, x_mpz, p_mpz) || mpz_cmp(x_inv_mpz, p_mpz) >= 0){
+				fprintf(stderr, "ERR: wrong reduction result using `inverse25519_batch_vartime`\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+
+		if (!crossover && benchmark_batch.median < benchmark_single.median)
+			crossover = n;
 
+		printf("%-11lu | %-12lu | %-12lu | %-12.4f | %.2f %%\n", n, benchmark_single.median, benchmark_batch.median, (double)benchmark_single.median/(double)benchmark_batch.median, ((double)benchmark_single.median - (double)benchmark_batch.median)/((double)benchmark_single.median) * 100);
+	}
+	printf("───────────────────────────────────────────────────────────────────────\n");
+	if (crossover)
+		printf("Batch inversion is faster from n = %lu\n", crossover);
+	else
+		printf("Batch inversion is not faster up to n = %i\n", max_batch_size);
 
 	return 0;
 }
@@ -270,9 +364,12 @@ int test_instance(int test_count){
 
 int main(){
 	
+	perf_open();
 	printf("Benchmark of inverse25519:\n");
 	printf("Number of samples = %i \n", number_of_samples);
 	test_instance(number_of_samples);
+	test_throughput(number_of_samples);
+	perf_report();
 	printf("Done!\n");
 		
 }
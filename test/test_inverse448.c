@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include <gmp.h>
+#include <time.h>
+#include "test-bench.h"
+#include "../src/inverse448/EEA_q/inverse448_EEA_vartime.h"
+
+#define number_of_samples 10000
+
+
+
+/* u64 to mpz */
+void u64_2_mpz(mpz_t out, const uint64_t* in, size_t l) 
+{
+	mpz_import(out, l, -1, sizeof(uint64_t), 0, 0, in);
+}
+
+/* mpz to u64 */
+void mpz_2_u64(uint64_t *out, const mpz_t in, size_t l) {
+    size_t count,i;
+    mpz_export(out, &count, -1, sizeof(uint64_t), 0, 0, in);
+    if (count < l){
+        for(i=count; i<l; i++){
+            out[i] = 0;
+        };
+    };
+};
+
+
+void rand_mpz(mpz_t b_mpz, gmp_randstate_t state, const mpz_t L){
+	for(;;){
+		mpz_urandomb(b_mpz, state, 448);
+		mpz_mod(b_mpz, b_mpz, L);
+		if(mpz_cmp_ui(b_mpz, 0))
+			break;
+	}
+}
+
+/* check if 1 = x_inv * x mod p */
+int check_correctness(const mpz_t x_inv_mpz, const mpz_t x_mpz, const mpz_t p_mpz){
+
+	mpz_t tmp;
+	mpz_init(tmp);
+	mpz_mul(tmp, x_inv_mpz, x_mpz);
+	mpz_mod(tmp, tmp, p_mpz);
+	return (mpz_cmp_ui(tmp, 1) || mpz_cmp(x_inv_mpz, p_mpz) >= 0) ? 0:1;
+
+}
+
+int test_instance(int test_count){
+
+	gmp_randstate_t state;
+	gmp_randinit_mt(state);
+	gmp_randseed_ui(state, time(NULL));
+
+	/* p = 2^448 - 2^224 - 1 */
+	mpz_t p_mpz;
+	mpz_init(p_mpz);
+	mpz_ui_pow_ui(p_mpz, 2, 448);
+	mpz_t tmp;
+	mpz_init(tmp);
+	mpz_ui_pow_ui(tmp, 2, 224);
+	mpz_sub(p_mpz, p_mpz, tmp);
+	mpz_sub_ui(p_mpz, p_mpz, 1);
+
+	mpz_t x_mpz[test_count], x_inv_mpz, y_mpz;
+	uint64_t x[7], x_inv[7];
+	mpz_init(x_inv_mpz);
+	mpz_init(y_mpz);
+
+
+	uint64_t t[test_count];
+	struct benchmark_result benchmark_FLT; 
+	struct benchmark_result benchmark_EEA; 
+	struct benchmark_result benchmark_gmp; 
+
+	for(size_t j=0; j<test_count; j++)
+	{
+		/* pick a random x, s.t. 0 < x < p */
+		mpz_init(x_mpz[j]);
+		rand_mpz(x_mpz[j], state, p_mpz);
+	}
+
+	/* edge cases: 1, 2, p - 1 and p - 2 */
+	mpz_set_ui(x_mpz[0], 1);
+	mpz_set_ui(x_mpz[1], 2);
+	mpz_sub_ui(x_mpz[2], p_mpz, 1);
+	mpz_sub_ui(x_mpz[3], p_mpz, 2);
+	for (size_t j = 0; j < 4; j++) {
+		mpz_2_u64(x, x_mpz[j], 7);
+		inverse448_EEA_vartime(x_inv, x);
+		u64_2_mpz(x_inv_mpz, x_inv, 7);
+		if (!check_correctness(x_inv_mpz, x_mpz[j], p_mpz)){
+			fprintf(stderr, "ERR: wrong inverse of an edge case using `inverse448_EEA_vartime`\n");
+			exit(EXIT_FAILURE);
+		}
+		inverse448_FLT(x_inv, x);
+		u64_2_mpz(x_inv_mpz, x_inv, 7);
+		if (!check_correctness(x_inv_mpz, x_mpz[j], p_mpz)){
+			fprintf(stderr, "ERR: wrong inverse of an edge case using `inverse448_FLT`\n");
+			exit(EXIT_FAILURE);
+		}
+		rand_mpz(x_mpz[j], state, p_mpz);
+	}
+
+
+	/* Test Fermat's little theorem */
+	for(size_t j=0; j<test_count; j++)
+	{
+		mpz_2_u64(x, x_mpz[j], 7);
+    	
+		BENCH_TICKS(t[j], 20, 100, "FLT", {
+			inverse448_FLT(x_inv, x);
+			inverse448_FLT(x, x_inv);
+			inverse448_FLT(x_inv, x);
+			inverse448_FLT(x, x_inv);
+			inverse448_FLT(x_inv, x);
+		});
+
+		u64_2_mpz(x_inv_mpz, x_inv, 7);
+		if (!check_correctness(x_inv_mpz, x_mpz[j], p_mpz)){
+			fprintf(stderr, "ERR: wrong reduction result using `inverse448_FLT`\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	benchmark_FLT = benchmark_summary(t, test_count, 100);
+
+	/* Test EEA */
+	for(size_t j=0; j<test_count; j++)
+	{
+		mpz_2_u64(x, x_mpz[j], 7);
+    	
+		BENCH_TICKS(t[j], 20, 100, "EEA_q", {
+			inverse448_EEA_vartime(x_inv, x);
+			inverse448_EEA_vartime(x, x_inv);
+			inverse448_EEA_vartime(x_inv, x);
+			inverse448_EEA_vartime(x, x_inv);
+			inverse448_EEA_vartime(x_inv, x);
+		});
+
+		u64_2_mpz(x_inv_mpz, x_inv, 7);
+		if (!check_correctness(x_inv_mpz, x_mpz[j], p_mpz)){
+			fprintf(stderr, "ERR: wrong reduction result using `inverse448_EEA_vartime`\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	benchmark_EEA = benchmark_summary(t, test_count, 100);
+
+	/* Test GMP */
+	for(size_t j=0; j<test_count; j++)
+	{
+		mpz_set(y_mpz, x_mpz[j]);
+
+		BENCH_TICKS(t[j], 20, 100, "mpz_invert", {
+			mpz_invert(x_inv_mpz, y_mpz, p_mpz);
+			mpz_invert(y_mpz, x_inv_mpz, p_mpz);
+			mpz_invert(x_inv_mpz, y_mpz, p_mpz);
+			mpz_invert(y_mpz, x_inv_mpz, p_mpz);
+			mpz_invert(x_inv_mpz, y_mpz, p_mpz);
+		});
+
+		if (!check_correctness(x_inv_mpz, x_mpz[j], p_mpz)){
+			fprintf(stderr, "ERR: wrong reduction result using `mpz_invert`\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	benchmark_gmp = benchmark_summary(t, test_count, 100);
+
+	    
+	print_comparison("FLT", "EEA_q", benchmark_FLT, benchmark_EEA);
+
+	print_comparison("GMP", "EEA_q", benchmark_gmp, benchmark_EEA);
+
+
+	return 0;
+}
+
+int main(){
+	perf_open();
+	printf("Benchmark of inverse448:\n");
+	printf("Number of samples = %i \n", number_of_samples);
+	test_instance(number_of_samples);
+	perf_report();
+	printf("Done!\n");
+}
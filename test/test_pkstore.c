@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test-bench.h"
+#include "../src/ed25519-donna/ed25519.h"
+
+
+#define number_of_samples 10000
+#define number_of_rounds 10
+#define batch_size 64
+#define store_path "test_pkstore.bin"
+
+
+struct store_result{
+	uint64_t decompress;
+	uint64_t store;
+};
+
+/*
+ * Runs ed25519_sign_open_hEEA without and with the store, checks that both
+ * accept the valid signatures and reject a corrupted copy, and keeps the
+ * median time of each.
+ */
+struct store_result bench_single(const ed25519_pk_store *store,
+	const unsigned char (*messages)[128], const size_t *message_lengths,
+	const ed25519_public_key *pks, const ed25519_signature *sigs, size_t test_count){
+	struct store_result res;
+	ed25519_signature bad;
+	uint64_t t[test_count], u[test_count];
+	int ret = 0, ret_bad = 1;
+	size_t i;
+
+	for (i = 0; i < test_count; i++) {
+		memcpy(bad, sigs[i], sizeof(bad));
+		bad[i & 31] ^= 1 << (i & 7);
+
+		ed25519_pk_store_use(NULL);
+		BENCH_TICKS(t[i], number_of_rounds, number_of_rounds, "single hEEA_q", ret |= ed25519_sign_open_hEEA(messages[i], message_lengths[i], pks[i], sigs[i]));
+		ret_bad &= ed25519_sign_open_hEEA(messages[i], message_lengths[i], pks[i], bad) ? 1 : 0;
+
+		ed25519_pk_store_use(store);
+		BENCH_TICKS(u[i], number_of_rounds, number_of_rounds, "single hEEA_q, store", ret |= ed25519_sign_open_hEEA(messages[i], message_lengths[i], pks[i], sigs[i]));
+		ret_bad &= ed25519_sign_open_hEEA(messages[i], message_lengths[i], pks[i], bad) ? 1 : 0;
+
+		if (ret || !ret_bad) {
+			fprintf(stderr, "ERR: `ed25519_sign_open_hEEA` failed on message %zu\n", i);
+			exit(EXIT_FAILURE);
+		}
+	}
+	ed25519_pk_store_use(NULL);
+	res.decompress = benchmark_median(t, test_count, number_of_rounds);
+	res.store = benchmark_median(u, test_count, number_of_rounds);
+	return res;
+}
+
+/* same for ed25519_sign_open_batch_hEEA on batches of batch_size, per signature */
+struct store_result bench_batch(const ed25519_pk_store *store,
+	const unsigned char (*messages)[128], const size_t *message_lengths,
+	const ed25519_public_key *pks, const ed25519_signature *sigs, size_t test_count){
+	struct store_result res;
+	const unsigned char *m[batch_size], *pk[batch_size], *RS[batch_size];
+	size_t mlen[batch_size];
+	int valid[batch_size];
+	char name_batch[PERF_NAME_SIZE], name_store[PERF_NAME_SIZE];
+	size_t batches = test_count / batch_size;
+	uint64_t t[batches], u[batches];
+	size_t b, i;
+
+	snprintf(name_batch, sizeof(name_batch), "batch hEEA_q, %d", batch_size);
+	snprintf(name_store, sizeof(name_store), "batch hEEA_q, %d, store", batch_size);
+	for (b = 0; b < batches; b++) {
+		for (i = 0; i < batch_size; i++) {
+			m[i] = messages[b * batch_size + i];
+			mlen[i] = message_lengths[b * batch_size + i];
+			pk[i] = pks[b * batch_size + i];
+			RS[i] = sigs[b * batch_size + i];
+		}
+
+		ed25519_pk_store_use(NULL);
+		BENCH_TICKS(t[b], number_of_rounds, (uint64_t)number_of_rounds * batch_size, name_batch, {
+			if (ed25519_sign_open_batch_hEEA(m, mlen, pk, RS, batch_size, valid)) {
+				fprintf(stderr, "ERR: `ed25519_sign_open_batch_hEEA` failed on batch %zu\n", b);
+				exit(EXIT_FAILURE);
+			}
+		});
+
+		ed25519_pk_store_use(store);
+		BENCH_TICKS(u[b], number_of_rounds, (uint64_t)number_of_rounds * batch_size, name_store, {
+			if (ed25519_sign_open_batch_hEEA(m, mlen, pk, RS, batch_size, valid)) {
+				fprintf(stderr, "ERR: `ed25519_sign_open_batch_hEEA` with the store failed on batch %zu\n", b);
+				exit(EXIT_FAILURE);
+			}
+		});
+	}
+	ed25519_pk_store_use(NULL);
+	res.decompress = benchmark_median(t, batches, number_of_rounds * batch_size);
+	res.store = benchmark_median(u, batches, number_of_rounds * batch_size);
+	return res;
+}
+
+void print_result(const char *name, struct store_result res){
+	printf("%-20s | %-12" PRIu64 " | %-12" PRIu64 " | %.4f\n", name, res.decompress, res.store, (double)res.store/(double)res.decompress);
+}
+
+int test_instance(size_t test_count){
+	static ed25519_secret_key sks[number_of_samples + 1];
+	static ed25519_public_key pks[number_of_samples + 1];
+	static ed25519_signature sigs[number_of_samples + 1];
+	static unsigned char messages[number_of_samples + 1][128];
+	static size_t message_lengths[number_of_samples + 1];
+	ed25519_pk_store *store;
+	uint64_t t_build, t_open;
+	int64_t stored;
+	size_t i;
+
+	ed25519_randombytes_unsafe(sks, sizeof(sks));
+	ed25519_randombytes_unsafe(messages, sizeof(messages));
+	for (i = 0; i <= test_count; i++) {
+		message_lengths[i] = (i & 127) + 1;
+		ed25519_publickey(sks[i], pks[i]);
+		ed25519_sign(messages[i], message_lengths[i], sks[i], pks[i], sigs[i]);
+	}
+
+	/* the last key stays out of the store */
+	t_build = get_ticks();
+	stored = ed25519_pk_store_build(store_path, (const ed25519_public_key *)pks, test_count, 0);
+	t_build = get_ticks() - t_build;
+	t_open = get_ticks();
+	store = ed25519_pk_store_open(store_path);
+	t_open = get_ticks() - t_open;
+	if (stored != (int64_t)test_count || !store || ed25519_pk_store_count(store) != test_count) {
+		fprintf(stderr, "ERR: could not build and open the store\n");
+		exit(EXIT_FAILURE);
+	}
+
+	ed25519_pk_store_use(store);
+	if (ed25519_sign_open_hEEA(messages[test_count], message_lengths[test_count], pks[test_count], sigs[test_count]) ||
+		!ed25519_sign_open_hEEA(messages[0], message_lengths[0], pks[test_count], sigs[0])) {
+		fprintf(stderr, "ERR: wrong result for a key outside the store\n");
+		exit(EXIT_FAILURE);
+	}
+	ed25519_pk_store_use(NULL);
+
+	printf("Store of %zu keys: built in %" PRIu64 " ticks, opened in %" PRIu64 " ticks\n", test_count, t_build, t_open);
+	printf("───────────────────────────────────────────────────────────────────────\n");
+	printf("Median (ticks)       | Decompress   | Store        | Ratio\n");
+	printf("───────────────────────────────────────────────────────────────────────\n");
+	print_result("hEEA_q", bench_single(store, (const unsigned char (*)[128])messages, message_lengths, (const ed25519_public_key *)pks, (const ed25519_signature *)sigs, test_count));
+	print_result("batch hEEA_q / sig", bench_batch(store, (const unsigned char (*)[128])messages, message_lengths, (const ed25519_public_key *)pks, (const ed25519_signature *)sigs, test_count));
+	printf("───────────────────────────────────────────────────────────────────────\n");
+
+	ed25519_pk_store_close(store);
+	remove(store_path);
+	return 0;
+}
+
+int main(){
+	perf_open();
+	printf("Benchmark of the precomputed public-key store:\n");
+	printf("Number of samples = %i \n", number_of_samples);
+	printf("Number of rounds = %i \n", number_of_rounds);
+	test_instance(number_of_samples);
+	perf_report();
+	printf("Done!\n");
+}
@@ -0,0 +1,168 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gmp.h>
+#include <time.h>
+#include "test-bench.h"
+#include "../src/half_size/curve25519/curve25519_hEEA_vartime.h"
+#include "../src/half_size/curve25519/curve25519_hEEA_lehmer_vartime.h"
+#include "../src/half_size/curve25519/curve25519_reduce_basis_vartime.h"
+#include "../src/half_size/curve448/curve448_hEEA_vartime.h"
+#include "../src/half_size/curve448/curve448_reduce_basis_vartime.h"
+#include "../src/inverse25519/EEA_q/inverse25519_EEA_vartime.h"
+#include "../src/inverse448/EEA_q/inverse448_EEA_vartime.h"
+
+
+#define number_of_samples 10000
+#define number_of_rounds 10
+
+/* the same sources built with -DPORTABLE_INTRINSICS (see `OBJPORTABLE` in the Makefile) */
+void curve25519_hEEA_portable_vartime(uint64_t *, uint64_t *, const uint64_t *);
+void curve25519_hEEA_lehmer_portable_vartime(uint64_t *, uint64_t *, const uint64_t *);
+void curve25519_reduce_basis_portable_vartime(uint64_t *, uint64_t *, const uint64_t *);
+void curve448_hEEA_portable_vartime(uint64_t *, uint64_t *, const uint64_t *);
+void curve448_reduce_basis_portable_vartime(uint64_t *, uint64_t *, const uint64_t *);
+void inverse25519_EEA_portable_vartime(uint64_t *, const uint64_t *);
+void inverse448_EEA_portable_vartime(uint64_t *, const uint64_t *);
+
+typedef void (*reduce_fn)(uint64_t *, uint64_t *, const uint64_t *);
+typedef void (*inverse_fn)(uint64_t *, const uint64_t *);
+
+
+struct portable_result{
+	uint64_t intrinsics;
+	uint64_t portable;
+};
+
+/* mpz to u64 */
+void mpz_2_u64(uint64_t *out, const mpz_t in, size_t l) {
+	size_t count,i;
+	mpz_export(out, &count, -1, sizeof(uint64_t), 0, 0, in);
+	for(i=count; i<l; i++)
+		out[i] = 0;
+}
+
+/* random 0 < x < m, as l limbs */
+void rand_u64(uint64_t *x, gmp_randstate_t state, const mpz_t m, size_t l){
+	mpz_t x_mpz;
+	mpz_init(x_mpz);
+	do {
+		mpz_urandomm(x_mpz, state, m);
+	} while (!mpz_cmp_ui(x_mpz, 0));
+	mpz_2_u64(x, x_mpz, l);
+	mpz_clear(x_mpz);
+}
+
+/*
+ * Runs both builds of a half-size reduction on the same inputs, checks that
+ * they return the same (c0, c1) and keeps the median time of each.
+ */
+struct portable_result bench_reduce(const char *name, reduce_fn intrinsics, reduce_fn portable,
+	uint64_t (*b)[7], size_t test_count){
+	struct portable_result res;
+	uint64_t c0[4], c1[4], d0[4], d1[4];
+	char name_intrinsics[PERF_NAME_SIZE], name_portable[PERF_NAME_SIZE];
+	uint64_t t[test_count], u[test_count];
+	size_t j;
+
+	snprintf(name_intrinsics, sizeof(name_intrinsics), "%s, intrinsics", name);
+	snprintf(name_portable, sizeof(name_portable), "%s, portable", name);
+	for (j = 0; j < test_count; j++) {
+		memset(c0, 0, sizeof(c0)); memset(c1, 0, sizeof(c1));
+		memset(d0, 0, sizeof(d0)); memset(d1, 0, sizeof(d1));
+
+		BENCH_TICKS(t[j], number_of_rounds, number_of_rounds, name_intrinsics, intrinsics(c0, c1, b[j]));
+
+		BENCH_TICKS(u[j], number_of_rounds, number_of_rounds, name_portable, portable(d0, d1, b[j]));
+
+		if (memcmp(c0, d0, sizeof(c0)) || memcmp(c1, d1, sizeof(c1))) {
+			fprintf(stderr, "ERR: portable `%s` differs from the intrinsic build\n", name);
+			exit(EXIT_FAILURE);
+		}
+	}
+	res.intrinsics = benchmark_median(t, test_count, number_of_rounds);
+	res.portable = benchmark_median(u, test_count, number_of_rounds);
+	return res;
+}
+
+/* same for a field inversion */
+struct portable_result bench_inverse(const char *name, inverse_fn intrinsics, inverse_fn portable,
+	uint64_t (*x)[7], size_t test_count){
+	struct portable_result res;
+	uint64_t y[7], z[7];
+	char name_intrinsics[PERF_NAME_SIZE], name_portable[PERF_NAME_SIZE];
+	uint64_t t[test_count], u[test_count];
+	size_t j;
+
+	snprintf(name_intrinsics, sizeof(name_intrinsics), "%s, intrinsics", name);
+	snprintf(name_portable, sizeof(name_portable), "%s, portable", name);
+	for (j = 0; j < test_count; j++) {
+		memset(y, 0, sizeof(y)); memset(z, 0, sizeof(z));
+
+		BENCH_TICKS(t[j], number_of_rounds, number_of_rounds, name_intrinsics, intrinsics(y, x[j]));
+
+		BENCH_TICKS(u[j], number_of_rounds, number_of_rounds, name_portable, portable(z, x[j]));
+
+		if (memcmp(y, z, sizeof(y))) {
+			fprintf(stderr, "ERR: portable `%s` differs from the intrinsic build\n", name);
+			exit(EXIT_FAILURE);
+		}
+	}
+	res.intrinsics = benchmark_median(t, test_count, number_of_rounds);
+	res.portable = benchmark_median(u, test_count, number_of_rounds);
+	return res;
+}
+
+void print_result(const char *name, struct portable_result res){
+	printf("%-20s | %-12lu | %-12lu | %.4f\n", name, res.intrinsics, res.portable, (double)res.portable/(double)res.intrinsics);
+}
+
+int test_instance(size_t test_count){
+	gmp_randstate_t state;
+	mpz_t el25519, el448, p25519, p448;
+	static uint64_t b25519[number_of_samples][7], b448[number_of_samples][7];
+	static uint64_t x25519[number_of_samples][7], x448[number_of_samples][7];
+	size_t j;
+
+	gmp_randinit_mt(state);
+	gmp_randseed_ui(state, time(NULL));
+	mpz_inits(el25519, el448, p25519, p448, NULL);
+	mpz_set_str(el25519, "7237005577332262213973186563042994240857116359379907606001950938285454250989", 10);
+	mpz_set_str(el448, "181709681073901722637330951972001133588410340171829515070372549795146003961539585716195755291692375963310293709091662304773755859649779", 10);
+	mpz_ui_pow_ui(p25519, 2, 255);
+	mpz_sub_ui(p25519, p25519, 19);
+	mpz_set_str(p448, "726838724295606890549323807888004534353641360687318060281490199180612328166730772686396383698676545930088884461843637361053498018365439", 10);
+
+	for (j = 0; j < test_count; j++) {
+		rand_u64(b25519[j], state, el25519, 7);
+		rand_u64(b448[j], state, el448, 7);
+		rand_u64(x25519[j], state, p25519, 7);
+		rand_u64(x448[j], state, p448, 7);
+	}
+
+	printf("───────────────────────────────────────────────────────────────────────\n");
+	printf("Median (ticks)       | Intrinsics   | Portable     | Ratio\n");
+	printf("───────────────────────────────────────────────────────────────────────\n");
+	print_result("curve25519 hEEA_q", bench_reduce("curve25519_hEEA_vartime", curve25519_hEEA_vartime, curve25519_hEEA_portable_vartime, b25519, test_count));
+	print_result("curve25519 lehmer", bench_reduce("curve25519_hEEA_lehmer_vartime", curve25519_hEEA_lehmer_vartime, curve25519_hEEA_lehmer_portable_vartime, b25519, test_count));
+	print_result("curve25519 reduce", bench_reduce("curve25519_reduce_basis_vartime", curve25519_reduce_basis_vartime, curve25519_reduce_basis_portable_vartime, b25519, test_count));
+	print_result("curve448 hEEA_q", bench_reduce("curve448_hEEA_vartime", curve448_hEEA_vartime, curve448_hEEA_portable_vartime, b448, test_count));
+	print_result("curve448 reduce", bench_reduce("curve448_reduce_basis_vartime", curve448_reduce_basis_vartime, curve448_reduce_basis_portable_vartime, b448, test_count));
+	print_result("inverse25519 EEA_q", bench_inverse("inverse25519_EEA_vartime", inverse25519_EEA_vartime, inverse25519_EEA_portable_vartime, x25519, test_count));
+	print_result("inverse448 EEA_q", bench_inverse("inverse448_EEA_vartime", inverse448_EEA_vartime, inverse448_EEA_portable_vartime, x448, test_count));
+	printf("───────────────────────────────────────────────────────────────────────\n");
+
+	mpz_clears(el25519, el448, p25519, p448, NULL);
+	gmp_randclear(state);
+	return 0;
+}
+
+int main(){
+	perf_open();
+	printf("Benchmark of the portable build against the x86 intrinsics:\n");
+	printf("Number of samples = %i \n", number_of_samples);
+	printf("Number of rounds = %i \n", number_of_rounds);
+	test_instance(number_of_samples);
+	perf_report();
+	printf("Done!\n");
+}
@@ -0,0 +1,78 @@
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include "test-bench.h"
+#include "../src/ed25519-donna/ed25519.h"
+
+#define number_of_samples 10000
+#define number_of_rounds 10
+
+
+int test_instance(size_t test_count){
+	ed25519_secret_key sks[test_count];
+	ed25519_public_key pks[test_count], pk;
+	ed25519_signature sigs[test_count], sig;
+	unsigned char messages[test_count][128];
+	size_t message_lengths[test_count];
+	size_t i;
+
+	uint64_t t[test_count];
+	struct benchmark_result benchmark_keygen_old;
+	struct benchmark_result benchmark_keygen_new;
+	struct benchmark_result benchmark_sign_old;
+	struct benchmark_result benchmark_sign_new;
+
+	/* generate secret keys and messages */
+	ed25519_randombytes_unsafe(sks, sizeof(sks));
+	ed25519_randombytes_unsafe(messages, sizeof(messages));
+	for (i = 0; i < test_count; i++)
+		message_lengths[i] = (i & 127) + 1;
+
+	/* Old key generation */
+	for (i = 0; i < test_count; i++)
+		BENCH_TICKS(t[i], number_of_rounds, number_of_rounds, "publickey donna", ed25519_publickey_donna(sks[i], pks[i]));
+	benchmark_keygen_old = benchmark_summary(t, test_count, number_of_rounds);
+
+	/* New key generation */
+	for (i = 0; i < test_count; i++) {
+		BENCH_TICKS(t[i], number_of_rounds, number_of_rounds, "publickey", ed25519_publickey(sks[i], pk));
+		if (memcmp(pk, pks[i], sizeof(pk))){
+			fprintf(stderr, "ERR: wrong public key %zu\n", i);
+			exit(EXIT_FAILURE);
+		}
+	}
+	benchmark_keygen_new = benchmark_summary(t, test_count, number_of_rounds);
+
+	/* Old signing */
+	for (i = 0; i < test_count; i++)
+		BENCH_TICKS(t[i], number_of_rounds, number_of_rounds, "sign donna", ed25519_sign_donna(messages[i], message_lengths[i], sks[i], pks[i], sigs[i]));
+	benchmark_sign_old = benchmark_summary(t, test_count, number_of_rounds);
+
+	/* New signing */
+	for (i = 0; i < test_count; i++) {
+		BENCH_TICKS(t[i], number_of_rounds, number_of_rounds, "sign", ed25519_sign(messages[i], message_lengths[i], sks[i], pks[i], sig));
+		if (memcmp(sig, sigs[i], sizeof(sig)) || ed25519_sign_open(messages[i], message_lengths[i], pks[i], sig)){
+			fprintf(stderr, "ERR: wrong signature %zu\n", i);
+			exit(EXIT_FAILURE);
+		}
+	}
+	benchmark_sign_new = benchmark_summary(t, test_count, number_of_rounds);
+
+	printf("Key generation:\n");
+	print_comparison("Old approach", "New inverse", benchmark_keygen_old, benchmark_keygen_new);
+
+	printf("Signing:\n");
+	print_comparison("Old approach", "New inverse", benchmark_sign_old, benchmark_sign_new);
+
+	return 0;
+}
+
+int main(){
+	perf_open();
+	printf("Benchmark of key generation and signing:\n");
+	printf("Number of samples = %i \n", number_of_samples);
+	printf("Number of rounds = %i \n", number_of_rounds);
+	test_instance(number_of_samples);
+	perf_report();
+	printf("Done!\n");
+}
@@ -1,31 +1,24 @@
 #include <stdio.h>
+#include <inttypes.h>
 #include <string.h>
-#include "test-ticks.h"
+#include <openssl/sha.h>
+#include "test-bench.h"
 #include "../src/ed25519-donna/ed25519.h"
 
 #define number_of_samples 10000
 #define number_of_rounds 10
 
 
-struct benchmark_result{
-	uint64_t best;
-	uint64_t median;
-	double average;
-};
 
-static int cmp_int64(const void *v1, const void *v2)
+/* H(R,A,M) computed outside the library, as a caller of ed25519_verify_prehashed_hram would */
+static void hram_openssl(unsigned char hram[64], const unsigned char *RS, const unsigned char *pk, const unsigned char *m, size_t mlen)
 {
-	int64_t x1, x2;
+	unsigned char buf[64 + 128];
 
-	x1 = *(const int64_t *)v1;
-	x2 = *(const int64_t *)v2;
-	if (x1 < x2) {
-		return -1;
-	} else if (x1 == x2) {
-		return 0;
-	} else {
-		return 1;
-	}
+	memcpy(buf, RS, 32);
+	memcpy(buf + 32, pk, 32);
+	memcpy(buf + 64, m, mlen);
+	SHA512(buf, 64 + mlen, hram);
 }
 
 
@@ -39,15 +32,16 @@ int test_instance(size_t test_count){
 	const unsigned char *pk_pointers[test_count];
 	const unsigned char *sig_pointers[test_count];
 	int ret;
-	size_t i, j;
-	uint64_t t_begin;
+	size_t i;
 
 	uint64_t t[test_count];
-	uint64_t total_t = 0;
 	struct benchmark_result benchmark_old; 
+	struct benchmark_result benchmark_old_pack; 
 	struct benchmark_result benchmark_hEEA; 
 	struct benchmark_result benchmark_hEEA_samePre; 
-	struct benchmark_result benchmark_gmp_hgcd; 
+#if !defined(ED25519_NO_HGCD)
+	struct benchmark_result benchmark_gmp_hgcd;
+#endif
 
 	/* generate keys */
 	for (i = 0; i < test_count; i++) {
@@ -72,119 +66,165 @@ int test_instance(size_t test_count){
 
 	/* verify messages */	
 			
+#if !defined(ED25519_NO_HGCD)
 	/* New approach using gmp_hgcd */
-	total_t = 0;
 	for (i = 0; i < test_count; i++) {
-		t_begin = get_ticks();
-		for(j=0;j<number_of_rounds;j++){
-			ret = ed25519_sign_open_hgcd(message_pointers[i], message_lengths[i], pks[i], sigs[i]);
-		}
-		t[i] = get_ticks() - t_begin;
-		total_t += t[i];
+		BENCH_TICKS(t[i], number_of_rounds, number_of_rounds, "hgcd", ret = ed25519_sign_open_hgcd(message_pointers[i], message_lengths[i], pks[i], sigs[i]));
 		if (ret){
-			fprintf(stderr, "ERR: failed to open message %lu using new open using hgcd\n", i);
+			fprintf(stderr, "ERR: failed to open message %zu using new open using hgcd\n", i);
 			exit(EXIT_FAILURE);
 		}
 	}
-	qsort(t, test_count, sizeof(uint64_t), cmp_int64);
-	benchmark_gmp_hgcd.best =  t[0]/number_of_rounds;
-	benchmark_gmp_hgcd.median = t[test_count/2]/number_of_rounds;
-	benchmark_gmp_hgcd.average =  total_t/(number_of_rounds*(double)test_count);
+	benchmark_gmp_hgcd = benchmark_summary(t, test_count, number_of_rounds);
+#endif
 	
 
 	/* Old approach */
-	total_t = 0;
 	for (i = 0; i < test_count; i++) {
-		t_begin = get_ticks();
-		for(j=0;j<number_of_rounds;j++){
-			ret = ed25519_sign_open(message_pointers[i], message_lengths[i], pks[i], sigs[i]);
+		BENCH_TICKS(t[i], number_of_rounds, number_of_rounds, "donna", ret = ed25519_sign_open_donna(message_pointers[i], message_lengths[i], pks[i], sigs[i]));
+		if (ret){
+			fprintf(stderr, "ERR: failed to open message %zu\n", i);
+			exit(EXIT_FAILURE);
+
 		}
-		t[i] = get_ticks() - t_begin;
-		total_t += t[i];
+	}
+	benchmark_old = benchmark_summary(t, test_count, number_of_rounds);
+
+	
+	/* Old approach, packing R with the EEA_q inversion */
+	for (i = 0; i < test_count; i++) {
+		BENCH_TICKS(t[i], number_of_rounds, number_of_rounds, "sign_open", ret = ed25519_sign_open(message_pointers[i], message_lengths[i], pks[i], sigs[i]));
 		if (ret){
-			fprintf(stderr, "ERR: failed to open message %lu\n", i);
+			fprintf(stderr, "ERR: failed to open message %zu using EEA_q pack\n", i);
 			exit(EXIT_FAILURE);
 
 		}
 	}
-	qsort(t, test_count, sizeof(uint64_t), cmp_int64);
-	benchmark_old.best =  t[0]/number_of_rounds;
-	benchmark_old.median = t[test_count/2]/number_of_rounds;
-	benchmark_old.average =  total_t/(number_of_rounds*(double)test_count);
+	benchmark_old_pack = benchmark_summary(t, test_count, number_of_rounds);
 
 	
 	/* New approach using hEEA */
-	total_t = 0;
 	for (i = 0; i < test_count; i++) {	
-		t_begin = get_ticks();
-		for(j=0;j<number_of_rounds;j++){
-			ret = ed25519_sign_open_hEEA(message_pointers[i], message_lengths[i], pks[i], sigs[i]);
-		}
-		t[i] = get_ticks() - t_begin;
-		total_t += t[i];
+		BENCH_TICKS(t[i], number_of_rounds, number_of_rounds, "hEEA_q", ret = ed25519_sign_open_hEEA(message_pointers[i], message_lengths[i], pks[i], sigs[i]));
 		if (ret){
-			fprintf(stderr, "ERR: failed to open message %lu using new open using hEEA_q\n", i);
+			fprintf(stderr, "ERR: failed to open message %zu using new open using hEEA_q\n", i);
 			exit(EXIT_FAILURE);
 		}	
 	}
-	qsort(t, test_count, sizeof(uint64_t), cmp_int64);
-	benchmark_hEEA.best =  t[0]/number_of_rounds;
-	benchmark_hEEA.median = t[test_count/2]/number_of_rounds;
-	benchmark_hEEA.average =  total_t/(number_of_rounds*(double)test_count);
+	benchmark_hEEA = benchmark_summary(t, test_count, number_of_rounds);
 
 	/* New approach using hEEA_samePre */
-	total_t = 0;
 	for (i = 0; i < test_count; i++) {	
-		t_begin = get_ticks();
-		for(j=0;j<number_of_rounds;j++){
-			ret = ed25519_sign_open_hEEA_samePre(message_pointers[i], message_lengths[i], pks[i], sigs[i]);
-		}
-		t[i] = get_ticks() - t_begin;
-		total_t += t[i];
+		BENCH_TICKS(t[i], number_of_rounds, number_of_rounds, "hEEA_q samePre", ret = ed25519_sign_open_hEEA_samePre(message_pointers[i], message_lengths[i], pks[i], sigs[i]));
 		if (ret){
-			fprintf(stderr, "ERR: failed to open message %lu using new open using hEEA with a same Pre-table\n", i);
+			fprintf(stderr, "ERR: failed to open message %zu using new open using hEEA with a same Pre-table\n", i);
 			exit(EXIT_FAILURE);
 		}
 	}
-	qsort(t, test_count, sizeof(uint64_t), cmp_int64);
-	benchmark_hEEA_samePre.best =  t[0]/number_of_rounds;
-	benchmark_hEEA_samePre.median = t[test_count/2]/number_of_rounds;
-	benchmark_hEEA_samePre.average =  total_t/(number_of_rounds*(double)test_count);
+	benchmark_hEEA_samePre = benchmark_summary(t, test_count, number_of_rounds);
 	
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Time (ticks)| Old approach |    hEEA_q    | Speed up     | Improvement\n");
-	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Best        | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_old.best, benchmark_hEEA.best, (double)benchmark_old.best/(double)benchmark_hEEA.best,(double)(benchmark_old.best - benchmark_hEEA.best)/((double)benchmark_old.best) * 100);
-	printf("Median      | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_old.median, benchmark_hEEA.median, (double)benchmark_old.median/(double)benchmark_hEEA.median,(double)(benchmark_old.median - benchmark_hEEA.median)/((double)benchmark_old.median) * 100);
-	printf("Average     | %-12.2f | %-12.2f | %-12.4f | %.2f %%\n", benchmark_old.average, benchmark_hEEA.average, (double)benchmark_old.average/(double)benchmark_hEEA.average,(double)(benchmark_old.average - benchmark_hEEA.average)/((double)benchmark_old.average) * 100);
-	printf("───────────────────────────────────────────────────────────────────────\n");
+	print_comparison("Old approach", "EEA_q pack", benchmark_old, benchmark_old_pack);
+
+	print_comparison("Old approach", "hEEA_q", benchmark_old, benchmark_hEEA);
+
+	print_comparison("Old approach", "hEEA_q_SamePre", benchmark_old, benchmark_hEEA_samePre);
+
+#if !defined(ED25519_NO_HGCD)
+	print_comparison("hEEA_q", "GMP_hgcd", benchmark_hEEA, benchmark_gmp_hgcd);
+#endif
+
+
+
+	/* Sweep of the (253 - bl_t)/bl_t split of the half-size scalars; 0 is the split picked by the cost model */
+	static const unsigned split_targets[] = {0, 115, 118, 121, 124, 127, 130, 133, 136};
+	size_t k;
 
 	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Time (ticks)| Old approach |hEEA_q_SamePre| Speed up     | Improvement\n");
+	printf("Split       | bl(c0)/bl(c1)| Model cost   | Median       | Average\n");
 	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Best        | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_old.best, benchmark_hEEA_samePre.best, (double)benchmark_old.best/(double)benchmark_hEEA_samePre.best,(double)(benchmark_old.best - benchmark_hEEA_samePre.best)/((double)benchmark_old.best) * 100);
-	printf("Median      | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_old.median, benchmark_hEEA_samePre.median, (double)benchmark_old.median/(double)benchmark_hEEA_samePre.median,(double)(benchmark_old.median - benchmark_hEEA_samePre.median)/((double)benchmark_old.median) * 100);
-	printf("Average     | %-12.2f | %-12.2f | %-12.4f | %.2f %%\n", benchmark_old.average, benchmark_hEEA_samePre.average, (double)benchmark_old.average/(double)benchmark_hEEA_samePre.average,(double)(benchmark_old.average - benchmark_hEEA_samePre.average)/((double)benchmark_old.average) * 100);
+	for (k = 0; k < sizeof(split_targets)/sizeof(split_targets[0]); k++) {
+		unsigned bl_t = split_targets[k] ? split_targets[k] : ed25519_hEEA_split();
+		struct benchmark_result benchmark_split;
+		char name[PERF_NAME_SIZE];
+
+		snprintf(name, sizeof(name), "hEEA_q split %u", split_targets[k]);
+		for (i = 0; i < test_count; i++) {
+			BENCH_TICKS(t[i], number_of_rounds, number_of_rounds, name, ret = ed25519_sign_open_hEEA_split(message_pointers[i], message_lengths[i], pks[i], sigs[i], split_targets[k]));
+			if (ret){
+				fprintf(stderr, "ERR: failed to open message %zu using hEEA_q split at %u bits\n", i, bl_t);
+				exit(EXIT_FAILURE);
+			}
+		}
+		benchmark_split = benchmark_summary(t, test_count, number_of_rounds);
+		printf("%-11s | %3u/%-8u | %-12" PRIu64 " | %-12" PRIu64 " | %.2f\n", split_targets[k] ? "" : "model", 253 - bl_t, bl_t,
+			ed25519_hEEA_split_cost(bl_t), benchmark_split.median, benchmark_split.average);
+	}
 	printf("───────────────────────────────────────────────────────────────────────\n");
 
+	/* Cost of each stage: H(R,A,M), the group check from a given hash, and both in ed25519_sign_open_hEEA */
+	static unsigned char hrams[number_of_samples][64];
+	ed25519_signature bad;
+	uint64_t t_hash[test_count], t_group[test_count];
+	uint64_t median_hash, median_group;
+
+	for (i = 0; i < test_count; i++) {
+		BENCH_TICKS(t_hash[i], number_of_rounds, number_of_rounds, "H(R,A,M)", hram_openssl(hrams[i], sigs[i], pks[i], message_pointers[i], message_lengths[i]));
+
+		BENCH_TICKS(t_group[i], number_of_rounds, number_of_rounds, "prehashed", ret = ed25519_verify_prehashed_hram(hrams[i], pks[i], sigs[i]));
+
+		memcpy(bad, sigs[i], sizeof(bad));
+		bad[32 + (i & 31)] ^= 1 << (i & 7);
+		if (ret || !ed25519_verify_prehashed_hram(hrams[i], pks[i], bad)){
+			fprintf(stderr, "ERR: wrong result for message %zu using the prehashed hEEA_q\n", i);
+			exit(EXIT_FAILURE);
+		}
+	}
+	median_hash = benchmark_median(t_hash, test_count, number_of_rounds);
+	median_group = benchmark_median(t_group, test_count, number_of_rounds);
+
 	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Time (ticks)|    hEEA_q    |   GMP_hgcd   | Speed up     | Improvement\n");
+	printf("Stage (median ticks)          | Ticks        | Share of hEEA_q\n");
 	printf("───────────────────────────────────────────────────────────────────────\n");
-	printf("Best        | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_hEEA.best, benchmark_gmp_hgcd.best, (double)benchmark_hEEA.best/(double)benchmark_gmp_hgcd.best,((double)benchmark_hEEA.best - (double)benchmark_gmp_hgcd.best)/((double)benchmark_hEEA.best) * 100);
-	printf("Median      | %-12lu | %-12lu | %-12.4f | %.2f %%\n", benchmark_hEEA.median, benchmark_gmp_hgcd.median, (double)benchmark_hEEA.median/(double)benchmark_gmp_hgcd.median,((double)benchmark_hEEA.median - (double)benchmark_gmp_hgcd.median)/((double)benchmark_hEEA.median) * 100);
-	printf("Average     | %-12.2f | %-12.2f | %-12.4f | %.2f %%\n", benchmark_hEEA.average, benchmark_gmp_hgcd.average, (double)benchmark_hEEA.average/(double)benchmark_gmp_hgcd.average,(double)(benchmark_hEEA.average - benchmark_gmp_hgcd.average)/((double)benchmark_hEEA.average) * 100);
+	printf("H(R,A,M), SHA-512             | %-12" PRIu64 " | %.2f %%\n", median_hash, (double)median_hash/(double)benchmark_hEEA.median * 100);
+	printf("ed25519_verify_prehashed_hram | %-12" PRIu64 " | %.2f %%\n", median_group, (double)median_group/(double)benchmark_hEEA.median * 100);
+	printf("ed25519_sign_open_hEEA        | %-12" PRIu64 " | 100.00 %%\n", benchmark_hEEA.median);
 	printf("───────────────────────────────────────────────────────────────────────\n");
 
-
 	return 0;
 
 }
 
-int main(){
+/* prints ed25519-donna-straus-windows.h for this machine */
+void calibrate(){
+	uint64_t table_cost, add_cost, dbl_cost;
+	unsigned char window[33];
+	size_t i;
+
+	ed25519_straus_calibrate(get_ticks, &table_cost, &add_cost, &dbl_cost, window);
+
+	printf("/*\n\tStraus window tuning, generated by `make calibrate`\n*/\n\n");
+	printf("#define GE25519_STRAUS_TABLE_COST %" PRIu64 "\n", table_cost);
+	printf("#define GE25519_STRAUS_ADD_COST %" PRIu64 "\n", add_cost);
+	printf("#define GE25519_STRAUS_DBL_COST %" PRIu64 "\n\n", dbl_cost);
+	printf("/* window width of a runtime stream, indexed by (bit length of its scalar + 7) / 8 */\n");
+	printf("static const unsigned char ge25519_straus_window[33] = {");
+	for (i = 0; i < 33; i++)
+		printf("%s%u%s", (i & 15) ? " " : "\n\t", window[i], (i < 32) ? "," : "\n");
+	printf("};\n");
+}
+
+int main(int argc, char **argv){
+	if (argc > 1 && !strcmp(argv[1], "--calibrate")) {
+		calibrate();
+		return 0;
+	}
+
+	perf_open();
 	printf("Benchmark of individual verification:\n");
 	printf("Number of samples = %i \n", number_of_samples);
 	printf("Number of rounds = %i \n", number_of_rounds);
 	test_instance(number_of_samples);
+	perf_report();
 	printf("Done!\n");
 		
 }
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test-bench.h"
+#include "../src/ed25519-donna/ed25519.h"
+
+
+#define number_of_samples 10000
+#define number_of_rounds 10
+
+/* ed25519.c built a second time with ED25519_SSE2 (see `OBJSSE2` in the Makefile) */
+int ed25519_sign_open_donna_sse2(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
+int ed25519_sign_open_hEEA_sse2(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
+int ed25519_sign_open_hEEA_samePre_sse2(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
+
+typedef int (*open_fn)(const unsigned char *, size_t, const ed25519_public_key, const ed25519_signature);
+
+
+struct sse2_result{
+	uint64_t base;
+	uint64_t sse2;
+};
+
+/*
+ * Runs both builds of a verifier on the same signatures, checks that they
+ * accept the valid ones and reject a corrupted copy, and keeps the median
+ * time of each.
+ */
+struct sse2_result bench_open(const char *name, open_fn base, open_fn sse2,
+	const unsigned char (*messages)[128], const size_t *message_lengths,
+	const ed25519_public_key *pks, const ed25519_signature *sigs, size_t test_count){
+	struct sse2_result res;
+	ed25519_signature bad;
+	char name_base[PERF_NAME_SIZE], name_sse2[PERF_NAME_SIZE];
+	uint64_t t[test_count], u[test_count];
+	int ret_base = 0, ret_sse2 = 0;
+	size_t i;
+
+	snprintf(name_base, sizeof(name_base), "%s, 64-bit", name);
+	snprintf(name_sse2, sizeof(name_sse2), "%s, SSE2", name);
+	for (i = 0; i < test_count; i++) {
+		BENCH_TICKS(t[i], number_of_rounds, number_of_rounds, name_base, ret_base |= base(messages[i], message_lengths[i], pks[i], sigs[i]));
+
+		BENCH_TICKS(u[i], number_of_rounds, number_of_rounds, name_sse2, ret_sse2 |= sse2(messages[i], message_lengths[i], pks[i], sigs[i]));
+
+		memcpy(bad, sigs[i], sizeof(bad));
+		bad[i & 31] ^= 1 << (i & 7);
+		if (ret_base || ret_sse2 || !base(messages[i], message_lengths[i], pks[i], bad) || !sse2(messages[i], message_lengths[i], pks[i], bad)) {
+			fprintf(stderr, "ERR: `%s` failed on message %zu\n", name, i);
+			exit(EXIT_FAILURE);
+		}
+	}
+	res.base = benchmark_median(t, test_count, number_of_rounds);
+	res.sse2 = benchmark_median(u, test_count, number_of_rounds);
+	return res;
+}
+
+void print_result(const char *name, struct sse2_result res){
+	printf("%-20s | %-12" PRIu64 " | %-12" PRIu64 " | %.4f\n", name, res.base, res.sse2, (double)res.sse2/(double)res.base);
+}
+
+int test_instance(size_t test_count){
+	static ed25519_secret_key sks[number_of_samples];
+	static ed25519_public_key pks[number_of_samples];
+	static ed25519_signature sigs[number_of_samples];
+	static unsigned char messages[number_of_samples][128];
+	static size_t message_lengths[number_of_samples];
+	size_t i;
+
+	ed25519_randombytes_unsafe(sks, sizeof(sks));
+	ed25519_randombytes_unsafe(messages, sizeof(messages));
+	for (i = 0; i < test_count; i++) {
+		message_lengths[i] = (i & 127) + 1;
+		ed25519_publickey(sks[i], pks[i]);
+		ed25519_sign(messages[i], message_lengths[i], sks[i], pks[i], sigs[i]);
+	}
+
+	printf("───────────────────────────────────────────────────────────────────────\n");
+	printf("Median (ticks)       | 64-bit       | SSE2         | Ratio\n");
+	printf("───────────────────────────────────────────────────────────────────────\n");
+	print_result("donna", bench_open("ed25519_sign_open_donna", ed25519_sign_open_donna, ed25519_sign_open_donna_sse2, (const unsigned char (*)[128])messages, message_lengths, (const ed25519_public_key *)pks, (const ed25519_signature *)sigs, test_count));
+	print_result("hEEA_q", bench_open("ed25519_sign_open_hEEA", ed25519_sign_open_hEEA, ed25519_sign_open_hEEA_sse2, (const unsigned char (*)[128])messages, message_lengths, (const ed25519_public_key *)pks, (const ed25519_signature *)sigs, test_count));
+	print_result("hEEA_q samePre", bench_open("ed25519_sign_open_hEEA_samePre", ed25519_sign_open_hEEA_samePre, ed25519_sign_open_hEEA_samePre_sse2, (const unsigned char (*)[128])messages, message_lengths, (const ed25519_public_key *)pks, (const ed25519_signature *)sigs, test_count));
+	printf("───────────────────────────────────────────────────────────────────────\n");
+
+	return 0;
+}
+
+int main(){
+	perf_open();
+	printf("Benchmark of the SSE2 backend against the 64-bit one:\n");
+	printf("Number of samples = %i \n", number_of_samples);
+	printf("Number of rounds = %i \n", number_of_rounds);
+	test_instance(number_of_samples);
+	perf_report();
+	printf("Done!\n");
+}